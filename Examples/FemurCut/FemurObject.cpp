@@ -111,9 +111,9 @@ void
 FemurObject::updateModifiedVoxels()
 {
     // Forward the level set's modified nodes to the isosurface extraction
-    for (auto i : getLevelSetModel()->getNodesToUpdate())
+    for (const Vec3i& coord : getLevelSetModel()->getNodesToUpdate())
     {
-        m_isoExtract->setModified(std::get<0>(i.second));
+        m_isoExtract->setModified(coord);
     }
 }
 
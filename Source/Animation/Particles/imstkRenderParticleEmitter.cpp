@@ -6,11 +6,43 @@
 
 #include "imstkRenderParticleEmitter.h"
 #include "imstkLogger.h"
+#include "imstkParallelFor.h"
 #include "imstkRenderParticles.h"
 #include "imstkTimer.h"
+#include "imstkVecDataArray.h"
+
+#include <algorithm>
+#include <numeric>
 
 namespace imstk
 {
+namespace
+{
+///
+/// \brief Raw pointers to the particle attributes for the parallel update
+///
+struct ParticleArrays
+{
+    ParticleArrays(RenderParticles& particles) :
+        positions(particles.getPositions()->getPointer()),
+        velocities(particles.getVelocities()->getPointer()),
+        ages(particles.getAges()->getPointer()),
+        colors(particles.getColors()->getPointer()),
+        scales(particles.getScales()->getPointer()),
+        rotations(particles.getRotations()->getPointer()),
+        rotationalVelocities(particles.getRotationalVelocities()->getPointer())
+    {
+    }
+
+    Vec3f* positions;
+    Vec3f* velocities;
+    float* ages;
+    Vec4f* colors;
+    float* scales;
+    float* rotations;
+    float* rotationalVelocities;
+};
+} // namespace
 RenderParticleEmitter::RenderParticleEmitter(std::shared_ptr<Geometry>   geometry,
                                              const float                 time /*= 3000*/,
                                              RenderParticleEmitter::Mode mode /*= Mode::CONTINUOUS*/)
@@ -37,6 +69,8 @@ RenderParticleEmitter::RenderParticleEmitter(std::shared_ptr<Geometry>   geometr
     this->initializeParticles();
 }
 
+RenderParticleEmitter::~RenderParticleEmitter() = default;
+
 void
 RenderParticleEmitter::setGeometry(
     std::shared_ptr<Geometry> geometry)
@@ -44,7 +78,7 @@ RenderParticleEmitter::setGeometry(
     CHECK(geometry->getTypeName() == RenderParticles::getStaticTypeName()) << "Error: Geometry must be RenderParticles";
 
     m_animationGeometry = geometry;
-    m_particles = &std::static_pointer_cast<RenderParticles>(m_animationGeometry)->getParticles();
+    m_particles = std::static_pointer_cast<RenderParticles>(m_animationGeometry);
 }
 
 RenderParticleEmitter::Mode
@@ -86,6 +120,7 @@ RenderParticleEmitter::addKeyFrame(RenderParticleKeyFrame keyFrame)
     }
 
     m_keyFrames.push_back(keyFrame);
+    m_keyFrameTableDirty = true;
     return true;
 }
 
@@ -102,6 +137,7 @@ RenderParticleEmitter::getStartKeyFrame()
         }
     }
 
+    m_keyFrameTableDirty = true;
     return &m_keyFrames[index];
 }
 
@@ -118,12 +154,14 @@ RenderParticleEmitter::getEndKeyFrame()
         }
     }
 
+    m_keyFrameTableDirty = true;
     return &m_keyFrames[index];
 }
 
 std::vector<RenderParticleKeyFrame>&
 RenderParticleEmitter::getKeyFrames()
 {
+    m_keyFrameTableDirty = true;
     return m_keyFrames;
 }
 
@@ -135,112 +173,168 @@ RenderParticleEmitter::reset()
         return;
     }
 
-    auto renderParticles = std::static_pointer_cast<RenderParticles>(m_geometry);
-    renderParticles->reset();
-
     this->initializeParticles();
 }
 
 void
 RenderParticleEmitter::update()
 {
-    auto renderParticles = std::static_pointer_cast<RenderParticles>(m_geometry);
-
     if (!m_started)
     {
         m_stopWatch->start();
         m_started = true;
     }
 
-    auto  time = m_stopWatch->getTimeElapsed();
-    float dt   = (float)(time - m_lastUpdateTime);
+    const double time = m_stopWatch->getTimeElapsed();
+    const float  dt   = static_cast<float>(time - m_lastUpdateTime);
     m_lastUpdateTime = time;
 
-    for (auto&& particle : (*m_particles))
-    {
-        auto startKeyFrameTemp = *this->getStartKeyFrame();
-        auto startKeyFrame     = &startKeyFrameTemp;
-        auto endKeyFrameTemp   = *this->getEndKeyFrame();
-        auto endKeyFrame       = &endKeyFrameTemp;
+    updateParticles(dt);
+}
 
-        particle->m_age += dt;
+///
+/// \brief Advance particle i by dt then interpolate the key frames at its age, the
+/// accelerations are those of the last key frame reached
+///
+static void
+updateParticle(const ParticleArrays& particles, const RenderParticleEmitter::KeyFrameTable& keyFrames,
+               const int i, const float dt)
+{
+    const float  age = particles.ages[i];
+    const size_t numKeyFrames = keyFrames.times.size();
+    const size_t next  = static_cast<size_t>(std::upper_bound(keyFrames.times.begin(), keyFrames.times.end(), age) - keyFrames.times.begin());
+    const size_t start = (next == 0) ? 0 : next - 1;
+    const size_t end   = std::min(next, numKeyFrames - 1);
+
+    const float dtSeconds = dt / 1000.0f;
+    particles.rotationalVelocities[i] += keyFrames.rotationalAccelerations[start] * dtSeconds;
+    particles.rotations[i]  += particles.rotationalVelocities[i] * dtSeconds;
+    particles.velocities[i] += keyFrames.accelerations[start] * dtSeconds;
+    particles.positions[i]  += particles.velocities[i] * dtSeconds;
+
+    const float timeDifference = keyFrames.times[end] - keyFrames.times[start];
+    const float alpha = (timeDifference > 0.0f) ? (age - keyFrames.times[start]) / timeDifference : 0.0f;
+    particles.scales[i] = alpha * keyFrames.scales[end] + (1.0f - alpha) * keyFrames.scales[start];
+    particles.colors[i] = alpha * keyFrames.colors[end] + (1.0f - alpha) * keyFrames.colors[start];
+}
 
-        if (!(particle->m_created) && particle->m_age >= 0)
-        {
-            particle->m_created = true;
-            this->emitParticle(particle);
-            renderParticles->incrementNumOfParticles();
-        }
-        else if (particle->m_age < 0)
-        {
-            continue;
-        }
+void
+RenderParticleEmitter::updateParticles(const float dt)
+{
+    updateKeyFrameTable();
+    if (m_keyFrameTable.times.empty())
+    {
+        LOG(WARNING) << "Particle emitter has no key frames";
+        return;
+    }
 
-        if (m_mode == RenderParticleEmitter::Mode::Continuous
-            && particle->m_age > m_time)
-        {
-            particle->m_age = particle->m_age - ((int)(particle->m_age / m_time) * m_time);
-            this->emitParticle(particle);
-        }
+    ParticleArrays particles(*m_particles);
 
-        // Search for nearest keyframe
-        for (size_t i = 0; i < m_keyFrames.size(); i++)
+    // Age and advance the active particles, those past their lifespan are handled after
+    const int numParticles = m_particles->getNumParticles();
+    m_expired.assign(numParticles, 0);
+    ParallelUtils::parallelFor(numParticles, [&](const int i)
         {
-            auto keyFrame = &m_keyFrames[i];
-            if (particle->m_age >= keyFrame->m_time
-                && keyFrame->m_time > startKeyFrame->m_time)
+            particles.ages[i] += dt;
+            if (particles.ages[i] > m_time)
             {
-                startKeyFrame = keyFrame;
+                m_expired[i] = 1;
             }
-            if (particle->m_age < keyFrame->m_time
-                && keyFrame->m_time < endKeyFrame->m_time)
+            else
             {
-                endKeyFrame = keyFrame;
+                updateParticle(particles, m_keyFrameTable, i, dt);
             }
-        }
-
-        // Update velocity and position
-        particle->m_rotationalAcceleration = startKeyFrame->m_rotationalAcceleration;
-        particle->m_rotationalVelocity    += particle->m_rotationalAcceleration * (dt / 1000.0f);
-        particle->m_rotation += particle->m_rotationalVelocity * (dt / 1000.0f);
-
-        particle->m_acceleration = startKeyFrame->m_acceleration;
-        particle->m_velocity    += particle->m_acceleration * (dt / 1000.0);
-        particle->m_position    += particle->m_velocity * (dt / 1000.0);
+        }, numParticles > 256);
 
-        float timeDifference = endKeyFrame->m_time - startKeyFrame->m_time;
-        float alpha = (particle->m_age - startKeyFrame->m_time) / timeDifference;
-
-        particle->m_scale = (alpha * endKeyFrame->m_scale)
-                            + ((1.0f - alpha) * startKeyFrame->m_scale);
+    std::vector<int> expiredIds;
+    for (int i = 0; i < numParticles; i++)
+    {
+        if (m_expired[i])
+        {
+            expiredIds.push_back(i);
+        }
+    }
+    if (m_mode == Mode::Continuous)
+    {
+        // Recycle, as if reemitted at the end of their lifespan
+        for (const int i : expiredIds)
+        {
+            const float age = std::fmod(particles.ages[i], m_time);
+            this->emitParticle(i);
+            particles.ages[i] = age;
+            updateParticle(particles, m_keyFrameTable, i, age);
+        }
+    }
+    else
+    {
+        m_particles->removeParticles(expiredIds);
+    }
 
-        auto particleColor = imstk::Color(particle->m_color[0], particle->m_color[1], particle->m_color[2], particle->m_color[3]);
-        this->interpolateColor(particleColor,
-            endKeyFrame->m_color,
-            startKeyFrame->m_color,
-            alpha);
+    // Emit at a constant rate, the maximum number of particles over the emit time.
+    // Burst emitters emit that many particles once
+    m_emitterTime += dt;
+    const int   maxNumParticles = m_particles->getMaxNumParticles();
+    const float emitInterval    = m_emitTime / static_cast<float>(std::max(maxNumParticles, 1));
+    while (m_numEmitted < maxNumParticles && m_numEmitted * emitInterval <= m_emitterTime)
+    {
+        const int i = m_particles->addParticle();
+        if (i == -1)
+        {
+            break;
+        }
+        this->emitParticle(i);
+        particles.ages[i] = m_emitterTime - m_numEmitted * emitInterval;
+        updateParticle(particles, m_keyFrameTable, i, particles.ages[i]);
+        m_numEmitted++;
     }
+
+    m_particles->postModified();
 }
 
 void
 RenderParticleEmitter::initializeParticles()
 {
-    m_particles->clear();
-
-    auto particles = std::static_pointer_cast<RenderParticles>(m_animationGeometry);
+    m_particles->reset();
+    m_emitterTime = 0.0f;
+    m_numEmitted  = 0;
+}
 
-    for (unsigned int i = 0; i < particles->getMaxNumParticles(); i++)
+void
+RenderParticleEmitter::updateKeyFrameTable()
+{
+    if (!m_keyFrameTableDirty)
     {
-        m_particles->push_back(std::unique_ptr<RenderParticle>(new RenderParticle()));
-        (*m_particles)[i]->m_age     = -(i / (float)(particles->getMaxNumParticles())) * m_emitTime;
-        (*m_particles)[i]->m_created = false;
+        return;
+    }
+    m_keyFrameTableDirty = false;
+
+    std::vector<size_t> order(m_keyFrames.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+        [&](const size_t a, const size_t b) { return m_keyFrames[a].m_time < m_keyFrames[b].m_time; });
+
+    m_keyFrameTable.times.resize(order.size());
+    m_keyFrameTable.colors.resize(order.size());
+    m_keyFrameTable.accelerations.resize(order.size());
+    m_keyFrameTable.rotationalAccelerations.resize(order.size());
+    m_keyFrameTable.scales.resize(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const RenderParticleKeyFrame& keyFrame = m_keyFrames[order[i]];
+        m_keyFrameTable.times[i]  = keyFrame.m_time;
+        m_keyFrameTable.colors[i] = Vec4f(static_cast<float>(keyFrame.m_color.r), static_cast<float>(keyFrame.m_color.g),
+            static_cast<float>(keyFrame.m_color.b), static_cast<float>(keyFrame.m_color.a));
+        m_keyFrameTable.accelerations[i] = keyFrame.m_acceleration;
+        m_keyFrameTable.rotationalAccelerations[i] = keyFrame.m_rotationalAcceleration;
+        m_keyFrameTable.scales[i] = keyFrame.m_scale;
     }
 }
 
 void
-RenderParticleEmitter::emitParticle(std::unique_ptr<RenderParticle>& particle)
+RenderParticleEmitter::emitParticle(const int i)
 {
-    auto position = m_animationGeometry->getTranslation();
+    ParticleArrays particles(*m_particles);
+    auto           position = m_animationGeometry->getTranslation();
 
     if (m_shape == Shape::Cube)
     {
@@ -248,16 +342,16 @@ RenderParticleEmitter::emitParticle(std::unique_ptr<RenderParticle>& particle)
         float y = (getRandomNormalizedFloat() - 0.5f) * m_emitterSize;
         float z = (getRandomNormalizedFloat() - 0.5f) * m_emitterSize;
 
-        particle->m_position[0] = (float)position[0] + x;
-        particle->m_position[1] = (float)position[1] + y;
-        particle->m_position[2] = (float)position[2] + z;
+        particles.positions[i][0] = (float)position[0] + x;
+        particles.positions[i][1] = (float)position[1] + y;
+        particles.positions[i][2] = (float)position[2] + z;
     }
 
     float randomRotation = getRandomNormalizedFloat() * (float)PI * 2.0f;
     float randomRotationalVelocity = getRandomNormalizedFloat();
-    particle->m_rotation = randomRotation;
-    particle->m_rotationalVelocity = (randomRotationalVelocity * m_minRotationSpeed) +
-                                     ((1.0f - randomRotationalVelocity) * m_maxRotationSpeed);
+    particles.rotations[i] = randomRotation;
+    particles.rotationalVelocities[i] = (randomRotationalVelocity * m_minRotationSpeed) +
+                                        ((1.0f - randomRotationalVelocity) * m_maxRotationSpeed);
 
     float randomDirectionX = getRandomNormalizedFloat();
     float randomDirectionY = getRandomNormalizedFloat();
@@ -270,21 +364,9 @@ RenderParticleEmitter::emitParticle(std::unique_ptr<RenderParticle>& particle)
     float directionZ = (randomDirectionZ * m_minDirection[2]) + ((1.0f - randomDirectionZ) * m_maxDirection[2]);
     Vec3f direction(directionX, directionY, directionZ);
     direction.normalize();
-    particle->m_velocity[0] = directionX * speed;
-    particle->m_velocity[1] = directionY * speed;
-    particle->m_velocity[2] = directionZ * speed;
-}
-
-void
-RenderParticleEmitter::interpolateColor(Color&       destination,
-                                        const Color& sourceA,
-                                        const Color& sourceB,
-                                        const float  alpha)
-{
-    destination.r = (sourceA.r * alpha) + (sourceB.r * (1.0f - alpha));
-    destination.g = (sourceA.g * alpha) + (sourceB.g * (1.0f - alpha));
-    destination.b = (sourceA.b * alpha) + (sourceB.b * (1.0f - alpha));
-    destination.a = (sourceA.a * alpha) + (sourceB.a * (1.0f - alpha));
+    particles.velocities[i][0] = directionX * speed;
+    particles.velocities[i][1] = directionY * speed;
+    particles.velocities[i][2] = directionZ * speed;
 }
 
 float
@@ -10,9 +10,11 @@
 #include "imstkAnimationModel.h"
 #include "imstkColor.h"
 
+#include <vector>
+
 namespace imstk
 {
-struct RenderParticle;
+class RenderParticles;
 class StopWatch;
 
 ///
@@ -61,6 +63,7 @@ public:
     explicit RenderParticleEmitter(std::shared_ptr<Geometry> geometry,
                                    const float               time = 3000.0f,
                                    Mode                      mode = Mode::Continuous);
+    ~RenderParticleEmitter();
 
     ///
     /// \brief Set animation geometry
@@ -109,13 +112,15 @@ public:
     bool addKeyFrame(RenderParticleKeyFrame keyFrame);
 
     ///
-    /// \brief Get start and end frames
+    /// \brief Get start and end frames. The key frames are taken as modified, changes
+    /// through the pointer must be made before the next update
     ///
     RenderParticleKeyFrame* getStartKeyFrame();
     RenderParticleKeyFrame* getEndKeyFrame();
 
     ///
-    /// \brief Get key frames
+    /// \brief Get key frames. The key frames are taken as modified, changes through
+    /// the reference must be made before the next update
     /// \returns key frames that are unsorted
     ///
     std::vector<RenderParticleKeyFrame>& getKeyFrames();
@@ -127,28 +132,46 @@ public:
     virtual void reset();
 
     ///
-    /// \brief Update
+    /// \brief Update with the wall clock time elapsed since the last update
     ///
     virtual void update();
 
+    ///
+    /// \brief Advance the particles by dt (in milliseconds). Ages, moves and interpolates
+    /// the key frames of the active particles in parallel then emits the particles due.
+    /// Continuous particles are recycled at the end of their lifespan, burst particles
+    /// are removed
+    ///
+    void updateParticles(const float dt);
+
+    ///
+    /// \brief Key frames sorted by time as arrays, for lookups in the particle update
+    ///
+    struct KeyFrameTable
+    {
+        std::vector<float> times;
+        StdVectorOfVec4f   colors;
+        StdVectorOfVec3f   accelerations;
+        std::vector<float> rotationalAccelerations;
+        std::vector<float> scales;
+    };
+
 protected:
     ///
-    /// \brief Initialize particles
+    /// \brief Restart emission, all particles are removed
     ///
     void initializeParticles();
 
     ///
-    /// \brief Interpolate color
+    /// \brief Sort the key frames into m_keyFrameTable, if they were modified since
+    /// the last time
     ///
-    void interpolateColor(Color&       destination,
-                          const Color& sourceA,
-                          const Color& sourceB,
-                          const float  alpha);
+    void updateKeyFrameTable();
 
     ///
-    /// \brief Emit particle
+    /// \brief Emit particle i, randomizing its position, velocity and rotation
     ///
-    void emitParticle(std::unique_ptr<RenderParticle>& particle);
+    void emitParticle(const int i);
 
     ///
     /// \brief Get uniformly-distributed float
@@ -170,8 +193,8 @@ protected:
     float m_minRotationSpeed;
     float m_maxRotationSpeed;
 
-    float m_time; ///< total time for particle system
-    float m_emitTime;
+    float m_time; ///< Lifespan of each particle
+    float m_emitTime; ///< Time over which the maximum number of particles are emitted
 
     std::unique_ptr<StopWatch> m_stopWatch;
 
@@ -182,7 +205,13 @@ protected:
 
     const int c_maxNumKeyFrames = 16; ///< Maximum key frames
 
+    float m_emitterTime  = 0.0f; ///< Time since emission started
+    int   m_numEmitted   = 0;    ///< Particles emitted since emission started, recycled ones excluded
+
     std::shared_ptr<Geometry> m_animationGeometry = nullptr;
-    std::vector<std::unique_ptr<RenderParticle>>* m_particles;
+    std::shared_ptr<RenderParticles> m_particles;
+    KeyFrameTable m_keyFrameTable;
+    bool          m_keyFrameTableDirty = true; ///< Key frames modified since the table was built
+    std::vector<char> m_expired; ///< Flags the particles past their lifespan in an update
 };
 } // imstk
@@ -0,0 +1,189 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDataArray.h"
+#include "imstkRenderParticleEmitter.h"
+#include "imstkRenderParticles.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Create an emitter of particles that live 1000ms, emitted without velocity
+///
+std::shared_ptr<RenderParticleEmitter>
+makeEmitter(std::shared_ptr<RenderParticles> particles, const RenderParticleEmitter::Mode mode)
+{
+    auto emitter = std::make_shared<RenderParticleEmitter>(particles, 1000.0f, mode);
+    emitter->setInitialVelocityRange(Vec3f(0.0f, 1.0f, 0.0f), Vec3f(0.0f, 1.0f, 0.0f), 0.0f, 0.0f, 0.0f, 0.0f);
+    return emitter;
+}
+} // namespace
+
+///
+/// \brief Test removed particles are filled by the last active particles
+///
+TEST(imstkRenderParticleEmitterTest, RemoveParticles)
+{
+    RenderParticles particles(8);
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(particles.addParticle(), i);
+        (*particles.getPositions())[i] = Vec3f(static_cast<float>(i), 0.0f, 0.0f);
+        (*particles.getAges())[i]      = static_cast<float>(i);
+    }
+
+    particles.removeParticles({ 1, 3 });
+    ASSERT_EQ(particles.getNumParticles(), 3);
+    EXPECT_EQ((*particles.getPositions())[0][0], 0.0f);
+    EXPECT_EQ((*particles.getPositions())[1][0], 4.0f);
+    EXPECT_EQ((*particles.getPositions())[2][0], 2.0f);
+    EXPECT_EQ((*particles.getAges())[1], 4.0f);
+
+    // Full
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(particles.addParticle(), 3 + i);
+    }
+    EXPECT_EQ(particles.addParticle(), -1);
+    EXPECT_EQ(particles.getNumParticles(), 8);
+}
+
+///
+/// \brief Test continuous emission ramps up to the maximum number of particles, which
+/// are then recycled
+///
+TEST(imstkRenderParticleEmitterTest, Continuous)
+{
+    auto particles = std::make_shared<RenderParticles>(1000);
+    auto emitter   = makeEmitter(particles, RenderParticleEmitter::Mode::Continuous);
+
+    // One particle every ms
+    for (int i = 0; i < 50; i++)
+    {
+        emitter->updateParticles(5.0f);
+    }
+    EXPECT_EQ(particles->getNumParticles(), 251);
+
+    for (int i = 0; i < 700; i++)
+    {
+        emitter->updateParticles(5.0f);
+    }
+    ASSERT_EQ(particles->getNumParticles(), 1000);
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_GE((*particles->getAges())[i], 0.0f);
+        EXPECT_LE((*particles->getAges())[i], 1000.0f);
+    }
+}
+
+///
+/// \brief Test burst particles are removed at the end of their lifespan and emitted
+/// again on reset
+///
+TEST(imstkRenderParticleEmitterTest, Burst)
+{
+    auto particles = std::make_shared<RenderParticles>(100);
+    auto emitter   = makeEmitter(particles, RenderParticleEmitter::Mode::Burst);
+
+    for (int i = 0; i < 100; i++)
+    {
+        emitter->updateParticles(10.0f);
+    }
+    EXPECT_EQ(particles->getNumParticles(), 100);
+
+    // The first particles expire while the last are still young
+    for (int i = 0; i < 50; i++)
+    {
+        emitter->updateParticles(10.0f);
+    }
+    EXPECT_EQ(particles->getNumParticles(), 50);
+    for (int i = 0; i < particles->getNumParticles(); i++)
+    {
+        EXPECT_LE((*particles->getAges())[i], 1000.0f);
+    }
+
+    for (int i = 0; i < 60; i++)
+    {
+        emitter->updateParticles(10.0f);
+    }
+    EXPECT_EQ(particles->getNumParticles(), 0);
+
+    emitter->reset();
+    emitter->updateParticles(10.0f);
+    EXPECT_EQ(particles->getNumParticles(), 2);
+}
+
+///
+/// \brief Test the particles interpolate key frames added out of order and accelerate
+/// with the last key frame reached
+///
+TEST(imstkRenderParticleEmitterTest, KeyFrames)
+{
+    auto particles = std::make_shared<RenderParticles>(100);
+    auto emitter   = makeEmitter(particles, RenderParticleEmitter::Mode::Continuous);
+    emitter->getStartKeyFrame()->m_acceleration = Vec3f(0.0f, -2.0f, 0.0f);
+    emitter->getEndKeyFrame()->m_scale = 3.0f;
+    emitter->getEndKeyFrame()->m_color = Color(0.0, 0.0, 0.0, 0.0);
+
+    RenderParticleKeyFrame midFrame;
+    midFrame.m_time  = 500.0f;
+    midFrame.m_scale = 5.0f;
+    midFrame.m_color = Color(1.0, 0.0, 0.0, 1.0);
+    midFrame.m_acceleration = Vec3f(4.0f, 0.0f, 0.0f);
+    ASSERT_TRUE(emitter->addKeyFrame(midFrame));
+
+    for (int i = 0; i < 80; i++)
+    {
+        emitter->updateParticles(10.0f);
+    }
+    ASSERT_EQ(particles->getNumParticles(), 81);
+
+    for (int i = 0; i < particles->getNumParticles(); i++)
+    {
+        const float age = (*particles->getAges())[i];
+        if (age < 500.0f)
+        {
+            const float alpha = age / 500.0f;
+            EXPECT_NEAR((*particles->getScales())[i], 1.0f + 4.0f * alpha, 1.0e-4f);
+            EXPECT_NEAR((*particles->getColors())[i][1], 1.0f - alpha, 1.0e-4f);
+            EXPECT_NEAR((*particles->getVelocities())[i][1], -2.0f * age / 1000.0f, 1.0e-4f);
+        }
+        else
+        {
+            const float alpha = (age - 500.0f) / 500.0f;
+            EXPECT_NEAR((*particles->getScales())[i], 5.0f - 2.0f * alpha, 1.0e-4f);
+            EXPECT_NEAR((*particles->getColors())[i][0], 1.0f - alpha, 1.0e-4f);
+            EXPECT_GT((*particles->getVelocities())[i][0], 0.0f);
+        }
+    }
+}
+
+///
+/// \brief Test key frames changed between updates are used by the next update
+///
+TEST(imstkRenderParticleEmitterTest, KeyFramesModified)
+{
+    auto particles = std::make_shared<RenderParticles>(100);
+    auto emitter   = makeEmitter(particles, RenderParticleEmitter::Mode::Continuous);
+    emitter->updateParticles(10.0f);
+    EXPECT_NEAR((*particles->getScales())[0], 1.0f, 1.0e-4f);
+
+    emitter->getEndKeyFrame()->m_scale = 3.0f;
+    emitter->updateParticles(10.0f);
+    EXPECT_NEAR((*particles->getScales())[0], 1.0f + 2.0f * 20.0f / 1000.0f, 1.0e-4f);
+
+    RenderParticleKeyFrame midFrame;
+    midFrame.m_time  = 20.0f;
+    midFrame.m_scale = 5.0f;
+    ASSERT_TRUE(emitter->addKeyFrame(midFrame));
+    emitter->updateParticles(10.0f);
+    EXPECT_NEAR((*particles->getScales())[0], 5.0f - 2.0f * 10.0f / 980.0f, 1.0e-4f);
+}
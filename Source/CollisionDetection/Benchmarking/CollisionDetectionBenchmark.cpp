@@ -0,0 +1,394 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCapsule.h"
+#include "imstkCCDAlgorithm.h"
+#include "imstkCDObjectFactory.h"
+#include "imstkCollisionData.h"
+#include "imstkCylinder.h"
+#include "imstkDataArray.h"
+#include "imstkImageData.h"
+#include "imstkLineMesh.h"
+#include "imstkOrientedBox.h"
+#include "imstkPlane.h"
+#include "imstkSignedDistanceField.h"
+#include "imstkSphere.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkTetrahedralMesh.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Creates a closed UV sphere surface
+/// \param center center of the sphere
+/// \param radius radius of the sphere
+/// \param res number of divisions along the latitude, twice as many along the longitude
+///
+static std::shared_ptr<SurfaceMesh>
+makeSphereMesh(const Vec3d& center, const double radius, const int res)
+{
+    const int numLon = res * 2;
+    auto      verticesPtr = std::make_shared<VecDataArray<double, 3>>((res - 1) * numLon + 2);
+    auto      indicesPtr  = std::make_shared<VecDataArray<int, 3>>();
+
+    VecDataArray<double, 3>& vertices = *verticesPtr;
+    VecDataArray<int, 3>&    indices  = *indicesPtr;
+    indices.reserve(2 * numLon * (res - 1));
+
+    // Rings of vertices between the poles
+    for (int i = 1; i < res; i++)
+    {
+        const double theta = PI * i / res;
+        for (int j = 0; j < numLon; j++)
+        {
+            const double phi = 2.0 * PI * j / numLon;
+            vertices[(i - 1) * numLon + j] = center +
+                                             radius * Vec3d(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+        }
+    }
+    const int northPole = (res - 1) * numLon;
+    const int southPole = northPole + 1;
+    vertices[northPole] = center + Vec3d(0.0, radius, 0.0);
+    vertices[southPole] = center - Vec3d(0.0, radius, 0.0);
+
+    for (int j = 0; j < numLon; j++)
+    {
+        const int j1 = (j + 1) % numLon;
+        indices.push_back(Vec3i(northPole, j1, j));
+        for (int i = 0; i < res - 2; i++)
+        {
+            const int v0 = i * numLon + j;
+            const int v1 = i * numLon + j1;
+            indices.push_back(Vec3i(v0, v1, v1 + numLon));
+            indices.push_back(Vec3i(v0, v1 + numLon, v0 + numLon));
+        }
+        indices.push_back(Vec3i(southPole, (res - 2) * numLon + j, (res - 2) * numLon + j1));
+    }
+
+    auto surfMesh = std::make_shared<SurfaceMesh>();
+    surfMesh->initialize(verticesPtr, indicesPtr);
+    return surfMesh;
+}
+
+///
+/// \brief Creates a tetrahedral grid of a unit cube
+/// \param center center of the grid
+/// \param res number of vertices along every axis
+///
+static std::shared_ptr<TetrahedralMesh>
+makeTetGrid(const Vec3d& center, const int res)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>(res * res * res);
+    auto indicesPtr  = std::make_shared<VecDataArray<int, 4>>();
+
+    VecDataArray<double, 3>& vertices = *verticesPtr;
+    VecDataArray<int, 4>&    indices  = *indicesPtr;
+    const double             dx       = 1.0 / (res - 1);
+    for (int z = 0; z < res; z++)
+    {
+        for (int y = 0; y < res; y++)
+        {
+            for (int x = 0; x < res; x++)
+            {
+                vertices[x + res * (y + res * z)] = Vec3d(x, y, z) * dx - Vec3d(0.5, 0.5, 0.5) + center;
+            }
+        }
+    }
+
+    // Split every cube into 5 tetrahedra, alternating to keep the faces conforming
+    indices.reserve((res - 1) * (res - 1) * (res - 1) * 5);
+    for (int z = 0; z < res - 1; z++)
+    {
+        for (int y = 0; y < res - 1; y++)
+        {
+            for (int x = 0; x < res - 1; x++)
+            {
+                int c[8];
+                for (int i = 0; i < 8; i++)
+                {
+                    c[i] = (x + (i & 1)) + res * ((y + ((i >> 1) & 1)) + res * (z + ((i >> 2) & 1)));
+                }
+                if ((x + y + z) % 2 == 0)
+                {
+                    indices.push_back(Vec4i(c[0], c[1], c[2], c[4]));
+                    indices.push_back(Vec4i(c[1], c[3], c[2], c[7]));
+                    indices.push_back(Vec4i(c[1], c[4], c[5], c[7]));
+                    indices.push_back(Vec4i(c[2], c[4], c[7], c[6]));
+                    indices.push_back(Vec4i(c[1], c[2], c[4], c[7]));
+                }
+                else
+                {
+                    indices.push_back(Vec4i(c[0], c[1], c[3], c[5]));
+                    indices.push_back(Vec4i(c[0], c[3], c[2], c[6]));
+                    indices.push_back(Vec4i(c[0], c[5], c[4], c[6]));
+                    indices.push_back(Vec4i(c[3], c[5], c[6], c[7]));
+                    indices.push_back(Vec4i(c[0], c[3], c[6], c[5]));
+                }
+            }
+        }
+    }
+
+    auto tetMesh = std::make_shared<TetrahedralMesh>();
+    tetMesh->initialize(verticesPtr, indicesPtr);
+    return tetMesh;
+}
+
+///
+/// \brief Creates a grid of points filling a unit cube
+/// \param center center of the cube
+/// \param res number of points along every axis
+///
+static std::shared_ptr<PointSet>
+makePointGrid(const Vec3d& center, const int res)
+{
+    auto                     verticesPtr = std::make_shared<VecDataArray<double, 3>>(res * res * res);
+    VecDataArray<double, 3>& vertices    = *verticesPtr;
+    const double             dx = 1.0 / (res - 1);
+    for (int z = 0; z < res; z++)
+    {
+        for (int y = 0; y < res; y++)
+        {
+            for (int x = 0; x < res; x++)
+            {
+                vertices[x + res * (y + res * z)] = Vec3d(x, y, z) * dx - Vec3d(0.5, 0.5, 0.5) + center;
+            }
+        }
+    }
+
+    auto pointSet = std::make_shared<PointSet>();
+    pointSet->initialize(verticesPtr);
+    return pointSet;
+}
+
+///
+/// \brief Creates a wave along x in the xz plane, a sine or a cosine, of segments
+/// 0.01 long along x with a period of 32 segments
+/// \param shift translation of the wave
+/// \param res number of segments
+///
+static std::shared_ptr<LineMesh>
+makeWave(const Vec3d& shift, const int res, const bool cosine)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>(res + 1);
+    auto indicesPtr  = std::make_shared<VecDataArray<int, 2>>(res);
+
+    VecDataArray<double, 3>& vertices = *verticesPtr;
+    VecDataArray<int, 2>&    indices  = *indicesPtr;
+    for (int i = 0; i <= res; i++)
+    {
+        const double angle = PI * i / 16.0;
+        vertices[i] = Vec3d((i - res * 0.5) * 0.01, 0.0, 0.05 * (cosine ? std::cos(angle) : std::sin(angle))) + shift;
+        if (i < res)
+        {
+            indices[i] = Vec2i(i, i + 1);
+        }
+    }
+
+    auto lineMesh = std::make_shared<LineMesh>();
+    lineMesh->initialize(verticesPtr, indicesPtr);
+    return lineMesh;
+}
+
+///
+/// \brief Creates the signed distance field of a sphere at the origin of radius 0.5
+/// \param res number of voxels along every axis
+///
+static std::shared_ptr<SignedDistanceField>
+makeSphereSdf(const int res)
+{
+    const double spacing = 1.2 / res;
+    auto         image   = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(res, res, res), Vec3d(spacing, spacing, spacing), Vec3d(-0.6, -0.6, -0.6));
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    for (int z = 0; z < res; z++)
+    {
+        for (int y = 0; y < res; y++)
+        {
+            for (int x = 0; x < res; x++)
+            {
+                const Vec3d pos = Vec3d(x + 0.5, y + 0.5, z + 0.5) * spacing - Vec3d(0.6, 0.6, 0.6);
+                scalars[image->getScalarIndex(x, y, z)] = pos.norm() - 0.5;
+            }
+        }
+    }
+    return std::make_shared<SignedDistanceField>(image);
+}
+
+///
+/// \brief Runs the collision detection of the factory type over the geometries, counting
+/// the contacts of each side found by the last run
+///
+static void
+runCollisionDetection(benchmark::State& state, const std::string& cdType,
+                      std::shared_ptr<Geometry> geomA, std::shared_ptr<Geometry> geomB)
+{
+    std::shared_ptr<CollisionDetectionAlgorithm> cd = CDObjectFactory::makeCollisionDetection(cdType);
+    cd->setInputGeometryA(geomA);
+    cd->setInputGeometryB(geomB);
+    for (auto _ : state)
+    {
+        cd->update();
+    }
+
+    std::shared_ptr<CollisionData> colData = cd->getCollisionData();
+    state.counters["ContactsA"] = colData->elementsA.size();
+    state.counters["ContactsB"] = colData->elementsB.size();
+}
+
+///
+/// \brief Offset along x of a unit sized geometry such that it overlaps the percentage
+/// of its width with a unit sized geometry at the origin
+///
+static Vec3d
+getOverlapShift(const benchmark::State& state)
+{
+    return Vec3d(1.0 - state.range(1) / 100.0, 0.0, 0.0);
+}
+
+///
+/// \brief Two spheres of resolution range(0), overlapping by range(1) percent of their diameter
+///
+static void
+BM_SurfaceMeshToSurfaceMesh(benchmark::State& state, const std::string& cdType)
+{
+    std::shared_ptr<SurfaceMesh> surfMeshA = makeSphereMesh(Vec3d::Zero(), 0.5, state.range(0));
+    std::shared_ptr<SurfaceMesh> surfMeshB = makeSphereMesh(getOverlapShift(state), 0.5, state.range(0));
+    runCollisionDetection(state, cdType, surfMeshA, surfMeshB);
+    state.counters["Tris"] = surfMeshA->getNumCells() + surfMeshB->getNumCells();
+}
+
+BENCHMARK_CAPTURE(BM_SurfaceMeshToSurfaceMesh, SurfaceMeshToSurfaceMeshCD, std::string("SurfaceMeshToSurfaceMeshCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 8, 16, 32 }, { 0, 25, 50 } });
+
+BENCHMARK_CAPTURE(BM_SurfaceMeshToSurfaceMesh, ClosedSurfaceMeshToMeshCD, std::string("ClosedSurfaceMeshToMeshCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 16, 32, 64 }, { 0, 25, 50 } });
+
+///
+/// \brief Tetrahedral grid and point grid of resolution range(0), overlapping by range(1)
+/// percent of their width
+///
+static void
+BM_TetraToPointSet(benchmark::State& state, const std::string& cdType)
+{
+    std::shared_ptr<TetrahedralMesh> tetMesh  = makeTetGrid(Vec3d::Zero(), state.range(0));
+    std::shared_ptr<PointSet>        pointSet = makePointGrid(getOverlapShift(state), state.range(0));
+    runCollisionDetection(state, cdType, tetMesh, pointSet);
+    state.counters["Tets"]   = tetMesh->getNumCells();
+    state.counters["Points"] = pointSet->getNumVertices();
+}
+
+BENCHMARK_CAPTURE(BM_TetraToPointSet, TetraToPointSetCD, std::string("TetraToPointSetCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 8, 16, 32 }, { 0, 25, 50 } });
+
+///
+/// \brief Signed distance field of a sphere and a sphere surface both of resolution
+/// range(0), overlapping by range(1) percent of their diameter
+///
+static void
+BM_ImplicitGeometryToPointSet(benchmark::State& state, const std::string& cdType)
+{
+    std::shared_ptr<SignedDistanceField> sdf      = makeSphereSdf(state.range(0));
+    std::shared_ptr<SurfaceMesh>         surfMesh = makeSphereMesh(getOverlapShift(state), 0.5, state.range(0));
+    runCollisionDetection(state, cdType, sdf, surfMesh);
+    state.counters["Points"] = surfMesh->getNumVertices();
+}
+
+BENCHMARK_CAPTURE(BM_ImplicitGeometryToPointSet, ImplicitGeometryToPointSetCD, std::string("ImplicitGeometryToPointSetCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 32, 64, 128 }, { 0, 25, 50 } });
+
+///
+/// \brief Two waves of range(0) segments, one moving through the other over a timestep,
+/// overlapping by range(1) percent of their length
+///
+static void
+BM_LineMeshToLineMesh(benchmark::State& state, const std::string& cdType)
+{
+    // Offset by half a segment so the waves never coincide
+    const Vec3d               shift         = getOverlapShift(state) * state.range(0) * 0.01 + Vec3d(0.005, 0.0, 0.0);
+    std::shared_ptr<LineMesh> lineMeshA     = makeWave(Vec3d::Zero(), state.range(0), false);
+    std::shared_ptr<LineMesh> lineMeshB     = makeWave(shift - Vec3d(0.0, 0.01, 0.0), state.range(0), true);
+    std::shared_ptr<LineMesh> prevLineMeshB = makeWave(shift + Vec3d(0.0, 0.01, 0.0), state.range(0), true);
+
+    std::shared_ptr<CollisionDetectionAlgorithm> cd  = CDObjectFactory::makeCollisionDetection(cdType);
+    std::shared_ptr<CCDAlgorithm>                ccd = std::dynamic_pointer_cast<CCDAlgorithm>(cd);
+    ccd->updatePreviousTimestepGeometry(lineMeshA, prevLineMeshB);
+    ccd->setInputGeometryA(lineMeshA);
+    ccd->setInputGeometryB(lineMeshB);
+    for (auto _ : state)
+    {
+        ccd->update();
+    }
+
+    std::shared_ptr<CollisionData> colData = ccd->getCollisionData();
+    state.counters["ContactsA"] = colData->elementsA.size();
+    state.counters["ContactsB"] = colData->elementsB.size();
+    state.counters["Segments"]  = lineMeshA->getNumCells() + lineMeshB->getNumCells();
+}
+
+BENCHMARK_CAPTURE(BM_LineMeshToLineMesh, LineMeshToLineMeshCCD, std::string("LineMeshToLineMeshCCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 1000, 10000, 100000 }, { 0, 25, 50 } });
+
+///
+/// \brief Analytic geometry of unit size at the origin and a point grid of resolution
+/// range(0), overlapping by range(1) percent of its width
+///
+static void
+BM_PointSetToAnalytic(benchmark::State& state, const std::string& cdType)
+{
+    std::shared_ptr<Geometry> analyticGeom;
+    if (cdType == "PointSetToSphereCD")
+    {
+        analyticGeom = std::make_shared<Sphere>(Vec3d::Zero(), 0.5);
+    }
+    else if (cdType == "PointSetToPlaneCD")
+    {
+        analyticGeom = std::make_shared<Plane>(Vec3d(0.5, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0));
+    }
+    else if (cdType == "PointSetToCapsuleCD")
+    {
+        analyticGeom = std::make_shared<Capsule>(Vec3d::Zero(), 0.5, 0.5);
+    }
+    else if (cdType == "PointSetToOrientedBoxCD")
+    {
+        analyticGeom = std::make_shared<OrientedBox>(Vec3d::Zero(), Vec3d(0.5, 0.5, 0.5));
+    }
+    else
+    {
+        analyticGeom = std::make_shared<Cylinder>(Vec3d::Zero(), 0.5, 1.0);
+    }
+    std::shared_ptr<PointSet> pointSet = makePointGrid(getOverlapShift(state), state.range(0));
+    runCollisionDetection(state, cdType, pointSet, analyticGeom);
+    state.counters["Points"] = pointSet->getNumVertices();
+}
+
+BENCHMARK_CAPTURE(BM_PointSetToAnalytic, PointSetToSphereCD, std::string("PointSetToSphereCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 16, 32, 64 }, { 0, 25, 50 } });
+
+BENCHMARK_CAPTURE(BM_PointSetToAnalytic, PointSetToPlaneCD, std::string("PointSetToPlaneCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 16, 32, 64 }, { 0, 25, 50 } });
+
+BENCHMARK_CAPTURE(BM_PointSetToAnalytic, PointSetToCapsuleCD, std::string("PointSetToCapsuleCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 16, 32, 64 }, { 0, 25, 50 } });
+
+BENCHMARK_CAPTURE(BM_PointSetToAnalytic, PointSetToOrientedBoxCD, std::string("PointSetToOrientedBoxCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 16, 32, 64 }, { 0, 25, 50 } });
+
+BENCHMARK_CAPTURE(BM_PointSetToAnalytic, PointSetToCylinderCD, std::string("PointSetToCylinderCD"))
+->Unit(benchmark::kMillisecond)
+->ArgsProduct({ { 16, 32, 64 }, { 0, 25, 50 } });
+
+BENCHMARK_MAIN();
@@ -7,6 +7,7 @@
 #include "imstkClosedSurfaceMeshToMeshCD.h"
 #include "imstkCollisionUtils.h"
 #include "imstkLineMesh.h"
+#include "imstkParallelUtils.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkVecDataArray.h"
 
@@ -97,7 +98,7 @@ struct PointSetData
 
 struct SurfMeshData
 {
-    SurfMeshData(std::shared_ptr<SurfaceMesh> surfMesh);
+    SurfMeshData(std::shared_ptr<SurfaceMesh> surfMesh, const BVH<3>& bvh);
 
     // Get geometry B data
     std::shared_ptr<SurfaceMesh> m_surfMesh;
@@ -105,6 +106,7 @@ struct SurfMeshData
     const VecDataArray<double, 3>& vertices;
     const std::vector<std::unordered_set<int>>& vertexFaces;
     const VecDataArray<double, 3>& faceNormals;
+    const BVH<3>& bvh;
 };
 
 PointSetData::PointSetData(std::shared_ptr<PointSet> pointSet) :
@@ -113,15 +115,45 @@ PointSetData::PointSetData(std::shared_ptr<PointSet> pointSet) :
 {
 }
 
-SurfMeshData::SurfMeshData(std::shared_ptr<SurfaceMesh> surfMesh) :
+SurfMeshData::SurfMeshData(std::shared_ptr<SurfaceMesh> surfMesh, const BVH<3>& bvh) :
     m_surfMesh(surfMesh),
     cells(*surfMesh->getCells()),
     vertices(*surfMesh->getVertexPositions()),
     vertexFaces(surfMesh->getVertexToCellMap()),
-    faceNormals(*surfMesh->getCellNormals())
+    faceNormals(*surfMesh->getCellNormals()),
+    bvh(bvh)
 {
 }
 
+///
+/// \brief Returns true if every edge of the triangles is shared by exactly two of them
+///
+static bool
+isClosedSurface(const VecDataArray<int, 3>& cells)
+{
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(cells.size() * 3);
+    for (const Vec3i& cell : cells)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            const int a = cell[i];
+            const int b = cell[(i + 1) % 3];
+            edges.push_back({ std::min(a, b), std::max(a, b) });
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (size_t i = 0; i < edges.size(); i += 2)
+    {
+        if (i + 1 >= edges.size() || edges[i] != edges[i + 1]
+            || (i + 2 < edges.size() && edges[i + 2] == edges[i]))
+        {
+            return false;
+        }
+    }
+    return !edges.empty();
+}
+
 ///
 /// \brief Compute the pseudonormal of the vertex given by vertexIndex
 ///
@@ -203,32 +235,31 @@ static double
 polySignedDist(const Vec3d& pos, const SurfMeshData& surfMeshData,
                int& caseType, Vec3i& vIds)
 {
-    int    closestCell     = -1;
-    Vec3d  closestPt       = Vec3d::Zero();
-    double minSqrDist      = IMSTK_DOUBLE_MAX;
-    int    closestCellCase = -1;
-
-    // Find the closest point out of all elements
-    // \todo: We could early reject backface cull all triangles (this is effectively case 6 done early)
-    for (int j = 0; j < surfMeshData.cells.size(); j++)
-    {
-        const Vec3i& cell = surfMeshData.cells[j];
-        const Vec3d& x1   = surfMeshData.vertices[cell[0]];
-        const Vec3d& x2   = surfMeshData.vertices[cell[1]];
-        const Vec3d& x3   = surfMeshData.vertices[cell[2]];
-
-        int          ptOnTriangleCaseType;
-        const Vec3d  closestPtOnTri = CollisionUtils::closestPointOnTriangle(pos, x1, x2, x3, ptOnTriangleCaseType);
-        const double sqrDist = (closestPtOnTri - pos).squaredNorm();
-        if (sqrDist < minSqrDist)
+    // Find the closest point out of the elements, the BVH culls the triangles further
+    // than the nearest found so far
+    const int closestCell = surfMeshData.bvh.queryClosest(pos, [&](const int cellId)
         {
-            minSqrDist      = sqrDist;
-            closestPt       = closestPtOnTri;
-            closestCell     = j;
-            closestCellCase = ptOnTriangleCaseType;
-        }
+            const Vec3i& cell = surfMeshData.cells[cellId];
+            int          ptOnTriangleCaseType;
+            const Vec3d  closestPtOnTri = CollisionUtils::closestPointOnTriangle(pos,
+                surfMeshData.vertices[cell[0]], surfMeshData.vertices[cell[1]], surfMeshData.vertices[cell[2]],
+                ptOnTriangleCaseType);
+            return (closestPtOnTri - pos).squaredNorm();
+        });
+
+    // Should only ever occur if there are no elements
+    if (closestCell == -1)
+    {
+        caseType = -1;
+        return IMSTK_DOUBLE_MAX;
     }
 
+    const Vec3i& cell = surfMeshData.cells[closestCell];
+    int          closestCellCase = -1;
+    const Vec3d  closestPt       = CollisionUtils::closestPointOnTriangle(pos,
+        surfMeshData.vertices[cell[0]], surfMeshData.vertices[cell[1]], surfMeshData.vertices[cell[2]],
+        closestCellCase);
+
     // We use the normal of the nearest element to determine sign, but we can't just use the
     // normal as there are discontinuities at the edges and vertices. We instead use the
     // "angle-weighted psuedonormal" given adjacent elements
@@ -281,7 +312,6 @@ polySignedDist(const Vec3d& pos, const SurfMeshData& surfMeshData,
         vIds[2]  = surfMeshData.cells[closestCell][2];
         return (pos - closestPt).dot(psuedoN);
     }
-    // Should only ever occur if there are no elements
     else
     {
         caseType = -1;
@@ -289,6 +319,65 @@ polySignedDist(const Vec3d& pos, const SurfMeshData& surfMeshData,
     }
 }
 
+///
+/// \brief Finds the nearest edge of the SurfaceMesh to the segment, such that the
+/// closest points lie within both edges and the one on the segment is inside the mesh
+/// \param first vertex of the segment
+/// \param second vertex of the segment
+/// \param SurfaceMesh to find the edge of
+/// \param only edges of triangles within this distance of the segment bounds are considered
+/// \param vertexIds of the nearest edge
+/// \return true if an edge was found
+///
+static bool
+closestInsideEdge(const Vec3d& a, const Vec3d& b, const SurfMeshData& surfMeshData,
+                  const double searchDist, Vec2i& edgeIds)
+{
+    const int triEdgePattern[3][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 } };
+    double    minSqrDist = IMSTK_DOUBLE_MAX;
+    bool      found      = false;
+
+    // For every triangle near the segment
+    surfMeshData.bvh.queryOverlap(
+        a.cwiseMin(b) - Vec3d::Constant(searchDist), a.cwiseMax(b) + Vec3d::Constant(searchDist),
+        [&](const int cellId)
+        {
+            const Vec3i& cellB = surfMeshData.cells[cellId];
+
+            // For every edge of that triangle
+            for (int k = 0; k < 3; k++)
+            {
+                const Vec2i edgeB(cellB[triEdgePattern[k][0]], cellB[triEdgePattern[k][1]]);
+
+                // Compute the closest point on the two edges
+                // Check the case, the edges must be within each others bounds/ranges
+                Vec3d ptA, ptB;
+                if (CollisionUtils::edgeToEdgeClosestPoints(a, b,
+                    surfMeshData.vertices[edgeB[0]], surfMeshData.vertices[edgeB[1]],
+                    ptA, ptB) == 0)
+                {
+                    // Find the closest element to this point on the edge
+                    const double sqrDist = (ptB - ptA).squaredNorm();
+                    // Use the closest one only
+                    if (sqrDist < minSqrDist)
+                    {
+                        // Check if the point on the oppositie edge nearest to edgeB is inside B
+                        int          caseType   = -1;
+                        Vec3i        vIds       = Vec3i::Zero();
+                        const double signedDist = polySignedDist(ptA, surfMeshData, caseType, vIds);
+                        if (signedDist <= 0.0)
+                        {
+                            minSqrDist = sqrDist;
+                            edgeIds    = edgeB;
+                            found      = true;
+                        }
+                    }
+                }
+            }
+        });
+    return found;
+}
+
 ClosedSurfaceMeshToMeshCD::ClosedSurfaceMeshToMeshCD()
 {
     setRequiredInputType<PointSet>(0);
@@ -309,13 +398,14 @@ ClosedSurfaceMeshToMeshCD::computeCollisionDataAB(
         auto surfMesh = std::dynamic_pointer_cast<SurfaceMesh>(geomB);
         surfMesh->computeTrianglesNormals();
         surfMesh->computeVertexToCellMap();
+        updateBVH(surfMesh);
 
         // Narrow phase
         if (m_generateVertexTriangleContacts)
         {
             if (m_vertexInside.size() < pointSet->getNumVertices())
             {
-                m_vertexInside = std::vector<bool>(pointSet->getNumVertices(), false);
+                m_vertexInside = std::vector<char>(pointSet->getNumVertices(), false);
             }
             if (m_signedDistances.size() < pointSet->getNumVertices())
             {
@@ -339,6 +429,51 @@ ClosedSurfaceMeshToMeshCD::computeCollisionDataAB(
     }
 }
 
+void
+ClosedSurfaceMeshToMeshCD::updateBVH(std::shared_ptr<SurfaceMesh> surfMesh)
+{
+    std::shared_ptr<VecDataArray<double, 3>> verticesPtr = surfMesh->getVertexPositions();
+    const VecDataArray<double, 3>&           vertices    = *verticesPtr;
+    std::shared_ptr<VecDataArray<int, 3>>    cellsPtr    = surfMesh->getCells();
+    const VecDataArray<int, 3>&              cells       = *cellsPtr;
+
+    // Rebuild on topology change and periodically as the refit tree degrades with deformation
+    m_bvh.setParallel(m_parallel);
+    m_bvh.setPadding(m_padding.maxCoeff());
+    const bool topologyChanged = (cellsPtr != m_prevCells || cells.size() != m_prevNumCells);
+    if (topologyChanged || verticesPtr != m_prevVertices || m_numUpdatesSinceRebuild >= m_rebuildInterval)
+    {
+        if (topologyChanged)
+        {
+            m_closed = isClosedSurface(cells);
+        }
+        m_bvh.build(verticesPtr, cellsPtr);
+        m_prevVertices = verticesPtr;
+        m_prevCells    = cellsPtr;
+        m_prevNumCells = cells.size();
+        m_numUpdatesSinceRebuild = 0;
+    }
+    else
+    {
+        m_bvh.refit();
+    }
+    m_numUpdatesSinceRebuild++;
+
+    // The longest edge bounds how far the nearest inside edge may be from an edge
+    if (m_generateEdgeEdgeContacts)
+    {
+        double maxEdgeLengthSqr = 0.0;
+        for (const Vec3i& cell : cells)
+        {
+            maxEdgeLengthSqr = std::max({ maxEdgeLengthSqr,
+                                          (vertices[cell[1]] - vertices[cell[0]]).squaredNorm(),
+                                          (vertices[cell[2]] - vertices[cell[1]]).squaredNorm(),
+                                          (vertices[cell[0]] - vertices[cell[2]]).squaredNorm() });
+        }
+        m_maxEdgeLength = std::sqrt(maxEdgeLengthSqr);
+    }
+}
+
 void
 ClosedSurfaceMeshToMeshCD::vertexToTriangleTest(
     std::shared_ptr<Geometry>      geomA,
@@ -347,75 +482,101 @@ ClosedSurfaceMeshToMeshCD::vertexToTriangleTest(
     std::vector<CollisionElement>& elementsB)
 {
     PointSetData pointSetData(std::dynamic_pointer_cast<PointSet>(geomA));
-    SurfMeshData surfMeshData(std::dynamic_pointer_cast<SurfaceMesh>(geomB));
+    SurfMeshData surfMeshData(std::dynamic_pointer_cast<SurfaceMesh>(geomB), m_bvh);
+
+    const int numVertices = pointSetData.vertices.size();
+    m_vertexCaseTypes.resize(numVertices);
+    m_vertexFeatureIds.resize(numVertices);
 
-    // For every vertex
-    for (int i = 0; i < pointSetData.vertices.size(); i++)
+    // Bounds of B including the padding, a closed surface always has triangles
+    Vec3d minB = Vec3d::Zero();
+    Vec3d maxB = Vec3d::Zero();
+    if (m_closed)
     {
-        const Vec3d& p = pointSetData.vertices[i];
+        minB = m_bvh.getNodes()[0].min;
+        maxB = m_bvh.getNodes()[0].max;
+    }
 
-        int          caseType   = -1;
-        Vec3i        vertexIds  = Vec3i::Zero();
-        const double signedDist = polySignedDist(p, surfMeshData, caseType, vertexIds);
-        m_signedDistances[i] = signedDist;
-        if (signedDist <= 0.0)
+    // For every vertex, each writes only its own entries
+    ParallelUtils::parallelFor(numVertices, [&](const int i)
         {
-            m_vertexInside[i] = true;
-            // The nearest feature to this vertex is another vertex
-            if (caseType == 0)
-            {
-                CellIndexElement elemA;
-                elemA.ids[0]   = i;
-                elemA.idCount  = 1;
-                elemA.cellType = IMSTK_VERTEX;
-
-                CellIndexElement elemB;
-                elemB.ids[0]   = vertexIds[0];
-                elemB.idCount  = 1;
-                elemB.cellType = IMSTK_VERTEX;
+            const Vec3d& p = pointSetData.vertices[i];
 
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
-            }
-            // The nearest feature to this vertex is an edge
-            else if (caseType == 1)
+            // A vertex outside the bounds of a closed surface can't be inside it, the distance
+            // to the bounds is a lower bound of its signed distance
+            if (m_closed && ((p.array() < minB.array()).any() || (p.array() > maxB.array()).any()))
             {
-                CellIndexElement elemA;
-                elemA.ids[0]   = i;
-                elemA.idCount  = 1;
-                elemA.cellType = IMSTK_VERTEX;
-
-                CellIndexElement elemB;
-                elemB.ids[0]   = vertexIds[0];
-                elemB.ids[1]   = vertexIds[1];
-                elemB.idCount  = 2;
-                elemB.cellType = IMSTK_EDGE;
-
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
+                m_signedDistances[i] = (p - p.cwiseMax(minB).cwiseMin(maxB)).norm();
+                m_vertexInside[i]    = false;
+                m_vertexCaseTypes[i] = -1;
+                return;
             }
-            // The nearest feature to this vertex is a triangle face
-            else if (caseType == 2)
-            {
-                CellIndexElement elemA;
-                elemA.ids[0]   = i;
-                elemA.idCount  = 1;
-                elemA.cellType = IMSTK_VERTEX;
 
-                CellIndexElement elemB;
-                elemB.ids[0]   = vertexIds[0];
-                elemB.ids[1]   = vertexIds[1];
-                elemB.ids[2]   = vertexIds[2];
-                elemB.idCount  = 3;
-                elemB.cellType = IMSTK_TRIANGLE;
+            int          caseType   = -1;
+            Vec3i        vertexIds  = Vec3i::Zero();
+            const double signedDist = polySignedDist(p, surfMeshData, caseType, vertexIds);
+            m_signedDistances[i]  = signedDist;
+            m_vertexInside[i]     = (signedDist <= 0.0);
+            m_vertexCaseTypes[i]  = m_vertexInside[i] ? caseType : -1;
+            m_vertexFeatureIds[i] = vertexIds;
+        }, m_parallel);
+
+    // Gather the contacts in vertex order
+    for (int i = 0; i < numVertices; i++)
+    {
+        const int    caseType  = m_vertexCaseTypes[i];
+        const Vec3i& vertexIds = m_vertexFeatureIds[i];
 
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
-            }
+        // The nearest feature to this vertex is another vertex
+        if (caseType == 0)
+        {
+            CellIndexElement elemA;
+            elemA.ids[0]   = i;
+            elemA.idCount  = 1;
+            elemA.cellType = IMSTK_VERTEX;
+
+            CellIndexElement elemB;
+            elemB.ids[0]   = vertexIds[0];
+            elemB.idCount  = 1;
+            elemB.cellType = IMSTK_VERTEX;
+
+            elementsA.push_back(elemA);
+            elementsB.push_back(elemB);
         }
-        else
+        // The nearest feature to this vertex is an edge
+        else if (caseType == 1)
         {
-            m_vertexInside[i] = false;
+            CellIndexElement elemA;
+            elemA.ids[0]   = i;
+            elemA.idCount  = 1;
+            elemA.cellType = IMSTK_VERTEX;
+
+            CellIndexElement elemB;
+            elemB.ids[0]   = vertexIds[0];
+            elemB.ids[1]   = vertexIds[1];
+            elemB.idCount  = 2;
+            elemB.cellType = IMSTK_EDGE;
+
+            elementsA.push_back(elemA);
+            elementsB.push_back(elemB);
+        }
+        // The nearest feature to this vertex is a triangle face
+        else if (caseType == 2)
+        {
+            CellIndexElement elemA;
+            elemA.ids[0]   = i;
+            elemA.idCount  = 1;
+            elemA.cellType = IMSTK_VERTEX;
+
+            CellIndexElement elemB;
+            elemB.ids[0]   = vertexIds[0];
+            elemB.ids[1]   = vertexIds[1];
+            elemB.ids[2]   = vertexIds[2];
+            elemB.idCount  = 3;
+            elemB.cellType = IMSTK_TRIANGLE;
+
+            elementsA.push_back(elemA);
+            elementsB.push_back(elemB);
         }
     }
 }
@@ -427,7 +588,7 @@ ClosedSurfaceMeshToMeshCD::lineMeshEdgeToTriangleTest(
     std::vector<CollisionElement>& elementsA,
     std::vector<CollisionElement>& elementsB)
 {
-    SurfMeshData surfMeshBData(std::dynamic_pointer_cast<SurfaceMesh>(geomB));
+    SurfMeshData surfMeshBData(std::dynamic_pointer_cast<SurfaceMesh>(geomB), m_bvh);
 
     // Get geometry A data
     std::shared_ptr<LineMesh>                lineMesh = std::dynamic_pointer_cast<LineMesh>(geomA);
@@ -436,75 +597,40 @@ ClosedSurfaceMeshToMeshCD::lineMeshEdgeToTriangleTest(
     std::shared_ptr<VecDataArray<int, 2>>    meshACellsPtr    = lineMesh->getCells();
     VecDataArray<int, 2>&                    meshACells       = *meshACellsPtr;
 
-    const int triEdgePattern[3][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 } };
-
-    // For every edge/line segment of the line mesh
-    for (int i = 0; i < meshACells.size(); i++)
-    {
-        const Vec2i& edgeA = meshACells[i];
-
-        // Only check edges that don't exist totally inside
-        if (!m_vertexInside[edgeA[0]] && !m_vertexInside[edgeA[1]])
+    // For every edge/line segment of the line mesh, each writes only its own entry
+    m_edgeContacts.resize(meshACells.size());
+    ParallelUtils::parallelFor(meshACells.size(), [&](const int i)
         {
-            double minSqrDist    = IMSTK_DOUBLE_MAX;
-            int    closestTriId  = -1;
-            int    closestEdgeId = -1;
+            const Vec2i& edgeA = meshACells[i];
+            m_edgeContacts[i]  = Vec2i(-1, -1);
 
-            // For every triangle/cell of meshB
-            for (int j = 0; j < surfMeshBData.cells.size(); j++)
+            // Only check edges that don't exist totally inside
+            if (!m_vertexInside[edgeA[0]] && !m_vertexInside[edgeA[1]])
             {
-                const Vec3i& cellB = surfMeshBData.cells[j];
-
-                // For every edge of that triangle
-                for (int k = 0; k < 3; k++)
-                {
-                    const Vec2i edgeB(cellB[triEdgePattern[k][0]], cellB[triEdgePattern[k][1]]);
-
-                    // Compute the closest point on the two edges
-                    // Check the case, the edges must be within each others bounds/ranges
-                    Vec3d ptA, ptB;
-                    if (CollisionUtils::edgeToEdgeClosestPoints(
-                        meshAVertices[edgeA[0]], meshAVertices[edgeA[1]],
-                        surfMeshBData.vertices[edgeB[0]], surfMeshBData.vertices[edgeB[1]],
-                        ptA, ptB) == 0)
-                    {
-                        // Find the closest element to this point on the edge
-                        const double sqrDist = (ptB - ptA).squaredNorm();
-                        // Use the closest one only
-                        if (sqrDist < minSqrDist)
-                        {
-                            // Check if the point on the oppositie edge nearest to edgeB is inside B
-                            int          caseType   = -1;
-                            Vec3i        vIds       = Vec3i::Zero();
-                            const double signedDist = polySignedDist(ptA, surfMeshBData, caseType, vIds);
-                            if (signedDist <= 0.0)
-                            {
-                                minSqrDist    = sqrDist;
-                                closestTriId  = j;
-                                closestEdgeId = k;
-                            }
-                        }
-                    }
-                }
+                closestInsideEdge(meshAVertices[edgeA[0]], meshAVertices[edgeA[1]], surfMeshBData,
+                    m_maxEdgeLength, m_edgeContacts[i]);
             }
+        }, m_parallel);
 
-            if (closestTriId != -1)
-            {
-                CellIndexElement elemA;
-                elemA.ids[0]   = edgeA[0];
-                elemA.ids[1]   = edgeA[1];
-                elemA.idCount  = 2;
-                elemA.cellType = IMSTK_EDGE;
-
-                CellIndexElement elemB;
-                elemB.ids[0]   = surfMeshBData.cells[closestTriId][triEdgePattern[closestEdgeId][0]];
-                elemB.ids[1]   = surfMeshBData.cells[closestTriId][triEdgePattern[closestEdgeId][1]];
-                elemB.idCount  = 2;
-                elemB.cellType = IMSTK_EDGE;
-
-                elementsA.push_back(elemA);
-                elementsB.push_back(elemB);
-            }
+    // Gather the contacts in edge order
+    for (int i = 0; i < meshACells.size(); i++)
+    {
+        if (m_edgeContacts[i][0] != -1)
+        {
+            CellIndexElement elemA;
+            elemA.ids[0]   = meshACells[i][0];
+            elemA.ids[1]   = meshACells[i][1];
+            elemA.idCount  = 2;
+            elemA.cellType = IMSTK_EDGE;
+
+            CellIndexElement elemB;
+            elemB.ids[0]   = m_edgeContacts[i][0];
+            elemB.ids[1]   = m_edgeContacts[i][1];
+            elemB.idCount  = 2;
+            elemB.cellType = IMSTK_EDGE;
+
+            elementsA.push_back(elemA);
+            elementsB.push_back(elemB);
         }
     }
 }
@@ -516,7 +642,7 @@ ClosedSurfaceMeshToMeshCD::surfMeshEdgeToTriangleTest(
     std::vector<CollisionElement>& elementsA,
     std::vector<CollisionElement>& elementsB)
 {
-    SurfMeshData surfMeshBData(std::dynamic_pointer_cast<SurfaceMesh>(geomB));
+    SurfMeshData surfMeshBData(std::dynamic_pointer_cast<SurfaceMesh>(geomB), m_bvh);
 
     // Get geometry A data
     std::shared_ptr<SurfaceMesh>             surfMeshA = std::dynamic_pointer_cast<SurfaceMesh>(geomA);
@@ -525,8 +651,6 @@ ClosedSurfaceMeshToMeshCD::surfMeshEdgeToTriangleTest(
     std::shared_ptr<VecDataArray<int, 3>>    meshACellsPtr    = surfMeshA->getCells();
     VecDataArray<int, 3>&                    meshACells       = *meshACellsPtr;
 
-    std::unordered_set<EdgePair> hashedEdges;
-
     // We find the nearest points on every edge with every other edge. Sampling this point we
     // can determine the signed distance and whether that edge is "inside" another.
     //
@@ -539,97 +663,58 @@ ClosedSurfaceMeshToMeshCD::surfMeshEdgeToTriangleTest(
     // Additionally we don't check edges whose vertices are already inside the closed surface (determined
     // in the vertex-triangle pass)
     const int triEdgePattern[3][2] = { { 0, 1 }, { 1, 2 }, { 2, 0 } };
-    int       edgeCheckCount       = 0;
     if (m_generateEdgeEdgeContacts)
     {
-        // For every edge/line segment of the line mesh
-        for (int i = 0; i < meshACells.size(); i++)
-        {
-            const Vec3i& cellA = meshACells[i];
-
-            // For every edge of triangle A
-            for (int j = 0; j < 3; j++)
+        // For every edge of every triangle of A, each writes only its own entry
+        m_edgeContacts.resize(meshACells.size() * 3);
+        ParallelUtils::parallelFor(meshACells.size() * 3, [&](const int i)
             {
-                const Vec2i edgeA = Vec2i(cellA[triEdgePattern[j][0]], cellA[triEdgePattern[j][1]]);
+                const Vec3i& cellA = meshACells[i / 3];
+                const Vec2i  edgeA = Vec2i(cellA[triEdgePattern[i % 3][0]], cellA[triEdgePattern[i % 3][1]]);
+                m_edgeContacts[i]  = Vec2i(-1, -1);
 
                 // Only check edges that don't exist totally inside
-                if (!m_vertexInside[edgeA[0]] && !m_vertexInside[edgeA[1]])
+                // If proximity is used, only check edges with vertices within proximity of the closed surface
+                if (!m_vertexInside[edgeA[0]] && !m_vertexInside[edgeA[1]]
+                    && (m_proximity <= 0.0 || (m_signedDistances[edgeA[0]] < m_proximity && m_signedDistances[edgeA[1]] < m_proximity)))
                 {
-                    double minSqrDist    = IMSTK_DOUBLE_MAX;
-                    int    closestTriId  = -1;
-                    int    closestEdgeId = -1;
+                    closestInsideEdge(meshAVertices[edgeA[0]], meshAVertices[edgeA[1]], surfMeshBData,
+                        m_maxEdgeLength, m_edgeContacts[i]);
+                }
+            }, m_parallel);
 
-                    // If proximity is used, only check edges with vertices within proximity of the closed surface
-                    if (m_proximity <= 0.0 || (m_signedDistances[edgeA[0]] < m_proximity && m_signedDistances[edgeA[1]] < m_proximity))
-                    {
-                        edgeCheckCount++;
-                        // For every triangle/cell of meshB
-                        for (int k = 0; k < surfMeshBData.cells.size(); k++)
-                        {
-                            const Vec3i& cellB = surfMeshBData.cells[k];
-
-                            // For every edge of that triangle
-                            for (int edgeId = 0; edgeId < 3; edgeId++)
-                            {
-                                const Vec2i edgeB(cellB[triEdgePattern[edgeId][0]], cellB[triEdgePattern[edgeId][1]]);
-
-                                // Compute the closest point on the two edges
-                                // Check the case, the edges must be within each others bounds/ranges
-                                Vec3d ptA, ptB;
-                                if (CollisionUtils::edgeToEdgeClosestPoints(
-                                    meshAVertices[edgeA[0]], meshAVertices[edgeA[1]],
-                                    surfMeshBData.vertices[edgeB[0]], surfMeshBData.vertices[edgeB[1]],
-                                    ptA, ptB) == 0)
-                                {
-                                    // Find the closest element to this point on the edge
-                                    const double sqrDist = (ptB - ptA).squaredNorm();
-                                    // Use the closest one only
-                                    if (sqrDist < minSqrDist)
-                                    {
-                                        // Check if the point on the oppositie edge nearest to edgeB is inside B
-                                        int          caseType   = -1;
-                                        Vec3i        vIds       = Vec3i::Zero();
-                                        const double signedDist = polySignedDist(ptA, surfMeshBData, caseType, vIds);
-                                        if (signedDist <= 0.0)
-                                        {
-                                            minSqrDist    = sqrDist;
-                                            closestTriId  = k;
-                                            closestEdgeId = edgeId;
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
+        // Gather the contacts in edge order, edges shared by triangles of A are found twice
+        std::unordered_set<EdgePair> hashedEdges;
+        for (int i = 0; i < meshACells.size() * 3; i++)
+        {
+            if (m_edgeContacts[i][0] == -1)
+            {
+                continue;
+            }
 
-                    if (closestTriId != -1)
-                    {
-                        // Before inserting check if it already exists
-                        EdgePair edgePair(
-                            edgeA[0], edgeA[1],
-                            surfMeshBData.cells[closestTriId][triEdgePattern[closestEdgeId][0]],
-                            surfMeshBData.cells[closestTriId][triEdgePattern[closestEdgeId][1]]);
-                        if (hashedEdges.count(edgePair) == 0)
-                        {
-                            CellIndexElement elemA;
-                            elemA.ids[0]   = edgeA[0];
-                            elemA.ids[1]   = edgeA[1];
-                            elemA.idCount  = 2;
-                            elemA.cellType = IMSTK_EDGE;
-
-                            CellIndexElement elemB;
-                            elemB.ids[0]   = surfMeshBData.cells[closestTriId][triEdgePattern[closestEdgeId][0]];
-                            elemB.ids[1]   = surfMeshBData.cells[closestTriId][triEdgePattern[closestEdgeId][1]];
-                            elemB.idCount  = 2;
-                            elemB.cellType = IMSTK_EDGE;
-
-                            elementsA.push_back(elemA);
-                            elementsB.push_back(elemB);
-
-                            hashedEdges.insert(edgePair);
-                        }
-                    }
-                }
+            const Vec3i& cellA = meshACells[i / 3];
+            const Vec2i  edgeA = Vec2i(cellA[triEdgePattern[i % 3][0]], cellA[triEdgePattern[i % 3][1]]);
+
+            // Before inserting check if it already exists
+            EdgePair edgePair(edgeA[0], edgeA[1], m_edgeContacts[i][0], m_edgeContacts[i][1]);
+            if (hashedEdges.count(edgePair) == 0)
+            {
+                CellIndexElement elemA;
+                elemA.ids[0]   = edgeA[0];
+                elemA.ids[1]   = edgeA[1];
+                elemA.idCount  = 2;
+                elemA.cellType = IMSTK_EDGE;
+
+                CellIndexElement elemB;
+                elemB.ids[0]   = m_edgeContacts[i][0];
+                elemB.ids[1]   = m_edgeContacts[i][1];
+                elemB.idCount  = 2;
+                elemB.cellType = IMSTK_EDGE;
+
+                elementsA.push_back(elemA);
+                elementsB.push_back(elemB);
+
+                hashedEdges.insert(edgePair);
             }
         }
     }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "imstkBVH.h"
 #include "imstkCollisionDetectionAlgorithm.h"
 #include "imstkDataArray.h"
 #include "imstkMacros.h"
@@ -19,7 +20,7 @@ class SurfaceMesh;
 ///
 /// \class ClosedSurfaceMeshToMeshCD
 ///
-/// \brief Closed mesh to mesh collision with brute force strategy.
+/// \brief Closed mesh to mesh collision.
 /// It can handle closed SurfaceMesh vs PointSet, LineMesh, & SurfaceMesh.
 /// Note: This CD method cannot yet automatically determine the closed
 /// SurfaceMesh given two unordered inputs. Ensure the second input/B is
@@ -35,9 +36,15 @@ class SurfaceMesh;
 /// It resolves vertices by computing signed distances using the psuedonormal
 /// method. This allows it to resolve very deep penetrations.
 ///
-/// If enabled, it may resolve edge-edge contact by brute force as well. This
-/// is an extremely costly operation in brute force and is off by default.
-/// Additionally it cannot find the globally best edge to resolve too.
+/// The nearest triangle and edge queries go through a BVH over the triangles of
+/// B, refit every update and rebuilt every few updates or when the topology
+/// changes. When B is closed, vertices outside its bounds are rejected without
+/// a query. Vertices and edges are tested in parallel.
+///
+/// If enabled, it may resolve edge-edge contact as well. This is a costly
+/// operation and is off by default. Only edges of B within the longest edge
+/// of B from an edge are considered, it cannot find the globally best edge
+/// to resolve too.
 ///
 /// Extrapolation is used past an opening based on the nearest elements normal.
 /// So some openings are ok depending on the intention. For instance, a
@@ -78,7 +85,27 @@ public:
     ///@{
     void setProximity(const double proximity) { m_proximity = proximity; }
     double getProximity() const { return m_proximity; }
-///@}
+    ///@}
+
+    ///
+    /// \brief Get/Set the number of updates between full rebuilds of the BVH,
+    /// the BVH is only refit in between. Default 20
+    ///@{
+    void setRebuildInterval(const int rebuildInterval) { m_rebuildInterval = std::max(rebuildInterval, 1); }
+    int getRebuildInterval() const { return m_rebuildInterval; }
+    ///@}
+
+    ///
+    /// \brief Get/Set whether the vertices and edges are tested in parallel, default true
+    ///@{
+    void setParallel(const bool parallel) { m_parallel = parallel; }
+    bool getParallel() const { return m_parallel; }
+    ///@}
+
+    ///
+    /// \brief Get the BVH over the triangles of B
+    ///
+    const BVH<3>& getBVH() const { return m_bvh; }
 
 protected:
     ///
@@ -109,6 +136,11 @@ protected:
         std::vector<CollisionElement>& elementsB);
 
 private:
+    ///
+    /// \brief Build or refit the BVH over the triangles of B
+    ///
+    void updateBVH(std::shared_ptr<SurfaceMesh> surfMesh);
+
     ///
     /// \brief Do a broad phase collision check using AABB
     /// \todo: Abstract and make changeable
@@ -120,9 +152,22 @@ private:
     bool m_generateEdgeEdgeContacts       = false;
     bool m_generateVertexTriangleContacts = true;
 
-    std::vector<bool> m_vertexInside;
-    DataArray<double> m_signedDistances;
+    std::vector<char>  m_vertexInside;     ///< Not vector<bool>, written from multiple threads
+    DataArray<double>  m_signedDistances;
+    std::vector<int>   m_vertexCaseTypes;  ///< Nearest feature type of each inside vertex, -1 if outside
+    std::vector<Vec3i> m_vertexFeatureIds; ///< Nearest feature vertex ids of each inside vertex
+    std::vector<Vec2i> m_edgeContacts;     ///< Nearest edge of B of each edge of A, -1 if none
     Vec3d  m_padding   = Vec3d(0.001, 0.001, 0.001);
     double m_proximity = -1.0; // Default off -1
+
+    BVH<3> m_bvh;
+    std::shared_ptr<VecDataArray<double, 3>> m_prevVertices = nullptr; ///< Vertices the BVH was built on
+    std::shared_ptr<VecDataArray<int, 3>>    m_prevCells    = nullptr; ///< Cells the BVH was built on
+    int    m_prevNumCells    = 0;
+    int    m_rebuildInterval = 20;
+    int    m_numUpdatesSinceRebuild = 0;
+    bool   m_parallel      = true;
+    bool   m_closed        = false; ///< Whether every edge of B is shared by two triangles
+    double m_maxEdgeLength = 0.0;   ///< Longest edge of B, bounds the edge-edge search
 };
 } // namespace imstk
\ No newline at end of file
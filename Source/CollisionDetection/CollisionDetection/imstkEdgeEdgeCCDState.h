@@ -67,6 +67,12 @@ public:
         return xj + ej * sj();
     }
 
+    /// Thickness of the colliding LineMeshes when none is set
+    static double defaultThickness()
+    {
+        return 0.0016;
+    }
+
     void setThickness(double thickness)
     {
         m_thickness = thickness;
@@ -98,7 +104,7 @@ private:
     double m_epsilon = 1e-10;
 
     // Thickness of colliding LineMeshes.
-    double m_thickness = 0.0016; // 0.0016
+    double m_thickness = defaultThickness();
 
     double a() const
     {
@@ -8,6 +8,7 @@
 #include "imstkEdgeEdgeCCDState.h"
 #include "imstkLineMesh.h"
 #include "imstkLineMeshToLineMeshCCD.h"
+#include "imstkParallelUtils.h"
 
 namespace imstk
 {
@@ -124,50 +125,127 @@ LineMeshToLineMeshCCD::internalComputeCollision(
     const VecDataArray<int, 2>&           linesA    = *linesAPtr;
     std::shared_ptr<VecDataArray<int, 2>> linesBPtr = meshB->getCells();
     const VecDataArray<int, 2>&           linesB    = *linesBPtr;
-    for (size_t i = 0; i < static_cast<size_t>(meshA->getNumCells()); ++i)
+
+    // Broad phase, BVHs over the segments swept from the previous to the current timestep.
+    // Refit while the topology is unchanged, rebuild every few updates as the refit trees degrade
+    const bool rebuild = (m_numUpdatesSinceRebuild >= m_rebuildInterval)
+                         || linesAPtr != m_prevCellsA || linesA.size() != m_prevNumCellsA
+                         || meshA->getVertexPositions() != m_prevVerticesA
+                         || linesBPtr != m_prevCellsB || linesB.size() != m_prevNumCellsB
+                         || meshB->getVertexPositions() != m_prevVerticesB;
+    m_bvhA.setPadding(m_thickness);
+    m_bvhA.setParallel(m_parallel);
+    if (rebuild)
+    {
+        m_bvhA.buildSwept(m_prevA->getVertexPositions(), meshA->getVertexPositions(), linesAPtr);
+        m_prevCellsA    = linesAPtr;
+        m_prevNumCellsA = linesA.size();
+        m_prevVerticesA = meshA->getVertexPositions();
+        m_prevCellsB    = linesBPtr;
+        m_prevNumCellsB = linesB.size();
+        m_prevVerticesB = meshB->getVertexPositions();
+        m_numUpdatesSinceRebuild = 0;
+    }
+    else
+    {
+        m_bvhA.refitSwept(m_prevA->getVertexPositions());
+    }
+    if (!selfCollision)
+    {
+        m_bvhB.setPadding(m_thickness);
+        m_bvhB.setParallel(m_parallel);
+        if (rebuild)
+        {
+            m_bvhB.buildSwept(m_prevB->getVertexPositions(), meshB->getVertexPositions(), linesBPtr);
+        }
+        else
+        {
+            m_bvhB.refitSwept(m_prevB->getVertexPositions());
+        }
+    }
+    m_numUpdatesSinceRebuild++;
+
+    // Narrow phase on the pairs whose swept boxes overlap
+    m_collidingPairs.resize(0);
+    std::atomic<int>        numCandidatePairs = { 0 };
+    ParallelUtils::SpinLock lock;
+
+    auto testPair = [&](int i, int j)
+                    {
+                        if (selfCollision)
+                        {
+                            // Do not process self or immediate neighboring cells (lines)
+                            if (i > j)
+                            {
+                                std::swap(i, j);
+                            }
+                            const Vec2i& cellI = linesA[i];
+                            const Vec2i& cellJ = linesA[j];
+                            if (j - i <= 1
+                                || cellI[0] == cellJ[0] || cellI[0] == cellJ[1]
+                                || cellI[1] == cellJ[0] || cellI[1] == cellJ[1])
+                            {
+                                return;
+                            }
+                        }
+                        numCandidatePairs++;
+
+                        const Vec2i& cellA = linesA[i];
+                        const Vec2i& cellB = linesB[j];
+
+                        EdgeEdgeCCDState currState(verticesA[cellA(0)], verticesA[cellA(1)], verticesB[cellB(0)], verticesB[cellB(1)]);
+                        EdgeEdgeCCDState prevState(prevA[cellA(0)], prevA[cellA(1)], prevB[cellB(0)], prevB[cellB(1)]);
+                        currState.setThickness(m_thickness);
+                        prevState.setThickness(m_thickness);
+
+                        // Test for collision between current and previous timestep
+                        double relativeTimeOfImpact = 0.0;
+                        if (EdgeEdgeCCDState::testCollision(prevState, currState, relativeTimeOfImpact) != 0)
+                        {
+                            lock.lock();
+                            m_collidingPairs.push_back({ i, j });
+                            lock.unlock();
+                        }
+                    };
+    if (selfCollision)
+    {
+        m_bvhA.querySelfOverlap(testPair, m_parallel);
+    }
+    else
     {
-        const imstk::Vec2i& cellA = linesA[i];
-        size_t              j     = selfCollision ? i + 2 : 0;
-        for (; j < static_cast<size_t>(meshB->getNumCells()); ++j)
+        m_bvhA.queryOverlap(m_bvhB, testPair, m_parallel);
+    }
+    m_numCandidatePairs = numCandidatePairs;
+
+    // Report in cell order regardless of the traversal order
+    std::sort(m_collidingPairs.begin(), m_collidingPairs.end());
+
+    // Create collision info
+    for (const std::pair<int, int>& pair : m_collidingPairs)
+    {
+        const Vec2i& cellA = linesA[pair.first];
+        const Vec2i& cellB = linesB[pair.second];
+        if (elementsA)
+        {
+            CellIndexElement elemA;
+            elemA.cellType = IMSTK_EDGE;
+            elemA.idCount  = 2;
+            elemA.ids[0]   = cellA(0);
+            elemA.ids[1]   = cellA(1);
+            CollisionElement e(elemA);
+            e.m_ccdData = true;
+            elementsA->push_back(e);
+        }
+        if (elementsB)
         {
-            // If performing self-collision, do not process self or immediate neighboring cells (lines).
-            if (selfCollision && (std::max(i, j) - std::min(i, j) <= 1))
-            {
-                continue;
-            }
-            const imstk::Vec2i& cellB = linesB[j];
-
-            EdgeEdgeCCDState currState(verticesA[cellA(0)], verticesA[cellA(1)], verticesB[cellB(0)], verticesB[cellB(1)]);
-            EdgeEdgeCCDState prevState(prevA[cellA(0)], prevA[cellA(1)], prevB[cellB(0)], prevB[cellB(1)]);
-
-            // Test for collision between current and previous timestep, and create collision info.
-            double relativeTimeOfImpact = 0.0;
-            int    collisionCase = EdgeEdgeCCDState::testCollision(prevState, currState, relativeTimeOfImpact);
-            if (collisionCase != 0)
-            {
-                if (elementsA)
-                {
-                    CellIndexElement elemA;
-                    elemA.cellType = IMSTK_EDGE;
-                    elemA.idCount  = 2;
-                    elemA.ids[0]   = cellA(0);
-                    elemA.ids[1]   = cellA(1);
-                    CollisionElement e(elemA);
-                    e.m_ccdData = true;
-                    elementsA->push_back(e);
-                }
-                if (elementsB)
-                {
-                    CellIndexElement elemB;
-                    elemB.cellType = IMSTK_EDGE;
-                    elemB.idCount  = 2;
-                    elemB.ids[0]   = cellB(0);
-                    elemB.ids[1]   = cellB(1);
-                    CollisionElement e(elemB);
-                    e.m_ccdData = true;
-                    elementsB->push_back(e);
-                }
-            }
+            CellIndexElement elemB;
+            elemB.cellType = IMSTK_EDGE;
+            elemB.idCount  = 2;
+            elemB.ids[0]   = cellB(0);
+            elemB.ids[1]   = cellB(1);
+            CollisionElement e(elemB);
+            e.m_ccdData = true;
+            elementsB->push_back(e);
         }
     }
 }
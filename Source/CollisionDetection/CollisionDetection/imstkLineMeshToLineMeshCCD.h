@@ -7,7 +7,9 @@
 #pragma once
 
 #include <array>
+#include "imstkBVH.h"
 #include "imstkCCDAlgorithm.h"
+#include "imstkEdgeEdgeCCDState.h"
 #include "imstkVecDataArray.h"
 #include "imstkMacros.h"
 
@@ -25,6 +27,10 @@ class LineMesh;
 /// Self collision mode is indicated to the algorithm by providing
 /// geometryA (input 0) == geometryB (input 1).
 ///
+/// Segments are kept in BVHs over their sweep from the previous to the current
+/// timestep, refit every update and rebuilt every few updates or on topology change.
+/// Only segment pairs whose swept boxes overlap are tested, in parallel.
+///
 class LineMeshToLineMeshCCD : public CCDAlgorithm
 {
 public:
@@ -43,6 +49,34 @@ public:
         std::shared_ptr<const Geometry> geomA,
         std::shared_ptr<const Geometry> geomB) override;
 
+    ///
+    /// \brief Get/Set the thickness of the lines, used by the segment tests and to pad
+    /// the swept boxes. Default EdgeEdgeCCDState::defaultThickness()
+    ///@{
+    void setThickness(const double thickness) { m_thickness = thickness; }
+    double getThickness() const { return m_thickness; }
+    ///@}
+
+    ///
+    /// \brief Get/Set the number of updates between full rebuilds of the BVHs,
+    /// the BVHs are only refit in between. Default 20
+    ///@{
+    void setRebuildInterval(const int rebuildInterval) { m_rebuildInterval = std::max(rebuildInterval, 1); }
+    int getRebuildInterval() const { return m_rebuildInterval; }
+    ///@}
+
+    ///
+    /// \brief Get/Set whether the narrow phase runs in parallel, default true
+    ///@{
+    void setParallel(const bool parallel) { m_parallel = parallel; }
+    bool getParallel() const { return m_parallel; }
+    ///@}
+
+    ///
+    /// \brief Number of segment pairs that passed the broad phase in the last update
+    ///
+    int getNumCandidatePairs() const { return m_numCandidatePairs; }
+
 protected:
     ///
     /// \brief Compute collision data for AB simultaneously
@@ -78,5 +112,21 @@ private:
 
     std::shared_ptr<imstk::LineMesh> m_prevA;
     std::shared_ptr<imstk::LineMesh> m_prevB;
+
+    BVH<2> m_bvhA;
+    BVH<2> m_bvhB;
+    std::shared_ptr<VecDataArray<int, 2>>    m_prevCellsA    = nullptr; ///< Cells BVH A was built on
+    std::shared_ptr<VecDataArray<int, 2>>    m_prevCellsB    = nullptr; ///< Cells BVH B was built on
+    std::shared_ptr<VecDataArray<double, 3>> m_prevVerticesA = nullptr; ///< Vertices BVH A was built on
+    std::shared_ptr<VecDataArray<double, 3>> m_prevVerticesB = nullptr; ///< Vertices BVH B was built on
+    int    m_prevNumCellsA   = 0;
+    int    m_prevNumCellsB   = 0;
+    int    m_rebuildInterval = 20;
+    int    m_numUpdatesSinceRebuild = 0;
+    double m_thickness = EdgeEdgeCCDState::defaultThickness();
+    bool   m_parallel  = true;
+
+    int m_numCandidatePairs = 0;
+    std::vector<std::pair<int, int>> m_collidingPairs; ///< Cell ids of the colliding pairs of the last update
 };
 } // namespace imstk
\ No newline at end of file
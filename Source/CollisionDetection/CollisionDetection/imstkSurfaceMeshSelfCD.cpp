@@ -0,0 +1,181 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkSurfaceMeshSelfCD.h"
+#include "imstkCollisionUtils.h"
+#include "imstkParallelUtils.h"
+#include "imstkSurfaceMesh.h"
+
+namespace imstk
+{
+///
+/// \brief Returns true if the triangles share a vertex
+///
+static bool
+isAdjacent(const Vec3i& cellA, const Vec3i& cellB)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        if (cellA[i] == cellB[0] || cellA[i] == cellB[1] || cellA[i] == cellB[2])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+SurfaceMeshSelfCD::SurfaceMeshSelfCD()
+{
+    setRequiredInputType<SurfaceMesh>(0);
+    setRequiredInputType<SurfaceMesh>(1);
+
+    // By default generate contact data for both sides
+    setGenerateCD(true, true);
+}
+
+void
+SurfaceMeshSelfCD::computeCollisionDataAB(
+    std::shared_ptr<Geometry>      geomA,
+    std::shared_ptr<Geometry>      geomB,
+    std::vector<CollisionElement>& elementsA,
+    std::vector<CollisionElement>& elementsB)
+{
+    CHECK(geomA == geomB) << "SurfaceMeshSelfCD expects the same mesh as input A and B";
+
+    std::shared_ptr<SurfaceMesh>             surfMesh    = std::dynamic_pointer_cast<SurfaceMesh>(geomA);
+    std::shared_ptr<VecDataArray<double, 3>> verticesPtr = surfMesh->getVertexPositions();
+    const VecDataArray<double, 3>&           vertices    = *verticesPtr;
+    std::shared_ptr<VecDataArray<int, 3>>    indicesPtr  = surfMesh->getCells();
+    const VecDataArray<int, 3>&              indices     = *indicesPtr;
+
+    // Rebuild on topology change and periodically as the refit tree degrades with deformation
+    m_bvh.setParallel(m_parallel);
+    if (verticesPtr != m_prevVertices || indicesPtr != m_prevCells || indices.size() != m_prevNumCells
+        || m_numUpdatesSinceRebuild >= m_rebuildInterval)
+    {
+        m_bvh.build(verticesPtr, indicesPtr);
+        m_prevVertices = verticesPtr;
+        m_prevCells    = indicesPtr;
+        m_prevNumCells = indices.size();
+        m_numUpdatesSinceRebuild = 0;
+    }
+    else
+    {
+        m_bvh.refit();
+    }
+    m_numUpdatesSinceRebuild++;
+
+    m_contacts.resize(0);
+    std::atomic<int>        numCandidatePairs = { 0 };
+    ParallelUtils::SpinLock lock;
+    m_bvh.querySelfOverlap([&](const int triIdA, const int triIdB)
+        {
+            const Vec3i& cellA = indices[triIdA];
+            const Vec3i& cellB = indices[triIdB];
+
+            // Neighboring triangles always touch, they are kept apart by the internal constraints
+            if (isAdjacent(cellA, cellB))
+            {
+                return;
+            }
+            numCandidatePairs++;
+
+            std::pair<Vec2i, Vec2i> eeContact;
+            std::pair<int, Vec3i>   vtContact;
+            std::pair<Vec3i, int>   tvContact;
+            const int               contactType = CollisionUtils::triangleToTriangle(cellA, cellB,
+                vertices[cellA[0]], vertices[cellA[1]], vertices[cellA[2]],
+                vertices[cellB[0]], vertices[cellB[1]], vertices[cellB[2]],
+                eeContact, vtContact, tvContact);
+
+            Contact contact;
+            // Type 0, edge-edge contact
+            if (contactType == 0)
+            {
+                Vec2i edgeA = eeContact.first;
+                Vec2i edgeB = eeContact.second;
+                if (edgeA[0] > edgeA[1])
+                {
+                    std::swap(edgeA[0], edgeA[1]);
+                }
+                if (edgeB[0] > edgeB[1])
+                {
+                    std::swap(edgeB[0], edgeB[1]);
+                }
+                if (edgeB[0] < edgeA[0] || (edgeB[0] == edgeA[0] && edgeB[1] < edgeA[1]))
+                {
+                    std::swap(edgeA, edgeB);
+                }
+                contact.isEdgeEdge = true;
+                contact.ids = { edgeA[0], edgeA[1], edgeB[0], edgeB[1] };
+            }
+            // Type 1, vertex-triangle contact
+            else if (contactType == 1)
+            {
+                Vec3i tri = vtContact.second;
+                std::sort(tri.data(), tri.data() + 3);
+                contact.isEdgeEdge = false;
+                contact.ids = { vtContact.first, tri[0], tri[1], tri[2] };
+            }
+            // Type 2, triangle-vertex contact
+            else if (contactType == 2)
+            {
+                Vec3i tri = tvContact.first;
+                std::sort(tri.data(), tri.data() + 3);
+                contact.isEdgeEdge = false;
+                contact.ids = { tvContact.second, tri[0], tri[1], tri[2] };
+            }
+            else
+            {
+                return;
+            }
+
+            lock.lock();
+            m_contacts.push_back(contact);
+            lock.unlock();
+        }, m_parallel);
+    m_numCandidatePairs = numCandidatePairs;
+
+    // The same contact is found from every pair of triangles sharing the edge/vertex, and the
+    // order of a parallel traversal is not deterministic, sort and remove duplicates
+    std::sort(m_contacts.begin(), m_contacts.end());
+    m_contacts.erase(std::unique(m_contacts.begin(), m_contacts.end()), m_contacts.end());
+
+    elementsA.reserve(m_contacts.size());
+    elementsB.reserve(m_contacts.size());
+    for (const Contact& contact : m_contacts)
+    {
+        CellIndexElement elemA;
+        CellIndexElement elemB;
+        if (contact.isEdgeEdge)
+        {
+            elemA.idCount  = 2;
+            elemA.cellType = IMSTK_EDGE;
+            elemA.ids[0]   = contact.ids[0];
+            elemA.ids[1]   = contact.ids[1];
+
+            elemB.idCount  = 2;
+            elemB.cellType = IMSTK_EDGE;
+            elemB.ids[0]   = contact.ids[2];
+            elemB.ids[1]   = contact.ids[3];
+        }
+        else
+        {
+            elemA.idCount  = 1;
+            elemA.cellType = IMSTK_VERTEX;
+            elemA.ids[0]   = contact.ids[0];
+
+            elemB.idCount  = 3;
+            elemB.cellType = IMSTK_TRIANGLE;
+            elemB.ids[0]   = contact.ids[1];
+            elemB.ids[1]   = contact.ids[2];
+            elemB.ids[2]   = contact.ids[3];
+        }
+        elementsA.push_back(elemA);
+        elementsB.push_back(elemB);
+    }
+}
+} // namespace imstk
@@ -0,0 +1,101 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkBVH.h"
+#include "imstkCollisionDetectionAlgorithm.h"
+#include "imstkMacros.h"
+
+namespace imstk
+{
+class SurfaceMesh;
+
+///
+/// \class SurfaceMeshSelfCD
+///
+/// \brief Self collision detection of a SurfaceMesh, ie: folding cloth or thin tissue.
+/// Give the same mesh as input A and B. Triangle boxes are kept in a BVH which is refit
+/// every update and rebuilt every few updates or when the topology changes. Pairs of
+/// triangles that share a vertex are culled, the remaining overlapping pairs are intersected
+/// in parallel producing vertex-triangle and edge-edge contacts (as SurfaceMeshToSurfaceMeshCD)
+/// that PbdCollisionHandling solves with a single constraint on both sides.
+///
+class SurfaceMeshSelfCD : public CollisionDetectionAlgorithm
+{
+public:
+    SurfaceMeshSelfCD();
+    ~SurfaceMeshSelfCD() override = default;
+
+    IMSTK_TYPE_NAME(SurfaceMeshSelfCD)
+
+public:
+    ///
+    /// \brief Get/Set the number of updates between full rebuilds of the BVH,
+    /// the BVH is only refit in between. Default 20
+    ///@{
+    void setRebuildInterval(const int rebuildInterval) { m_rebuildInterval = std::max(rebuildInterval, 1); }
+    int getRebuildInterval() const { return m_rebuildInterval; }
+    ///@}
+
+    ///
+    /// \brief Get/Set whether the narrow phase runs in parallel, default true
+    ///@{
+    void setParallel(const bool parallel) { m_parallel = parallel; }
+    bool getParallel() const { return m_parallel; }
+    ///@}
+
+    ///
+    /// \brief Number of triangle pairs that passed the broad phase and adjacency culling in the last update
+    ///
+    int getNumCandidatePairs() const { return m_numCandidatePairs; }
+
+    ///
+    /// \brief Get the BVH over the triangles of the mesh
+    ///
+    const BVH<3>& getBVH() const { return m_bvh; }
+
+protected:
+    ///
+    /// \brief Compute collision data for AB simultaneously
+    ///
+    void computeCollisionDataAB(
+        std::shared_ptr<Geometry>      geomA,
+        std::shared_ptr<Geometry>      geomB,
+        std::vector<CollisionElement>& elementsA,
+        std::vector<CollisionElement>& elementsB) override;
+
+    ///
+    /// \brief Contact by vertex ids. Vertex-triangle contacts store the vertex then the
+    /// triangle, edge-edge contacts store both edges. Ids are ordered such that the same
+    /// contact found from different triangle pairs compares equal.
+    ///
+    struct Contact
+    {
+        bool isEdgeEdge;
+        std::array<int, 4> ids;
+
+        bool operator<(const Contact& other) const
+        {
+            return (isEdgeEdge != other.isEdgeEdge) ? !isEdgeEdge : ids < other.ids;
+        }
+
+        bool operator==(const Contact& other) const { return isEdgeEdge == other.isEdgeEdge && ids == other.ids; }
+    };
+
+protected:
+    BVH<3> m_bvh;
+    std::shared_ptr<VecDataArray<double, 3>> m_prevVertices = nullptr; ///< Vertices the BVH was built on
+    std::shared_ptr<VecDataArray<int, 3>>    m_prevCells    = nullptr; ///< Cells the BVH was built on
+    int m_prevNumCells    = 0;
+    int m_rebuildInterval = 20;
+    int m_numUpdatesSinceRebuild = 0;
+    bool m_parallel = true;
+
+    int m_numCandidatePairs = 0;
+    std::vector<Contact> m_contacts;
+};
+} // namespace imstk
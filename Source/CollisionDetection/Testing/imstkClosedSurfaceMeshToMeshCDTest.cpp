@@ -182,4 +182,81 @@ TEST(imstkClosedSurfaceMeshToMeshCDTest, IntersectionTestAB_VertexToEdge)
 
     EXPECT_EQ(colData->elementsA[0].m_element.m_CellIndexElement.idCount, 2);
     EXPECT_EQ(colData->elementsB[0].m_element.m_CellIndexElement.idCount, 1);
-}
\ No newline at end of file
+}
+TEST(imstkClosedSurfaceMeshToMeshCDTest, IntersectionTestAB_ManyVertices)
+{
+    // Create a closed octahedron of radius 1
+    auto octMesh = std::make_shared<SurfaceMesh>();
+    {
+        auto verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+        verticesPtr->push_back(Vec3d(1.0, 0.0, 0.0));
+        verticesPtr->push_back(Vec3d(-1.0, 0.0, 0.0));
+        verticesPtr->push_back(Vec3d(0.0, 1.0, 0.0));
+        verticesPtr->push_back(Vec3d(0.0, -1.0, 0.0));
+        verticesPtr->push_back(Vec3d(0.0, 0.0, 1.0));
+        verticesPtr->push_back(Vec3d(0.0, 0.0, -1.0));
+        auto indicesPtr = std::make_shared<VecDataArray<int, 3>>();
+        indicesPtr->push_back(Vec3i(0, 2, 4));
+        indicesPtr->push_back(Vec3i(2, 1, 4));
+        indicesPtr->push_back(Vec3i(1, 3, 4));
+        indicesPtr->push_back(Vec3i(3, 0, 4));
+        indicesPtr->push_back(Vec3i(2, 0, 5));
+        indicesPtr->push_back(Vec3i(1, 2, 5));
+        indicesPtr->push_back(Vec3i(3, 1, 5));
+        indicesPtr->push_back(Vec3i(0, 3, 5));
+        octMesh->initialize(verticesPtr, indicesPtr);
+    }
+
+    // Create a grid of points around it, some inside
+    auto vertexMesh = std::make_shared<PointSet>();
+    int  numInside  = 0;
+    {
+        auto verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+        for (int z = 0; z < 11; z++)
+        {
+            for (int y = 0; y < 11; y++)
+            {
+                for (int x = 0; x < 11; x++)
+                {
+                    const Vec3d pos = Vec3d(x, y, z) * 0.3 - Vec3d(1.513, 1.527, 1.541);
+                    verticesPtr->push_back(pos);
+                    numInside += (pos.cwiseAbs().sum() < 1.0) ? 1 : 0;
+                }
+            }
+        }
+        vertexMesh->initialize(verticesPtr);
+    }
+
+    ClosedSurfaceMeshToMeshCD m_meshCD;
+    m_meshCD.setInput(vertexMesh, 0);
+    m_meshCD.setInput(octMesh, 1);
+    m_meshCD.setGenerateCD(true, true); // Generate both A and B
+    m_meshCD.setParallel(false);
+    m_meshCD.update();
+
+    std::shared_ptr<CollisionData>      colData   = m_meshCD.getCollisionData();
+    const std::vector<CollisionElement> elementsA = colData->elementsA;
+    const std::vector<CollisionElement> elementsB = colData->elementsB;
+
+    // Every inside vertex is found once
+    ASSERT_EQ(numInside, elementsA.size());
+    ASSERT_EQ(numInside, elementsB.size());
+    for (size_t i = 0; i < elementsA.size(); i++)
+    {
+        const int vertexId = elementsA[i].m_element.m_CellIndexElement.ids[0];
+        EXPECT_LT(vertexMesh->getVertexPosition(vertexId).cwiseAbs().sum(), 1.0);
+    }
+
+    // The parallel results should match
+    m_meshCD.setParallel(true);
+    m_meshCD.update();
+    ASSERT_EQ(elementsA.size(), colData->elementsA.size());
+    for (size_t i = 0; i < elementsA.size(); i++)
+    {
+        for (int j = 0; j < 3; j++)
+        {
+            EXPECT_EQ(elementsA[i].m_element.m_CellIndexElement.ids[j], colData->elementsA[i].m_element.m_CellIndexElement.ids[j]);
+            EXPECT_EQ(elementsB[i].m_element.m_CellIndexElement.ids[j], colData->elementsB[i].m_element.m_CellIndexElement.ids[j]);
+        }
+    }
+}
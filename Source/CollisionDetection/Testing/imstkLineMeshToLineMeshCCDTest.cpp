@@ -224,3 +224,90 @@ TEST(imstkLineMeshToLineMeshCCDTest, NonIntersectionTestAB)
     EXPECT_EQ(0, colData->elementsA.size());
     EXPECT_EQ(0, colData->elementsB.size());
 }
+
+// Lines ending closer than the thickness but not crossing
+TEST(imstkLineMeshToLineMeshCCDTest, IntersectionTestAB_thickness)
+{
+    auto lineMeshA      = makeOneSegmentLineMesh(Vec3d(0.00, 0.00, -0.01), Vec3d(0.00, 0.00, 0.01));
+    auto lineMeshB_prev = makeOneSegmentLineMesh(Vec3d(-0.01, 0.01, 0.00), Vec3d(0.01, 0.01, 0.00));
+    auto lineMeshB_curr = makeOneSegmentLineMesh(Vec3d(-0.01, 0.005, 0.00), Vec3d(0.01, 0.005, 0.00));
+
+    LineMeshToLineMeshCCD m_lineMeshToLineMeshCCD;
+    EXPECT_EQ(EdgeEdgeCCDState::defaultThickness(), m_lineMeshToLineMeshCCD.getThickness());
+    m_lineMeshToLineMeshCCD.updatePreviousTimestepGeometry(lineMeshA, lineMeshB_prev);
+    m_lineMeshToLineMeshCCD.setInput(lineMeshA, 0);
+    m_lineMeshToLineMeshCCD.setInput(lineMeshB_curr, 1);
+    m_lineMeshToLineMeshCCD.setGenerateCD(true, true); // Generate both A and B
+    m_lineMeshToLineMeshCCD.update();
+    EXPECT_EQ(0, m_lineMeshToLineMeshCCD.getCollisionData()->elementsA.size());
+
+    // Thicker than the gap
+    m_lineMeshToLineMeshCCD.setThickness(0.01);
+    m_lineMeshToLineMeshCCD.update();
+    EXPECT_EQ(1, m_lineMeshToLineMeshCCD.getCollisionData()->elementsA.size());
+    EXPECT_EQ(1, m_lineMeshToLineMeshCCD.getCollisionData()->elementsB.size());
+}
+
+///
+/// \brief Creates a mesh of n disconnected parallel segments along the given axis
+///
+static std::shared_ptr<LineMesh>
+makeParallelSegments(const int n, const int axis, const double offset)
+{
+    auto lineMesh   = std::make_shared<LineMesh>();
+    auto verxPtr    = std::make_shared<VecDataArray<double, 3>>();
+    auto indicesPtr = std::make_shared<VecDataArray<int, 2>>();
+    for (int i = 0; i < n; i++)
+    {
+        Vec3d a = Vec3d(0.0, 0.0, offset);
+        a[1 - axis] = i * 0.1;
+        Vec3d b = a;
+        a[axis] = -0.05;
+        b[axis] = n * 0.1;
+        verxPtr->push_back(a);
+        verxPtr->push_back(b);
+        indicesPtr->push_back(Vec2i(2 * i, 2 * i + 1));
+    }
+    lineMesh->initialize(verxPtr, indicesPtr);
+    return lineMesh;
+}
+
+// Many segments crossing each other, all pairs should be found through the broad phase
+TEST(imstkLineMeshToLineMeshCCDTest, IntersectionTestAB_many)
+{
+    const int n = 20;
+    auto      lineMeshA_prev = makeParallelSegments(n, 0, -0.01);
+    auto      lineMeshA_curr = makeParallelSegments(n, 0, 0.01);
+    auto      lineMeshB      = makeParallelSegments(n, 1, 0.0);
+
+    LineMeshToLineMeshCCD m_lineMeshToLineMeshCCD;
+    m_lineMeshToLineMeshCCD.updatePreviousTimestepGeometry(lineMeshA_prev, lineMeshB);
+    m_lineMeshToLineMeshCCD.setInput(lineMeshA_curr, 0);
+    m_lineMeshToLineMeshCCD.setInput(lineMeshB, 1);
+    m_lineMeshToLineMeshCCD.setGenerateCD(true, true); // Generate both A and B
+    m_lineMeshToLineMeshCCD.update();
+    std::shared_ptr<CollisionData> colData = m_lineMeshToLineMeshCCD.getCollisionData();
+
+    ASSERT_EQ(n * n, colData->elementsA.size());
+    ASSERT_EQ(n * n, colData->elementsB.size());
+
+    // Reported in cell order
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            EXPECT_EQ(2 * i, colData->elementsA[i * n + j].m_element.m_CellIndexElement.ids[0]);
+            EXPECT_EQ(2 * j, colData->elementsB[i * n + j].m_element.m_CellIndexElement.ids[0]);
+        }
+    }
+
+    // Move A away, the refit trees should no longer overlap
+    m_lineMeshToLineMeshCCD.updatePreviousTimestepGeometry(lineMeshA_curr, lineMeshB);
+    for (int i = 0; i < lineMeshA_curr->getNumVertices(); i++)
+    {
+        lineMeshA_curr->getVertexPosition(i)[2] = 0.05;
+    }
+    m_lineMeshToLineMeshCCD.update();
+    EXPECT_EQ(0, colData->elementsA.size());
+    EXPECT_EQ(0, m_lineMeshToLineMeshCCD.getNumCandidatePairs());
+}
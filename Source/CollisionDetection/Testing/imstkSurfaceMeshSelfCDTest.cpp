@@ -0,0 +1,159 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkSurfaceMesh.h"
+#include "imstkSurfaceMeshSelfCD.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+namespace
+{
+std::shared_ptr<SurfaceMesh>
+makeSurfaceMesh(const std::vector<Vec3d>& positions, const std::vector<Vec3i>& cells)
+{
+    auto verticesPtr = std::make_shared<VecDataArray<double, 3>>();
+    auto indicesPtr  = std::make_shared<VecDataArray<int, 3>>();
+    for (const Vec3d& pos : positions)
+    {
+        verticesPtr->push_back(pos);
+    }
+    for (const Vec3i& cell : cells)
+    {
+        indicesPtr->push_back(cell);
+    }
+    auto surfMesh = std::make_shared<SurfaceMesh>();
+    surfMesh->initialize(verticesPtr, indicesPtr);
+    return surfMesh;
+}
+
+std::shared_ptr<CollisionData>
+computeSelfCollision(std::shared_ptr<SurfaceMesh> surfMesh, const bool parallel = true)
+{
+    SurfaceMeshSelfCD cd;
+    cd.setInput(surfMesh, 0);
+    cd.setInput(surfMesh, 1);
+    cd.setParallel(parallel);
+    cd.update();
+    return cd.getCollisionData();
+}
+} // namespace
+
+///
+/// \brief Neighboring triangles folded onto each other share vertices and are not reported
+///
+TEST(imstkSurfaceMeshSelfCDTest, IgnoreAdjacent)
+{
+    std::shared_ptr<SurfaceMesh> surfMesh = makeSurfaceMesh(
+        { Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0), Vec3d(0.0, 1.0, 0.0), Vec3d(0.5, 0.5, 0.0), Vec3d(0.2, 0.2, 0.0) },
+        { Vec3i(0, 1, 2), Vec3i(1, 3, 2), Vec3i(0, 4, 1) });
+
+    std::shared_ptr<CollisionData> colData = computeSelfCollision(surfMesh);
+    EXPECT_EQ(0, colData->elementsA.size());
+    EXPECT_EQ(0, colData->elementsB.size());
+}
+
+///
+/// \brief A vertex poking through a non adjacent triangle gives one vertex-triangle contact,
+/// even though two triangles containing the vertex intersect it
+///
+TEST(imstkSurfaceMeshSelfCDTest, VertexTriangle)
+{
+    std::shared_ptr<SurfaceMesh> surfMesh = makeSurfaceMesh(
+        {
+            // Triangle in the xy plane
+            Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0), Vec3d(0.0, 1.0, 0.0),
+            // Fan around a vertex below the plane
+            Vec3d(0.25, 0.25, -0.2), Vec3d(0.2, 0.3, 0.5), Vec3d(0.3, 0.2, 0.5), Vec3d(0.3, 0.3, 0.5)
+        },
+        { Vec3i(0, 1, 2), Vec3i(3, 4, 5), Vec3i(3, 5, 6) });
+
+    std::shared_ptr<CollisionData> colData = computeSelfCollision(surfMesh);
+    ASSERT_EQ(1, colData->elementsA.size());
+    ASSERT_EQ(1, colData->elementsB.size());
+
+    const CellIndexElement& elemA = colData->elementsA[0].m_element.m_CellIndexElement;
+    const CellIndexElement& elemB = colData->elementsB[0].m_element.m_CellIndexElement;
+    EXPECT_EQ(CollisionElementType::CellIndex, colData->elementsA[0].m_type);
+    EXPECT_EQ(IMSTK_VERTEX, elemA.cellType);
+    EXPECT_EQ(3, elemA.ids[0]);
+    EXPECT_EQ(IMSTK_TRIANGLE, elemB.cellType);
+    EXPECT_EQ(3, elemB.idCount);
+    EXPECT_EQ(0, elemB.ids[0]);
+    EXPECT_EQ(1, elemB.ids[1]);
+    EXPECT_EQ(2, elemB.ids[2]);
+}
+
+///
+/// \brief Two crossing triangles with one edge through each other give one edge-edge contact
+///
+TEST(imstkSurfaceMeshSelfCDTest, EdgeEdge)
+{
+    std::shared_ptr<SurfaceMesh> surfMesh = makeSurfaceMesh(
+        {
+            Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0), Vec3d(0.0, 1.0, 0.0),
+            Vec3d(0.2, -0.5, 0.5), Vec3d(0.2, -0.5, -0.5), Vec3d(0.2, 0.5, 0.0)
+        },
+        { Vec3i(0, 1, 2), Vec3i(3, 4, 5) });
+
+    std::shared_ptr<CollisionData> colData = computeSelfCollision(surfMesh, false);
+    ASSERT_EQ(1, colData->elementsA.size());
+    ASSERT_EQ(1, colData->elementsB.size());
+    EXPECT_EQ(IMSTK_EDGE, colData->elementsA[0].m_element.m_CellIndexElement.cellType);
+    EXPECT_EQ(IMSTK_EDGE, colData->elementsB[0].m_element.m_CellIndexElement.cellType);
+    EXPECT_EQ(2, colData->elementsA[0].m_element.m_CellIndexElement.idCount);
+    EXPECT_EQ(2, colData->elementsB[0].m_element.m_CellIndexElement.idCount);
+}
+
+///
+/// \brief A flat grid folded over itself, the parallel and serial results should match
+///
+TEST(imstkSurfaceMeshSelfCDTest, FoldedGrid)
+{
+    const int          dim = 20;
+    std::vector<Vec3d> positions;
+    std::vector<Vec3i> cells;
+    for (int y = 0; y < dim; y++)
+    {
+        for (int x = 0; x < dim; x++)
+        {
+            // Fold the upper half back down through the lower half
+            const double fx = static_cast<double>(x) / (dim - 1);
+            const double fy = static_cast<double>(y) / (dim - 1);
+            positions.push_back((fy < 0.5) ?
+                                Vec3d(fx, fy, 0.0) :
+                                Vec3d(fx + 0.013, 1.0 - fy + 0.021, (fx - 0.5) * 0.2 + 0.01));
+        }
+    }
+    for (int y = 0; y < dim - 1; y++)
+    {
+        for (int x = 0; x < dim - 1; x++)
+        {
+            const int i0 = x + dim * y;
+            cells.push_back(Vec3i(i0, i0 + 1, i0 + dim));
+            cells.push_back(Vec3i(i0 + 1, i0 + dim + 1, i0 + dim));
+        }
+    }
+    std::shared_ptr<SurfaceMesh> surfMesh = makeSurfaceMesh(positions, cells);
+
+    std::shared_ptr<CollisionData> colDataSerial = computeSelfCollision(surfMesh, false);
+    EXPECT_GT(colDataSerial->elementsA.size(), 0);
+    const std::vector<CollisionElement> elementsA = colDataSerial->elementsA;
+    const std::vector<CollisionElement> elementsB = colDataSerial->elementsB;
+
+    std::shared_ptr<CollisionData> colDataParallel = computeSelfCollision(surfMesh, true);
+    ASSERT_EQ(elementsA.size(), colDataParallel->elementsA.size());
+    for (size_t i = 0; i < elementsA.size(); i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            EXPECT_EQ(elementsA[i].m_element.m_CellIndexElement.ids[j], colDataParallel->elementsA[i].m_element.m_CellIndexElement.ids[j]);
+            EXPECT_EQ(elementsB[i].m_element.m_CellIndexElement.ids[j], colDataParallel->elementsB[i].m_element.m_CellIndexElement.ids[j]);
+        }
+    }
+}
@@ -19,6 +19,7 @@
 #include "imstkPointSetToSphereCD.h"
 #include "imstkSphereToCylinderCD.h"
 #include "imstkSphereToSphereCD.h"
+#include "imstkSurfaceMeshSelfCD.h"
 #include "imstkSurfaceMeshToCapsuleCD.h"
 #include "imstkSurfaceMeshToSphereCD.h"
 #include "imstkSurfaceMeshToSurfaceMeshCD.h"
@@ -42,6 +43,7 @@ IMSTK_REGISTER_COLLISION_DETECTION(PointSetToSphereCD);
 IMSTK_REGISTER_COLLISION_DETECTION(PointSetToOrientedBoxCD);
 IMSTK_REGISTER_COLLISION_DETECTION(SphereToCylinderCD);
 IMSTK_REGISTER_COLLISION_DETECTION(SphereToSphereCD);
+IMSTK_REGISTER_COLLISION_DETECTION(SurfaceMeshSelfCD);
 IMSTK_REGISTER_COLLISION_DETECTION(SurfaceMeshToSurfaceMeshCD);
 IMSTK_REGISTER_COLLISION_DETECTION(SurfaceMeshToCapsuleCD);
 IMSTK_REGISTER_COLLISION_DETECTION(SurfaceMeshToSphereCD);
@@ -10,6 +10,7 @@
 #include "imstkParallelFor.h"
 #include "imstkRbdConstraint.h"
 #include "imstkRigidObject2.h"
+#include "imstkSpinLock.h"
 #include "imstkTetrahedralMesh.h"
 
 namespace imstk
@@ -32,6 +33,7 @@ BoneDrillingCH::erodeBone(
     const std::vector<CollisionElement>& elementsB)
 {
     auto boneTetMesh = std::dynamic_pointer_cast<TetrahedralMesh>(getBoneObj()->getCollidingGeometry());
+    ParallelUtils::SpinLock lock;
 
     // BoneDrillingCH process tetra-pointdirection elements
     ParallelUtils::parallelFor(elementsA.size(),
@@ -78,10 +80,12 @@ BoneDrillingCH::erodeBone(
                 m_nodeRemovalStatus[tetIndex] = true;
 
                 // tag the tetra that will be removed
+                lock.lock();
                 for (auto& tetId : m_nodalCardinalSet[tetIndex])
                 {
                     boneTetMesh->setTetrahedraAsRemoved(static_cast<unsigned int>(tetId));
                 }
+                lock.unlock();
             }
         });
 }
@@ -0,0 +1,106 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkSVD3x3.h"
+
+#include <benchmark/benchmark.h>
+#include <random>
+
+using namespace imstk;
+
+///
+/// \brief Deformation gradients near identity as seen in a deforming tet mesh,
+/// a fraction of them inverted
+///
+template<typename T>
+static std::vector<Eigen::Matrix<T, 3, 3>>
+makeDeformationGradients(const int count)
+{
+    std::mt19937                      gen(0);
+    std::uniform_real_distribution<T> dist(T(-0.5), T(0.5));
+
+    std::vector<Eigen::Matrix<T, 3, 3>> F(count);
+    for (int i = 0; i < count; i++)
+    {
+        F[i].setIdentity();
+        for (int j = 0; j < 9; j++)
+        {
+            F[i].data()[j] += dist(gen);
+        }
+        if (i % 10 == 0)
+        {
+            F[i].col(0) *= T(-1);
+        }
+    }
+    return F;
+}
+
+///
+/// \brief Eigen's two sided Jacobi SVD
+///
+template<typename T>
+static void
+BM_EigenJacobiSVD(benchmark::State& state)
+{
+    const std::vector<Eigen::Matrix<T, 3, 3>> F = makeDeformationGradients<T>(state.range(0));
+    T sum = T(0);
+    for (auto _ : state)
+    {
+        for (const Eigen::Matrix<T, 3, 3>& f : F)
+        {
+            Eigen::JacobiSVD<Eigen::Matrix<T, 3, 3>> svd(f, Eigen::ComputeFullU | Eigen::ComputeFullV);
+            sum += svd.singularValues()[2] + svd.matrixU()(0, 0) + svd.matrixV()(0, 0);
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+///
+/// \brief Fixed sweep Jacobi SVD with quaternion accumulation
+///
+template<typename T>
+static void
+BM_SVD3x3(benchmark::State& state)
+{
+    const std::vector<Eigen::Matrix<T, 3, 3>> F = makeDeformationGradients<T>(state.range(0));
+    T sum = T(0);
+    for (auto _ : state)
+    {
+        for (const Eigen::Matrix<T, 3, 3>& f : F)
+        {
+            Eigen::Matrix<T, 3, 3> U, V;
+            Eigen::Matrix<T, 3, 1> sigma;
+            svd3x3(f, U, sigma, V);
+            sum += sigma[2] + U(0, 0) + V(0, 0);
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_EigenJacobiSVD, double)
+->Unit(benchmark::kMicrosecond)
+->Name("Eigen JacobiSVD double")
+->Args({ 10000 });
+
+BENCHMARK_TEMPLATE(BM_SVD3x3, double)
+->Unit(benchmark::kMicrosecond)
+->Name("SVD3x3 double")
+->Args({ 10000 });
+
+BENCHMARK_TEMPLATE(BM_EigenJacobiSVD, float)
+->Unit(benchmark::kMicrosecond)
+->Name("Eigen JacobiSVD float")
+->Args({ 10000 });
+
+BENCHMARK_TEMPLATE(BM_SVD3x3, float)
+->Unit(benchmark::kMicrosecond)
+->Name("SVD3x3 float")
+->Args({ 10000 });
+
+// Run the benchmark
+BENCHMARK_MAIN();
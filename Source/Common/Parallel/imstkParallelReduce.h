@@ -173,5 +173,49 @@ findAABB(const VecDataArray<double, 3>& points, Vec3d& lowerCorner, Vec3d& upper
     lowerCorner = pObj.getLowerCorner();
     upperCorner = pObj.getUpperCorner();
 }
+
+///
+/// \brief Gather the indices i in [0, n) for which pred(i) is true, in increasing order.
+/// The indices are split in blocks, the matches of every block are counted in parallel,
+/// an exclusive prefix sum of the counts gives where every block writes its matches,
+/// which are then written in parallel. pred is evaluated twice per index
+///
+template<typename Predicate>
+inline void
+findIndices(const size_t n, Predicate&& pred, std::vector<size_t>& indices)
+{
+    const size_t        blockSize = 4096;
+    const size_t        numBlocks = (n + blockSize - 1) / blockSize;
+    std::vector<size_t> offsets(numBlocks + 1, 0);
+
+    tbb::parallel_for(size_t(0), numBlocks, [&](const size_t block)
+        {
+            const size_t end = std::min(n, (block + 1) * blockSize);
+            size_t count     = 0;
+            for (size_t i = block * blockSize; i < end; i++)
+            {
+                count += pred(i) ? 1 : 0;
+            }
+            offsets[block + 1] = count;
+        });
+    for (size_t block = 0; block < numBlocks; block++)
+    {
+        offsets[block + 1] += offsets[block];
+    }
+
+    indices.resize(offsets[numBlocks]);
+    tbb::parallel_for(size_t(0), numBlocks, [&](const size_t block)
+        {
+            const size_t end = std::min(n, (block + 1) * blockSize);
+            size_t j = offsets[block];
+            for (size_t i = block * blockSize; i < end; i++)
+            {
+                if (pred(i))
+                {
+                    indices[j++] = i;
+                }
+            }
+        });
+}
 } // end namespace ParallelUtils
 } // end namespace imstk
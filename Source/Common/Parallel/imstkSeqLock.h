@@ -0,0 +1,108 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+namespace imstk
+{
+namespace ParallelUtils
+{
+///
+/// \class SeqLock
+///
+/// \brief A sequence lock holding a value of type T written by a single thread and read
+/// by any number of threads. The writer never waits and readers never block the writer,
+/// a reader retries only if a write happened while it was copying. Suited for small state
+/// updated at high rate, such as device poses.
+///
+/// The value is stored as relaxed atomic words such that concurrent reads are not data races.
+/// T must be bitwise copyable (plain data without pointers to itself), ie: Eigen fixed size types
+///
+template<typename T>
+class SeqLock
+{
+public:
+    SeqLock() : SeqLock(T()) { }
+    SeqLock(const T& value)
+    {
+        m_sequence.store(0, std::memory_order_relaxed);
+        storeWords(value);
+    }
+
+    SeqLock(const SeqLock& other) : SeqLock(other.read()) { }
+
+    SeqLock& operator=(const SeqLock& other)
+    {
+        write(other.read());
+        return *this;
+    }
+
+public:
+    ///
+    /// \brief Write the value, only one thread may write at a time
+    ///
+    void write(const T& value)
+    {
+        // Odd sequence marks a write in progress
+        const uint64_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        storeWords(value);
+        m_sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    ///
+    /// \brief Read a consistent copy of the value
+    ///
+    T read() const
+    {
+        std::array<uint64_t, NumWords> words;
+        uint64_t seq0, seq1;
+        do
+        {
+            seq0 = m_sequence.load(std::memory_order_acquire);
+            for (size_t i = 0; i < NumWords; i++)
+            {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            seq1 = m_sequence.load(std::memory_order_relaxed);
+        }
+        while ((seq0 & 1) != 0 || seq0 != seq1);
+
+        T value;
+        std::memcpy(static_cast<void*>(&value), words.data(), sizeof(T));
+        return value;
+    }
+
+    ///
+    /// \brief Number of writes done
+    ///
+    uint64_t getNumWrites() const { return m_sequence.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t NumWords = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    void storeWords(const T& value)
+    {
+        std::array<uint64_t, NumWords> words = { };
+        std::memcpy(words.data(), static_cast<const void*>(&value), sizeof(T));
+        for (size_t i = 0; i < NumWords; i++)
+        {
+            m_words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<uint64_t> m_sequence;
+    std::array<std::atomic<uint64_t>, NumWords> m_words;
+};
+} // end namespace ParallelUtils
+} // end namespace imstk
@@ -328,7 +328,6 @@ TEST(imstkDataArrayTest, RangedBasedFor)
 
 TEST(imstkDataArrayTest, Cloning)
 {
-    using Base = DataArray<int>;
     DataArray<int> a{ 1, 2, 3, 4 };
 
     // Cloning known type
@@ -343,4 +342,57 @@ TEST(imstkDataArrayTest, Cloning)
 
     ASSERT_NE(cloned, nullptr);
     EXPECT_TRUE(isEqualTo(a, *cloned));
-}
\ No newline at end of file
+}
+
+TEST(imstkDataArrayTest, Alignment)
+{
+    DataArray<double> a;
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(a.getPointer()) % 64);
+    for (int i = 0; i < 1000; i++)
+    {
+        a.push_back(static_cast<double>(i));
+        EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(a.getPointer()) % 64);
+    }
+    a.squeeze();
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(a.getPointer()) % 64);
+    EXPECT_EQ(999.0, a[999]);
+}
+
+TEST(imstkDataArrayTest, ArenaAllocator)
+{
+    auto arena = std::make_shared<ArenaAllocator>(1024 * 1024);
+
+    DataArray<int> a{ 1, 2, 3, 4 };
+    a.setAllocator(arena);
+    EXPECT_EQ(arena, a.getAllocator());
+    EXPECT_TRUE(isEqualTo(a, { 1, 2, 3, 4 }));
+
+    // The last block of the arena grows in place
+    const int* ptr = a.getPointer();
+    a.reserve(1000);
+    EXPECT_EQ(ptr, a.getPointer());
+    EXPECT_TRUE(isEqualTo(a, { 1, 2, 3, 4 }));
+
+    // Copies use the same allocator and are packed after it
+    DataArray<int> b(a);
+    EXPECT_EQ(arena, b.getAllocator());
+    EXPECT_EQ(a.getPointer() + 1008, b.getPointer()); // 1000 ints rounded to 64 bytes
+    EXPECT_EQ(1, arena->getNumChunks());
+}
+
+TEST(imstkDataArrayTest, HugePageAllocator)
+{
+    auto allocator = std::make_shared<HugePageAllocator>(4096);
+
+    DataArray<double> a;
+    a.setAllocator(allocator);
+    for (int i = 0; i < 10000; i++)
+    {
+        a.push_back(static_cast<double>(i));
+    }
+    a.squeeze();
+    for (int i = 0; i < 10000; i++)
+    {
+        ASSERT_EQ(static_cast<double>(i), a[i]);
+    }
+}
@@ -0,0 +1,58 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkParallelReduce.h"
+
+using namespace imstk;
+
+TEST(imstkParallelReduceTest, FindIndicesEmpty)
+{
+    std::vector<size_t> indices = { 1, 2, 3 };
+    ParallelUtils::findIndices(0, [](const size_t) { return true; }, indices);
+    EXPECT_TRUE(indices.empty());
+}
+
+TEST(imstkParallelReduceTest, FindIndicesNone)
+{
+    std::vector<size_t> indices = { 1, 2, 3 };
+    ParallelUtils::findIndices(10000, [](const size_t) { return false; }, indices);
+    EXPECT_TRUE(indices.empty());
+}
+
+TEST(imstkParallelReduceTest, FindIndicesAll)
+{
+    // Not a multiple of the block size
+    const size_t        n = 10001;
+    std::vector<size_t> indices;
+    ParallelUtils::findIndices(n, [](const size_t) { return true; }, indices);
+    ASSERT_EQ(indices.size(), n);
+    for (size_t i = 0; i < n; i++)
+    {
+        EXPECT_EQ(indices[i], i);
+    }
+}
+
+TEST(imstkParallelReduceTest, FindIndicesOrder)
+{
+    // Matches spread unevenly over several blocks, denser in the last one
+    const size_t n    = 20000;
+    auto         pred = [](const size_t i) { return (i % 7 == 3) || (i > 19000 && i % 2 == 0); };
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (pred(i))
+        {
+            expected.push_back(i);
+        }
+    }
+
+    std::vector<size_t> indices;
+    ParallelUtils::findIndices(n, pred, indices);
+    EXPECT_EQ(indices, expected);
+}
@@ -0,0 +1,124 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkSVD3x3.h"
+
+#include <random>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Checks the decomposition of A against Eigen's JacobiSVD, tolerance relative to the largest singular value
+///
+template<typename T>
+void
+checkSVD(const Eigen::Matrix<T, 3, 3>& A, const T tol)
+{
+    using Mat = Eigen::Matrix<T, 3, 3>;
+    using Vec = Eigen::Matrix<T, 3, 1>;
+
+    Mat U, V;
+    Vec sigma;
+    svd3x3(A, U, sigma, V);
+
+    Eigen::JacobiSVD<Mat> svd(A, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    const Vec             expectedSigma = svd.singularValues();
+    const T               scale = std::max(expectedSigma[0], T(1));
+
+    // Rotations
+    EXPECT_NEAR(U.determinant(), T(1), tol);
+    EXPECT_NEAR(V.determinant(), T(1), tol);
+    EXPECT_TRUE((U.transpose() * U).isApprox(Mat::Identity(), tol));
+    EXPECT_TRUE((V.transpose() * V).isApprox(Mat::Identity(), tol));
+
+    // Sorted singular values, equal up to the sign of the last which is that of det(A)
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_NEAR(std::abs(sigma[i]), expectedSigma[i], tol * scale);
+    }
+    EXPECT_GE(sigma[0], T(0));
+    EXPECT_GE(sigma[1], T(0));
+    if (std::abs(A.determinant()) > tol * scale * scale * scale)
+    {
+        EXPECT_EQ(A.determinant() < T(0), sigma[2] < T(0));
+    }
+
+    // Reconstruction
+    const Mat reconstructed = U * sigma.asDiagonal() * V.transpose();
+    EXPECT_LT((reconstructed - A).norm(), tol * scale);
+}
+
+template<typename T>
+void
+checkRandomMatrices(const T tol)
+{
+    using Mat = Eigen::Matrix<T, 3, 3>;
+
+    std::mt19937                      gen(0);
+    std::uniform_real_distribution<T> dist(T(-1), T(1));
+    for (int i = 0; i < 1000; i++)
+    {
+        Mat A;
+        for (int j = 0; j < 9; j++)
+        {
+            A.data()[j] = dist(gen);
+        }
+        checkSVD<T>(A, tol);
+    }
+}
+} // namespace
+
+TEST(imstkSVD3x3Test, RandomDouble)
+{
+    checkRandomMatrices<double>(1.0e-10);
+}
+
+TEST(imstkSVD3x3Test, RandomFloat)
+{
+    checkRandomMatrices<float>(1.0e-4f);
+}
+
+TEST(imstkSVD3x3Test, SpecialMatrices)
+{
+    checkSVD<double>(Mat3d::Identity(), 1.0e-10);
+    checkSVD<double>(Mat3d::Zero(), 1.0e-10);
+    checkSVD<double>(Vec3d(3.0, 1.0, 2.0).asDiagonal(), 1.0e-10);
+    checkSVD<double>(Vec3d(2.0, 2.0, 2.0).asDiagonal(), 1.0e-10);
+    checkSVD<double>(Rotd(1.2, Vec3d(1.0, 2.0, 3.0).normalized()).toRotationMatrix(), 1.0e-10);
+
+    // Inverted, single and double reflections
+    checkSVD<double>(Vec3d(1.0, -0.5, 2.0).asDiagonal(), 1.0e-10);
+    checkSVD<double>(Vec3d(-1.0, -0.5, 2.0).asDiagonal(), 1.0e-10);
+
+    // Near singular, a flattened and a collapsed element
+    Mat3d flat = Rotd(0.3, Vec3d(0.0, 1.0, 1.0).normalized()).toRotationMatrix() * Vec3d(1.5, 0.7, 1.0e-9).asDiagonal();
+    checkSVD<double>(flat, 1.0e-10);
+    Mat3d line = Mat3d::Zero();
+    line.col(0) = Vec3d(1.0, 2.0, 3.0);
+    checkSVD<double>(line, 1.0e-10);
+}
+
+TEST(imstkSVD3x3Test, PolarDecomposition)
+{
+    const Mat3d A = Rotd(0.7, Vec3d(1.0, -1.0, 0.5).normalized()).toRotationMatrix()
+                    * Vec3d(1.2, 0.9, 1.1).asDiagonal();
+    Mat3d R, S;
+    polarDecomposition3x3(A, R, S);
+    EXPECT_TRUE((R * S).isApprox(A, 1.0e-10));
+    EXPECT_TRUE(S.isApprox(S.transpose(), 1.0e-10));
+    EXPECT_NEAR(R.determinant(), 1.0, 1.0e-10);
+
+    // Inverted, R stays a rotation
+    Mat3d inverted = A;
+    inverted.col(2) *= -1.0;
+    polarDecomposition3x3(inverted, R, S);
+    EXPECT_TRUE((R * S).isApprox(inverted, 1.0e-10));
+    EXPECT_NEAR(R.determinant(), 1.0, 1.0e-10);
+}
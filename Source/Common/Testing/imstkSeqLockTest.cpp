@@ -0,0 +1,56 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkMath.h"
+#include "imstkSeqLock.h"
+
+#include <thread>
+
+using namespace imstk;
+
+TEST(imstkSeqLockTest, ReadWrite)
+{
+    ParallelUtils::SeqLock<Vec3d> lock(Vec3d(1.0, 2.0, 3.0));
+    EXPECT_TRUE(lock.read().isApprox(Vec3d(1.0, 2.0, 3.0)));
+    EXPECT_EQ(lock.getNumWrites(), 0);
+
+    lock.write(Vec3d(4.0, 5.0, 6.0));
+    EXPECT_TRUE(lock.read().isApprox(Vec3d(4.0, 5.0, 6.0)));
+    EXPECT_EQ(lock.getNumWrites(), 1);
+}
+
+TEST(imstkSeqLockTest, ConcurrentRead)
+{
+    // Every written value has all components equal, a torn read would not
+    ParallelUtils::SeqLock<Vec4d> lock(Vec4d::Zero());
+    const int numWrites = 100000;
+
+    std::thread writer([&]()
+        {
+            for (int i = 1; i <= numWrites; i++)
+            {
+                lock.write(Vec4d::Constant(static_cast<double>(i)));
+            }
+        });
+
+    int    numTorn = 0;
+    double prev    = 0.0;
+    bool   ordered = true;
+    while (lock.getNumWrites() < numWrites)
+    {
+        const Vec4d value = lock.read();
+        numTorn += (value.array() != value[0]).any() ? 1 : 0;
+        ordered &= (value[0] >= prev);
+        prev     = value[0];
+    }
+    writer.join();
+
+    EXPECT_EQ(numTorn, 0);
+    EXPECT_TRUE(ordered);
+    EXPECT_EQ(lock.read()[0], static_cast<double>(numWrites));
+}
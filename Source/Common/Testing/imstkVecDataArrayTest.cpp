@@ -343,7 +343,7 @@ TEST(imstkVecDataArrayTest, RangedBasedFor)
         VecDataArray<int, 2> a{ Vec2i(1, 2), Vec2i(3, 4), Vec2i(5, 6), Vec2i(7, 8) };
 
         Vec2i expected = Vec2i(1, 2);
-        for (const auto value : a)
+        for (const auto& value : a)
         {
             EXPECT_EQ(value, expected);
             expected += Vec2i(2, 2);
@@ -369,7 +369,7 @@ TEST(imstkVecDataArrayTest, RangedBasedFor)
         const VecDataArray<int, 2> aConst{ Vec2i(1, 2), Vec2i(3, 4), Vec2i(5, 6), Vec2i(7, 8) };
 
         Vec2i expected = Vec2i(1, 2);
-        for (const auto value : aConst)
+        for (const auto& value : aConst)
         {
             EXPECT_EQ(value, expected);
             expected += Vec2i(2, 2);
@@ -393,4 +393,27 @@ TEST(imstkVecDataArrayTest, Cloning)
 
     ASSERT_NE(cloned, nullptr);
     EXPECT_TRUE(isEqualTo(a, *cloned));
-}
\ No newline at end of file
+}
+
+TEST(imstkVecDataArrayTest, Allocator)
+{
+    VecDataArray<double, 3> a;
+    for (int i = 0; i < 100; i++)
+    {
+        a.push_back(Vec3d(i, i + 1, i + 2));
+    }
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(a.getPointer()) % 64);
+
+    a.setAllocator(std::make_shared<ArenaAllocator>());
+    for (int i = 0; i < 100; i++)
+    {
+        EXPECT_EQ(Vec3d(i, i + 1, i + 2), a[i]);
+    }
+    a.push_back(Vec3d(1.0, 2.0, 3.0));
+    EXPECT_EQ(101, a.size());
+    EXPECT_EQ(Vec3d(1.0, 2.0, 3.0), a[100]);
+
+    // Padded storage gives aligned 4-wide vectors
+    VecDataArray<double, 4> b(10);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(&b[1]) % 32);
+}
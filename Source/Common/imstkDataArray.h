@@ -7,16 +7,20 @@
 #pragma once
 
 #include "imstkAbstractDataArray.h"
+#include "imstkDataArrayAllocator.h"
 #include "imstkMath.h"
 #include "imstkMacros.h"
 
+#include <type_traits>
+
 namespace imstk
 {
 ///
 /// \class DataArray
 ///
 /// \brief Simple dynamic array implementation that also supports
-/// event posting and viewing/facade
+/// event posting and viewing/facade. Buffers are allocated by a DataArrayAllocator,
+/// aligned to 64 bytes by default
 ///
 template<typename T>
 class DataArray : public AbstractDataArray
@@ -122,7 +126,7 @@ public:
     /// \brief Constructs an empty data array
     /// DataArray will never have capacity < 1
     ///
-    DataArray() : m_mapped(false), m_data(new T[1])
+    DataArray() : m_mapped(false), m_allocator(DataArrayAllocator::getDefault()), m_data(allocateData(1))
     {
         setType(TypeTemplateMacro(T));
         m_capacity = 1;
@@ -131,7 +135,8 @@ public:
     ///
     /// \brief Constructs a data array
     ///
-    DataArray(const int size) : AbstractDataArray(size), m_mapped(false), m_data(new T[size])
+    DataArray(const int size) : AbstractDataArray(size), m_mapped(false), m_allocator(DataArrayAllocator::getDefault()),
+        m_data(allocateData(size))
     {
         setType(TypeTemplateMacro(T));
     }
@@ -140,7 +145,8 @@ public:
     /// \brief Constructs from intializer list
     ///
     template<typename U>
-    DataArray(std::initializer_list<U> list) : AbstractDataArray(static_cast<int>(list.size())), m_mapped(false), m_data(new T[list.size()])
+    DataArray(std::initializer_list<U> list) : AbstractDataArray(static_cast<int>(list.size())), m_mapped(false),
+        m_allocator(DataArrayAllocator::getDefault()), m_data(allocateData(static_cast<int>(list.size())))
     {
         int j = 0;
         for (auto i : list)
@@ -163,13 +169,14 @@ public:
         m_size       = other.m_size;
         m_capacity   = other.m_capacity;
         m_scalarType = other.m_scalarType;
+        m_allocator  = other.m_allocator;
         if (m_mapped)
         {
             m_data = other.m_data;
         }
         else
         {
-            m_data = new T[m_size];
+            m_data = allocateData(m_capacity);
             std::copy_n(other.m_data, m_size, m_data);
         }
     }
@@ -180,6 +187,7 @@ public:
         m_size         = other.m_size;
         m_capacity     = other.m_capacity;
         m_scalarType   = other.m_scalarType;
+        m_allocator    = other.m_allocator;
         m_data         = other.m_data; // Take the others buffer
         other.m_mapped = true;         // The others destructor should then not delete
     }
@@ -188,7 +196,7 @@ public:
     {
         if (!m_mapped)
         {
-            delete[] m_data;
+            deallocateData(m_data, m_capacity);
             m_data = nullptr;
         }
     }
@@ -211,11 +219,8 @@ public:
         }
         else
         {
-            const T* oldData = m_data;
-            m_data = new T[size];
-            std::copy_n(oldData, m_size, m_data);
-            delete[] oldData;
-            m_size = m_capacity = size;
+            reallocateData(size);
+            m_size = size;
         }
     }
 
@@ -229,11 +234,12 @@ public:
     ///
     virtual inline void squeeze()
     {
-        const T* oldData = m_data;
-        m_data = new T[m_size];
-        std::copy_n(oldData, m_size, m_data);
-        delete[] oldData;
-        m_capacity = m_size;
+        // Can't reallocate a mapped vector
+        if (m_mapped)
+        {
+            return;
+        }
+        reallocateData(m_size);
     }
 
     ///
@@ -354,9 +360,9 @@ public:
         // If previously mapped, don't delete, just overwrite
         if (!m_mapped)
         {
-            delete[] m_data;
+            deallocateData(m_data, m_capacity);
         }
-        m_data = new T[list.size()];
+        m_data = allocateData(static_cast<int>(list.size()));
         int j = 0;
         for (auto i : list)
         {
@@ -415,7 +421,7 @@ public:
     {
         if (!m_mapped)
         {
-            delete[] m_data;
+            deallocateData(m_data, m_capacity);
         }
         m_mapped = true;
         m_data   = ptr;
@@ -424,6 +430,33 @@ public:
 
     inline virtual int getNumberOfComponents() const override { return NumComponents; }
 
+    ///
+    /// \brief Get/Set the allocator of the buffer. Setting moves the values of an unmapped
+    /// array into a buffer of the new allocator, ie: to place it in an arena or huge pages
+    ///@{
+    virtual void setAllocator(std::shared_ptr<DataArrayAllocator> allocator)
+    {
+        if (allocator == nullptr || allocator == m_allocator)
+        {
+            return;
+        }
+        // A mapped buffer is not ours, the allocator is used once the array is unmapped
+        if (m_mapped)
+        {
+            m_allocator = allocator;
+            return;
+        }
+        std::shared_ptr<DataArrayAllocator> oldAllocator = m_allocator;
+        T*                                  oldData      = m_data;
+        m_allocator = allocator;
+        m_data      = allocateData(m_capacity);
+        std::copy_n(oldData, m_size, m_data);
+        deallocateData(*oldAllocator, oldData, m_capacity);
+    }
+
+    std::shared_ptr<DataArrayAllocator> getAllocator() const { return m_allocator; }
+///@}
+
     ///
     /// \brief Cast array to specific c++ type
     ///
@@ -470,9 +503,70 @@ public:
     }
 
 protected:
+    ///
+    /// \brief Allocate a buffer of count values with the allocator of the array
+    ///
+    T* allocateData(const int count)
+    {
+        T* data = static_cast<T*>(m_allocator->allocate(sizeof(T) * count));
+        if (!std::is_trivially_default_constructible<T>::value)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                new(data + i) T();
+            }
+        }
+        return data;
+    }
+
+    ///
+    /// \brief Free a buffer of count values given by allocateData
+    ///@{
+    void deallocateData(T* data, const int count) { deallocateData(*m_allocator, data, count); }
+
+    static void deallocateData(DataArrayAllocator& allocator, T* data, const int count)
+    {
+        if (data == nullptr)
+        {
+            return;
+        }
+        if (!std::is_trivially_destructible<T>::value)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                data[i].~T();
+            }
+        }
+        allocator.deallocate(data, sizeof(T) * count);
+    }
+///@}
 
+    ///
+    /// \brief Reallocate the buffer to hold capacity values, keeping the current ones. Trivially
+    /// copyable values are moved by the allocator which may grow the buffer in place
+    ///
+    void reallocateData(const int capacity)
+    {
+        const int numToKeep = std::min(m_size, capacity);
+        if (std::is_trivially_copyable<T>::value)
+        {
+            m_data = static_cast<T*>(m_allocator->reallocate(m_data,
+                sizeof(T) * m_capacity, sizeof(T) * capacity, sizeof(T) * numToKeep));
+        }
+        else
+        {
+            T* newData = allocateData(capacity);
+            std::move(m_data, m_data + numToKeep, newData);
+            deallocateData(m_data, m_capacity);
+            m_data = newData;
+        }
+        m_capacity = capacity;
+    }
+
+protected:
     bool m_mapped;
-    T*   m_data;
+    std::shared_ptr<DataArrayAllocator> m_allocator;
+    T* m_data;
 
 private:
 
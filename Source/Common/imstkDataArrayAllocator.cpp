@@ -0,0 +1,257 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDataArrayAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace imstk
+{
+namespace
+{
+std::shared_ptr<DataArrayAllocator>&
+defaultAllocator()
+{
+    static std::shared_ptr<DataArrayAllocator> allocator = std::make_shared<AlignedAllocator>();
+    return allocator;
+}
+
+#if defined(__linux__)
+static const size_t hugePageNumBytes = 2 * 1024 * 1024;
+
+size_t
+roundToHugePages(const size_t numBytes)
+{
+    return (numBytes + hugePageNumBytes - 1) / hugePageNumBytes * hugePageNumBytes;
+}
+#endif
+} // namespace
+
+DataArrayAllocator::DataArrayAllocator(const size_t alignment) : m_alignment(alignment)
+{
+}
+
+void*
+DataArrayAllocator::reallocate(void* ptr, const size_t oldNumBytes, const size_t newNumBytes, const size_t numBytesToKeep)
+{
+    void* newPtr = allocate(newNumBytes);
+    if (ptr != nullptr)
+    {
+        std::memcpy(newPtr, ptr, std::min(numBytesToKeep, newNumBytes));
+        deallocate(ptr, oldNumBytes);
+    }
+    return newPtr;
+}
+
+std::shared_ptr<DataArrayAllocator>
+DataArrayAllocator::getDefault()
+{
+    return std::atomic_load(&defaultAllocator());
+}
+
+void
+DataArrayAllocator::setDefault(std::shared_ptr<DataArrayAllocator> allocator)
+{
+    std::atomic_store(&defaultAllocator(), (allocator == nullptr) ? std::make_shared<AlignedAllocator>() : allocator);
+}
+
+void*
+AlignedAllocator::allocate(const size_t numBytes)
+{
+    // Never hand out nullptr, arrays of size 0 still have a buffer
+    const size_t size = std::max<size_t>(numBytes, 1);
+#if defined(_WIN32)
+    void* ptr = _aligned_malloc(size, m_alignment);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, std::max(m_alignment, sizeof(void*)), size) != 0)
+    {
+        ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void
+AlignedAllocator::deallocate(void* ptr, const size_t)
+{
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+bool
+HugePageAllocator::useHugePages(const size_t numBytes) const
+{
+#if defined(__linux__)
+    return numBytes >= m_minNumBytes;
+#else
+    return false;
+#endif
+}
+
+void*
+HugePageAllocator::allocate(const size_t numBytes)
+{
+#if defined(__linux__)
+    if (useHugePages(numBytes))
+    {
+        void* ptr = mmap(nullptr, roundToHugePages(numBytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        // Only a hint, the kernel may still back it with regular pages
+        madvise(ptr, roundToHugePages(numBytes), MADV_HUGEPAGE);
+        return ptr;
+    }
+#endif
+    return AlignedAllocator(m_alignment).allocate(numBytes);
+}
+
+void
+HugePageAllocator::deallocate(void* ptr, const size_t numBytes)
+{
+#if defined(__linux__)
+    if (useHugePages(numBytes))
+    {
+        munmap(ptr, roundToHugePages(numBytes));
+        return;
+    }
+#endif
+    AlignedAllocator(m_alignment).deallocate(ptr, numBytes);
+}
+
+void*
+HugePageAllocator::reallocate(void* ptr, const size_t oldNumBytes, const size_t newNumBytes, const size_t numBytesToKeep)
+{
+#if defined(__linux__)
+    // Remap the pages instead of copying them
+    if (ptr != nullptr && useHugePages(oldNumBytes) && useHugePages(newNumBytes))
+    {
+        void* newPtr = mremap(ptr, roundToHugePages(oldNumBytes), roundToHugePages(newNumBytes), MREMAP_MAYMOVE);
+        if (newPtr == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        madvise(newPtr, roundToHugePages(newNumBytes), MADV_HUGEPAGE);
+        return newPtr;
+    }
+#endif
+    return DataArrayAllocator::reallocate(ptr, oldNumBytes, newNumBytes, numBytesToKeep);
+}
+
+ArenaAllocator::ArenaAllocator(const size_t chunkNumBytes, const size_t alignment) : DataArrayAllocator(alignment),
+    m_chunkNumBytes(chunkNumBytes), m_chunkAllocator(alignment)
+{
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+    for (Chunk& chunk : m_chunks)
+    {
+        m_chunkAllocator.deallocate(chunk.data, chunk.numBytes);
+    }
+}
+
+void*
+ArenaAllocator::allocate(const size_t numBytes)
+{
+    const size_t size = alignSize(std::max<size_t>(numBytes, 1));
+
+    m_lock.lock();
+    if (m_chunks.empty() || m_chunks.back().offset + size > m_chunks.back().numBytes)
+    {
+        // Blocks larger than a chunk get a chunk of their own
+        Chunk chunk;
+        chunk.numBytes = std::max(m_chunkNumBytes, size);
+        chunk.data     = static_cast<char*>(m_chunkAllocator.allocate(chunk.numBytes));
+        chunk.offset   = 0;
+        m_chunks.push_back(chunk);
+    }
+    Chunk& chunk = m_chunks.back();
+    void*  ptr   = chunk.data + chunk.offset;
+    chunk.offset += size;
+    m_lock.unlock();
+    return ptr;
+}
+
+void
+ArenaAllocator::deallocate(void* ptr, const size_t numBytes)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    const size_t size = alignSize(std::max<size_t>(numBytes, 1));
+
+    // Reclaim the space only if it is the last block of its chunk
+    m_lock.lock();
+    for (auto iter = m_chunks.rbegin(); iter != m_chunks.rend(); iter++)
+    {
+        if (static_cast<char*>(ptr) + size == iter->data + iter->offset)
+        {
+            iter->offset -= size;
+            break;
+        }
+    }
+    m_lock.unlock();
+}
+
+void*
+ArenaAllocator::reallocate(void* ptr, const size_t oldNumBytes, const size_t newNumBytes, const size_t numBytesToKeep)
+{
+    if (ptr != nullptr)
+    {
+        const size_t oldSize = alignSize(std::max<size_t>(oldNumBytes, 1));
+        const size_t newSize = alignSize(std::max<size_t>(newNumBytes, 1));
+
+        m_lock.lock();
+        for (auto iter = m_chunks.rbegin(); iter != m_chunks.rend(); iter++)
+        {
+            if (iter->offset >= oldSize && static_cast<char*>(ptr) == iter->data + iter->offset - oldSize
+                && iter->offset - oldSize + newSize <= iter->numBytes)
+            {
+                iter->offset = iter->offset - oldSize + newSize;
+                m_lock.unlock();
+                return ptr;
+            }
+        }
+        m_lock.unlock();
+    }
+    return DataArrayAllocator::reallocate(ptr, oldNumBytes, newNumBytes, numBytesToKeep);
+}
+
+size_t
+ArenaAllocator::getNumBytesUsed() const
+{
+    m_lock.lock();
+    size_t numBytes = 0;
+    for (const Chunk& chunk : m_chunks)
+    {
+        numBytes += chunk.offset;
+    }
+    m_lock.unlock();
+    return numBytes;
+}
+} // namespace imstk
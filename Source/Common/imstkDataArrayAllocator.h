@@ -0,0 +1,160 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkSpinLock.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace imstk
+{
+///
+/// \class DataArrayAllocator
+///
+/// \brief Allocation policy of the buffers of DataArray and VecDataArray. Buffers
+/// are aligned to getAlignment() bytes (64 by default, a cache line and wide enough
+/// for any SIMD load). The allocator used for new arrays can be changed with setDefault
+///
+class DataArrayAllocator
+{
+public:
+    DataArrayAllocator(const size_t alignment = 64);
+    virtual ~DataArrayAllocator() = default;
+
+public:
+    ///
+    /// \brief Allocate an aligned block of numBytes, never returns nullptr
+    ///
+    virtual void* allocate(const size_t numBytes) = 0;
+
+    ///
+    /// \brief Free a block given by allocate, numBytes must be the size it was allocated with
+    ///
+    virtual void deallocate(void* ptr, const size_t numBytes) = 0;
+
+    ///
+    /// \brief Grow or shrink a block keeping its first numBytesToKeep bytes, the block may move.
+    /// Only valid for trivially copyable contents. By default allocates, copies and frees.
+    ///
+    virtual void* reallocate(void* ptr, const size_t oldNumBytes, const size_t newNumBytes, const size_t numBytesToKeep);
+
+    ///
+    /// \brief Alignment of the returned blocks in bytes
+    ///
+    size_t getAlignment() const { return m_alignment; }
+
+    ///
+    /// \brief Get/Set the allocator given to newly constructed arrays, default an AlignedAllocator
+    ///@{
+    static std::shared_ptr<DataArrayAllocator> getDefault();
+    static void setDefault(std::shared_ptr<DataArrayAllocator> allocator);
+///@}
+
+protected:
+    size_t m_alignment;
+};
+
+///
+/// \class AlignedAllocator
+///
+/// \brief Heap allocator returning blocks aligned to the given alignment
+///
+class AlignedAllocator : public DataArrayAllocator
+{
+public:
+    AlignedAllocator(const size_t alignment = 64) : DataArrayAllocator(alignment) { }
+    ~AlignedAllocator() override = default;
+
+public:
+    void* allocate(const size_t numBytes) override;
+    void deallocate(void* ptr, const size_t numBytes) override;
+};
+
+///
+/// \class HugePageAllocator
+///
+/// \brief Backs large buffers with transparent huge pages where the OS supports it (Linux),
+/// reducing TLB misses when streaming over large meshes. Blocks below the threshold, and all
+/// blocks on other platforms, are aligned heap allocations. Large blocks grow in place of
+/// the virtual address space rather than by copying
+///
+class HugePageAllocator : public DataArrayAllocator
+{
+public:
+    HugePageAllocator(const size_t minNumBytes = 2 * 1024 * 1024) : m_minNumBytes(minNumBytes) { }
+    ~HugePageAllocator() override = default;
+
+public:
+    void* allocate(const size_t numBytes) override;
+    void deallocate(void* ptr, const size_t numBytes) override;
+    void* reallocate(void* ptr, const size_t oldNumBytes, const size_t newNumBytes, const size_t numBytesToKeep) override;
+
+    ///
+    /// \brief Blocks of at least this many bytes are mapped in huge pages, default 2MB
+    ///
+    size_t getMinNumBytes() const { return m_minNumBytes; }
+
+protected:
+    bool useHugePages(const size_t numBytes) const;
+
+    size_t m_minNumBytes;
+};
+
+///
+/// \class ArenaAllocator
+///
+/// \brief Bump allocator handing out blocks from large contiguous chunks, such that the
+/// buffers of a simulation (positions, velocities, masses, ...) are packed together.
+/// Freed blocks are only reclaimed when last in their chunk, all memory is released with
+/// the arena. Arrays hold a reference to their allocator so the arena outlives them
+///
+class ArenaAllocator : public DataArrayAllocator
+{
+public:
+    ArenaAllocator(const size_t chunkNumBytes = 16 * 1024 * 1024, const size_t alignment = 64);
+    ~ArenaAllocator() override;
+
+public:
+    void* allocate(const size_t numBytes) override;
+    void deallocate(void* ptr, const size_t numBytes) override;
+
+    ///
+    /// \brief Grows or shrinks in place when the block is the last of its chunk
+    ///
+    void* reallocate(void* ptr, const size_t oldNumBytes, const size_t newNumBytes, const size_t numBytesToKeep) override;
+
+    ///
+    /// \brief Number of bytes of the chunks currently in use
+    ///
+    size_t getNumBytesUsed() const;
+
+    ///
+    /// \brief Number of chunks allocated
+    ///
+    int getNumChunks() const { return static_cast<int>(m_chunks.size()); }
+
+protected:
+    struct Chunk
+    {
+        char* data;
+        size_t numBytes;
+        size_t offset; ///< Start of the free space
+    };
+
+    ///
+    /// \brief Round up to a multiple of the alignment
+    ///
+    size_t alignSize(const size_t numBytes) const { return (numBytes + m_alignment - 1) / m_alignment * m_alignment; }
+
+    size_t m_chunkNumBytes;
+    std::vector<Chunk> m_chunks;
+    AlignedAllocator   m_chunkAllocator;
+    mutable ParallelUtils::SpinLock m_lock;
+};
+} // namespace imstk
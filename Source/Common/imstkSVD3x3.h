@@ -0,0 +1,181 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+namespace imstk
+{
+namespace detail
+{
+///
+/// \brief Number of cyclic Jacobi sweeps needed to reach precision of T
+///
+template<typename T> struct SVD3x3Sweeps { static constexpr int value = 6; };
+template<> struct SVD3x3Sweeps<float> { static constexpr int value = 5; };
+
+///
+/// \brief Applies the approximate Givens rotation of McAdams et al. in the (p, q) plane
+/// to the symmetric matrix S, S = Q^T S Q, reducing S(p, q). The half angle is taken
+/// from the first order approximation tan(theta / 2) ~ S(p, q) / (2 (S(p, p) - S(q, q))),
+/// clamped to pi / 8 when it would exceed it, which needs one reciprocal square root
+/// instead of solving for the exact angle. Only the upper triangle of S is used.
+/// Returns the cosine and sine of half the rotation angle for quaternion accumulation.
+///
+template<typename T, int p, int q, int r>
+inline void
+jacobiConjugate(Eigen::Matrix<T, 3, 3>& S, T& ch, T& sh)
+{
+    // 3 + 2 sqrt(2), tan(pi / 8)^2 = 1 / gamma
+    static constexpr T gamma = T(5.828427124746190);
+    static constexpr T cStar = T(0.923879532511287); // cos(pi / 8)
+    static constexpr T sStar = T(0.382683432365090); // sin(pi / 8)
+
+    const T spp = S(p, p);
+    const T sqq = S(q, q);
+    T&      spq = (p < q) ? S(p, q) : S(q, p);
+    T&      spr = (p < r) ? S(p, r) : S(r, p);
+    T&      sqr = (q < r) ? S(q, r) : S(r, q);
+
+    // Once S(p, q) is below rounding of the diagonal the pair is converged, it is zeroed
+    // rather than rotated further such that the off diagonals do not underflow to denormals
+    const bool converged = std::abs(spq) <= std::numeric_limits<T>::epsilon() * std::abs(spp - sqq);
+    ch = converged ? T(1) : T(2) * (spp - sqq);
+    sh = converged ? T(0) : spq;
+    const bool useApprox = gamma * sh * sh < ch * ch;
+    const T    w = T(1) / std::sqrt(useApprox ? ch * ch + sh * sh : T(1));
+    ch = useApprox ? w * ch : cStar;
+    sh = useApprox ? w * sh : sStar;
+
+    // Rotation of twice the half angle
+    const T c   = ch * ch - sh * sh;
+    const T s   = T(2) * ch * sh;
+    const T cc  = c * c;
+    const T ss  = s * s;
+    const T cs  = c * s;
+    const T pq2 = T(2) * cs * spq;
+
+    S(p, p) = cc * spp + pq2 + ss * sqq;
+    S(q, q) = ss * spp - pq2 + cc * sqq;
+    spq     = converged ? T(0) : cs * (sqq - spp) + (cc - ss) * spq;
+    const T newSpr = c * spr + s * sqr;
+    const T newSqr = -s * spr + c * sqr;
+    spr = newSpr;
+    sqr = newSqr;
+}
+
+///
+/// \brief Swaps columns i and j of B and V if the column norm of i is less than j,
+/// negating one of them to keep det(V)
+///
+template<typename T>
+inline void
+condNegSwap(const bool swap, Eigen::Matrix<T, 3, 3>& B, Eigen::Matrix<T, 3, 3>& V,
+            Eigen::Matrix<T, 3, 1>& rho, const int i, const int j)
+{
+    for (int k = 0; k < 3; k++)
+    {
+        const T bi = B(k, i);
+        const T vi = V(k, i);
+        B(k, i) = swap ? B(k, j) : bi;
+        V(k, i) = swap ? V(k, j) : vi;
+        B(k, j) = swap ? -bi : B(k, j);
+        V(k, j) = swap ? -vi : V(k, j);
+    }
+    const T ri = rho[i];
+    rho[i] = swap ? rho[j] : ri;
+    rho[j] = swap ? ri : rho[j];
+}
+
+///
+/// \brief Givens rotation zeroing B(j, col) against B(i, col), applied as B = G B
+/// and accumulated into U = U G^T
+///
+template<typename T>
+inline void
+givensQR(Eigen::Matrix<T, 3, 3>& B, Eigen::Matrix<T, 3, 3>& U, const int i, const int j, const int col)
+{
+    const T a   = B(i, col);
+    const T b   = B(j, col);
+    const T    rhoSqr = a * a + b * b;
+    const bool valid  = rhoSqr > std::numeric_limits<T>::min();
+    const T    invRho = T(1) / std::sqrt(valid ? rhoSqr : T(1));
+    const T    c      = valid ? a * invRho : T(1);
+    const T    s      = valid ? b * invRho : T(0);
+
+    const Eigen::Matrix<T, 1, 3> bi = B.row(i);
+    B.row(i) = c * bi + s * B.row(j);
+    B.row(j) = -s * bi + c * B.row(j);
+
+    const Eigen::Matrix<T, 3, 1> ui = U.col(i);
+    U.col(i) = c * ui + s * U.col(j);
+    U.col(j) = -s * ui + c * U.col(j);
+}
+} // namespace detail
+
+///
+/// \brief Singular value decomposition of a 3x3 matrix A = U diag(sigma) V^T, as described
+/// in McAdams et al. "Computing the Singular Value Decomposition of 3x3 matrices with minimal
+/// branching and elementary floating point operations". A fixed number of cyclic Jacobi sweeps
+/// of approximate Givens rotations diagonalize A^T A with V accumulated as a quaternion,
+/// followed by a Givens QR of AV.
+///
+/// U and V are always rotations (det = 1). Singular values are sorted by decreasing magnitude,
+/// the last one carries the sign of det(A) such that inverted elements keep their orientation
+/// (the rotation variant SVD of Irving et al.). Sweeps may be given to trade accuracy for speed
+///
+template<typename T>
+inline void
+svd3x3(const Eigen::Matrix<T, 3, 3>& A,
+       Eigen::Matrix<T, 3, 3>& U, Eigen::Matrix<T, 3, 1>& sigma, Eigen::Matrix<T, 3, 3>& V,
+       const int numSweeps = detail::SVD3x3Sweeps<T>::value)
+{
+    // Symmetric eigenproblem A^T A = V diag(sigma^2) V^T
+    Eigen::Matrix<T, 3, 3> S = A.transpose() * A;
+    Eigen::Quaternion<T>   quat(T(1), T(0), T(0), T(0));
+    for (int i = 0; i < numSweeps; i++)
+    {
+        T ch, sh;
+        detail::jacobiConjugate<T, 0, 1, 2>(S, ch, sh);
+        quat = quat * Eigen::Quaternion<T>(ch, T(0), T(0), sh);
+        detail::jacobiConjugate<T, 1, 2, 0>(S, ch, sh);
+        quat = quat * Eigen::Quaternion<T>(ch, sh, T(0), T(0));
+        detail::jacobiConjugate<T, 2, 0, 1>(S, ch, sh);
+        quat = quat * Eigen::Quaternion<T>(ch, T(0), sh, T(0));
+    }
+    V = quat.normalized().toRotationMatrix();
+
+    // Sort the columns of B = AV by decreasing norm
+    Eigen::Matrix<T, 3, 3> B   = A * V;
+    Eigen::Matrix<T, 3, 1> rho = B.colwise().squaredNorm().transpose();
+    detail::condNegSwap(rho[0] < rho[1], B, V, rho, 0, 1);
+    detail::condNegSwap(rho[0] < rho[2], B, V, rho, 0, 2);
+    detail::condNegSwap(rho[1] < rho[2], B, V, rho, 1, 2);
+
+    // QR of B gives U and the (signed) singular values on the diagonal of R
+    U.setIdentity();
+    detail::givensQR(B, U, 0, 1, 0);
+    detail::givensQR(B, U, 0, 2, 0);
+    detail::givensQR(B, U, 1, 2, 1);
+    sigma = B.diagonal();
+}
+
+///
+/// \brief Polar decomposition A = RS of a 3x3 matrix with R a rotation and S symmetric,
+/// computed from svd3x3. For inverted A (det < 0) S is indefinite rather than R a reflection
+///
+template<typename T>
+inline void
+polarDecomposition3x3(const Eigen::Matrix<T, 3, 3>& A, Eigen::Matrix<T, 3, 3>& R, Eigen::Matrix<T, 3, 3>& S)
+{
+    Eigen::Matrix<T, 3, 3> U, V;
+    Eigen::Matrix<T, 3, 1> sigma;
+    svd3x3(A, U, sigma, V);
+    R = U * V.transpose();
+    S = V * sigma.asDiagonal() * V.transpose();
+}
+} // namespace imstk
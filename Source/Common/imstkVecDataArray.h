@@ -137,37 +137,18 @@ public:
         }
     }
 
-    VecDataArray(const VecDataArray& other)
+    VecDataArray(const VecDataArray& other) : DataArray<T>(other)
     {
-        DataArray<T>::m_mapped          = other.m_mapped;
-        AbstractDataArray::m_size       = other.m_size;
-        AbstractDataArray::m_capacity   = other.m_capacity;
-        AbstractDataArray::m_scalarType = other.m_scalarType;
-        if (DataArray<T>::m_mapped)
-        {
-            DataArray<T>::m_data = other.m_data;
-        }
-        else
-        {
-            DataArray<T>::m_data = new T[AbstractDataArray::m_capacity];
-            std::copy_n(other.m_data, AbstractDataArray::m_size, DataArray<T>::m_data);
-        }
         m_vecSize     = other.m_vecSize;
         m_vecCapacity = other.m_vecCapacity;
         m_dataCast    = reinterpret_cast<ValueType*>(DataArray<T>::m_data);
     }
 
-    VecDataArray(VecDataArray&& other)
+    VecDataArray(VecDataArray&& other) : DataArray<T>(std::move(other)) // Takes the others buffer
     {
-        DataArray<T>::m_mapped        = other.m_mapped;
-        AbstractDataArray::m_size     = other.m_size;
-        AbstractDataArray::m_capacity = other.m_capacity;
         m_vecSize     = other.m_vecSize;
         m_vecCapacity = other.m_vecCapacity;
-        AbstractDataArray::m_scalarType = other.m_scalarType;
-        DataArray<T>::m_data = other.m_data; // Take the others buffer
-        m_dataCast     = other.m_dataCast;
-        other.m_mapped = true;
+        m_dataCast    = other.m_dataCast;
     }
 
     ~VecDataArray() override = default;
@@ -403,9 +384,9 @@ public:
         // If previously mapped, don't delete, just overwrite
         if (!DataArray<T>::m_mapped)
         {
-            delete[] DataArray<T>::m_data;
+            DataArray<T>::deallocateData(DataArray<T>::m_data, AbstractDataArray::m_capacity);
         }
-        DataArray<T>::m_data = new T[list.size() * N];
+        DataArray<T>::m_data = DataArray<T>::allocateData(static_cast<int>(list.size() * N));
         m_dataCast = reinterpret_cast<ValueType*>(DataArray<T>::m_data);
         int j = 0;
         for (auto i : list)
@@ -470,7 +451,7 @@ public:
     {
         if (!DataArray<T>::m_mapped)
         {
-            delete[] DataArray<T>::m_data;
+            DataArray<T>::deallocateData(DataArray<T>::m_data, AbstractDataArray::m_capacity);
         }
 
         DataArray<T>::m_mapped = true;
@@ -482,6 +463,12 @@ public:
 
     inline int getNumberOfComponents() const override { return N; }
 
+    void setAllocator(std::shared_ptr<DataArrayAllocator> allocator) override
+    {
+        DataArray<T>::setAllocator(allocator);
+        m_dataCast = reinterpret_cast<ValueType*>(DataArray<T>::m_data);
+    }
+
     ///
     /// \brief Polymorphic clone, shadows the declaration in the superclasss
     ///        but returns own type
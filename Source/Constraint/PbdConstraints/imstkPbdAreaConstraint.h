@@ -32,6 +32,8 @@ public:
         const size_t& pIdx1, const size_t& pIdx2, const size_t& pIdx3,
         const double k = 2.5);
 
+    using PbdConstraint::computeValueAndGradient;
+
     bool computeValueAndGradient(
         const VecDataArray<double, 3>& currVertexPositions,
         double& c,
@@ -39,36 +39,55 @@ PbdBendConstraint::initConstraint(
     m_restLength = restLength;
 }
 
+template<typename T>
 bool
-PbdBendConstraint::computeValueAndGradient(
-    const VecDataArray<double, 3>& currVertexPositions,
-    double& c,
-    std::vector<Vec3d>& dcdx) const
+PbdBendConstraint::computeValueAndGradientImpl(
+    const VecDataArray<T, 3>& currVertexPositions,
+    T& c,
+    std::vector<Eigen::Matrix<T, 3, 1>>& dcdx) const
 {
     const size_t i0 = m_vertexIds[0];
     const size_t i1 = m_vertexIds[1];
     const size_t i2 = m_vertexIds[2];
 
-    const Vec3d& p0 = currVertexPositions[i0];
-    const Vec3d& p1 = currVertexPositions[i1];
-    const Vec3d& p2 = currVertexPositions[i2];
+    const Eigen::Matrix<T, 3, 1>& p0 = currVertexPositions[i0];
+    const Eigen::Matrix<T, 3, 1>& p1 = currVertexPositions[i1];
+    const Eigen::Matrix<T, 3, 1>& p2 = currVertexPositions[i2];
 
     // Move towards triangle center
-    const Vec3d& center = (p0 + p1 + p2) / 3.0;
-    const Vec3d& diff   = p1 - center;
-    const double dist   = diff.norm();
+    const Eigen::Matrix<T, 3, 1>& center = (p0 + p1 + p2) / T(3);
+    const Eigen::Matrix<T, 3, 1>& diff   = p1 - center;
+    const T dist = diff.norm();
 
     if (dist < m_epsilon)
     {
         return false;
     }
 
-    c = dist - m_restLength;
+    c = dist - static_cast<T>(m_restLength);
 
-    dcdx[0] = (-2.0 / dist) * diff;
-    dcdx[1] = -2.0 * dcdx[0];
+    dcdx[0] = (T(-2) / dist) * diff;
+    dcdx[1] = T(-2) * dcdx[0];
     dcdx[2] = dcdx[0];
 
     return true;
 }
+
+bool
+PbdBendConstraint::computeValueAndGradient(
+    const VecDataArray<double, 3>& currVertexPositions,
+    double& c,
+    std::vector<Vec3d>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, c, dcdx);
+}
+
+bool
+PbdBendConstraint::computeValueAndGradient(
+    const VecDataArray<float, 3>& currVertexPositions,
+    float& c,
+    std::vector<Vec3f>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, c, dcdx);
+}
 } // namespace imstk
\ No newline at end of file
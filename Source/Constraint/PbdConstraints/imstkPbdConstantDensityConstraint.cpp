@@ -25,6 +25,8 @@ PbdConstantDensityConstraint::initConstraint(const VecDataArray<double, 3>& init
     m_densities.resize(numParticles);
     m_deltaPositions.resize(numParticles);
     m_neighborList.resize(numParticles);
+    m_neighborOffsets.clear();
+    m_neighborIds.clear();
 
     m_restDensity       = density;
     m_particleRadius    = particleRadius;
@@ -33,7 +35,7 @@ PbdConstantDensityConstraint::initConstraint(const VecDataArray<double, 3>& init
     m_wSpikyCoeff       = 15.0 / (PI * pow(m_particleRadius, 6)) * -3.0;
 
     // Initialize neighbor searcher
-    m_NeighborSearcher = std::make_shared<NeighborSearch>(m_NeighborSearchMethod, m_particleRadius);
+    m_NeighborSearcher = std::make_shared<NeighborSearch>(m_NeighborSearchMethod, m_particleRadius + m_neighborSkin);
 }
 
 void
@@ -45,70 +47,114 @@ PbdConstantDensityConstraint::projectConstraint(const DataArray<double>& imstkNo
     const size_t numParticles = currVertexPositions.size();
 
     // Search neighbor for each particle
-    m_NeighborSearcher->getNeighbors(m_neighborList, currVertexPositions);
+    updateNeighbors(currVertexPositions);
 
     ParallelUtils::parallelFor(numParticles,
         [&](const size_t idx) {
-            computeDensity(currVertexPositions[idx], idx, currVertexPositions);
+            computeDensityAndLambda(currVertexPositions[idx], idx, currVertexPositions);
     });
 
     ParallelUtils::parallelFor(numParticles,
         [&](const size_t idx) {
-            computeLambdaScalingFactor(currVertexPositions[idx], idx, currVertexPositions);
+            updatePositions(currVertexPositions[idx], idx, currVertexPositions);
     });
 
+    // Apply after all deltas are computed, neighbors read the positions above
     ParallelUtils::parallelFor(numParticles,
         [&](const size_t idx) {
-            updatePositions(currVertexPositions[idx], idx, currVertexPositions);
+            currVertexPositions[idx] += m_deltaPositions[idx];
     });
 }
 
 void
-PbdConstantDensityConstraint::computeDensity(const Vec3d& pi,
-                                             const size_t index,
-                                             const VecDataArray<double, 3>& positions)
+PbdConstantDensityConstraint::updateNeighbors(const VecDataArray<double, 3>& positions)
 {
-    double densitySum = 0.0;
-    for (auto q : m_neighborList[index])
+    const int numParticles = positions.size();
+
+    // Neighbors within the radius + skin stay complete until a particle moved more than
+    // half the skin, two particles may then have closed the skin
+    bool doSearch = (m_neighborSkin <= 0.0 || m_searchPositions.size() != numParticles
+                     || static_cast<int>(m_neighborOffsets.size()) != numParticles + 1);
+    if (!doSearch)
+    {
+        const double maxDispSqr = 0.25 * m_neighborSkin * m_neighborSkin;
+        for (int i = 0; i < numParticles; i++)
+        {
+            if ((positions[i] - m_searchPositions[i]).squaredNorm() > maxDispSqr)
+            {
+                doSearch = true;
+                break;
+            }
+        }
+    }
+    if (!doSearch)
     {
-        densitySum += wPoly6(pi, positions[q]);
+        return;
     }
 
-    m_densities[index] = densitySum;
+    if (m_NeighborSearcher->getSearchRadius() != m_particleRadius + m_neighborSkin)
+    {
+        m_NeighborSearcher->setSearchRadius(m_particleRadius + m_neighborSkin);
+    }
+    m_NeighborSearcher->getNeighbors(m_neighborList, positions);
+    m_numNeighborSearches++;
+
+    // Flatten the lists
+    m_neighborOffsets.resize(numParticles + 1);
+    m_neighborOffsets[0] = 0;
+    for (int i = 0; i < numParticles; i++)
+    {
+        m_neighborOffsets[i + 1] = m_neighborOffsets[i] + static_cast<int>(m_neighborList[i].size());
+    }
+    m_neighborIds.resize(m_neighborOffsets[numParticles]);
+    ParallelUtils::parallelFor(numParticles,
+        [&](const int i) {
+            std::copy(m_neighborList[i].begin(), m_neighborList[i].end(), m_neighborIds.begin() + m_neighborOffsets[i]);
+    });
+
+    // Copy, positions may be a mapped array
+    if (m_neighborSkin > 0.0)
+    {
+        m_searchPositions.resize(numParticles);
+        std::copy(positions.begin(), positions.end(), m_searchPositions.begin());
+    }
 }
 
 void
-PbdConstantDensityConstraint::computeLambdaScalingFactor(const Vec3d& pi,
-                                                         const size_t index,
-                                                         const VecDataArray<double, 3>& positions)
+PbdConstantDensityConstraint::computeDensityAndLambda(const Vec3d& pi,
+                                                      const size_t index,
+                                                      const VecDataArray<double, 3>& positions)
 {
-    const double invRestDensity    = 1.0 / m_restDensity;
-    const double densityConstraint = (m_densities[index] * invRestDensity) - 1.0;
-    double       gradientSum       = 0.0;
-
-    for (auto q : m_neighborList[index])
+    const double invRestDensity = 1.0 / m_restDensity;
+    double       densitySum     = 0.0;
+    double       gradientSum    = 0.0;
+    for (int j = m_neighborOffsets[index]; j < m_neighborOffsets[index + 1]; j++)
     {
-        gradientSum += gradSpiky(pi, positions[q]).squaredNorm() * invRestDensity;
+        const Vec3d& pj = positions[m_neighborIds[j]];
+        densitySum  += wPoly6(pi, pj);
+        gradientSum += gradSpiky(pi, pj).squaredNorm() * invRestDensity;
     }
 
+    m_densities[index] = densitySum;
+    const double densityConstraint = (densitySum * invRestDensity) - 1.0;
     m_lambdas[index] = densityConstraint / (gradientSum + m_relaxationParameter);
 }
 
 void
 PbdConstantDensityConstraint::updatePositions(const Vec3d& pi,
                                               const size_t index,
-                                              VecDataArray<double, 3>& positions)
+                                              const VecDataArray<double, 3>& positions)
 {
     // Make sure the point is valid
     Vec3d gradientLambdaSum(0.0, 0.0, 0.0);
-    for (auto q : m_neighborList[index])
+    for (int j = m_neighborOffsets[index]; j < m_neighborOffsets[index + 1]; j++)
     {
+        const int    q = m_neighborIds[j];
         const double lambdasDiff = (m_lambdas[index] + m_lambdas[q]);
         const Vec3d  gradKernal  = gradSpiky(pi, positions[q]);
         gradientLambdaSum += (gradKernal * lambdasDiff);
     }
 
     m_deltaPositions[index] = gradientLambdaSum / m_restDensity;
-    positions[index] += m_deltaPositions[index];
 }
 } // namespace imstk
\ No newline at end of file
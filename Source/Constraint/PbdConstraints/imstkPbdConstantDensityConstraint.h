@@ -18,6 +18,10 @@ namespace imstk
 /// \brief Implements the constant density constraint to simulate fluids.
 /// This constraint is global and applied to all vertices passed in during projection
 ///
+/// Neighbors are kept in flat (CSR) arrays. With a neighbor skin they are searched within
+/// the particle radius plus the skin, and only searched again once a particle has moved
+/// more than half the skin, reusing them over solver iterations and time steps.
+///
 class PbdConstantDensityConstraint : public PbdConstraint
 {
 public:
@@ -29,6 +33,9 @@ public:
     void initConstraint(const VecDataArray<double, 3>& initVertexPositions,
                         const double particleRadius, const double density = 6378.0);
 
+    using PbdConstraint::projectConstraint;
+    using PbdConstraint::computeValueAndGradient;
+
     ///
     /// \brief Solves the constant density constraint
     ///
@@ -50,7 +57,21 @@ public:
     ///@{
     void setDensity(const double density) { m_restDensity = density; }
     double getDensity() const { return m_restDensity; }
-///@}
+    ///@}
+
+    ///
+    /// \brief Set/Get the neighbor skin, distance added to the neighbor search radius such
+    /// that neighbors can be reused until a particle moves more than half of it.
+    /// Default 0, neighbors are searched on every projection
+    ///@{
+    void setNeighborSkin(const double neighborSkin) { m_neighborSkin = neighborSkin; }
+    double getNeighborSkin() const { return m_neighborSkin; }
+    ///@}
+
+    ///
+    /// \brief Get the number of neighbor searches done, for diagnostics
+    ///
+    int getNumNeighborSearches() const { return m_numNeighborSearches; }
 
 private:
     ///
@@ -88,19 +109,19 @@ private:
     }
 
     ///
-    /// \brief
+    /// \brief Search the neighbors of every particle if the previous ones can't be reused
     ///
-    void computeDensity(const Vec3d& pi, const size_t index, const VecDataArray<double, 3>& positions);
+    void updateNeighbors(const VecDataArray<double, 3>& positions);
 
     ///
-    /// \brief
+    /// \brief Computes the density and lambda of a particle in one pass over its neighbors
     ///
-    void computeLambdaScalingFactor(const Vec3d& pi, const size_t index, const VecDataArray<double, 3>& positions);
+    void computeDensityAndLambda(const Vec3d& pi, const size_t index, const VecDataArray<double, 3>& positions);
 
     ///
-    /// \brief
+    /// \brief Computes the position change of a particle, applied once all are computed
     ///
-    void updatePositions(const Vec3d& pi, const size_t index, VecDataArray<double, 3>& positions);
+    void updatePositions(const Vec3d& pi, const size_t index, const VecDataArray<double, 3>& positions);
 
     ///
     /// \brief Set/Get neighbor search method
@@ -120,7 +141,12 @@ private:
     std::vector<double> m_lambdas;                   ///< lambdas
     std::vector<double> m_densities;                 ///< densities
     std::vector<Vec3d>  m_deltaPositions;            ///< delta positions
-    std::vector<std::vector<size_t>> m_neighborList; ///< indices of neighbor particles
+    std::vector<std::vector<size_t>> m_neighborList; ///< neighbor search results
+    std::vector<int>    m_neighborOffsets;           ///< start of the neighbors of each particle in m_neighborIds
+    std::vector<int>    m_neighborIds;               ///< indices of neighbor particles of all particles
+    VecDataArray<double, 3> m_searchPositions;       ///< positions at the last neighbor search
+    double m_neighborSkin        = 0.0;              ///< distance added to the search radius
+    int    m_numNeighborSearches = 0;
 
     NeighborSearch::Method m_NeighborSearchMethod = NeighborSearch::Method::UniformGridBasedSearch;
     std::shared_ptr<NeighborSearch> m_NeighborSearcher;  ///< neighbor searcher, must be initialized during model initialization
@@ -8,31 +8,33 @@
 
 namespace imstk
 {
+template<typename T>
 void
-PbdConstraint::projectConstraint(const DataArray<double>& invMasses, const double dt, const SolverType& solverType, VecDataArray<double, 3>& pos)
+PbdConstraint::projectConstraintImpl(const DataArray<T>& invMasses, const T dt, const SolverType& solverType,
+                                     VecDataArray<T, 3>& pos, std::vector<Eigen::Matrix<T, 3, 1>>& dcdx)
 {
     if (dt == 0.0)
     {
         return;
     }
 
-    double c      = 0.0;
-    bool   update = this->computeValueAndGradient(pos, c, m_dcdx);
+    T    c      = 0.0;
+    bool update = this->computeValueAndGradient(pos, c, dcdx);
     if (!update)
     {
         return;
     }
 
-    double dcMidc = 0.0;
-    double lambda = 0.0;
-    double alpha  = 0.0;
+    T dcMidc = 0.0;
+    T lambda = 0.0;
+    T alpha  = 0.0;
 
     for (size_t i = 0; i < m_vertexIds.size(); ++i)
     {
-        dcMidc += invMasses[m_vertexIds[i]] * m_dcdx[i].squaredNorm();
+        dcMidc += invMasses[m_vertexIds[i]] * dcdx[i].squaredNorm();
     }
 
-    if (dcMidc < IMSTK_DOUBLE_EPS)
+    if (dcMidc < std::numeric_limits<T>::epsilon())
     {
         return;
     }
@@ -40,16 +42,16 @@ PbdConstraint::projectConstraint(const DataArray<double>& invMasses, const doubl
     switch (solverType)
     {
     case (SolverType::xPBD):
-        alpha     = m_compliance / (dt * dt);
-        lambda    = -(c + alpha * m_lambda) / (dcMidc + alpha);
+        alpha     = static_cast<T>(m_compliance) / (dt * dt);
+        lambda    = -(c + alpha * static_cast<T>(m_lambda)) / (dcMidc + alpha);
         m_lambda += lambda;
         break;
     case (SolverType::PBD):
-        lambda = -c * m_stiffness / dcMidc;
+        lambda = -c * static_cast<T>(m_stiffness) / dcMidc;
         break;
     default:
-        alpha     = m_compliance / (dt * dt);
-        lambda    = -(c + alpha * m_lambda) / (dcMidc + alpha);
+        alpha     = static_cast<T>(m_compliance) / (dt * dt);
+        lambda    = -(c + alpha * static_cast<T>(m_lambda)) / (dcMidc + alpha);
         m_lambda += lambda;
     }
 
@@ -58,8 +60,21 @@ PbdConstraint::projectConstraint(const DataArray<double>& invMasses, const doubl
         vid = m_vertexIds[i];
         if (invMasses[vid] > 0.0)
         {
-            pos[vid] += invMasses[vid] * lambda * m_dcdx[i];
+            pos[vid] += invMasses[vid] * lambda * dcdx[i];
         }
     }
 }
+
+void
+PbdConstraint::projectConstraint(const DataArray<double>& invMasses, const double dt, const SolverType& solverType, VecDataArray<double, 3>& pos)
+{
+    projectConstraintImpl(invMasses, dt, solverType, pos, m_dcdx);
+}
+
+void
+PbdConstraint::projectConstraint(const DataArray<float>& invMasses, const float dt, const SolverType& solverType, VecDataArray<float, 3>& pos)
+{
+    m_dcdxf.resize(m_dcdx.size());
+    projectConstraintImpl(invMasses, dt, solverType, pos, m_dcdxf);
+}
 } // namespace imstk
@@ -43,6 +43,23 @@ public:
         double& c,
         std::vector<Vec3d>& dcdx) const = 0;
 
+    ///
+    /// \brief Single precision variant of computeValueAndGradient, only implemented by
+    /// constraints for which supportsSinglePrecision is true. Returns false otherwise
+    ///
+    virtual bool computeValueAndGradient(
+        const VecDataArray<float, 3>& imstkNotUsed(currVertexPositions),
+        float& imstkNotUsed(c),
+        std::vector<Vec3f>& imstkNotUsed(dcdx)) const
+    {
+        return false;
+    }
+
+    ///
+    /// \brief Whether the constraint can be projected on single precision positions
+    ///
+    virtual bool supportsSinglePrecision() const { return false; }
+
     ///
     /// \brief Get the vertex indices of the constraint
     ///
@@ -82,6 +99,16 @@ public:
     ///
     virtual void projectConstraint(const DataArray<double>& currInvMasses, const double dt, const SolverType& type, VecDataArray<double, 3>& pos);
 
+    ///
+    /// \brief Update single precision positions by projecting constraints, see supportsSinglePrecision
+    ///
+    virtual void projectConstraint(const DataArray<float>& currInvMasses, const float dt, const SolverType& type, VecDataArray<float, 3>& pos);
+
+protected:
+    template<typename T>
+    void projectConstraintImpl(const DataArray<T>& currInvMasses, const T dt, const SolverType& type,
+                               VecDataArray<T, 3>& pos, std::vector<Eigen::Matrix<T, 3, 1>>& dcdx);
+
 protected:
     std::vector<size_t> m_vertexIds;   ///< index of points for the constraint
     double m_epsilon        = 1.0e-16; ///< Tolerance used for the costraints
@@ -90,5 +117,6 @@ protected:
     mutable double m_lambda = 0.0;     ///< Lagrange multiplier
 
     std::vector<Vec3d> m_dcdx;         ///< Normalized constraint gradients (per vertex)
+    std::vector<Vec3f> m_dcdxf;        ///< Single precision gradients, only allocated when projected in single precision
 };
 } // namespace imstk
\ No newline at end of file
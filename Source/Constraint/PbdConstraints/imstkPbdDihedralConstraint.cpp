@@ -35,36 +35,39 @@ PbdDihedralConstraint::initConstraint(const VecDataArray<double, 3>& initVertexP
     m_restAngle = atan2(n1.cross(n2).dot(p3 - p2), (p3 - p2).norm() * n1.dot(n2));
 }
 
+template<typename T>
 bool
-PbdDihedralConstraint::computeValueAndGradient(
-    const VecDataArray<double, 3>& currVertexPositions,
-    double& c,
-    std::vector<Vec3d>& dcdx) const
+PbdDihedralConstraint::computeValueAndGradientImpl(
+    const VecDataArray<T, 3>& currVertexPositions,
+    T& c,
+    std::vector<Eigen::Matrix<T, 3, 1>>& dcdx) const
 {
+    using Vec3 = Eigen::Matrix<T, 3, 1>;
+
     const auto i0 = m_vertexIds[0];
     const auto i1 = m_vertexIds[1];
     const auto i2 = m_vertexIds[2];
     const auto i3 = m_vertexIds[3];
 
-    const Vec3d& p0 = currVertexPositions[i0];
-    const Vec3d& p1 = currVertexPositions[i1];
-    const Vec3d& p2 = currVertexPositions[i2];
-    const Vec3d& p3 = currVertexPositions[i3];
+    const Vec3& p0 = currVertexPositions[i0];
+    const Vec3& p1 = currVertexPositions[i1];
+    const Vec3& p2 = currVertexPositions[i2];
+    const Vec3& p3 = currVertexPositions[i3];
 
-    const auto e  = p3 - p2;
-    const auto e1 = p3 - p0;
-    const auto e2 = p0 - p2;
-    const auto e3 = p3 - p1;
-    const auto e4 = p1 - p2;
+    const Vec3 e  = p3 - p2;
+    const Vec3 e1 = p3 - p0;
+    const Vec3 e2 = p0 - p2;
+    const Vec3 e3 = p3 - p1;
+    const Vec3 e4 = p1 - p2;
     // To accelerate, all normal (area) vectors and edge length should be precomputed in parallel
-    auto       n1 = e1.cross(e);
-    auto       n2 = e.cross(e3);
-    const auto A1 = n1.norm();
-    const auto A2 = n2.norm();
+    Vec3    n1 = e1.cross(e);
+    Vec3    n2 = e.cross(e3);
+    const T A1 = n1.norm();
+    const T A2 = n2.norm();
     n1 /= A1;
     n2 /= A2;
 
-    const double l = e.norm();
+    const T l = e.norm();
     if (l < m_epsilon)
     {
         return false;
@@ -75,8 +78,26 @@ PbdDihedralConstraint::computeValueAndGradient(
     dcdx[2] = (e.dot(e1) / (A1 * l)) * n1 + (e.dot(e3) / (A2 * l)) * n2;
     dcdx[3] = (e.dot(e2) / (A1 * l)) * n1 + (e.dot(e4) / (A2 * l)) * n2;
 
-    c = atan2(n1.cross(n2).dot(e), l * n1.dot(n2)) - m_restAngle;
+    c = std::atan2(n1.cross(n2).dot(e), l * n1.dot(n2)) - static_cast<T>(m_restAngle);
 
     return true;
 }
-} // namespace imstk
\ No newline at end of file
+
+bool
+PbdDihedralConstraint::computeValueAndGradient(
+    const VecDataArray<double, 3>& currVertexPositions,
+    double& c,
+    std::vector<Vec3d>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, c, dcdx);
+}
+
+bool
+PbdDihedralConstraint::computeValueAndGradient(
+    const VecDataArray<float, 3>& currVertexPositions,
+    float& c,
+    std::vector<Vec3f>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, c, dcdx);
+}
+} // namespace imstk
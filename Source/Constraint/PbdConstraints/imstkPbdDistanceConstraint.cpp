@@ -25,25 +25,44 @@ PbdDistanceConstraint::initConstraint(const VecDataArray<double, 3>& initVertexP
     m_restLength = (p0 - p1).norm();
 }
 
+template<typename T>
 bool
-PbdDistanceConstraint::computeValueAndGradient(
-    const VecDataArray<double, 3>& currVertexPositions,
-    double& c,
-    std::vector<Vec3d>& dcdx) const
+PbdDistanceConstraint::computeValueAndGradientImpl(
+    const VecDataArray<T, 3>& currVertexPositions,
+    T& c,
+    std::vector<Eigen::Matrix<T, 3, 1>>& dcdx) const
 {
-    const Vec3d& p0 = currVertexPositions[m_vertexIds[0]];
-    const Vec3d& p1 = currVertexPositions[m_vertexIds[1]];
+    const Eigen::Matrix<T, 3, 1>& p0 = currVertexPositions[m_vertexIds[0]];
+    const Eigen::Matrix<T, 3, 1>& p1 = currVertexPositions[m_vertexIds[1]];
 
     dcdx[0] = p0 - p1;
-    const double len = dcdx[0].norm();
+    const T len = dcdx[0].norm();
     if (len == 0.0)
     {
         return false;
     }
     dcdx[0] /= len;
     dcdx[1]  = -dcdx[0];
-    c        = len - m_restLength;
+    c        = len - static_cast<T>(m_restLength);
 
     return true;
 }
+
+bool
+PbdDistanceConstraint::computeValueAndGradient(
+    const VecDataArray<double, 3>& currVertexPositions,
+    double& c,
+    std::vector<Vec3d>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, c, dcdx);
+}
+
+bool
+PbdDistanceConstraint::computeValueAndGradient(
+    const VecDataArray<float, 3>& currVertexPositions,
+    float& c,
+    std::vector<Vec3f>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, c, dcdx);
+}
 } // namespace imstk
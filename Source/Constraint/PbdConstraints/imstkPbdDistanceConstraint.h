@@ -37,6 +37,20 @@ public:
         double& c,
         std::vector<Vec3d>& dcdx) const override;
 
+    bool computeValueAndGradient(
+        const VecDataArray<float, 3>& currVertexPositions,
+        float& c,
+        std::vector<Vec3f>& dcdx) const override;
+
+    bool supportsSinglePrecision() const override { return true; }
+
+protected:
+    template<typename T>
+    bool computeValueAndGradientImpl(
+        const VecDataArray<T, 3>& currVertexPositions,
+        T& c,
+        std::vector<Eigen::Matrix<T, 3, 1>>& dcdx) const;
+
 public:
     double m_restLength = 0.0; ///< Rest length between the nodes
 };
@@ -5,6 +5,7 @@
 */
 
 #include "imstkPbdFemTetConstraint.h"
+#include "imstkSVD3x3.h"
 
 namespace imstk
 {
@@ -43,51 +44,58 @@ PbdFemTetConstraint::initConstraint(const VecDataArray<double, 3>& initVertexPos
     return false;
 }
 
+template<typename T>
 bool
-PbdFemTetConstraint::computeValueAndGradient(
-    const VecDataArray<double, 3>& currVertexPositions,
-    double& cval,
-    std::vector<Vec3d>& dcdx) const
+PbdFemTetConstraint::computeValueAndGradientImpl(
+    const VecDataArray<T, 3>& currVertexPositions,
+    T& cval,
+    std::vector<Eigen::Matrix<T, 3, 1>>& dcdx) const
 {
+    using Mat3x3 = Eigen::Matrix<T, 3, 3>;
+    using Vec3   = Eigen::Matrix<T, 3, 1>;
+
+    const Mat3x3 invRestMat           = m_invRestMat.cast<T>();
+    const T      initialElementVolume = static_cast<T>(m_initialElementVolume);
+
     const auto i0 = m_vertexIds[0];
     const auto i1 = m_vertexIds[1];
     const auto i2 = m_vertexIds[2];
     const auto i3 = m_vertexIds[3];
 
-    const Vec3d& p0 = currVertexPositions[i0];
-    const Vec3d& p1 = currVertexPositions[i1];
-    const Vec3d& p2 = currVertexPositions[i2];
-    const Vec3d& p3 = currVertexPositions[i3];
+    const Eigen::Matrix<T, 3, 1>& p0 = currVertexPositions[i0];
+    const Eigen::Matrix<T, 3, 1>& p1 = currVertexPositions[i1];
+    const Eigen::Matrix<T, 3, 1>& p2 = currVertexPositions[i2];
+    const Eigen::Matrix<T, 3, 1>& p3 = currVertexPositions[i3];
 
-    Mat3d m;
+    Mat3x3 m;
     m.col(0) = p0 - p3;
     m.col(1) = p1 - p3;
     m.col(2) = p2 - p3;
 
     // deformation gradient (F)
-    Mat3d defgrad = m * m_invRestMat;
+    Mat3x3 defgrad = m * invRestMat;
 
     // SVD matrices
-    Mat3d U    = Mat3d::Identity();
-    Mat3d Fhat = Mat3d::Identity();
-    Mat3d VT   = Mat3d::Identity();
+    Mat3x3 U    = Mat3x3::Identity();
+    Mat3x3 Fhat = Mat3x3::Identity();
+    Mat3x3 VT   = Mat3x3::Identity();
 
-    Mat3d F = defgrad;
+    Mat3x3 F = defgrad;
 
     // If inverted, handle if flag set to true
-    if (m_handleInversions && defgrad.determinant() <= 1E-8)
+    if (m_handleInversions && defgrad.determinant() <= T(1E-8))
     {
         handleInversions(defgrad, U, Fhat, VT);
         F = Fhat; // diagonalized deformation gradient
     }
 
     // First Piola-Kirchhoff tensor
-    Mat3d P;
+    Mat3x3 P;
     // energy constraint
-    double C = 0;
+    T C = T(0);
 
-    const auto mu     = m_config->m_mu;
-    const auto lambda = m_config->m_lambda;
+    const T mu     = static_cast<T>(m_config->m_mu);
+    const T lambda = static_cast<T>(m_config->m_lambda);
 
     switch (m_material)
     {
@@ -95,20 +103,20 @@ PbdFemTetConstraint::computeValueAndGradient(
     // E = (F^T*F - I)/2
     case MaterialType::StVK:
     {
-        Mat3d E;
-        E(0, 0) = 0.5 * (F(0, 0) * F(0, 0) + F(1, 0) * F(1, 0) + F(2, 0) * F(2, 0) - 1.0);                  // xx
-        E(1, 1) = 0.5 * (F(0, 1) * F(0, 1) + F(1, 1) * F(1, 1) + F(2, 1) * F(2, 1) - 1.0);                  // yy
-        E(2, 2) = 0.5 * (F(0, 2) * F(0, 2) + F(1, 2) * F(1, 2) + F(2, 2) * F(2, 2) - 1.0);                  // zz
-        E(0, 1) = 0.5 * (F(0, 0) * F(0, 1) + F(1, 0) * F(1, 1) + F(2, 0) * F(2, 1));                        // xy
-        E(0, 2) = 0.5 * (F(0, 0) * F(0, 2) + F(1, 0) * F(1, 2) + F(2, 0) * F(2, 2));                        // xz
-        E(1, 2) = 0.5 * (F(0, 1) * F(0, 2) + F(1, 1) * F(1, 2) + F(2, 1) * F(2, 2));                        // yz
+        Mat3x3 E;
+        E(0, 0) = T(0.5) * (F(0, 0) * F(0, 0) + F(1, 0) * F(1, 0) + F(2, 0) * F(2, 0) - T(1));                  // xx
+        E(1, 1) = T(0.5) * (F(0, 1) * F(0, 1) + F(1, 1) * F(1, 1) + F(2, 1) * F(2, 1) - T(1));                  // yy
+        E(2, 2) = T(0.5) * (F(0, 2) * F(0, 2) + F(1, 2) * F(1, 2) + F(2, 2) * F(2, 2) - T(1));                  // zz
+        E(0, 1) = T(0.5) * (F(0, 0) * F(0, 1) + F(1, 0) * F(1, 1) + F(2, 0) * F(2, 1));                        // xy
+        E(0, 2) = T(0.5) * (F(0, 0) * F(0, 2) + F(1, 0) * F(1, 2) + F(2, 0) * F(2, 2));                        // xz
+        E(1, 2) = T(0.5) * (F(0, 1) * F(0, 2) + F(1, 1) * F(1, 2) + F(2, 1) * F(2, 2));                        // yz
         E(1, 0) = E(0, 1);
         E(2, 0) = E(0, 2);
         E(2, 1) = E(1, 2);
 
-        P = 2 * mu * E;
-        double tr = E.trace();
-        double lt = lambda * tr;
+        P = T(2) * mu * E;
+        T tr     = E.trace();
+        T lt     = lambda * tr;
         P(0, 0) += lt;
         P(1, 1) += lt;
         P(2, 2) += lt;
@@ -117,7 +125,7 @@ PbdFemTetConstraint::computeValueAndGradient(
         C = E(0, 0) * E(0, 0) + E(0, 1) * E(0, 1) + E(0, 2) * E(0, 2)
             + E(1, 0) * E(1, 0) + E(1, 1) * E(1, 1) + E(1, 2) * E(1, 2)
             + E(2, 0) * E(2, 0) + E(2, 1) * E(2, 1) + E(2, 2) * E(2, 2);
-        C = mu * C + 0.5 * lambda * tr * tr;
+        C = mu * C + T(0.5) * lambda * tr * tr;
 
         break;
     }
@@ -125,38 +133,39 @@ PbdFemTetConstraint::computeValueAndGradient(
     // P(F) = (2*mu*(F-R) + lambda*(J-1)*J*F^-T
     case MaterialType::Corotation:
     {
-        Eigen::JacobiSVD<Mat3d> svd(F, Eigen::ComputeFullU | Eigen::ComputeFullV);
-        Mat3d                   R = svd.matrixU() * svd.matrixV().adjoint();
-        Vec3d                   Sigma(svd.singularValues());
-        Mat3d                   invFT = svd.matrixU();
+        Mat3x3 Ur, Vr;
+        Vec3   Sigma;
+        svd3x3(F, Ur, Sigma, Vr);
+        Mat3x3 R     = Ur * Vr.transpose();
+        Mat3x3 invFT = Ur;
         invFT.col(0) /= Sigma(0);
         invFT.col(1) /= Sigma(1);
         invFT.col(2) /= Sigma(2);
-        invFT *= svd.matrixV().adjoint();
-        double J  = Sigma(0) * Sigma(1) * Sigma(2);
-        Mat3d  FR = F - R;
+        invFT *= Vr.transpose();
+        T      J  = Sigma(0) * Sigma(1) * Sigma(2);
+        Mat3x3 FR = F - R;
 
-        P = 2 * mu * FR + lambda * (J - 1) * J * invFT;
+        P = T(2) * mu * FR + lambda * (J - T(1)) * J * invFT;
 
         C = FR(0, 0) * FR(0, 0) + FR(0, 1) * FR(0, 1) + FR(0, 2) * FR(0, 2)
             + FR(1, 0) * FR(1, 0) + FR(1, 1) * FR(1, 1) + FR(1, 2) * FR(1, 2)
             + FR(2, 0) * FR(2, 0) + FR(2, 1) * FR(2, 1) + FR(2, 2) * FR(2, 2);
-        C = mu * C + 0.5 * lambda * (J - 1) * (J - 1);
+        C = mu * C + T(0.5) * lambda * (J - T(1)) * (J - T(1));
 
         break;
     }
     // P(F) = mu*(F - mu*F^-T) + lambda*log(J)F^-T;
     case MaterialType::NeoHookean:
     {
-        Mat3d  invFT = F.inverse().transpose();
-        double logJ  = log(F.determinant());
+        Mat3x3 invFT = F.inverse().transpose();
+        T      logJ  = std::log(F.determinant());
         P = mu * (F - invFT) + lambda * logJ * invFT;
 
         C = F(0, 0) * F(0, 0) + F(0, 1) * F(0, 1) + F(0, 2) * F(0, 2)
             + F(1, 0) * F(1, 0) + F(1, 1) * F(1, 1) + F(1, 2) * F(1, 2)
             + F(2, 0) * F(2, 0) + F(2, 1) * F(2, 1) + F(2, 2) * F(2, 2);
 
-        C = 0.5 * mu * (C - 3) - mu * logJ + 0.5 * lambda * logJ * logJ;
+        C = T(0.5) * mu * (C - T(3)) - mu * logJ + T(0.5) * lambda * logJ * logJ;
 
         break;
     }
@@ -172,9 +181,9 @@ PbdFemTetConstraint::computeValueAndGradient(
     // Rotate P back here. P = U\hat{P}V^{T}
     P = U * P * VT;
 
-    Mat3d gradC = m_initialElementVolume * P * m_invRestMat.transpose();
+    Mat3x3 gradC = initialElementVolume * P * invRestMat.transpose();
     cval    = C;
-    cval   *=  m_initialElementVolume;
+    cval   *= initialElementVolume;
     dcdx[0] = gradC.col(0);
     dcdx[1] = gradC.col(1);
     dcdx[2] = gradC.col(2);
@@ -183,137 +192,27 @@ PbdFemTetConstraint::computeValueAndGradient(
     return true;
 }
 
+template<typename T>
 void
 PbdFemTetConstraint::handleInversions(
-    Mat3d& F,
-    Mat3d& U,
-    Mat3d& Fhat,
-    Mat3d& VT) const
+    Eigen::Matrix<T, 3, 3>& F,
+    Eigen::Matrix<T, 3, 3>& U,
+    Eigen::Matrix<T, 3, 3>& Fhat,
+    Eigen::Matrix<T, 3, 3>& VT) const
 {
-    // Compute SVD of F and return U and VT. Modify to handle inversions. F = U\hat{F} V^{T}
-    Eigen::JacobiSVD<Mat3d> svd(F, Eigen::ComputeFullU | Eigen::ComputeFullV);
-
-    // Save \hat{F}
-    Vec3d sigma(svd.singularValues());
-
-    // Store as matrix
-    for (int i = 0; i < 3; i++)
-    {
-        Fhat(i, i) = sigma(i);
-    }
-
-    // Save U and V
-    U = svd.matrixU();
-    Mat3d V = svd.matrixV();
-
-    // Verify that V is a pure rotations
-    const double detV = V.determinant();
-
-    // If detV is negative, then V includes a reflection.
-    // Switch to reflection by multiplying one column by -1
-    if (detV < 0.0)
-    {
-        double minLambda = IMSTK_DOUBLE_MAX;
-        int    column    = 0;
-        for (int i = 0; i < 3; i++)
-        {
-            if (Fhat(i, i) < minLambda)
-            {
-                column    = i;
-                minLambda = Fhat(i, i);
-            }
-        }
-
-        V.col(column) *= -1.0;
-    }
-
-    VT = V.transpose();
+    using Mat3x3 = Eigen::Matrix<T, 3, 3>;
+    using Vec3   = Eigen::Matrix<T, 3, 1>;
 
-    // Check for small singular values
-    int count    = 0; // number of small singlar values
-    int position = 0; // position of small singular values
-
-    for (int i = 0; i < 3; i++)
-    {
-        if (fabs(Fhat(i, i)) < 1E-4)
-        {
-            position = i;
-            count++;
-        }
-    }
-
-    if (count > 0)
-    {
-        // If more than one singular value is small the element has collapsed
-        // to a line or point. To fix set U to identity.
-        if (count > 1)
-        {
-            U.setIdentity();
-        }
-        else
-        {
-            U = F * V;
-
-            for (int i = 0; i < 3; i++)
-            {
-                if (i != position)
-                {
-                    for (int j = 0; j < 3; j++)
-                    {
-                        U(j, i) *= 1.0 / Fhat(i, i);
-                    }
-                }
-            }
-
-            // Replace column of U associated with small singular value with
-            // new basis orthogonal to other columns of U
-            Eigen::Matrix<double, 3, 1, 2> v[2];
-            int                            index = 0;
-            for (int i = 0; i < 3; i++)
-            {
-                if (i != position)
-                {
-                    v[index++] = Eigen::Matrix<double, 3, 1, 2>(U(0, i), U(1, i), U(2, i));
-                }
-            }
-
-            Vec3d vec = v[0].cross(v[1]).normalized();
-            U.col(position) = vec;
-        }
-    }
-    else // No modificaitons required: U = FV\hat{F}^{-1}
-    {
-        Mat3d FhatInv(Fhat.inverse());
-        U = F * V * FhatInv;
-    }
-
-    // If detU is negative, then U includes a reflection.
-    double detU = U.determinant();
-
-    if (detU < 0.0)
-    {
-        int    position  = 0;
-        double minLambda = IMSTK_DOUBLE_MAX;
-        for (int i = 0; i < 3; i++)
-        {
-            if (Fhat(i, i) < minLambda)
-            {
-                position  = i;
-                minLambda = Fhat(i, i);
-            }
-        }
-
-        // Invert values of smallest singular value and associated column of U
-        // This "pushes" the node nearest the uninverted state towards the uninverted state
-        Fhat(position, position) *= -1.0;
-        for (int i = 0; i < 3; i++)
-        {
-            U(i, position) *= -1.0;
-        }
-    }
+    // Rotation variant SVD of F, U and V are rotations and the smallest singular value
+    // is negated when F is inverted. F = U\hat{F} V^{T}
+    Mat3x3 V;
+    Vec3   sigma;
+    svd3x3(F, U, sigma, V);
+    Fhat = sigma.asDiagonal();
+    VT   = V.transpose();
 
     // Clamp small singular values of Fhat
-    double clamp = 0.577;
+    const T clamp = T(0.577);
     for (int i = 0; i < 3; i++)
     {
         if (Fhat(i, i) < clamp)
@@ -322,4 +221,25 @@ PbdFemTetConstraint::handleInversions(
         }
     }
 } // end handle tet inversion
+
+bool
+PbdFemTetConstraint::computeValueAndGradient(
+    const VecDataArray<double, 3>& currVertexPositions,
+    double& cval,
+    std::vector<Vec3d>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, cval, dcdx);
+}
+
+bool
+PbdFemTetConstraint::computeValueAndGradient(
+    const VecDataArray<float, 3>& currVertexPositions,
+    float& cval,
+    std::vector<Vec3f>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, cval, dcdx);
+}
+
+template void PbdFemTetConstraint::handleInversions<double>(Mat3d&, Mat3d&, Mat3d&, Mat3d&) const;
+template void PbdFemTetConstraint::handleInversions<float>(Mat3f&, Mat3f&, Mat3f&, Mat3f&) const;
 }; // namespace imstk
\ No newline at end of file
@@ -38,15 +38,23 @@ public:
         double& c,
         std::vector<Vec3d>& dcdx) const override;
 
+    bool computeValueAndGradient(
+        const VecDataArray<float, 3>& currVertexPositions,
+        float& c,
+        std::vector<Vec3f>& dcdx) const override;
+
+    bool supportsSinglePrecision() const override { return true; }
+
     ///
     /// \brief Handle inverted tets with the method described by Irving et. al. in
     /// "Invertible Finite Elements For Robust Simulation of Large Deformation"
     ///
+    template<typename T>
     void handleInversions(
-        Mat3d& F,
-        Mat3d& U,
-        Mat3d& Fhat,
-        Mat3d& VT
+        Eigen::Matrix<T, 3, 3>& F,
+        Eigen::Matrix<T, 3, 3>& U,
+        Eigen::Matrix<T, 3, 3>& Fhat,
+        Eigen::Matrix<T, 3, 3>& VT
         ) const;
 
     ///
@@ -56,6 +64,13 @@ public:
     bool getInverstionHandling() const { return m_handleInversions; }
 ///@}
 
+protected:
+    template<typename T>
+    bool computeValueAndGradientImpl(
+        const VecDataArray<T, 3>& currVertexPositions,
+        T& c,
+        std::vector<Eigen::Matrix<T, 3, 1>>& dcdx) const;
+
 private:
     bool m_handleInversions = true;
 };
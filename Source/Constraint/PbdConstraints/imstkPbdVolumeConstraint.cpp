@@ -30,31 +30,50 @@ PbdVolumeConstraint::initConstraint(const VecDataArray<double, 3>& initVertexPos
     m_restVolume = (1.0 / 6.0) * ((p1 - p0).cross(p2 - p0)).dot(p3 - p0);
 }
 
+template<typename T>
 bool
-PbdVolumeConstraint::computeValueAndGradient(
-    const VecDataArray<double, 3>& currVertexPositions,
-    double& c,
-    std::vector<Vec3d>& dcdx) const
+PbdVolumeConstraint::computeValueAndGradientImpl(
+    const VecDataArray<T, 3>& currVertexPositions,
+    T& c,
+    std::vector<Eigen::Matrix<T, 3, 1>>& dcdx) const
 {
     const auto i0 = m_vertexIds[0];
     const auto i1 = m_vertexIds[1];
     const auto i2 = m_vertexIds[2];
     const auto i3 = m_vertexIds[3];
 
-    const Vec3d& x0 = currVertexPositions[i0];
-    const Vec3d& x1 = currVertexPositions[i1];
-    const Vec3d& x2 = currVertexPositions[i2];
-    const Vec3d& x3 = currVertexPositions[i3];
+    const Eigen::Matrix<T, 3, 1>& x0 = currVertexPositions[i0];
+    const Eigen::Matrix<T, 3, 1>& x1 = currVertexPositions[i1];
+    const Eigen::Matrix<T, 3, 1>& x2 = currVertexPositions[i2];
+    const Eigen::Matrix<T, 3, 1>& x3 = currVertexPositions[i3];
 
-    const double onesixth = 1.0 / 6.0;
+    const T onesixth = T(1) / T(6);
 
     dcdx[0] = onesixth * (x1 - x2).cross(x3 - x1);
     dcdx[1] = onesixth * (x2 - x0).cross(x3 - x0);
     dcdx[2] = onesixth * (x3 - x0).cross(x1 - x0);
     dcdx[3] = onesixth * (x1 - x0).cross(x2 - x0);
 
-    const double volume = dcdx[3].dot(x3 - x0);
-    c = (volume - m_restVolume);
+    const T volume = dcdx[3].dot(x3 - x0);
+    c = (volume - static_cast<T>(m_restVolume));
     return true;
 }
+
+bool
+PbdVolumeConstraint::computeValueAndGradient(
+    const VecDataArray<double, 3>& currVertexPositions,
+    double& c,
+    std::vector<Vec3d>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, c, dcdx);
+}
+
+bool
+PbdVolumeConstraint::computeValueAndGradient(
+    const VecDataArray<float, 3>& currVertexPositions,
+    float& c,
+    std::vector<Vec3f>& dcdx) const
+{
+    return computeValueAndGradientImpl(currVertexPositions, c, dcdx);
+}
 } // namespace imstk
\ No newline at end of file
@@ -0,0 +1,71 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkPbdConstantDensityConstraint.h"
+
+using namespace imstk;
+
+///
+/// \brief Creates a jittered block of particles
+///
+static VecDataArray<double, 3>
+makeParticleBlock(const int dim, const double spacing)
+{
+    VecDataArray<double, 3> positions;
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                const double jitter = 0.1 * spacing * std::sin(x * 1.3 + y * 2.1 + z * 0.7);
+                positions.push_back(Vec3d(x, y, z) * spacing + Vec3d(jitter, -jitter, 0.5 * jitter));
+            }
+        }
+    }
+    return positions;
+}
+
+///
+/// \brief Test that reusing neighbors with a skin gives the same projection as
+/// searching them every time, with fewer searches
+///
+TEST(imstkPbdConstantDensityConstraintTest, TestNeighborSkin)
+{
+    const double            particleRadius = 0.2;
+    VecDataArray<double, 3> positionsA     = makeParticleBlock(6, 0.08);
+    VecDataArray<double, 3> positionsB     = makeParticleBlock(6, 0.08);
+    DataArray<double>       invMasses(positionsA.size());
+    invMasses.fill(1.0);
+
+    PbdConstantDensityConstraint constraintA;
+    constraintA.initConstraint(positionsA, particleRadius, 1000.0);
+
+    PbdConstantDensityConstraint constraintB;
+    constraintB.setNeighborSkin(0.1);
+    constraintB.initConstraint(positionsB, particleRadius, 1000.0);
+
+    for (int i = 0; i < 10; i++)
+    {
+        constraintA.projectConstraint(invMasses, 0.01, PbdConstraint::SolverType::PBD, positionsA);
+        constraintB.projectConstraint(invMasses, 0.01, PbdConstraint::SolverType::PBD, positionsB);
+    }
+
+    for (int i = 0; i < positionsA.size(); i++)
+    {
+        EXPECT_NEAR(positionsA[i][0], positionsB[i][0], 1.0e-10);
+        EXPECT_NEAR(positionsA[i][1], positionsB[i][1], 1.0e-10);
+        EXPECT_NEAR(positionsA[i][2], positionsB[i][2], 1.0e-10);
+    }
+
+    // The block must have been moved for the test to mean anything
+    EXPECT_GT((positionsA[0] - makeParticleBlock(6, 0.08)[0]).norm(), 1.0e-6);
+
+    EXPECT_EQ(10, constraintA.getNumNeighborSearches());
+    EXPECT_LT(constraintB.getNumNeighborSearches(), 10);
+}
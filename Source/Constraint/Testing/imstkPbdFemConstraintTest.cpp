@@ -192,4 +192,66 @@ TEST(imstkPbdFemConstraintTest, TestTetInversionCorotational)
     auto  detF = F.determinant();
 
     EXPECT_TRUE(detF > 0);
-}
\ No newline at end of file
+
+}
+///
+/// \brief Test that projecting in single precision follows the double precision
+/// solution for every material
+///
+TEST(imstkPbdFemConstraintTest, TestSinglePrecision)
+{
+    auto femConfig = std::make_shared<PbdFemConstraintConfig>(344.82, 3103.44, 1000.0, 0.45);
+
+    for (const PbdFemConstraint::MaterialType material : {
+            PbdFemConstraint::MaterialType::StVK,
+            PbdFemConstraint::MaterialType::Corotation,
+            PbdFemConstraint::MaterialType::NeoHookean })
+    {
+        PbdFemTetConstraint constraint(material);
+        PbdFemTetConstraint constraintf(material);
+        EXPECT_TRUE(constraintf.supportsSinglePrecision());
+
+        DataArray<double> invMasses(4);
+        DataArray<float>  invMassesf(4);
+        invMasses.fill(1.0);
+        invMassesf.fill(1.0f);
+
+        VecDataArray<double, 3> verts(4);
+        verts[0] = Vec3d(0.5, 0.0, -1.0 / 3.0);
+        verts[1] = Vec3d(-0.5, 0.0, -1.0 / 3.0);
+        verts[2] = Vec3d(0.0, 0.0, 2.0 / 3.0);
+        verts[3] = Vec3d(0.0, 1.0, 0.0);
+        constraint.initConstraint(verts, 0, 1, 2, 3, femConfig);
+        constraintf.initConstraint(verts, 0, 1, 2, 3, femConfig);
+
+        // Stretch the tet
+        verts[3] += Vec3d(0.1, 0.3, -0.1);
+        VecDataArray<float, 3> vertsf(4);
+        for (int i = 0; i < 4; i++)
+        {
+            vertsf[i] = verts[i].cast<float>();
+        }
+
+        double             c;
+        float              cf;
+        std::vector<Vec3d> dcdx(4);
+        std::vector<Vec3f> dcdxf(4);
+        ASSERT_TRUE(constraint.computeValueAndGradient(verts, c, dcdx));
+        ASSERT_TRUE(constraintf.computeValueAndGradient(vertsf, cf, dcdxf));
+        EXPECT_NEAR(c, cf, 1.0e-4 * std::abs(c));
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_LT((dcdx[i] - dcdxf[i].cast<double>()).norm(), 1.0e-4 * dcdx[i].norm() + 1.0e-6);
+        }
+
+        for (int step = 0; step < 10; step++)
+        {
+            constraint.projectConstraint(invMasses, 0.01, PbdConstraint::SolverType::xPBD, verts);
+            constraintf.projectConstraint(invMassesf, 0.01f, PbdConstraint::SolverType::xPBD, vertsf);
+        }
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_LT((verts[i] - vertsf[i].cast<double>()).norm(), 1.0e-4);
+        }
+    }
+}
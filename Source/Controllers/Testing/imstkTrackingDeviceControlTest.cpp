@@ -21,11 +21,13 @@ public:
     void setPosition(const Vec3d& position)
     {
         m_position = position;
+        publishState();
     }
 
     void setOrientation(const Quatd& orientation)
     {
         m_orientation = orientation;
+        publishState();
     }
 };
 
@@ -178,4 +180,28 @@ TEST_F(TrackingDeviceControlTest, TranslationOffset)
     EXPECT_TRUE(expectedRot.isApprox(control.getOrientation()))
         << "Expected: " << expectedRot.coeffs().transpose()
         << " Actual: " << control.getOrientation().coeffs().transpose();
-}
\ No newline at end of file
+}
+
+TEST_F(TrackingDeviceControlTest, ToDevicePosition)
+{
+    control.setTranslationOffset(Vec3d(4.0, 5.0, 6.0));
+    control.setRotationOffset(Quatd(Rotd(PI_2, Vec3d(0.0, 1.0, 0.0))));
+    control.setTranslationScaling(2.0);
+    control.setInversionFlags(TrackingDeviceControl::InvertFlag::transX);
+
+    auto pos = Vec3d(1.0, 2.0, 3.0);
+    client->setPosition(pos);
+    control.updateTrackingData(0.0);
+
+    // Mapping the virtual position back should give the physical one
+    EXPECT_TRUE(pos.isApprox(control.toDevicePosition(control.getPosition())))
+        << "Expected: " << pos.transpose()
+        << " Actual: " << control.toDevicePosition(control.getPosition()).transpose();
+
+    // Vectors are not offset by the translation
+    const Vec3d disp = Vec3d(0.5, -1.0, 2.0);
+    const Vec3d expectedDisp = control.toDevicePosition(control.getPosition() + disp) - pos;
+    EXPECT_TRUE(expectedDisp.isApprox(control.toDeviceVector(disp)))
+        << "Expected: " << expectedDisp.transpose()
+        << " Actual: " << control.toDeviceVector(disp).transpose();
+}
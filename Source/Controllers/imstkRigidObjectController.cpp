@@ -131,7 +131,18 @@ RigidObjectController::applyForces()
     if (!m_deviceClient->getButton(0))
     {
         // Apply force back to device
-        if (m_rigidObject != nullptr && m_useSpring)
+        if (m_rigidObject != nullptr && m_useSpring && m_useForceProxy)
+        {
+            // Spring between device and body in device space, distances there are 1/scaling
+            // of those in virtual space so the stiffness is scaled to give the same force
+            const double scale = m_forceScaling * m_scaling;
+            m_deviceClient->setForceProxy(
+                toDevicePosition(m_rigidObject->getRigidBody()->getPosition()),
+                toDeviceVector(m_rigidObject->getRigidBody()->getVelocity()),
+                m_linearKs.maxCoeff() * scale, m_linearKd * scale);
+            m_deviceClient->setForce(Vec3d(0.0, 0.0, 0.0));
+        }
+        else if (m_rigidObject != nullptr && m_useSpring)
         {
             const Vec3d force = -getDeviceForce();
             if (m_forceSmoothening)
@@ -157,6 +168,7 @@ RigidObjectController::applyForces()
     }
     else
     {
+        m_deviceClient->disableForceProxy();
         m_deviceClient->setForce(Vec3d(0.0, 0.0, 0.0));
     }
 }
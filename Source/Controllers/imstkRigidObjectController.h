@@ -82,6 +82,17 @@ public:
     void setUseForceSmoothening(const bool useForceSmoothening) { m_forceSmoothening = useForceSmoothening; }
     ///@}
 
+    ///
+    /// \brief Set/Get whether to render force through a proxy on the device (default off)
+    /// When on, instead of setting a force each simulation step the device client is
+    /// given the position and velocity of the body to couple against. The device thread
+    /// then evaluates the spring at its own rate with its latest pose, this avoids the
+    /// force being stale between simulation steps. Force smoothening is not used
+    ///@{
+    bool getUseForceProxy() const { return m_useForceProxy; }
+    void setUseForceProxy(const bool useForceProxy) { m_useForceProxy = useForceProxy; }
+    ///@}
+
     ///
     /// \brief Set/Get whether to use critical damping (default on)
     /// Critical damping automatically computes linear & angular kd values. It may be turned
@@ -159,6 +170,7 @@ protected:
     double m_forceScaling       = 0.0000075;
     bool   m_useSpring          = true; ///< If off, pos & orientation directly set
     bool   m_useCriticalDamping = true; ///< If on, kd is automatically computed
+    bool   m_useForceProxy      = false; ///< If on, the device renders force from a proxy
 
     bool m_forceSmoothening    = true;
     int  m_smoothingKernelSize = 15;
@@ -95,6 +95,31 @@ TrackingDeviceControl::updateTrackingData(const double dt)
     return true;
 }
 
+Vec3d
+TrackingDeviceControl::toDevicePosition(const Vec3d& pos) const
+{
+    return toDeviceVector(pos - m_translationOffset);
+}
+
+Vec3d
+TrackingDeviceControl::toDeviceVector(const Vec3d& vec) const
+{
+    Vec3d deviceVec = m_rotationOffset.inverse() * vec / m_scaling;
+    if (m_invertFlags & InvertFlag::transX)
+    {
+        deviceVec[0] = -deviceVec[0];
+    }
+    if (m_invertFlags & InvertFlag::transY)
+    {
+        deviceVec[1] = -deviceVec[1];
+    }
+    if (m_invertFlags & InvertFlag::transZ)
+    {
+        deviceVec[2] = -deviceVec[2];
+    }
+    return deviceVec;
+}
+
 const imstk::Vec3d&
 TrackingDeviceControl::getPosition() const
 {
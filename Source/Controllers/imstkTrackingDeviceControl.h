@@ -123,6 +123,15 @@ public:
     void setInversionFlags(const unsigned char f);
     ///@}
 
+    ///
+    /// \brief Map a position/vector given in virtual space back to the physical device
+    /// space. This is the inverse of the inversions, scaling and offsets applied to the
+    /// tracking data, ie: for giving the device a target in its own coordinates
+    ///@{
+    Vec3d toDevicePosition(const Vec3d& pos) const;
+    Vec3d toDeviceVector(const Vec3d& vec) const;
+    ///@}
+
     ///
     /// \brief Update tracking data
     ///
@@ -0,0 +1,294 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBVH.h"
+#include "imstkMath.h"
+#include "imstkVecDataArray.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Creates a wavy triangulated sheet in the xz plane
+/// \param dimension of the vertex grid
+/// \param vertices output vertices
+/// \param cells output triangles
+/// \param height offset of the sheet
+///
+static void
+makeSheet(const int dim,
+          std::shared_ptr<VecDataArray<double, 3>>& vertices,
+          std::shared_ptr<VecDataArray<int, 3>>& cells,
+          const double height = 0.0)
+{
+    vertices = std::make_shared<VecDataArray<double, 3>>(dim * dim);
+    cells    = std::make_shared<VecDataArray<int, 3>>();
+    cells->reserve((dim - 1) * (dim - 1) * 2);
+
+    const double dx = 1.0 / (dim - 1);
+    for (int y = 0; y < dim; y++)
+    {
+        for (int x = 0; x < dim; x++)
+        {
+            (*vertices)[x + dim * y] = Vec3d(x * dx, height + 0.05 * std::sin(x * dx * 20.0) * std::cos(y * dx * 20.0), y * dx);
+        }
+    }
+    for (int y = 0; y < dim - 1; y++)
+    {
+        for (int x = 0; x < dim - 1; x++)
+        {
+            const int i0 = x + dim * y;
+            cells->push_back(Vec3i(i0, i0 + dim, i0 + 1));
+            cells->push_back(Vec3i(i0 + 1, i0 + dim, i0 + dim + 1));
+        }
+    }
+}
+
+///
+/// \brief Displaces the sheet, as a deforming mesh would each step
+///
+static void
+deformSheet(VecDataArray<double, 3>& vertices, const double t)
+{
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        vertices[i][1] += 0.001 * std::sin(vertices[i][0] * 10.0 + t);
+    }
+}
+
+///
+/// \brief Full binned SAH build of the tree
+///
+static void
+BM_Build(benchmark::State& state)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeSheet(state.range(0), vertices, cells);
+
+    BVH<3> bvh;
+    bvh.setParallel(state.range(1) == 1);
+
+    state.counters["Triangles"] = cells->size();
+    for (auto _ : state)
+    {
+        bvh.build(vertices, cells);
+    }
+    state.counters["Depth"] = bvh.computeDepth();
+    state.counters["Nodes"] = static_cast<double>(bvh.getNodes().size());
+}
+
+BENCHMARK(BM_Build)
+->Unit(benchmark::kMillisecond)
+->Name("BVH Build")
+->ArgsProduct({ { 32, 128, 512 }, { 0, 1 } });
+
+///
+/// \brief Refit of a deforming mesh
+///
+static void
+BM_Refit(benchmark::State& state)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeSheet(state.range(0), vertices, cells);
+
+    BVH<3> bvh;
+    bvh.setParallel(state.range(1) == 1);
+    bvh.build(vertices, cells);
+
+    state.counters["Triangles"] = cells->size();
+    double t = 0.0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        deformSheet(*vertices, t);
+        t += 0.01;
+        state.ResumeTiming();
+
+        bvh.refit();
+    }
+}
+
+BENCHMARK(BM_Refit)
+->Unit(benchmark::kMillisecond)
+->Name("BVH Refit")
+->ArgsProduct({ { 32, 128, 512 }, { 0, 1 } });
+
+///
+/// \brief Box queries spread over the sheet
+///
+static void
+BM_QueryOverlap(benchmark::State& state)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeSheet(state.range(0), vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+
+    const int numQueries = 1000;
+    int       numHits    = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < numQueries; i++)
+        {
+            const Vec3d center(static_cast<double>(i % 32) / 32.0, 0.0, static_cast<double>(i / 32) / 32.0);
+            bvh.queryOverlap(center - Vec3d::Constant(0.01), center + Vec3d::Constant(0.01),
+                [&](const int) { numHits++; });
+        }
+    }
+    benchmark::DoNotOptimize(numHits);
+    state.counters["Triangles"] = cells->size();
+    state.counters["Queries"]   = numQueries;
+}
+
+BENCHMARK(BM_QueryOverlap)
+->Unit(benchmark::kMillisecond)
+->Name("BVH Box Queries")
+->Args({ 32 })->Args({ 128 })->Args({ 512 });
+
+///
+/// \brief Rays cast down onto the sheet against the triangle boxes
+///
+static void
+BM_QueryRay(benchmark::State& state)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeSheet(state.range(0), vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+
+    const int   numQueries = 1000;
+    const Vec3d dir(0.01, -1.0, 0.02);
+    int         numHits = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < numQueries; i++)
+        {
+            const Vec3d origin(static_cast<double>(i % 32) / 32.0, 1.0, static_cast<double>(i / 32) / 32.0);
+            double      t = IMSTK_DOUBLE_MAX;
+            // Hit the plane through the first vertex of the triangle
+            const int hitId = bvh.queryRay(origin, dir,
+                [&](const int cellId) { return (origin[1] - (*vertices)[(*cells)[cellId][0]][1]) / -dir[1]; }, t);
+            numHits += (hitId != -1) ? 1 : 0;
+        }
+    }
+    benchmark::DoNotOptimize(numHits);
+    state.counters["Triangles"] = cells->size();
+    state.counters["Queries"]   = numQueries;
+}
+
+BENCHMARK(BM_QueryRay)
+->Unit(benchmark::kMillisecond)
+->Name("BVH Ray Queries")
+->Args({ 32 })->Args({ 128 })->Args({ 512 });
+
+///
+/// \brief Closest vertex of the triangles to points above the sheet
+///
+static void
+BM_QueryClosest(benchmark::State& state)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeSheet(state.range(0), vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+
+    const int numQueries = 1000;
+    int       sum = 0;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < numQueries; i++)
+        {
+            const Vec3d pos(static_cast<double>(i % 32) / 32.0, 0.2, static_cast<double>(i / 32) / 32.0);
+            sum += bvh.queryClosest(pos, [&](const int cellId)
+                {
+                    return ((*vertices)[(*cells)[cellId][0]] - pos).squaredNorm();
+                });
+        }
+    }
+    benchmark::DoNotOptimize(sum);
+    state.counters["Triangles"] = cells->size();
+    state.counters["Queries"]   = numQueries;
+}
+
+BENCHMARK(BM_QueryClosest)
+->Unit(benchmark::kMillisecond)
+->Name("BVH Closest Queries")
+->Args({ 32 })->Args({ 128 })->Args({ 512 });
+
+///
+/// \brief All overlapping pairs of the sheet with itself, adjacent triangles included
+///
+static void
+BM_QuerySelfOverlap(benchmark::State& state)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeSheet(state.range(0), vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+
+    const bool       doParallel = (state.range(1) == 1);
+    std::atomic<int> numPairs   = { 0 };
+    for (auto _ : state)
+    {
+        numPairs = 0;
+        bvh.querySelfOverlap([&](const int, const int) { numPairs++; }, doParallel);
+    }
+    state.counters["Triangles"] = cells->size();
+    state.counters["Pairs"]     = numPairs.load();
+}
+
+BENCHMARK(BM_QuerySelfOverlap)
+->Unit(benchmark::kMillisecond)
+->Name("BVH Self Overlap")
+->ArgsProduct({ { 32, 128, 512 }, { 0, 1 } });
+
+///
+/// \brief All overlapping pairs of two close sheets
+///
+static void
+BM_QueryTreeOverlap(benchmark::State& state)
+{
+    std::shared_ptr<VecDataArray<double, 3>> verticesA;
+    std::shared_ptr<VecDataArray<int, 3>>    cellsA;
+    makeSheet(state.range(0), verticesA, cellsA);
+    std::shared_ptr<VecDataArray<double, 3>> verticesB;
+    std::shared_ptr<VecDataArray<int, 3>>    cellsB;
+    makeSheet(state.range(0), verticesB, cellsB, 0.01);
+
+    BVH<3> bvhA;
+    bvhA.build(verticesA, cellsA);
+    BVH<3> bvhB;
+    bvhB.build(verticesB, cellsB);
+
+    const bool       doParallel = (state.range(1) == 1);
+    std::atomic<int> numPairs   = { 0 };
+    for (auto _ : state)
+    {
+        numPairs = 0;
+        bvhA.queryOverlap(bvhB, [&](const int, const int) { numPairs++; }, doParallel);
+    }
+    state.counters["Triangles"] = cellsA->size() * 2;
+    state.counters["Pairs"]     = numPairs.load();
+}
+
+BENCHMARK(BM_QueryTreeOverlap)
+->Unit(benchmark::kMillisecond)
+->Name("BVH Tree vs Tree Overlap")
+->ArgsProduct({ { 32, 128, 512 }, { 0, 1 } });
+
+// Run the benchmark
+BENCHMARK_MAIN();
@@ -0,0 +1,330 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBVH.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Generates a triangle soup of small random triangles in the unit cube
+///
+void
+makeTriangleSoup(const int numTris, const unsigned int seed,
+                 std::shared_ptr<VecDataArray<double, 3>>& vertices,
+                 std::shared_ptr<VecDataArray<int, 3>>& cells)
+{
+    std::mt19937                           gen(seed);
+    std::uniform_real_distribution<double> posDist(0.0, 1.0);
+    std::uniform_real_distribution<double> offsetDist(-0.05, 0.05);
+
+    vertices = std::make_shared<VecDataArray<double, 3>>(numTris * 3);
+    cells    = std::make_shared<VecDataArray<int, 3>>(numTris);
+    for (int i = 0; i < numTris; i++)
+    {
+        const Vec3d center(posDist(gen), posDist(gen), posDist(gen));
+        for (int j = 0; j < 3; j++)
+        {
+            (*vertices)[i * 3 + j] = center + Vec3d(offsetDist(gen), offsetDist(gen), offsetDist(gen));
+        }
+        (*cells)[i] = Vec3i(i * 3, i * 3 + 1, i * 3 + 2);
+    }
+}
+
+void
+computeCellBounds(const VecDataArray<double, 3>& vertices, const Vec3i& cell, Vec3d& min, Vec3d& max)
+{
+    min = vertices[cell[0]].cwiseMin(vertices[cell[1]]).cwiseMin(vertices[cell[2]]);
+    max = vertices[cell[0]].cwiseMax(vertices[cell[1]]).cwiseMax(vertices[cell[2]]);
+}
+
+std::vector<std::pair<int, int>>
+sortPairs(std::vector<std::pair<int, int>> pairs)
+{
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+} // namespace
+
+TEST(imstkBVHTest, BuildStructure)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeTriangleSoup(1000, 0, vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+    EXPECT_EQ(bvh.getNumPrimitives(), 1000);
+
+    // Every primitive is in exactly one leaf, and every leaf is within its parents
+    std::vector<int> numRefs(1000, 0);
+    const std::vector<BVHNode>& nodes = bvh.getNodes();
+    for (const BVHNode& node : nodes)
+    {
+        if (node.isLeaf())
+        {
+            EXPECT_LE(node.count, bvh.getMaxLeafSize());
+            for (int i = node.first; i < node.first + node.count; i++)
+            {
+                numRefs[bvh.getPrimitiveIds()[i]]++;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < 2; i++)
+            {
+                const BVHNode& child = nodes[node.first + i];
+                EXPECT_TRUE((child.min.array() >= node.min.array()).all());
+                EXPECT_TRUE((child.max.array() <= node.max.array()).all());
+            }
+        }
+    }
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_EQ(numRefs[i], 1);
+    }
+    EXPECT_LT(bvh.computeDepth(), 30);
+}
+
+TEST(imstkBVHTest, QueryOverlap)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeTriangleSoup(2000, 1, vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+
+    const Vec3d queryMin(0.2, 0.3, 0.1);
+    const Vec3d queryMax(0.5, 0.6, 0.4);
+    std::vector<int> results;
+    bvh.queryOverlap(queryMin, queryMax, results);
+    std::sort(results.begin(), results.end());
+
+    std::vector<int> expected;
+    for (int i = 0; i < cells->size(); i++)
+    {
+        Vec3d min, max;
+        computeCellBounds(*vertices, (*cells)[i], min, max);
+        if (BVH<3>::testOverlap(min, max, queryMin, queryMax))
+        {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(results, expected);
+}
+
+TEST(imstkBVHTest, Refit)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeTriangleSoup(500, 2, vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+
+    // Move everything, the tree should follow after a refit
+    for (int i = 0; i < vertices->size(); i++)
+    {
+        (*vertices)[i] += Vec3d(2.0, 0.0, 0.0);
+    }
+    bvh.refit();
+    EXPECT_GE(bvh.getNodes()[0].min[0], 1.9);
+
+    std::vector<int> results;
+    bvh.queryOverlap(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.5, 2.0, 2.0), results);
+    EXPECT_TRUE(results.empty());
+    bvh.queryOverlap(Vec3d(1.5, -1.0, -1.0), Vec3d(4.0, 2.0, 2.0), results);
+    EXPECT_EQ(results.size(), 500);
+}
+
+TEST(imstkBVHTest, QueryClosestPoints)
+{
+    auto                   vertices = std::make_shared<VecDataArray<double, 3>>(1000);
+    auto                   cells    = std::make_shared<VecDataArray<int, 1>>(1000);
+    std::mt19937           gen(3);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (int i = 0; i < 1000; i++)
+    {
+        (*vertices)[i] = Vec3d(dist(gen), dist(gen), dist(gen));
+        (*cells)[i]    = Eigen::Matrix<int, 1, 1>(i);
+    }
+
+    BVH<1> bvh;
+    bvh.build(vertices, cells);
+
+    for (int k = 0; k < 20; k++)
+    {
+        const Vec3d pos(dist(gen) * 2.0, dist(gen) * 2.0, dist(gen) * 2.0);
+        const int   closestId = bvh.queryClosest(pos,
+            [&](const int cellId) { return ((*vertices)[cellId] - pos).squaredNorm(); });
+
+        int    expectedId = -1;
+        double minDistSqr = IMSTK_DOUBLE_MAX;
+        for (int i = 0; i < 1000; i++)
+        {
+            const double distSqr = ((*vertices)[i] - pos).squaredNorm();
+            if (distSqr < minDistSqr)
+            {
+                minDistSqr = distSqr;
+                expectedId = i;
+            }
+        }
+        EXPECT_EQ(closestId, expectedId);
+    }
+}
+
+TEST(imstkBVHTest, QueryRay)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeTriangleSoup(2000, 4, vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+
+    // Ray against the boxes of the primitives, the nearest entry should match brute force
+    const Vec3d origin(-1.0, 0.45, 0.55);
+    const Vec3d dir(1.0, 0.01, -0.02);
+    const Vec3d invDir(1.0 / dir[0], 1.0 / dir[1], 1.0 / dir[2]);
+    auto        rayBoxFunc = [&](const int cellId)
+                             {
+                                 Vec3d min, max;
+                                 computeCellBounds(*vertices, (*cells)[cellId], min, max);
+                                 const Vec3d  t0   = (min - origin).cwiseProduct(invDir);
+                                 const Vec3d  t1   = (max - origin).cwiseProduct(invDir);
+                                 const double tMin = t0.cwiseMin(t1).maxCoeff();
+                                 const double tMax = t0.cwiseMax(t1).minCoeff();
+                                 return (tMin <= tMax && tMax >= 0.0) ? std::max(tMin, 0.0) : -1.0;
+                             };
+
+    double    t     = IMSTK_DOUBLE_MAX;
+    const int hitId = bvh.queryRay(origin, dir, rayBoxFunc, t);
+
+    int    expectedId = -1;
+    double expectedT  = IMSTK_DOUBLE_MAX;
+    for (int i = 0; i < cells->size(); i++)
+    {
+        const double tHit = rayBoxFunc(i);
+        if (tHit >= 0.0 && tHit < expectedT)
+        {
+            expectedT  = tHit;
+            expectedId = i;
+        }
+    }
+    ASSERT_NE(expectedId, -1);
+    EXPECT_EQ(hitId, expectedId);
+    EXPECT_DOUBLE_EQ(t, expectedT);
+}
+
+TEST(imstkBVHTest, QuerySelfOverlap)
+{
+    std::shared_ptr<VecDataArray<double, 3>> vertices;
+    std::shared_ptr<VecDataArray<int, 3>>    cells;
+    makeTriangleSoup(1500, 5, vertices, cells);
+
+    BVH<3> bvh;
+    bvh.build(vertices, cells);
+
+    std::vector<std::pair<int, int>> expected;
+    for (int i = 0; i < cells->size(); i++)
+    {
+        Vec3d minA, maxA;
+        computeCellBounds(*vertices, (*cells)[i], minA, maxA);
+        for (int j = i + 1; j < cells->size(); j++)
+        {
+            Vec3d minB, maxB;
+            computeCellBounds(*vertices, (*cells)[j], minB, maxB);
+            if (BVH<3>::testOverlap(minA, maxA, minB, maxB))
+            {
+                expected.push_back({ i, j });
+            }
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+
+    std::vector<std::pair<int, int>> results;
+    bvh.querySelfOverlap([&](const int a, const int b)
+        {
+            results.push_back({ std::min(a, b), std::max(a, b) });
+        });
+    EXPECT_EQ(sortPairs(results), expected);
+
+    // Parallel
+    results.clear();
+    ParallelUtils::SpinLock lock;
+    bvh.querySelfOverlap([&](const int a, const int b)
+        {
+            lock.lock();
+            results.push_back({ std::min(a, b), std::max(a, b) });
+            lock.unlock();
+        }, true);
+    EXPECT_EQ(sortPairs(results), expected);
+}
+
+TEST(imstkBVHTest, QueryTreeOverlap)
+{
+    std::shared_ptr<VecDataArray<double, 3>> verticesA;
+    std::shared_ptr<VecDataArray<int, 3>>    cellsA;
+    makeTriangleSoup(1000, 6, verticesA, cellsA);
+
+    // Line segments
+    auto                                   verticesB = std::make_shared<VecDataArray<double, 3>>(1000);
+    auto                                   cellsB    = std::make_shared<VecDataArray<int, 2>>(500);
+    std::mt19937                           gen(7);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    for (int i = 0; i < 500; i++)
+    {
+        const Vec3d pos(dist(gen), dist(gen), dist(gen));
+        (*verticesB)[i * 2]     = pos;
+        (*verticesB)[i * 2 + 1] = pos + Vec3d(0.05, 0.02, 0.0);
+        (*cellsB)[i] = Vec2i(i * 2, i * 2 + 1);
+    }
+
+    BVH<3> bvhA;
+    bvhA.build(verticesA, cellsA);
+    BVH<2> bvhB;
+    bvhB.build(verticesB, cellsB);
+
+    std::vector<std::pair<int, int>> expected;
+    for (int i = 0; i < cellsA->size(); i++)
+    {
+        Vec3d minA, maxA;
+        computeCellBounds(*verticesA, (*cellsA)[i], minA, maxA);
+        for (int j = 0; j < cellsB->size(); j++)
+        {
+            const Vec2i& cell = (*cellsB)[j];
+            const Vec3d  minB = (*verticesB)[cell[0]].cwiseMin((*verticesB)[cell[1]]);
+            const Vec3d  maxB = (*verticesB)[cell[0]].cwiseMax((*verticesB)[cell[1]]);
+            if (BVH<3>::testOverlap(minA, maxA, minB, maxB))
+            {
+                expected.push_back({ i, j });
+            }
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+
+    std::vector<std::pair<int, int>> results;
+    bvhA.queryOverlap(bvhB, [&](const int a, const int b) { results.push_back({ a, b }); });
+    EXPECT_EQ(sortPairs(results), expected);
+
+    results.clear();
+    ParallelUtils::SpinLock lock;
+    bvhA.queryOverlap(bvhB, [&](const int a, const int b)
+        {
+            lock.lock();
+            results.push_back({ a, b });
+            lock.unlock();
+        }, true);
+    EXPECT_EQ(sortPairs(results), expected);
+}
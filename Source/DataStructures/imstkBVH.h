@@ -0,0 +1,805 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+#include "imstkParallelUtils.h"
+#include "imstkVecDataArray.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <utility>
+
+namespace imstk
+{
+///
+/// \struct BVHNode
+///
+/// \brief Node of a flat BVH. Internal nodes store the index of their first child,
+/// the second child always directly follows it. Leaves store a range into the
+/// primitive order of the tree.
+///
+struct BVHNode
+{
+    Vec3d min = Vec3d::Zero();
+    Vec3d max = Vec3d::Zero();
+    int first = 0; ///< First child if internal, first primitive if leaf
+    int count = 0; ///< Number of primitives, 0 for internal nodes
+
+    bool isLeaf() const { return count > 0; }
+};
+
+///
+/// \class BVH
+///
+/// \brief Axis aligned bounding box hierarchy over the cells of a mesh with N vertices
+/// per cell (1=points, 2=lines, 3=triangles, 4=tetrahedrons). Nodes live in a flat array,
+/// built top down with binned SAH in parallel. Deforming meshes may be refit without
+/// rebuilding, the topology of the tree is kept.
+///
+/// Queries are stack based and read only, they may be called from multiple threads. The
+/// exact primitive tests are left to the caller through functors, the tree only culls
+/// by bounding box.
+/// \tparam N number of vertices per cell
+///
+template<int N>
+class BVH
+{
+public:
+    using CellType = Eigen::Matrix<int, N, 1>;
+
+    static constexpr int MaxDepth = 60; ///< Deeper ranges are made leaves, bounds the traversal stacks
+    static constexpr int NumBins  = 12; ///< Number of bins for the SAH per axis
+
+    BVH() = default;
+    virtual ~BVH() = default;
+
+public:
+    ///
+    /// \brief Get/Set the maximum number of primitives in a leaf, default 4
+    ///@{
+    void setMaxLeafSize(const int maxLeafSize) { m_maxLeafSize = std::max(maxLeafSize, 1); }
+    int getMaxLeafSize() const { return m_maxLeafSize; }
+    ///@}
+
+    ///
+    /// \brief Get/Set the distance primitive boxes are padded with (ie: a thickness or
+    /// contact distance), default 0
+    ///@{
+    void setPadding(const double padding) { m_padding = padding; }
+    double getPadding() const { return m_padding; }
+    ///@}
+
+    ///
+    /// \brief Get/Set whether the build/refit may run in parallel, default true
+    ///@{
+    void setParallel(const bool parallel) { m_parallel = parallel; }
+    bool getParallel() const { return m_parallel; }
+    ///@}
+
+    ///
+    /// \brief Build the tree over the given cells, the arrays are kept for refits
+    ///
+    void build(std::shared_ptr<VecDataArray<double, 3>> vertices,
+               std::shared_ptr<VecDataArray<int, N>>    cells)
+    {
+        m_vertices     = vertices;
+        m_prevVertices = nullptr;
+        m_cells        = cells;
+        build();
+    }
+
+    ///
+    /// \brief Build the tree over the given mesh, ie: SurfaceMesh, LineMesh, TetrahedralMesh
+    ///
+    template<class MeshType>
+    void build(std::shared_ptr<MeshType> mesh)
+    {
+        static_assert(MeshType::CellVertexCount == N, "Mesh cell type does not match the tree");
+        build(mesh->getVertexPositions(), mesh->getCells());
+    }
+
+    ///
+    /// \brief Build the tree over the cells swept from previous to current vertices,
+    /// used for continuous collision detection
+    ///
+    void buildSwept(std::shared_ptr<VecDataArray<double, 3>> prevVertices,
+                    std::shared_ptr<VecDataArray<double, 3>> vertices,
+                    std::shared_ptr<VecDataArray<int, N>>    cells)
+    {
+        m_vertices     = vertices;
+        m_prevVertices = prevVertices;
+        m_cells        = cells;
+        build();
+    }
+
+    ///
+    /// \brief Rebuild the tree from the arrays given previously
+    ///
+    void build()
+    {
+        const int numPrims = (m_cells == nullptr) ? 0 : m_cells->size();
+        m_primIds.resize(numPrims);
+        m_primBounds.resize(numPrims);
+        m_nodes.clear();
+        m_nodeCount = 0;
+        if (numPrims == 0)
+        {
+            return;
+        }
+
+        std::vector<Vec3d> centroids(numPrims);
+        ParallelUtils::parallelFor(numPrims, [&](const int i)
+            {
+                m_primIds[i] = i;
+                computePrimBounds(i);
+                centroids[i] = (m_primBounds[i].first + m_primBounds[i].second) * 0.5;
+            }, m_parallel && numPrims > s_parallelCutoff);
+
+        // A binary tree with at least one primitive per leaf has at most 2n-1 nodes
+        m_nodes.resize(2 * numPrims - 1);
+        m_nodeCount = 1;
+        buildNode(0, 0, numPrims, 0, centroids);
+        m_nodes.resize(m_nodeCount);
+    }
+
+    ///
+    /// \brief Recompute the bounds of all nodes for the current vertex positions,
+    /// the topology is kept. Quality degrades for large deformations, rebuild then.
+    ///
+    void refit()
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        ParallelUtils::parallelFor(static_cast<int>(m_primBounds.size()), [&](const int i)
+            {
+                computePrimBounds(i);
+            }, m_parallel && m_primBounds.size() > s_parallelCutoff);
+
+        // Children are always allocated after their parents, so reverse order
+        // visits children before parents
+        for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; i--)
+        {
+            BVHNode& node = m_nodes[i];
+            if (node.isLeaf())
+            {
+                computeLeafBounds(node);
+            }
+            else
+            {
+                const BVHNode& left  = m_nodes[node.first];
+                const BVHNode& right = m_nodes[node.first + 1];
+                node.min = left.min.cwiseMin(right.min);
+                node.max = left.max.cwiseMax(right.max);
+            }
+        }
+    }
+
+    ///
+    /// \brief Refit with the cells swept from the given previous positions to the current
+    ///
+    void refitSwept(std::shared_ptr<VecDataArray<double, 3>> prevVertices)
+    {
+        m_prevVertices = prevVertices;
+        refit();
+    }
+
+    ///
+    /// \brief Calls func(cellId) for every cell whose box overlaps the given box
+    ///
+    template<class Func>
+    void queryOverlap(const Vec3d& min, const Vec3d& max, Func&& func) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+        std::array<int, MaxDepth + 2> stack;
+        int                           stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const BVHNode& node = m_nodes[stack[--stackSize]];
+            if (!testOverlap(node.min, node.max, min, max))
+            {
+                continue;
+            }
+            if (node.isLeaf())
+            {
+                for (int i = node.first; i < node.first + node.count; i++)
+                {
+                    const int primId = m_primIds[i];
+                    if (testOverlap(m_primBounds[primId].first, m_primBounds[primId].second, min, max))
+                    {
+                        func(primId);
+                    }
+                }
+            }
+            else
+            {
+                stack[stackSize++] = node.first;
+                stack[stackSize++] = node.first + 1;
+            }
+        }
+    }
+
+    ///
+    /// \brief Gathers the cells whose box overlaps the given box
+    ///
+    void queryOverlap(const Vec3d& min, const Vec3d& max, std::vector<int>& results) const
+    {
+        queryOverlap(min, max, [&](const int cellId) { results.push_back(cellId); });
+    }
+
+    ///
+    /// \brief Finds the nearest hit along a ray. Cells are visited front to back by box,
+    /// hitFunc(cellId) should return the ray parameter of the hit or a negative value for none
+    /// \param ray origin
+    /// \param ray direction (need not be normalized, the parameter is in multiples of it)
+    /// \param hitFunc exact ray to cell test
+    /// \param maximum ray parameter, set to the parameter of the nearest hit
+    /// \return id of the nearest hit cell or -1
+    ///
+    template<class Func>
+    int queryRay(const Vec3d& origin, const Vec3d& dir, Func&& hitFunc,
+                 double& maxT) const
+    {
+        if (m_nodes.empty())
+        {
+            return -1;
+        }
+        const Vec3d invDir = Vec3d(1.0 / dir[0], 1.0 / dir[1], 1.0 / dir[2]);
+
+        int                           hitId = -1;
+        std::array<int, MaxDepth + 2> stack;
+        int                           stackSize = 0;
+        double                        tmp;
+        if (!testRayBox(origin, invDir, m_nodes[0].min, m_nodes[0].max, maxT, tmp))
+        {
+            return -1;
+        }
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const BVHNode& node = m_nodes[stack[--stackSize]];
+            if (node.isLeaf())
+            {
+                for (int i = node.first; i < node.first + node.count; i++)
+                {
+                    const int    primId = m_primIds[i];
+                    const double t      = hitFunc(primId);
+                    if (t >= 0.0 && t < maxT)
+                    {
+                        maxT  = t;
+                        hitId = primId;
+                    }
+                }
+                continue;
+            }
+
+            // Push the farther child first such that the nearer one is visited first
+            double     tLeft, tRight;
+            const bool hitLeft  = testRayBox(origin, invDir, m_nodes[node.first].min, m_nodes[node.first].max, maxT, tLeft);
+            const bool hitRight = testRayBox(origin, invDir, m_nodes[node.first + 1].min, m_nodes[node.first + 1].max, maxT, tRight);
+            if (hitLeft && hitRight)
+            {
+                const bool leftFirst = tLeft <= tRight;
+                stack[stackSize++] = leftFirst ? node.first + 1 : node.first;
+                stack[stackSize++] = leftFirst ? node.first : node.first + 1;
+            }
+            else if (hitLeft)
+            {
+                stack[stackSize++] = node.first;
+            }
+            else if (hitRight)
+            {
+                stack[stackSize++] = node.first + 1;
+            }
+        }
+        return hitId;
+    }
+
+    ///
+    /// \brief Finds the closest cell to a point. distSqrFunc(cellId) should return
+    /// the squared distance from the point to the cell.
+    /// \param query point
+    /// \param distSqrFunc exact squared distance to cell
+    /// \param maximum squared distance to search within, set to the squared distance of the closest
+    /// \return id of the closest cell or -1 if none within the maximum distance
+    ///
+    template<class Func>
+    int queryClosest(const Vec3d& pos, Func&& distSqrFunc, double& maxDistSqr) const
+    {
+        if (m_nodes.empty())
+        {
+            return -1;
+        }
+
+        int                           closestId = -1;
+        std::array<int, MaxDepth + 2> stack;
+        int                           stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0)
+        {
+            const BVHNode& node = m_nodes[stack[--stackSize]];
+            if (boxDistSqr(pos, node.min, node.max) > maxDistSqr)
+            {
+                continue;
+            }
+            if (node.isLeaf())
+            {
+                for (int i = node.first; i < node.first + node.count; i++)
+                {
+                    const int primId = m_primIds[i];
+                    if (boxDistSqr(pos, m_primBounds[primId].first, m_primBounds[primId].second) > maxDistSqr)
+                    {
+                        continue;
+                    }
+                    const double distSqr = distSqrFunc(primId);
+                    if (distSqr < maxDistSqr)
+                    {
+                        maxDistSqr = distSqr;
+                        closestId  = primId;
+                    }
+                }
+                continue;
+            }
+
+            // Push the farther child first such that the nearer one is visited first
+            const double distLeft  = boxDistSqr(pos, m_nodes[node.first].min, m_nodes[node.first].max);
+            const double distRight = boxDistSqr(pos, m_nodes[node.first + 1].min, m_nodes[node.first + 1].max);
+            const bool   leftFirst = distLeft <= distRight;
+            stack[stackSize++] = leftFirst ? node.first + 1 : node.first;
+            stack[stackSize++] = leftFirst ? node.first : node.first + 1;
+        }
+        return closestId;
+    }
+
+    ///
+    /// \brief Finds the closest cell to a point
+    /// \return id of the closest cell or -1 if the tree is empty
+    ///
+    template<class Func>
+    int queryClosest(const Vec3d& pos, Func&& distSqrFunc) const
+    {
+        double maxDistSqr = IMSTK_DOUBLE_MAX;
+        return queryClosest(pos, std::forward<Func>(distSqrFunc), maxDistSqr);
+    }
+
+    ///
+    /// \brief Calls func(cellA, cellB) for every pair of distinct cells of this tree whose
+    /// boxes overlap, each pair is reported once. Cells sharing vertices are reported too,
+    /// cull them in func if needed.
+    /// \param if true func is called from multiple threads
+    ///
+    template<class Func>
+    void querySelfOverlap(Func&& func, const bool doParallel = false) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+        traversePairs(*this, 0, 0, std::forward<Func>(func), doParallel);
+    }
+
+    ///
+    /// \brief Calls func(cellA, cellB) for every cell of this tree (A) overlapping a cell of the other (B)
+    /// \param if true func is called from multiple threads
+    ///
+    template<int M, class Func>
+    void queryOverlap(const BVH<M>& other, Func&& func, const bool doParallel = false) const
+    {
+        if (m_nodes.empty() || other.getNodes().empty())
+        {
+            return;
+        }
+        traversePairs(other, 0, 0, std::forward<Func>(func), doParallel);
+    }
+
+    ///
+    /// \brief Get the nodes, the root is the first
+    ///
+    const std::vector<BVHNode>& getNodes() const { return m_nodes; }
+
+    ///
+    /// \brief Get the order of the cells, leaves index ranges of it
+    ///
+    const std::vector<int>& getPrimitiveIds() const { return m_primIds; }
+
+    ///
+    /// \brief Get the padded box (min, max) of a cell
+    ///
+    const std::pair<Vec3d, Vec3d>& getPrimitiveBounds(const int cellId) const { return m_primBounds[cellId]; }
+
+    ///
+    /// \brief Get the number of cells in the tree
+    ///
+    int getNumPrimitives() const { return static_cast<int>(m_primIds.size()); }
+
+    ///
+    /// \brief Returns the depth of the tree, for diagnostics
+    ///
+    int computeDepth() const
+    {
+        if (m_nodes.empty())
+        {
+            return 0;
+        }
+        int                                          maxDepth = 0;
+        std::array<std::pair<int, int>, MaxDepth + 2> stack;
+        int                                          stackSize = 0;
+        stack[stackSize++] = { 0, 1 };
+        while (stackSize > 0)
+        {
+            const std::pair<int, int> item = stack[--stackSize];
+            const BVHNode&            node = m_nodes[item.first];
+            maxDepth = std::max(maxDepth, item.second);
+            if (!node.isLeaf())
+            {
+                stack[stackSize++] = { node.first, item.second + 1 };
+                stack[stackSize++] = { node.first + 1, item.second + 1 };
+            }
+        }
+        return maxDepth;
+    }
+
+    static bool testOverlap(const Vec3d& minA, const Vec3d& maxA, const Vec3d& minB, const Vec3d& maxB)
+    {
+        return minA[0] <= maxB[0] && minB[0] <= maxA[0]
+               && minA[1] <= maxB[1] && minB[1] <= maxA[1]
+               && minA[2] <= maxB[2] && minB[2] <= maxA[2];
+    }
+
+protected:
+    template<int M> friend class BVH;
+
+    ///
+    /// \brief Pair of nodes to test for overlap, nodeB is in the other tree
+    ///
+    struct NodePair
+    {
+        int nodeA;
+        int nodeB;
+    };
+
+    void computePrimBounds(const int primId)
+    {
+        const VecDataArray<double, 3>& vertices = *m_vertices;
+        const CellType&                cell     = (*m_cells)[primId];
+        Vec3d                          min      = vertices[cell[0]];
+        Vec3d                          max      = min;
+        for (int j = 1; j < N; j++)
+        {
+            min = min.cwiseMin(vertices[cell[j]]);
+            max = max.cwiseMax(vertices[cell[j]]);
+        }
+        if (m_prevVertices != nullptr)
+        {
+            const VecDataArray<double, 3>& prevVertices = *m_prevVertices;
+            for (int j = 0; j < N; j++)
+            {
+                min = min.cwiseMin(prevVertices[cell[j]]);
+                max = max.cwiseMax(prevVertices[cell[j]]);
+            }
+        }
+        m_primBounds[primId].first  = min - Vec3d::Constant(m_padding);
+        m_primBounds[primId].second = max + Vec3d::Constant(m_padding);
+    }
+
+    void computeLeafBounds(BVHNode& node) const
+    {
+        node.min = Vec3d::Constant(IMSTK_DOUBLE_MAX);
+        node.max = Vec3d::Constant(IMSTK_DOUBLE_MIN);
+        for (int i = node.first; i < node.first + node.count; i++)
+        {
+            const std::pair<Vec3d, Vec3d>& bounds = m_primBounds[m_primIds[i]];
+            node.min = node.min.cwiseMin(bounds.first);
+            node.max = node.max.cwiseMax(bounds.second);
+        }
+    }
+
+    static double boxArea(const Vec3d& min, const Vec3d& max)
+    {
+        const Vec3d d = (max - min).cwiseMax(0.0);
+        return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+    }
+
+    static double boxDistSqr(const Vec3d& pos, const Vec3d& min, const Vec3d& max)
+    {
+        return (min - pos).cwiseMax(pos - max).cwiseMax(0.0).squaredNorm();
+    }
+
+    static bool testRayBox(const Vec3d& origin, const Vec3d& invDir, const Vec3d& min, const Vec3d& max,
+                           const double maxT, double& tEnter)
+    {
+        const Vec3d  t0   = (min - origin).cwiseProduct(invDir);
+        const Vec3d  t1   = (max - origin).cwiseProduct(invDir);
+        const double tMin = std::max(t0.cwiseMin(t1).maxCoeff(), 0.0);
+        const double tMax = std::min(t0.cwiseMax(t1).minCoeff(), maxT);
+        tEnter = tMin;
+        return tMin <= tMax;
+    }
+
+    ///
+    /// \brief Recursively builds the subtree over [begin, end) of the primitive order into nodeId
+    ///
+    void buildNode(const int nodeId, const int begin, const int end, const int depth,
+                   const std::vector<Vec3d>& centroids)
+    {
+        BVHNode& node = m_nodes[nodeId];
+        node.first = begin;
+        node.count = end - begin;
+        computeLeafBounds(node);
+
+        const int count = end - begin;
+        if (count <= 1 || depth >= MaxDepth)
+        {
+            return;
+        }
+
+        Vec3d centroidMin = Vec3d::Constant(IMSTK_DOUBLE_MAX);
+        Vec3d centroidMax = Vec3d::Constant(IMSTK_DOUBLE_MIN);
+        for (int i = begin; i < end; i++)
+        {
+            centroidMin = centroidMin.cwiseMin(centroids[m_primIds[i]]);
+            centroidMax = centroidMax.cwiseMax(centroids[m_primIds[i]]);
+        }
+        const Vec3d extent = centroidMax - centroidMin;
+
+        // Binned SAH over all three axes
+        int    bestAxis  = -1;
+        int    bestSplit = -1;
+        double bestCost  = IMSTK_DOUBLE_MAX;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            if (extent[axis] <= 0.0)
+            {
+                continue;
+            }
+            std::array<int, NumBins>   binCounts;
+            std::array<Vec3d, NumBins> binMin, binMax;
+            binCounts.fill(0);
+            binMin.fill(Vec3d::Constant(IMSTK_DOUBLE_MAX));
+            binMax.fill(Vec3d::Constant(IMSTK_DOUBLE_MIN));
+            const double scale = NumBins / extent[axis];
+            for (int i = begin; i < end; i++)
+            {
+                const int primId = m_primIds[i];
+                const int bin    = std::min(static_cast<int>((centroids[primId][axis] - centroidMin[axis]) * scale), NumBins - 1);
+                binCounts[bin]++;
+                binMin[bin] = binMin[bin].cwiseMin(m_primBounds[primId].first);
+                binMax[bin] = binMax[bin].cwiseMax(m_primBounds[primId].second);
+            }
+
+            // Sweep from the right to get the cost of every right side
+            std::array<double, NumBins> rightCosts;
+            Vec3d                       accMin   = Vec3d::Constant(IMSTK_DOUBLE_MAX);
+            Vec3d                       accMax   = Vec3d::Constant(IMSTK_DOUBLE_MIN);
+            int                         accCount = 0;
+            for (int i = NumBins - 1; i > 0; i--)
+            {
+                accMin        = accMin.cwiseMin(binMin[i]);
+                accMax        = accMax.cwiseMax(binMax[i]);
+                accCount     += binCounts[i];
+                rightCosts[i] = (accCount > 0) ? boxArea(accMin, accMax) * accCount : 0.0;
+            }
+            // Sweep from the left, split after bin i
+            accMin   = Vec3d::Constant(IMSTK_DOUBLE_MAX);
+            accMax   = Vec3d::Constant(IMSTK_DOUBLE_MIN);
+            accCount = 0;
+            for (int i = 0; i < NumBins - 1; i++)
+            {
+                accMin    = accMin.cwiseMin(binMin[i]);
+                accMax    = accMax.cwiseMax(binMax[i]);
+                accCount += binCounts[i];
+                const double cost = ((accCount > 0) ? boxArea(accMin, accMax) * accCount : 0.0) + rightCosts[i + 1];
+                if (accCount > 0 && accCount < count && cost < bestCost)
+                {
+                    bestCost  = cost;
+                    bestAxis  = axis;
+                    bestSplit = i;
+                }
+            }
+        }
+
+        // Compare against making a leaf (unit traversal and intersection cost)
+        const double parentArea = boxArea(node.min, node.max);
+        const double leafCost   = static_cast<double>(count);
+        const double splitCost  = (parentArea > 0.0) ? 1.0 + bestCost / parentArea : IMSTK_DOUBLE_MAX;
+        if (count <= m_maxLeafSize && leafCost <= splitCost)
+        {
+            return;
+        }
+
+        int mid = begin;
+        if (bestAxis != -1)
+        {
+            const double scale = NumBins / extent[bestAxis];
+            mid = static_cast<int>(std::partition(m_primIds.begin() + begin, m_primIds.begin() + end,
+                [&](const int primId)
+                {
+                    const int bin = std::min(static_cast<int>((centroids[primId][bestAxis] - centroidMin[bestAxis]) * scale), NumBins - 1);
+                    return bin <= bestSplit;
+                }) - m_primIds.begin());
+        }
+        if (mid == begin || mid == end)
+        {
+            if (count <= m_maxLeafSize)
+            {
+                return;
+            }
+            // All centroids coincide, split by count
+            mid = begin + count / 2;
+        }
+
+        const int leftId = m_nodeCount.fetch_add(2);
+        node.first = leftId;
+        node.count = 0;
+
+        if (m_parallel && count > s_parallelCutoff)
+        {
+            tbb::parallel_invoke(
+                [&]() { buildNode(leftId, begin, mid, depth + 1, centroids); },
+                [&]() { buildNode(leftId + 1, mid, end, depth + 1, centroids); });
+        }
+        else
+        {
+            buildNode(leftId, begin, mid, depth + 1, centroids);
+            buildNode(leftId + 1, mid, end, depth + 1, centroids);
+        }
+    }
+
+    ///
+    /// \brief Simultaneous descent of this and the other tree from the given node pair.
+    /// When other is this, pairs are only visited once.
+    ///
+    template<int M, class Func>
+    void traversePairs(const BVH<M>& other, const int rootA, const int rootB, Func&& func, const bool doParallel) const
+    {
+        const bool isSelf = (static_cast<const void*>(&other) == static_cast<const void*>(this));
+
+        std::vector<NodePair> work;
+        work.push_back({ rootA, rootB });
+
+        // Expand the top of the traversal breadth first to get independent tasks
+        if (doParallel)
+        {
+            const size_t          targetNumTasks = 256;
+            std::vector<NodePair> next;
+            while (!work.empty() && work.size() < targetNumTasks)
+            {
+                next.clear();
+                bool expanded = false;
+                for (const NodePair& pair : work)
+                {
+                    expanded |= expandPair(other, pair, isSelf, next, func);
+                }
+                std::swap(work, next);
+                if (!expanded)
+                {
+                    break;
+                }
+            }
+            ParallelUtils::parallelFor(work.size(), [&](const size_t i)
+                {
+                    descendPair(other, work[i], isSelf, func);
+                });
+        }
+        else
+        {
+            descendPair(other, work[0], isSelf, func);
+        }
+    }
+
+    ///
+    /// \brief Expands a node pair one level, leaf pairs are tested immediately
+    /// \return true if any pair was split
+    ///
+    template<int M, class Func>
+    bool expandPair(const BVH<M>& other, const NodePair& pair, const bool isSelf,
+                    std::vector<NodePair>& results, Func&& func) const
+    {
+        const BVHNode& nodeA = m_nodes[pair.nodeA];
+        const BVHNode& nodeB = other.m_nodes[pair.nodeB];
+        if (isSelf && pair.nodeA == pair.nodeB)
+        {
+            if (nodeA.isLeaf())
+            {
+                testLeafPair(other, nodeA, nodeB, true, func);
+                return false;
+            }
+            results.push_back({ nodeA.first, nodeA.first });
+            results.push_back({ nodeA.first + 1, nodeA.first + 1 });
+            results.push_back({ nodeA.first, nodeA.first + 1 });
+            return true;
+        }
+        if (!testOverlap(nodeA.min, nodeA.max, nodeB.min, nodeB.max))
+        {
+            return false;
+        }
+        if (nodeA.isLeaf() && nodeB.isLeaf())
+        {
+            testLeafPair(other, nodeA, nodeB, false, func);
+            return false;
+        }
+        // Split the larger (or only internal) node
+        const bool splitA = !nodeA.isLeaf()
+                            && (nodeB.isLeaf() || boxArea(nodeA.min, nodeA.max) >= boxArea(nodeB.min, nodeB.max));
+        if (splitA)
+        {
+            results.push_back({ nodeA.first, pair.nodeB });
+            results.push_back({ nodeA.first + 1, pair.nodeB });
+        }
+        else
+        {
+            results.push_back({ pair.nodeA, nodeB.first });
+            results.push_back({ pair.nodeA, nodeB.first + 1 });
+        }
+        return true;
+    }
+
+    template<int M, class Func>
+    void descendPair(const BVH<M>& other, const NodePair& root, const bool isSelf, Func&& func) const
+    {
+        // Self pairs may push three pairs per pop, the stack is bounded by 2x the sum of depths
+        std::array<NodePair, 4 * (MaxDepth + 2)> stack;
+        int                                      stackSize = 0;
+        stack[stackSize++] = root;
+        std::vector<NodePair> next;
+        while (stackSize > 0)
+        {
+            const NodePair pair = stack[--stackSize];
+            next.clear();
+            expandPair(other, pair, isSelf, next, func);
+            for (const NodePair& p : next)
+            {
+                stack[stackSize++] = p;
+            }
+        }
+    }
+
+    template<int M, class Func>
+    void testLeafPair(const BVH<M>& other, const BVHNode& nodeA, const BVHNode& nodeB, const bool sameLeaf, Func&& func) const
+    {
+        for (int i = nodeA.first; i < nodeA.first + nodeA.count; i++)
+        {
+            const int                      primA   = m_primIds[i];
+            const std::pair<Vec3d, Vec3d>& boundsA = m_primBounds[primA];
+            for (int j = sameLeaf ? i + 1 : nodeB.first; j < nodeB.first + nodeB.count; j++)
+            {
+                const int                      primB   = other.m_primIds[j];
+                const std::pair<Vec3d, Vec3d>& boundsB = other.m_primBounds[primB];
+                if (testOverlap(boundsA.first, boundsA.second, boundsB.first, boundsB.second))
+                {
+                    func(primA, primB);
+                }
+            }
+        }
+    }
+
+protected:
+    std::shared_ptr<VecDataArray<double, 3>> m_vertices     = nullptr;
+    std::shared_ptr<VecDataArray<double, 3>> m_prevVertices = nullptr; ///< If set, boxes enclose the sweep
+    std::shared_ptr<VecDataArray<int, N>>    m_cells = nullptr;
+
+    std::vector<BVHNode> m_nodes;
+    std::vector<int>     m_primIds;                       ///< Primitive order, leaves reference ranges of it
+    std::vector<std::pair<Vec3d, Vec3d>> m_primBounds;    ///< Padded box per cell, indexed by cell id
+    std::atomic<int> m_nodeCount = { 0 };
+
+    int    m_maxLeafSize = 4;
+    double m_padding     = 0.0;
+    bool   m_parallel    = true;
+
+    static constexpr int s_parallelCutoff = 4096; ///< Ranges smaller than this are built serially
+};
+} // namespace imstk
@@ -0,0 +1,65 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkDummyClient.h"
+
+using namespace imstk;
+
+TEST(imstkDeviceClientTest, PublishState)
+{
+    DummyClient client;
+    EXPECT_EQ(client.getDeviceState().timestamp, 0.0);
+
+    const double t0 = DeviceClient::getTime();
+    client.setPosition(Vec3d(1.0, 2.0, 3.0));
+    client.setVelocity(Vec3d(4.0, 5.0, 6.0));
+
+    const DeviceState state = client.getDeviceState();
+    EXPECT_TRUE(state.position.isApprox(Vec3d(1.0, 2.0, 3.0)));
+    EXPECT_TRUE(state.velocity.isApprox(Vec3d(4.0, 5.0, 6.0)));
+    EXPECT_TRUE(client.getPosition().isApprox(state.position));
+    EXPECT_GE(state.timestamp, t0);
+}
+
+TEST(imstkDeviceClientTest, Force)
+{
+    DummyClient client;
+    client.setForce(Vec3d(1.0, 0.0, 0.0));
+    client.renderForce();
+    EXPECT_TRUE(client.getRenderedForce().isApprox(Vec3d(1.0, 0.0, 0.0)));
+}
+
+TEST(imstkDeviceClientTest, ForceProxy)
+{
+    DummyClient client;
+    client.setPosition(Vec3d(0.0, 0.0, 0.0));
+    client.setForceProxy(Vec3d(1.0, 0.0, 0.0), Vec3d(0.0, 2.0, 0.0), 10.0, 0.5);
+
+    // At the time it was set the proxy is not extrapolated
+    const double t0 = client.getForceProxy().timestamp;
+    client.renderForce(t0);
+    EXPECT_TRUE(client.getRenderedForce().isApprox(Vec3d(10.0, 1.0, 0.0)));
+
+    // The proxy moves with its velocity until the next update
+    client.renderForce(t0 + 0.01);
+    EXPECT_TRUE(client.getRenderedForce().isApprox(Vec3d(10.0, 1.0 + 10.0 * 0.02, 0.0)));
+
+    // But only up to the max extrapolation time
+    client.setMaxExtrapolationTime(0.02);
+    client.renderForce(t0 + 1.0);
+    EXPECT_TRUE(client.getRenderedForce().isApprox(Vec3d(10.0, 1.0 + 10.0 * 0.04, 0.0)));
+
+    // Force set directly adds to the proxy force
+    client.setForce(Vec3d(0.0, 0.0, 3.0));
+    client.renderForce(t0);
+    EXPECT_TRUE(client.getRenderedForce().isApprox(Vec3d(10.0, 1.0, 3.0)));
+
+    client.disableForceProxy();
+    client.renderForce(t0);
+    EXPECT_TRUE(client.getRenderedForce().isApprox(Vec3d(0.0, 0.0, 3.0)));
+}
@@ -0,0 +1,143 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkDeviceRecorder.h"
+#include "imstkDummyClient.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace imstk;
+
+TEST(imstkDeviceRecordingTest, WriteRead)
+{
+    auto device0 = std::make_shared<DummyClient>();
+    auto device1 = std::make_shared<DummyClient>();
+    std::vector<std::shared_ptr<DeviceClient>> devices = { device0, device1 };
+
+    DeviceRecording recording(2);
+    for (int i = 0; i < 3; i++)
+    {
+        device0->setPosition(Vec3d(i, 2.0 * i, 3.0 * i));
+        device1->setOrientation(Quatd(Rotd(0.1 * i, Vec3d(0.0, 1.0, 0.0))));
+        device1->setButton(0, i % 2);
+        recording.addFrame(0.01 * (i + 1), devices);
+    }
+    EXPECT_EQ(recording.getNumFrames(), 3);
+    EXPECT_DOUBLE_EQ(recording.getTotalTime(), 0.06);
+
+    const std::string filePath = "imstkDeviceRecordingTest.rec";
+    ASSERT_TRUE(recording.write(filePath));
+
+    DeviceRecording readRecording;
+    ASSERT_TRUE(readRecording.read(filePath));
+    std::remove(filePath.c_str());
+
+    ASSERT_EQ(readRecording.getNumDevices(), 2);
+    ASSERT_EQ(readRecording.getNumFrames(), 3);
+    for (int i = 0; i < 3; i++)
+    {
+        const DeviceRecording::Frame& expected = recording.getFrame(i);
+        const DeviceRecording::Frame& actual   = readRecording.getFrame(i);
+        EXPECT_EQ(actual.dt, expected.dt);
+        for (int j = 0; j < 2; j++)
+        {
+            EXPECT_EQ(actual.states[j].position, expected.states[j].position);
+            EXPECT_EQ(actual.states[j].orientation.coeffs(), expected.states[j].orientation.coeffs());
+            EXPECT_EQ(actual.states[j].timestamp, expected.states[j].timestamp);
+            EXPECT_EQ(actual.buttons[j], expected.buttons[j]);
+        }
+    }
+}
+
+TEST(imstkDeviceRecordingTest, ReadInvalid)
+{
+    DeviceRecording recording;
+    EXPECT_FALSE(recording.read("imstkDeviceRecordingTestMissing.rec"));
+    EXPECT_EQ(recording.getNumFrames(), 0);
+}
+
+TEST(imstkDeviceRecordingTest, ReadTruncated)
+{
+    auto device = std::make_shared<DummyClient>();
+    std::vector<std::shared_ptr<DeviceClient>> devices = { device };
+
+    DeviceRecording recording(1);
+    for (int i = 0; i < 3; i++)
+    {
+        device->setPosition(Vec3d(i, 0.0, 0.0));
+        recording.addFrame(0.01, devices);
+    }
+    const std::string filePath = "imstkDeviceRecordingTestTruncated.rec";
+    ASSERT_TRUE(recording.write(filePath));
+
+    std::string contents;
+    {
+        std::ifstream file(filePath, std::ios::binary | std::ios::in);
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    // Header: magic (8), version (4), number of devices (4), number of frames (8)
+    const size_t headerSize = 24;
+    ASSERT_GT(contents.size(), headerSize);
+
+    // Cut the last frame in half
+    {
+        std::ofstream file(filePath, std::ios::binary | std::ios::out | std::ios::trunc);
+        file.write(contents.data(), contents.size() - (contents.size() - headerSize) / 6);
+    }
+    DeviceRecording readRecording;
+    EXPECT_FALSE(readRecording.read(filePath));
+    EXPECT_EQ(readRecording.getNumFrames(), 0);
+
+    // Keep the frames but claim far more of them than the file holds
+    {
+        const uint64_t numFrames = std::numeric_limits<uint64_t>::max() / 2;
+        std::memcpy(&contents[headerSize - sizeof(numFrames)], &numFrames, sizeof(numFrames));
+        std::ofstream file(filePath, std::ios::binary | std::ios::out | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+    }
+    EXPECT_FALSE(readRecording.read(filePath));
+    EXPECT_EQ(readRecording.getNumFrames(), 0);
+
+    // Claim far more devices than the file holds
+    {
+        const uint64_t numFrames  = 3;
+        const uint32_t numDevices = std::numeric_limits<uint32_t>::max();
+        std::memcpy(&contents[headerSize - sizeof(numFrames)], &numFrames, sizeof(numFrames));
+        std::memcpy(&contents[headerSize - sizeof(numFrames) - sizeof(numDevices)], &numDevices, sizeof(numDevices));
+        std::ofstream file(filePath, std::ios::binary | std::ios::out | std::ios::trunc);
+        file.write(contents.data(), contents.size());
+    }
+    EXPECT_FALSE(readRecording.read(filePath));
+    EXPECT_EQ(readRecording.getNumFrames(), 0);
+    std::remove(filePath.c_str());
+}
+
+TEST(imstkDeviceRecordingTest, Recorder)
+{
+    auto device = std::make_shared<DummyClient>();
+
+    DeviceRecorder recorder;
+    recorder.addDevice(device);
+    recorder.init();
+    for (int i = 0; i < 4; i++)
+    {
+        device->setPosition(Vec3d(i, 0.0, 0.0));
+        recorder.setDt(0.001 * i);
+        recorder.update();
+    }
+    recorder.uninit();
+
+    const DeviceRecording& recording = recorder.getRecording();
+    ASSERT_EQ(recording.getNumFrames(), 4);
+    EXPECT_EQ(recording.getFrame(3).dt, 0.003);
+    EXPECT_EQ(recording.getFrame(3).states[0].position, Vec3d(3.0, 0.0, 0.0));
+}
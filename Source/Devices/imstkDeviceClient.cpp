@@ -6,6 +6,8 @@
 
 #include "imstkDeviceClient.h"
 #include "imstkLogger.h"
+
+#include <chrono>
 #include <limits>
 
 namespace imstk
@@ -15,67 +17,60 @@ DeviceClient::DeviceClient(const std::string& name, const std::string& ip) :
     m_ip(ip),
     m_position(Vec3d::Zero()),
     m_velocity(Vec3d::Zero()),
+    m_angularVelocity(Vec3d::Zero()),
     m_orientation(Quatd::Identity()),
     m_force(Vec3d::Zero())
 {
 }
 
-Vec3d
-DeviceClient::getPosition()
+void
+DeviceClient::publishState(const double timestamp)
 {
-    Vec3d pos;
-    m_transformLock.lock();
-    pos = m_position;
-    m_transformLock.unlock();
-    return pos;
+    DeviceState state;
+    state.position        = m_position;
+    state.velocity        = m_velocity;
+    state.angularVelocity = m_angularVelocity;
+    state.orientation     = m_orientation;
+    state.timestamp       = timestamp;
+    m_state.write(state);
 }
 
-Vec3d
-DeviceClient::getVelocity()
+void
+DeviceClient::setForceProxy(const Vec3d& position, const Vec3d& velocity, const double stiffness, const double damping)
 {
-    Vec3d vel;
-    m_transformLock.lock();
-    vel = m_velocity;
-    m_transformLock.unlock();
-    return vel;
+    DeviceForceProxy proxy;
+    proxy.position  = position;
+    proxy.velocity  = velocity;
+    proxy.stiffness = stiffness;
+    proxy.damping   = damping;
+    proxy.timestamp = getTime();
+    m_forceProxy.write(proxy);
 }
 
 Vec3d
-DeviceClient::getAngularVelocity()
+DeviceClient::computeForce(const double time) const
 {
-    Vec3d angVel;
-    m_transformLock.lock();
-    angVel = m_angularVelocity;
-    m_transformLock.unlock();
-    return angVel;
-}
+    Vec3d                  force = m_force.read();
+    const DeviceForceProxy proxy = m_forceProxy.read();
+    if (proxy.stiffness == 0.0 && proxy.damping == 0.0)
+    {
+        return force;
+    }
 
-Quatd
-DeviceClient::getOrientation()
-{
-    Quatd orientation;
-    m_transformLock.lock();
-    orientation = m_orientation;
-    m_transformLock.unlock();
-    return orientation;
-}
+    // Extrapolate the proxy to now, hold it if physics stopped updating it
+    const DeviceState state = m_state.read();
+    const double      dt    = std::min(std::max(time - proxy.timestamp, 0.0), m_maxExtrapolationTime);
+    const Vec3d       proxyPos = proxy.position + proxy.velocity * dt;
 
-Vec3d
-DeviceClient::getForce()
-{
-    Vec3d force;
-    m_transformLock.lock();
-    force = m_force;
-    m_transformLock.unlock();
+    force += proxy.stiffness * (proxyPos - state.position) + proxy.damping * (proxy.velocity - state.velocity);
     return force;
 }
 
-void
-DeviceClient::setForce(Vec3d force)
+double
+DeviceClient::getTime()
 {
-    m_forceLock.lock();
-    m_force = force;
-    m_forceLock.unlock();
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
 }
 
 const std::unordered_map<int, int>&
@@ -8,6 +8,7 @@
 
 #include "imstkMath.h"
 #include "imstkEventObject.h"
+#include "imstkSeqLock.h"
 #include "imstkSpinLock.h"
 
 #include <unordered_map>
@@ -42,6 +43,36 @@ public:
     const int       m_button = -1;
 };
 
+///
+/// \struct DeviceState
+///
+/// \brief Snapshot of the tracking state of a device
+///
+struct DeviceState
+{
+    Vec3d position = Vec3d::Zero();
+    Vec3d velocity = Vec3d::Zero();
+    Vec3d angularVelocity = Vec3d::Zero();
+    Quatd orientation     = Quatd::Identity();
+    double timestamp      = 0.0; ///< Time of the sample in seconds, see DeviceClient::getTime
+};
+
+///
+/// \struct DeviceForceProxy
+///
+/// \brief Proxy the device is coupled to with a spring damper, given in device coordinates.
+/// The force is rendered on the device thread with the proxy linearly extrapolated from
+/// the time it was set, such that forces keep the device rate when physics runs slower
+///
+struct DeviceForceProxy
+{
+    Vec3d position  = Vec3d::Zero();
+    Vec3d velocity  = Vec3d::Zero();
+    double stiffness = 0.0; ///< Spring stiffness, 0 disables the proxy
+    double damping   = 0.0; ///< Damping of the velocity relative to the proxy
+    double timestamp = 0.0; ///< Time the proxy was set in seconds
+};
+
 ///
 /// \class DeviceClient
 ///
@@ -85,25 +116,30 @@ public:
     bool getForceEnabled() const { return m_forceEnabled; }
     void setForceEnabled(const bool status) { m_forceEnabled = status; }
 
+    ///
+    /// \brief Get a consistent snapshot of the device tracking state, never blocks the device thread
+    ///
+    DeviceState getDeviceState() const { return m_state.read(); }
+
     ///
     /// \brief Get the device position
     ///
-    Vec3d getPosition();
+    Vec3d getPosition() const { return getDeviceState().position; }
 
     ///
     /// \brief Get the device velocity
     ///
-    Vec3d getVelocity();
+    Vec3d getVelocity() const { return getDeviceState().velocity; }
 
     ///
     /// \brief Get the device angular velocity
     ///
-    Vec3d getAngularVelocity();
+    Vec3d getAngularVelocity() const { return getDeviceState().angularVelocity; }
 
     ///
     /// \brief Get the device orientation
     ///
-    Quatd getOrientation();
+    Quatd getOrientation() const { return getDeviceState().orientation; }
 
     ///
     /// \brief Get offset from position for device end effector
@@ -113,10 +149,45 @@ public:
     ///
     /// \brief Get/Set the device force
     ///@{
-    Vec3d getForce();
-    void setForce(Vec3d force);
+    Vec3d getForce() const { return m_force.read(); }
+    void setForce(Vec3d force) { m_force.write(force); }
+    ///@}
+
+    ///
+    /// \brief Set the proxy the device is pulled towards, rendered in addition to the force.
+    /// Stamped with the current time
+    ///
+    void setForceProxy(const Vec3d& position, const Vec3d& velocity, const double stiffness, const double damping);
+
+    ///
+    /// \brief Stop rendering the proxy
+    ///
+    void disableForceProxy() { m_forceProxy.write(DeviceForceProxy()); }
+
+    ///
+    /// \brief Get the proxy
+    ///
+    DeviceForceProxy getForceProxy() const { return m_forceProxy.read(); }
+
+    ///
+    /// \brief Get/Set the longest time the proxy is extrapolated for in seconds, default 0.05.
+    /// Beyond this the proxy is held, ie: when physics stalls
+    ///@{
+    double getMaxExtrapolationTime() const { return m_maxExtrapolationTime; }
+    void setMaxExtrapolationTime(const double time) { m_maxExtrapolationTime = time; }
     ///@}
 
+    ///
+    /// \brief Computes the force to render at the given time, the force plus the proxy spring
+    /// damper evaluated at the latest device state. Called on the device thread every servo tick
+    ///
+    Vec3d computeForce(const double time) const;
+
+    ///
+    /// \brief Monotonic time in seconds used for timestamps
+    ///
+    static double getTime();
+
     ///
     /// \brief Get button map
     ///
@@ -147,6 +218,13 @@ public:
 protected:
     DeviceClient(const std::string& name, const std::string& ip);
 
+    ///
+    /// \brief Publish the position, velocity, angular velocity and orientation members
+    /// to readers as one state. Must only be called from the thread filling them
+    ///
+    void publishState(const double timestamp);
+    void publishState() { publishState(getTime()); }
+
     std::string m_deviceName;                         ///< Device Name
     std::string m_ip;                                 ///< Connection device IP
 
@@ -155,18 +233,21 @@ protected:
     bool m_buttonsEnabled  = true;                    ///< Buttons enabled if true
     bool m_forceEnabled    = false;                   ///< Force enabled if true
 
+    // Filled by the device thread, readers use the published state
     Vec3d m_position;                                 ///< Position of end effector
     Vec3d m_velocity;                                 ///< Linear velocity of end effector
     Vec3d m_angularVelocity;                          ///< Angular velocity of the end effector
     Quatd m_orientation;                              ///< Orientation of the end effector
-    Vec3d m_force;                                    ///< Force vector
     Vec3d m_endEffectorOffset = Vec3d(0.0, 0.0, 0.0); ///< Offset from origin
 
     std::unordered_map<int, int> m_buttons;
     std::vector<double> m_analogChannels;
 
-    ParallelUtils::SpinLock m_transformLock;    ///< Used for devices filling data from other threads
-    ParallelUtils::SpinLock m_forceLock;        ///< Used for devices filling data from other threads
+    ParallelUtils::SeqLock<DeviceState>      m_state;      ///< Last published tracking state
+    ParallelUtils::SeqLock<Vec3d>            m_force;      ///< Force vector
+    ParallelUtils::SeqLock<DeviceForceProxy> m_forceProxy; ///< Proxy rendered on the device thread
+    double m_maxExtrapolationTime = 0.05;
+
     mutable ParallelUtils::SpinLock m_dataLock; ///< Used for button and analog data
 };
 } // namespace imstk
@@ -0,0 +1,40 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDeviceRecorder.h"
+#include "imstkLogger.h"
+
+namespace imstk
+{
+DeviceRecorder::DeviceRecorder(const std::string& filePath) : m_filePath(filePath)
+{
+    m_executionType    = ExecutionType::ADAPTIVE;
+    m_muteUpdateEvents = true;
+}
+
+bool
+DeviceRecorder::initModule()
+{
+    m_recording.clear(static_cast<int>(m_devices.size()));
+    return true;
+}
+
+void
+DeviceRecorder::updateModule()
+{
+    m_recording.addFrame(m_dt, m_devices);
+}
+
+void
+DeviceRecorder::uninitModule()
+{
+    if (!m_filePath.empty() && m_recording.write(m_filePath))
+    {
+        LOG(INFO) << "Recorded " << m_recording.getNumFrames() << " frames of "
+                  << m_recording.getNumDevices() << " devices to " << m_filePath;
+    }
+}
+} // namespace imstk
@@ -0,0 +1,58 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkDeviceRecording.h"
+#include "imstkModule.h"
+
+namespace imstk
+{
+///
+/// \class DeviceRecorder
+///
+/// \brief Module recording the state of devices every update along with the time step.
+/// It is adaptive such that, added to the SimulationManager before the SceneManager, it
+/// records one frame per simulation step. The recording is written to file on uninit
+/// if a file path is given, see ReplayDriver to replay it
+///
+class DeviceRecorder : public Module
+{
+public:
+    DeviceRecorder(const std::string& filePath = "");
+    ~DeviceRecorder() override = default;
+
+public:
+    ///
+    /// \brief Add a device to record, devices are replayed in the order added
+    ///
+    void addDevice(std::shared_ptr<DeviceClient> device) { m_devices.push_back(device); }
+
+    ///
+    /// \brief Get/Set the file the recording is written to on uninit, empty for none
+    ///@{
+    const std::string& getFilePath() const { return m_filePath; }
+    void setFilePath(const std::string& filePath) { m_filePath = filePath; }
+    ///@}
+
+    ///
+    /// \brief Get the recording
+    ///
+    const DeviceRecording& getRecording() const { return m_recording; }
+
+public:
+    bool initModule() override;
+
+    void updateModule() override;
+
+    void uninitModule() override;
+
+protected:
+    std::vector<std::shared_ptr<DeviceClient>> m_devices;
+    std::string     m_filePath;
+    DeviceRecording m_recording;
+};
+} // namespace imstk
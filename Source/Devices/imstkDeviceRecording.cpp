@@ -0,0 +1,205 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDeviceRecording.h"
+#include "imstkLogger.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace imstk
+{
+namespace
+{
+const char     fileMagic[8]  = { 'i', 'M', 'S', 'T', 'K', 'R', 'E', 'C' };
+const uint32_t fileVersion   = 1;
+const int      numStateWords = 14; // position, velocity, angular velocity, orientation (xyzw), timestamp
+
+template<typename T>
+void
+writeValue(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+bool
+readValue(std::ifstream& file, T& value)
+{
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(file);
+}
+} // namespace
+
+void
+DeviceRecording::addFrame(const Frame& frame)
+{
+    CHECK(static_cast<int>(frame.states.size()) == m_numDevices) << "Frame must have a state for every device";
+    m_frames.push_back(frame);
+    m_frames.back().buttons.resize(m_numDevices);
+}
+
+void
+DeviceRecording::addFrame(const double dt, const std::vector<std::shared_ptr<DeviceClient>>& devices)
+{
+    Frame frame;
+    frame.dt = dt;
+    frame.states.resize(devices.size());
+    frame.buttons.resize(devices.size());
+    for (size_t i = 0; i < devices.size(); i++)
+    {
+        frame.states[i] = devices[i]->getDeviceState();
+        for (const auto& button : devices[i]->getButtons())
+        {
+            frame.buttons[i].push_back(button);
+        }
+    }
+    addFrame(frame);
+}
+
+void
+DeviceRecording::clear(const int numDevices)
+{
+    m_numDevices = numDevices;
+    m_frames.clear();
+}
+
+double
+DeviceRecording::getTotalTime() const
+{
+    double totalTime = 0.0;
+    for (const Frame& frame : m_frames)
+    {
+        totalTime += frame.dt;
+    }
+    return totalTime;
+}
+
+bool
+DeviceRecording::write(const std::string& filePath) const
+{
+    std::ofstream file(filePath, std::ios::binary | std::ios::out);
+    if (!file.is_open())
+    {
+        LOG(WARNING) << "Failed to write recording, could not open " << filePath;
+        return false;
+    }
+
+    file.write(fileMagic, sizeof(fileMagic));
+    writeValue(file, fileVersion);
+    writeValue(file, static_cast<uint32_t>(m_numDevices));
+    writeValue(file, static_cast<uint64_t>(m_frames.size()));
+    for (const Frame& frame : m_frames)
+    {
+        writeValue(file, frame.dt);
+        for (int i = 0; i < m_numDevices; i++)
+        {
+            const DeviceState& state = frame.states[i];
+            const double       words[numStateWords] =
+            {
+                state.position[0], state.position[1], state.position[2],
+                state.velocity[0], state.velocity[1], state.velocity[2],
+                state.angularVelocity[0], state.angularVelocity[1], state.angularVelocity[2],
+                state.orientation.x(), state.orientation.y(), state.orientation.z(), state.orientation.w(),
+                state.timestamp
+            };
+            file.write(reinterpret_cast<const char*>(words), sizeof(words));
+
+            writeValue(file, static_cast<uint32_t>(frame.buttons[i].size()));
+            for (const auto& button : frame.buttons[i])
+            {
+                writeValue(file, static_cast<int32_t>(button.first));
+                writeValue(file, static_cast<int32_t>(button.second));
+            }
+        }
+    }
+
+    if (!file)
+    {
+        LOG(WARNING) << "Failed to write recording " << filePath;
+        return false;
+    }
+    return true;
+}
+
+bool
+DeviceRecording::read(const std::string& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary | std::ios::in);
+    if (!file.is_open())
+    {
+        LOG(WARNING) << "Failed to read recording, could not open " << filePath;
+        return false;
+    }
+
+    char     magic[sizeof(fileMagic)];
+    uint32_t version    = 0;
+    uint32_t numDevices = 0;
+    uint64_t numFrames  = 0;
+    file.read(magic, sizeof(magic));
+    if (!file || std::memcmp(magic, fileMagic, sizeof(fileMagic)) != 0
+        || !readValue(file, version) || version != fileVersion
+        || !readValue(file, numDevices) || !readValue(file, numFrames))
+    {
+        LOG(WARNING) << "Failed to read recording, " << filePath << " is not a recording of version " << fileVersion;
+        return false;
+    }
+
+    // Every frame holds at least its dt and, per device, its state and button count. Check
+    // the header against the rest of the file before allocating the frames
+    const std::streampos dataBegin = file.tellg();
+    file.seekg(0, std::ios::end);
+    const uint64_t numDataBytes = static_cast<uint64_t>(file.tellg() - dataBegin);
+    file.seekg(dataBegin);
+    const uint64_t minFrameBytes = sizeof(double) + static_cast<uint64_t>(numDevices) * (numStateWords * sizeof(double) + sizeof(uint32_t));
+    if (!file || numFrames > numDataBytes / minFrameBytes)
+    {
+        LOG(WARNING) << "Failed to read recording, " << filePath << " is truncated, its header lists "
+                     << numFrames << " frames of " << numDevices << " devices";
+        return false;
+    }
+
+    std::vector<Frame> frames(numFrames);
+    for (Frame& frame : frames)
+    {
+        readValue(file, frame.dt);
+        frame.states.resize(numDevices);
+        frame.buttons.resize(numDevices);
+        for (uint32_t i = 0; i < numDevices; i++)
+        {
+            double words[numStateWords];
+            file.read(reinterpret_cast<char*>(words), sizeof(words));
+
+            DeviceState& state = frame.states[i];
+            state.position        = Vec3d(words[0], words[1], words[2]);
+            state.velocity        = Vec3d(words[3], words[4], words[5]);
+            state.angularVelocity = Vec3d(words[6], words[7], words[8]);
+            state.orientation     = Quatd(words[12], words[9], words[10], words[11]);
+            state.timestamp       = words[13];
+
+            uint32_t numButtons = 0;
+            readValue(file, numButtons);
+            for (uint32_t j = 0; j < numButtons && file; j++)
+            {
+                int32_t id = 0, buttonState = 0;
+                readValue(file, id);
+                readValue(file, buttonState);
+                frame.buttons[i].push_back(std::pair<int, int>(id, buttonState));
+            }
+        }
+        if (!file)
+        {
+            LOG(WARNING) << "Failed to read recording, " << filePath << " is truncated";
+            return false;
+        }
+    }
+
+    m_numDevices = static_cast<int>(numDevices);
+    m_frames     = std::move(frames);
+    return true;
+}
+} // namespace imstk
@@ -0,0 +1,84 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkDeviceClient.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace imstk
+{
+///
+/// \class DeviceRecording
+///
+/// \brief Input of a set of devices recorded over a run, one frame per simulation step
+/// holding the time step taken and the tracking state and buttons of every device.
+/// Replaying it makes a run with live devices repeatable, ie: for benchmarking
+///
+class DeviceRecording
+{
+public:
+    struct Frame
+    {
+        double dt = 0.0;                                       ///< Time step of the frame
+        std::vector<DeviceState> states;                       ///< State of every device
+        std::vector<std::vector<std::pair<int, int>>> buttons; ///< (id, state) of the buttons of every device
+    };
+
+    DeviceRecording(const int numDevices = 0) : m_numDevices(numDevices) { }
+    virtual ~DeviceRecording() = default;
+
+public:
+    ///
+    /// \brief Get the number of devices recorded
+    ///
+    int getNumDevices() const { return m_numDevices; }
+
+    ///
+    /// \brief Get the number of frames
+    ///
+    int getNumFrames() const { return static_cast<int>(m_frames.size()); }
+
+    ///
+    /// \brief Get a frame
+    ///
+    const Frame& getFrame(const int i) const { return m_frames[i]; }
+
+    ///
+    /// \brief Add a frame, must have a state for every device
+    ///
+    void addFrame(const Frame& frame);
+
+    ///
+    /// \brief Sample the devices into a new frame
+    ///
+    void addFrame(const double dt, const std::vector<std::shared_ptr<DeviceClient>>& devices);
+
+    ///
+    /// \brief Remove all frames and set the number of devices
+    ///
+    void clear(const int numDevices);
+
+    ///
+    /// \brief Sum of the time steps of all frames
+    ///
+    double getTotalTime() const;
+
+    ///
+    /// \brief Write/Read the binary recording file, returns false on failure
+    ///@{
+    bool write(const std::string& filePath) const;
+    bool read(const std::string& filePath);
+    ///@}
+
+protected:
+    int m_numDevices = 0;
+    std::vector<Frame> m_frames;
+};
+} // namespace imstk
@@ -10,12 +10,17 @@
 namespace imstk
 {
 void
-DummyClient::setButton(const unsigned int buttonId, const bool buttonStatus)
+DummyClient::setButton(const int buttonId, const int buttonStatus)
 {
-    auto x = m_buttons.find(buttonId);
-    if (x != m_buttons.end())
+    m_dataLock.lock();
+    auto       x       = m_buttons.find(buttonId);
+    const bool changed = (x == m_buttons.end() || x->second != buttonStatus);
+    m_buttons[buttonId] = buttonStatus;
+    m_dataLock.unlock();
+
+    if (changed)
     {
-        x->second = buttonStatus;
+        postEvent(ButtonEvent(DummyClient::buttonStateChanged(), buttonId, buttonStatus));
     }
 }
 } // namespace imstk
\ No newline at end of file
@@ -32,7 +32,7 @@ protected:
     {
         for (unsigned int i = 0; i < numButtons; i++)
         {
-            m_buttons[i] = false;
+            m_buttons[i] = BUTTON_RELEASED;
         }
     }
 
@@ -43,17 +43,29 @@ public:
     ///
     /// \brief Set position
     ///
-    void setPosition(const Vec3d& pos) { m_position = pos; }
+    void setPosition(const Vec3d& pos)
+    {
+        m_position = pos;
+        publishState();
+    }
 
     ///
     /// \brief Set velocity
     ///
-    void setVelocity(const Vec3d& vel) { m_velocity = vel; }
+    void setVelocity(const Vec3d& vel)
+    {
+        m_velocity = vel;
+        publishState();
+    }
 
     ///
     /// \brief Set orientation
     ///
-    void setOrientation(const Quatd& orient) { m_orientation = orient; }
+    void setOrientation(const Quatd& orient)
+    {
+        m_orientation = orient;
+        publishState();
+    }
 
     ///
     /// \brief Set orientation from 4x4 transform
@@ -61,14 +73,40 @@ public:
     void setOrientation(double* transform)
     {
         m_orientation = (Eigen::Affine3d(Eigen::Matrix4d(transform))).rotation();
+        publishState();
     }
 
     ///
-    /// \brief Set the button status if it exists
+    /// \brief Set the whole tracking state, keeping its timestamp. Used to replay
+    /// a recorded state
+    ///
+    void setDeviceState(const DeviceState& state)
+    {
+        m_position        = state.position;
+        m_velocity        = state.velocity;
+        m_angularVelocity = state.angularVelocity;
+        m_orientation     = state.orientation;
+        publishState(state.timestamp);
+    }
+
+    ///
+    /// \brief Acts as one servo tick of a device thread, computes the force to render
+    /// at the given time
+    ///
+    void renderForce(const double time) { m_renderedForce = computeForce(time); }
+    void renderForce() { renderForce(getTime()); }
+
+    ///
+    /// \brief Force computed by the last renderForce
+    ///
+    const Vec3d& getRenderedForce() const { return m_renderedForce; }
+
+    ///
+    /// \brief Set the button status, posts buttonStateChanged when it changes
     ///
-    void setButton(const unsigned int buttonId, const bool buttonStatus);
+    void setButton(const int buttonId, const int buttonStatus);
 
 protected:
-    std::unordered_map<int, bool> m_buttons;
+    Vec3d m_renderedForce = Vec3d::Zero();
 };
 } // namespace imstk
@@ -98,30 +98,29 @@ HapticDeviceClient::hapticCallback(void* pData)
         return HD_CALLBACK_DONE;
     }
 
-    client->m_forceLock.lock();
-    const Vec3d force = client->m_force;
-    client->m_forceLock.unlock();
-
     hdBeginFrame(handle);
 
     hdMakeCurrentDevice(handle);
-    hdSetDoublev(HD_CURRENT_FORCE, force.data());
     hdGetDoublev(HD_CURRENT_POSITION, state.pos);
     hdGetDoublev(HD_CURRENT_VELOCITY, state.vel);
     hdGetDoublev(HD_CURRENT_ANGULAR_VELOCITY, state.angularVel);
     hdGetDoublev(HD_CURRENT_TRANSFORM, state.transform);
     hdGetIntegerv(HD_CURRENT_BUTTONS, &state.buttons);
 
-    hdEndFrame(handle);
-
-    // Might be worth locking each part separately
-    const Quatd orientation = Quatd((Eigen::Affine3d(Eigen::Matrix4d(state.transform))).rotation());
-    client->m_transformLock.lock();
+    // Publish the pose, readers never block this thread
+    const double time = getTime();
     client->m_position << state.pos[0], state.pos[1], state.pos[2];
     client->m_velocity << state.vel[0], state.vel[1], state.vel[2];
     client->m_angularVelocity << state.angularVel[0], state.angularVel[1], state.angularVel[2];
-    client->m_orientation = orientation;
-    client->m_transformLock.unlock();
+    client->m_orientation = Quatd((Eigen::Affine3d(Eigen::Matrix4d(state.transform))).rotation());
+    client->publishState(time);
+
+    // Render the force against the pose just read, the proxy keeps this at servo rate
+    // when physics updates it slower
+    const Vec3d force = client->computeForce(time);
+    hdSetDoublev(HD_CURRENT_FORCE, force.data());
+
+    hdEndFrame(handle);
 
     client->m_dataLock.lock();
     for (int i = 0; i < 4; i++)
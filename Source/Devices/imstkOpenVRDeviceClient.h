@@ -55,6 +55,7 @@ public:
         m_trackingEnabled = true;
         m_position    = pos;
         m_orientation = orientation;
+        publishState();
     }
 
 protected:
@@ -32,10 +32,9 @@ VRPNDeviceClient::trackerPositionChangeHandler(void* userData, const _vrpn_TRACK
     quat.z() = t.quat[3];
     quat.w() = t.quat[0];
 
-    deviceClient->m_transformLock.lock();
     deviceClient->m_position << t.pos[0], t.pos[1], t.pos[2];
     deviceClient->m_orientation = quat;
-    deviceClient->m_transformLock.unlock();
+    deviceClient->publishState();
 }
 
 void VRPN_CALLBACK
@@ -57,12 +56,11 @@ VRPNDeviceClient::trackerVelocityChangeHandler(void* userData, const _vrpn_TRACK
     auto  deviceClient = reinterpret_cast<VRPNDeviceClient*>(userData);
     Quatd quat(v.vel_quat[1], v.vel_quat[2], v.vel_quat[3], v.vel_quat[0]);
 
-    deviceClient->m_transformLock.lock();
     deviceClient->m_velocity << v.vel[0], v.vel[1], v.vel[2];
     // \todo translate velocity quaternion to imstk
     // deviceClient->m_angularVelocity = quat;
     //
-    deviceClient->m_transformLock.unlock();
+    deviceClient->publishState();
 }
 
 void VRPN_CALLBACK
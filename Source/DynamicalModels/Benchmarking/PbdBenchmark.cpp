@@ -7,12 +7,15 @@
 #include "imstkCapsule.h"
 #include "imstkCollisionHandling.h"
 #include "imstkGeometry.h"
+#include "imstkGeometryUtilities.h"
 #include "imstkMath.h"
 #include "imstkMeshIO.h"
+#include "imstkPbdConstraintContainer.h"
 #include "imstkPbdModel.h"
 #include "imstkPbdObject.h"
 #include "imstkPbdObjectCollision.h"
 #include "imstkPointSetToCapsuleCD.h"
+#include "imstkPointSet.h"
 #include "imstkPointwiseMap.h"
 #include "imstkSphere.h"
 #include "imstkScene.h"
@@ -23,6 +26,9 @@
 
 #include <benchmark/benchmark.h>
 
+#include <numeric>
+#include <random>
+
 using namespace imstk;
 
 ///
@@ -357,6 +363,300 @@ BENCHMARK(BM_PbdFem)
 ->Name("FEM Constraints: Tet Mesh")
 ->ArgsProduct({ { 4, 6, 8, 10, 16, 20 }, { 2, 5, 8 } });
 
+///
+/// \brief Constraints of the precision benchmarks
+///
+enum class PrecisionConstraints
+{
+    Fem,              ///< StVK FEM constraints on a tet mesh
+    DistanceVolume,   ///< Distance+Volume constraints on a tet mesh
+    DistanceDihedral  ///< Distance+Dihedral constraints on the surface of the tet mesh
+};
+
+///
+/// \brief Creates a scene with a hanging tet grid, or its surface
+/// \param dim dimensions of tetrahedral grid
+/// \param constraints constraints simulating the mesh
+/// \param singlePrecision whether constraints are solved in single precision
+/// \param mesh returns the simulated mesh
+///
+static std::shared_ptr<Scene>
+makePbdPrecisionScene(const int dim, const PrecisionConstraints constraints, const bool singlePrecision,
+                      std::shared_ptr<PointSet>& mesh)
+{
+    auto scene    = std::make_shared<Scene>("PbdBenchmark");
+    auto prismObj = std::make_shared<PbdObject>("Prism");
+
+    std::shared_ptr<TetrahedralMesh> prismMesh = makeTetGrid(Vec3d(4.0, 4.0, 4.0), Vec3i(dim, dim, dim), Vec3d(0.0, 0.0, 0.0));
+    mesh = prismMesh;
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    switch (constraints)
+    {
+    case PrecisionConstraints::Fem:
+        pbdParams->m_femParams->m_YoungModulus = 5.0;
+        pbdParams->m_femParams->m_PoissonRatio = 0.4;
+        pbdParams->enableFemConstraint(PbdFemConstraint::MaterialType::StVK);
+        break;
+    case PrecisionConstraints::DistanceVolume:
+        pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 1.0);
+        pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0);
+        break;
+    case PrecisionConstraints::DistanceDihedral:
+        pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Dihedral, 1.0);
+        pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0);
+        mesh = prismMesh->extractSurfaceMesh();
+        break;
+    }
+
+    pbdParams->m_doPartitioning   = false;
+    pbdParams->m_uniformMassValue = 0.05;
+    pbdParams->m_gravity    = Vec3d(0.0, -1.0, 0.0);
+    pbdParams->m_dt         = 0.05;
+    pbdParams->m_iterations = 5;
+    pbdParams->m_viscousDampingCoeff = 0.03;
+    pbdParams->m_singlePrecision     = singlePrecision;
+
+    // Fix the top
+    for (int i = 0; i < mesh->getNumVertices(); i++)
+    {
+        if (mesh->getVertexPosition(i)[1] == 2.0)
+        {
+            pbdParams->m_fixedNodeIds.push_back(i);
+        }
+    }
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(mesh);
+    pbdModel->configure(pbdParams);
+
+    prismObj->setPhysicsGeometry(mesh);
+    prismObj->setDynamicalModel(pbdModel);
+
+    scene->addSceneObject(prismObj);
+    scene->initialize();
+    return scene;
+}
+
+///
+/// \brief Time evolution step of PBD solved in double (0) or single (1) precision.
+/// Drift gives the largest distance of a vertex to a double precision run of the
+/// same number of steps
+///
+static void
+BM_PbdPrecision(benchmark::State& state, const PrecisionConstraints constraints)
+{
+    const double              dt = 0.05;
+    std::shared_ptr<PointSet> mesh;
+    std::shared_ptr<Scene>    scene = makePbdPrecisionScene(state.range(0), constraints, state.range(1) == 1, mesh);
+
+    state.counters["DOFs"] = mesh->getNumVertices();
+
+    // This loop gets timed
+    int numSteps = 0;
+    for (auto _ : state)
+    {
+        scene->advance(dt);
+        numSteps++;
+    }
+
+    std::shared_ptr<PointSet> refMesh;
+    std::shared_ptr<Scene>    refScene = makePbdPrecisionScene(state.range(0), constraints, false, refMesh);
+    for (int i = 0; i < numSteps; i++)
+    {
+        refScene->advance(dt);
+    }
+    double drift = 0.0;
+    for (int i = 0; i < mesh->getNumVertices(); i++)
+    {
+        drift = std::max(drift, (mesh->getVertexPosition(i) - refMesh->getVertexPosition(i)).norm());
+    }
+    state.counters["Drift"] = drift;
+}
+
+BENCHMARK_CAPTURE(BM_PbdPrecision, Fem, PrecisionConstraints::Fem)
+->Unit(benchmark::kMillisecond)
+->Name("FEM Constraints Precision: Tet Mesh")
+->ArgsProduct({ { 8, 16, 20 }, { 0, 1 } });
+
+BENCHMARK_CAPTURE(BM_PbdPrecision, DistanceVolume, PrecisionConstraints::DistanceVolume)
+->Unit(benchmark::kMillisecond)
+->Name("Distance and Volume Constraints Precision: Tet Mesh")
+->ArgsProduct({ { 8, 16, 20 }, { 0, 1 } });
+
+BENCHMARK_CAPTURE(BM_PbdPrecision, DistanceDihedral, PrecisionConstraints::DistanceDihedral)
+->Unit(benchmark::kMillisecond)
+->Name("Distance and Dihedral Constraints Precision: Surface Mesh")
+->ArgsProduct({ { 16, 26, 38 }, { 0, 1 } });
+
+///
+/// \brief Time evolution step of PBD using stiff Distance+Volume constraints on a tet mesh,
+/// the same number of constraint projections are split into a varying number of substeps.
+/// Residual gives the mean absolute constraint value at the end of the run
+///
+static void
+BM_PbdSubstepping(benchmark::State& state)
+{
+    auto   scene = std::make_shared<Scene>("PbdBenchmark");
+    double dt    = 0.05;
+
+    auto prismObj = std::make_shared<PbdObject>("Prism");
+
+    std::shared_ptr<TetrahedralMesh> prismMesh = makeTetGrid(
+        Vec3d(4.0, 4.0, 4.0),
+        Vec3i(10, 10, 10),
+        Vec3d(0.0, 0.0, 0.0));
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 1.0e6);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e6);
+
+    pbdParams->m_doPartitioning   = false;
+    pbdParams->m_uniformMassValue = 0.05;
+    pbdParams->m_gravity    = Vec3d(0.0, -10.0, 0.0);
+    pbdParams->m_dt         = dt;
+    pbdParams->m_substeps   = state.range(0);
+    pbdParams->m_iterations = state.range(1);
+    pbdParams->m_viscousDampingCoeff = 0.03;
+
+    // Fix one side
+    for (int z = 0; z < 10; z++)
+    {
+        for (int y = 0; y < 10; y++)
+        {
+            pbdParams->m_fixedNodeIds.push_back(10 * (y + 10 * z));
+        }
+    }
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(prismMesh);
+    pbdModel->configure(pbdParams);
+
+    prismObj->setPhysicsGeometry(prismMesh);
+    prismObj->setDynamicalModel(pbdModel);
+
+    scene->addSceneObject(prismObj);
+    scene->initialize();
+
+    state.counters["Substeps"]   = state.range(0);
+    state.counters["Iterations"] = state.range(1);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        scene->advance(dt);
+    }
+
+    const std::vector<std::shared_ptr<PbdConstraint>>& constraints = pbdModel->getConstraints()->getConstraints();
+    const VecDataArray<double, 3>&                     positions   = *prismMesh->getVertexPositions();
+    std::vector<Vec3d>                                 dcdx(4);
+    double                                             residual = 0.0;
+    for (const auto& constraint : constraints)
+    {
+        double c = 0.0;
+        constraint->computeValueAndGradient(positions, c, dcdx);
+        residual += std::abs(c);
+    }
+    state.counters["Residual"] = residual / constraints.size();
+}
+
+BENCHMARK(BM_PbdSubstepping)
+->Unit(benchmark::kMillisecond)
+->Name("Distance and Volume Constraints Substepping: Tet Mesh")
+->Args({ 1, 20 })
+->Args({ 2, 10 })
+->Args({ 5, 4 })
+->Args({ 10, 2 })
+->Args({ 20, 1 });
+
+///
+/// \brief Time evolution step of PBD using FEM constraints on a tet mesh whose vertices
+/// are in order (0), randomly shuffled (1), shuffled then renumbered with Reverse
+/// Cuthill-Mckee (2) or shuffled then renumbered along a space filling curve (3) on initialize
+///
+static void
+BM_PbdRenumbering(benchmark::State& state)
+{
+    const int dim   = state.range(0);
+    auto      scene = std::make_shared<Scene>("PbdBenchmark");
+    double    dt    = 0.05;
+
+    auto prismObj = std::make_shared<PbdObject>("Prism");
+
+    std::shared_ptr<TetrahedralMesh> prismMesh = makeTetGrid(Vec3d(4.0, 4.0, 4.0), Vec3i(dim, dim, dim), Vec3d(0.0, 0.0, 0.0));
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->m_femParams->m_YoungModulus = 5.0;
+    pbdParams->m_femParams->m_PoissonRatio = 0.4;
+    pbdParams->enableFemConstraint(PbdFemConstraint::MaterialType::StVK);
+
+    pbdParams->m_doPartitioning   = false;
+    pbdParams->m_uniformMassValue = 0.05;
+    pbdParams->m_gravity    = Vec3d(0.0, -1.0, 0.0);
+    pbdParams->m_dt         = dt;
+    pbdParams->m_iterations = 5;
+    pbdParams->m_viscousDampingCoeff = 0.03;
+
+    // Fix the top
+    for (int z = 0; z < dim; z++)
+    {
+        for (int x = 0; x < dim; x++)
+        {
+            pbdParams->m_fixedNodeIds.push_back(x + dim * ((dim - 1) + dim * z));
+        }
+    }
+
+    // Scramble the mesh as a poorly ordered input would be
+    if (state.range(1) > 0)
+    {
+        std::vector<size_t> newToOld(prismMesh->getNumVertices());
+        std::iota(newToOld.begin(), newToOld.end(), 0);
+        std::shuffle(newToOld.begin(), newToOld.end(), std::mt19937(0));
+        GeometryUtils::permuteVertices(prismMesh, newToOld);
+
+        std::vector<size_t> oldToNew(newToOld.size());
+        for (size_t i = 0; i < newToOld.size(); i++)
+        {
+            oldToNew[newToOld[i]] = i;
+        }
+        for (size_t& id : pbdParams->m_fixedNodeIds)
+        {
+            id = oldToNew[id];
+        }
+    }
+    if (state.range(1) > 1)
+    {
+        prismObj->setRenumberPhysicsMesh(true);
+        prismObj->setRenumberingStrategy(state.range(1) == 2 ?
+            GeometryUtils::MeshNodeRenumberingStrategy::ReverseCuthillMckee :
+            GeometryUtils::MeshNodeRenumberingStrategy::SpaceFillingCurve);
+    }
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(prismMesh);
+    pbdModel->configure(pbdParams);
+
+    prismObj->setPhysicsGeometry(prismMesh);
+    prismObj->setDynamicalModel(pbdModel);
+
+    scene->addSceneObject(prismObj);
+    scene->initialize();
+
+    state.counters["DOFs"] = prismMesh->getNumVertices();
+    state.counters["Tets"] = prismMesh->getNumTetrahedra();
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        scene->advance(dt);
+    }
+}
+
+BENCHMARK(BM_PbdRenumbering)
+->Unit(benchmark::kMillisecond)
+->Name("FEM Constraints Renumbering: Tet Mesh")
+->ArgsProduct({ { 16, 24, 32 }, { 0, 1, 2, 3 } });
+
 ///
 /// \brief Time evolution step of PBD using distance+volume constraint on volume mesh
 /// includes contact with a capsule
@@ -679,5 +979,79 @@ BENCHMARK(BM_PbdFemContact)
 ->Name("FEM Constraints with contact: Tet Mesh")
 ->ArgsProduct({ { 4, 6, 8, 10, 16, 20 }, { 2, 5, 8 } });
 
+///
+/// \brief Time evolution step of PBD using the constant density constraint on a block
+/// of fluid particles, with and without reusing neighbors over iterations
+///
+static void
+BM_PbdFluid(benchmark::State& state)
+{
+    // Setup simulation
+    auto scene = std::make_shared<Scene>("PbdBenchmark");
+
+    double dt = 0.005;
+
+    // Create PBD object
+    auto fluidObj = std::make_shared<PbdObject>("Fluid");
+
+    // Setup the Geometry, a block of particles spaced under the particle radius
+    const double particleRadius = 0.5;
+    const int    dim = state.range(0);
+    auto         verticesPtr = std::make_shared<VecDataArray<double, 3>>(dim * dim * dim);
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                (*verticesPtr)[x + dim * (y + dim * z)] = Vec3d(x, y, z) * particleRadius * 0.5;
+            }
+        }
+    }
+    auto fluidMesh = std::make_shared<PointSet>();
+    fluidMesh->initialize(verticesPtr);
+
+    // Setup the Parameters
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+
+    // Use constant density constraint, reuse neighbors while particles move less than half the skin
+    const double neighborSkin = (state.range(2) == 1) ? particleRadius * 0.2 : 0.0;
+    pbdParams->enableConstantDensityConstraint(1.0, particleRadius, 6378.0, neighborSkin);
+
+    pbdParams->m_uniformMassValue = 1.0;
+    pbdParams->m_gravity    = Vec3d(0.0, -9.8, 0.0);
+    pbdParams->m_dt         = dt;
+    pbdParams->m_iterations = state.range(1);
+
+    // Setup the Model
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(fluidMesh);
+    pbdModel->configure(pbdParams);
+
+    // Setup the Object
+    fluidObj->setPhysicsGeometry(fluidMesh);
+    fluidObj->setDynamicalModel(pbdModel);
+
+    // Create the scene
+    scene->addSceneObject(fluidObj);
+    scene->initialize();
+
+    // Setup outputs for results
+    state.counters["Particles"]  = fluidMesh->getNumVertices();
+    state.counters["Iterations"] = state.range(1);
+    state.counters["Reuse"]      = state.range(2);
+
+    // This loop gets timed
+    for (auto _ : state)
+    {
+        scene->advance(dt);
+    }
+}
+
+BENCHMARK(BM_PbdFluid)
+->Unit(benchmark::kMillisecond)
+->Name("Constant Density Constraint: Fluid")
+->ArgsProduct({ { 10, 20, 30 }, { 2, 10 }, { 0, 1 } });
+
 // Run the benchmark
 BENCHMARK_MAIN();
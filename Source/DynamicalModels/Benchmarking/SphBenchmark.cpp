@@ -0,0 +1,88 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkSphChannelFlow.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Sph fluid continuously flowing through a vessel like channel, particles
+/// being emitted at the inlet and recycled at the outlet every step, as in a bleeding scene
+///
+namespace
+{
+///
+/// \brief Channel of numParticles fluid particles along x with a cross section of 16x16
+/// particles, with as many buffer particles as fluid particles
+///
+std::shared_ptr<SphModel>
+makeChannelFlow(const int numParticles, const SphKernelExecution execution = SphKernelExecution::MultiPass)
+{
+    const Vec3i dim(std::max(numParticles / 256, 1), 16, 16);
+    return makeSphChannelFlow(dim, 0.005, dim[0] * dim[1] * dim[2], execution);
+}
+} // namespace
+
+///
+/// \brief Full step of the flowing fluid with the given kernel execution
+///
+static void
+BM_SphStep(benchmark::State& state, const SphKernelExecution execution)
+{
+    std::shared_ptr<SphModel>            sphModel = makeChannelFlow(static_cast<int>(state.range(0)), execution);
+    std::shared_ptr<TaskGraphController> taskGraphController = initSphController(sphModel);
+    for (auto _ : state)
+    {
+        taskGraphController->execute();
+    }
+    state.counters["Particles"] = static_cast<double>(sphModel->getCurrentState()->getNumParticles());
+}
+
+BENCHMARK_CAPTURE(BM_SphStep, MultiPass, SphKernelExecution::MultiPass)
+->Unit(benchmark::kMillisecond)
+->Arg(25000)->Arg(200000)
+->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_SphStep, Fused, SphKernelExecution::Fused)
+->Unit(benchmark::kMillisecond)
+->Arg(25000)->Arg(200000)
+->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_SphStep, FusedFloatCache, SphKernelExecution::FusedFloatCache)
+->Unit(benchmark::kMillisecond)
+->Arg(25000)->Arg(200000)
+->UseRealTime();
+
+///
+/// \brief Only move the particles and handle the inlet, outlet and buffer of the flowing fluid
+///
+static void
+BM_SphMoveParticles(benchmark::State& state)
+{
+    std::shared_ptr<SphModel>            sphModel = makeChannelFlow(static_cast<int>(state.range(0)));
+    std::shared_ptr<TaskGraphController> taskGraphController = initSphController(sphModel);
+    for (int i = 0; i < 10; i++)
+    {
+        taskGraphController->execute();
+    }
+    std::shared_ptr<TaskNode> moveParticlesNode = sphModel->getMoveParticlesNode();
+    for (auto _ : state)
+    {
+        moveParticlesNode->execute();
+    }
+    state.counters["Particles"] = static_cast<double>(sphModel->getCurrentState()->getNumParticles());
+    state.counters["Buffer"]    = static_cast<double>(sphModel->getBoundaryConditions()->getBufferIndices().size());
+}
+
+BENCHMARK(BM_SphMoveParticles)
+->Unit(benchmark::kMicrosecond)
+->Name("Sph move particles, channel flow")
+->Arg(25000)->Arg(200000)
+->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -12,6 +12,7 @@
 
 namespace imstk
 {
+class StateBuffers;
 class TaskGraph;
 class TaskNode;
 
@@ -68,6 +69,12 @@ public:
     ///
     virtual void resetToInitialState() = 0;
 
+    ///
+    /// \brief Add the memory holding the state of the model, see Scene::captureSnapshot.
+    /// Nothing by default
+    ///
+    virtual void getStateBuffers(StateBuffers& imstkNotUsed(buffers)) { }
+
     ///
     /// \brief Get/Set the number of degrees of freedom
     ///@{
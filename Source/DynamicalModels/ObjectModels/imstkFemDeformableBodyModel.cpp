@@ -12,6 +12,7 @@
 #include "imstkLogger.h"
 #include "imstkNewtonSolver.h"
 #include "imstkPointSet.h"
+#include "imstkStateBuffers.h"
 #include "imstkTaskGraph.h"
 #include "imstkTimeIntegrator.h"
 #include "imstkTypes.h"
@@ -914,4 +915,15 @@ FemDeformableBodyModel::initGraphEdges(std::shared_ptr<TaskNode> source, std::sh
     m_taskGraph->addEdge(source, m_solveNode);
     m_taskGraph->addEdge(m_solveNode, sink);
 }
+
+void
+FemDeformableBodyModel::getStateBuffers(StateBuffers& buffers)
+{
+    for (const auto& state : { m_currentState, m_previousState })
+    {
+        buffers.add(state->getQ());
+        buffers.add(state->getQDot());
+        buffers.add(state->getQDotDot());
+    }
+}
 } // namespace imstk
\ No newline at end of file
@@ -78,6 +78,11 @@ public:
     ///
     bool initialize() override;
 
+    ///
+    /// \brief Adds the current and previous states
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
     ///
     /// \brief Get/Set force model configuration
     ///@{
@@ -77,10 +77,13 @@ LevelSetModel::initialize()
         m_forwardGrad.setDx(Vec3i(1, 1, 1), actualSpacing);
         m_backwardGrad.setDx(Vec3i(1, 1, 1), actualSpacing);
         m_curvature.setDx(Vec3i(1, 1, 1), actualSpacing);
-    }
+        m_invSpacing = actualSpacing.cwiseInverse();
 
-    m_nodeUpdatePool.resize(5000);
-    noteUpdatePoolSize = 0;
+        // Grid of bricks covering the image, only the bricks with impulses are allocated
+        m_brickGridDim = (sdfImage->getDimensions() + Vec3i(BrickSize - 1, BrickSize - 1, BrickSize - 1)) / BrickSize;
+        m_brickIndices.assign(m_brickGridDim[0] * m_brickGridDim[1] * m_brickGridDim[2], -1);
+        m_numActiveBricks = 0;
+    }
 
     return true;
 }
@@ -106,87 +109,32 @@ LevelSetModel::evolve()
     if (m_config->m_sparseUpdate)
     {
         // Sparse update
-        if (m_nodesToUpdate.size() == 0)
+        if (m_numActiveBricks == 0)
         {
             return;
         }
 
-        // Setup a map of 0 based index -> image sparse index m_nodesToUpdate to parallelize
-        std::vector<size_t> baseIndexToImageIndex;
-        baseIndexToImageIndex.reserve(m_nodesToUpdate.size());
-        for (std::unordered_map<size_t, std::tuple<Vec3i, double>>::iterator iter = m_nodesToUpdate.begin(); iter != m_nodesToUpdate.end(); iter++)
-        {
-            baseIndexToImageIndex.push_back(iter->first);
-        }
-        DISABLE_WARNING_PUSH
-        DISABLE_WARNING_PADDING
-
-        // Compute gradients
-        const double                             constantVel = m_config->m_constantVelocity;
-        std::tuple<size_t, Vec3i, double, Vec2d> val;
         for (int j = 0; j < m_config->m_substeps; j++)
         {
-            ParallelUtils::parallelFor(baseIndexToImageIndex.size(), [&](const size_t i)
+            // Gather the distances of all bricks before any is updated
+            ParallelUtils::parallelFor(m_numActiveBricks, [&](const int i)
                 {
-                    std::tuple<size_t, Vec3i, double, Vec2d, double>& outputVal = m_nodeUpdatePool[i];
-                    const size_t& index = std::get<0>(outputVal) = baseIndexToImageIndex[i];
-
-                    std::tuple<Vec3i, double>& inputVal = m_nodesToUpdate[index];
-
-                    const Vec3i& coords    = std::get<1>(outputVal) = std::get<0>(inputVal);
-                    std::get<2>(outputVal) = std::get<1>(inputVal);
-
-                    // Gradients
-                    const Vec3d gradPos = m_forwardGrad(Vec3d(coords[0], coords[1], coords[2]));
-                    const Vec3d gradNeg = m_backwardGrad(Vec3d(coords[0], coords[1], coords[2]));
-
-                    Vec3d gradNegMax = gradNeg.cwiseMax(0.0);
-                    Vec3d gradNegMin = gradNeg.cwiseMin(0.0);
-                    Vec3d gradPosMax = gradPos.cwiseMax(0.0);
-                    Vec3d gradPosMin = gradPos.cwiseMin(0.0);
-
-                    // Square them
-                    gradNegMax = gradNegMax.cwiseProduct(gradNegMax);
-                    gradNegMin = gradNegMin.cwiseProduct(gradNegMin);
-                    gradPosMax = gradPosMax.cwiseProduct(gradPosMax);
-                    gradPosMin = gradPosMin.cwiseProduct(gradPosMin);
-
-                    const double posMag =
-                        gradNegMax[0] + gradNegMax[1] + gradNegMax[2] +
-                        gradPosMin[0] + gradPosMin[1] + gradPosMin[2];
-
-                    const double negMag =
-                        gradNegMin[0] + gradNegMin[1] + gradNegMin[2] +
-                        gradPosMax[0] + gradPosMax[1] + gradPosMax[2];
-
-                    std::get<3>(outputVal) = Vec2d(negMag, posMag);
-
-                    // Curvature
-                    //const double kappa = m_curvature(Vec3d(coords[0], coords[1], coords[2]));
-                }, baseIndexToImageIndex.size() > 50);
+                    gatherDistances(m_bricks[i], *sdf);
+                }, m_numActiveBricks > 1);
 
             // Update levelset
-            ParallelUtils::parallelFor(baseIndexToImageIndex.size(), [&](const size_t& i)
+            ParallelUtils::parallelFor(m_numActiveBricks, [&](const int i)
                 {
-                    const size_t index = std::get<0>(m_nodeUpdatePool[i]);
-                    const double vel   = std::get<2>(m_nodeUpdatePool[i]) + constantVel;
-                    const Vec2d& g     = std::get<3>(m_nodeUpdatePool[i]);
-                    //const double kappa = std::get<4>(nodeUpdates[i]);
+                    evolveBrick(m_bricks[i], imgPtr, dim, dt);
+                }, m_numActiveBricks > 1);
+        }
 
-                    // If speed function positive use forward difference (posMag)
-                    if (vel > 0.0)
-                    {
-                        imgPtr[index] += dt * (vel * std::sqrt(g[0]) /*+ kappa * k*/);
-                    }
-                    // If speed function negative use backward difference (negMag)
-                    else if (vel < 0.0)
-                    {
-                        imgPtr[index] += dt * (vel * std::sqrt(g[1]) /*+ kappa * k*/);
-                    }
-            }, noteUpdatePoolSize > m_maxVelocitiesParallel);
+        // Release the bricks, keeping them in the pool
+        for (int i = 0; i < m_numActiveBricks; i++)
+        {
+            m_brickIndices[m_bricks[i].brickId] = -1;
         }
-        DISABLE_WARNING_POP
-        m_nodesToUpdate.clear();
+        m_numActiveBricks = 0;
     }
     else
     {
@@ -263,21 +211,18 @@ LevelSetModel::addImpulse(const Vec3i& coord, double f)
         && coord[1] >= 0 && coord[1] < dim[1]
         && coord[2] >= 0 && coord[2] < dim[2])
     {
-        const size_t index = coord[0] + coord[1] * dim[0] + coord[2] * dim[0] * dim[1];
         if (m_config->m_sparseUpdate)
         {
-            if (m_nodesToUpdate.count(index) > 0)
-            {
-                m_nodesToUpdate[index] = std::tuple<Vec3i, double>(coord, std::max(std::get<1>(m_nodesToUpdate[index]), f));
-            }
-            else
-            {
-                m_nodesToUpdate[index] = std::tuple<Vec3i, double>(coord, f);
-            }
+            Brick&    brick = getBrick(coord);
+            const Vec3i local = coord - brick.start;
+            const int   nodeIndex = local[0] + BrickSize * (local[1] + BrickSize * local[2]);
+            brick.velocities[nodeIndex]  = brick.hasVelocity[nodeIndex] ? std::max(brick.velocities[nodeIndex], f) : f;
+            brick.hasVelocity[nodeIndex] = true;
         }
         else
         {
-            double* velocitiesPtr = static_cast<double*>(m_velocities->getScalars()->getVoidPointer());
+            const size_t index = coord[0] + coord[1] * dim[0] + coord[2] * dim[0] * dim[1];
+            double*      velocitiesPtr = static_cast<double*>(m_velocities->getScalars()->getVoidPointer());
             velocitiesPtr[index] = std::max(velocitiesPtr[index], f);
         }
     }
@@ -294,19 +239,181 @@ LevelSetModel::setImpulse(const Vec3i& coord, double f)
         && coord[1] >= 0 && coord[1] < dim[1]
         && coord[2] >= 0 && coord[2] < dim[2])
     {
-        const size_t index = coord[0] + coord[1] * dim[0] + coord[2] * dim[0] * dim[1];
         if (m_config->m_sparseUpdate)
         {
-            m_nodesToUpdate[index] = std::tuple<Vec3i, double>(coord, f);
+            Brick&    brick = getBrick(coord);
+            const Vec3i local = coord - brick.start;
+            const int   nodeIndex = local[0] + BrickSize * (local[1] + BrickSize * local[2]);
+            brick.velocities[nodeIndex]  = f;
+            brick.hasVelocity[nodeIndex] = true;
         }
         else
         {
-            double* velocitiesPtr = static_cast<double*>(m_velocities->getScalars()->getVoidPointer());
+            const size_t index = coord[0] + coord[1] * dim[0] + coord[2] * dim[0] * dim[1];
+            double*      velocitiesPtr = static_cast<double*>(m_velocities->getScalars()->getVoidPointer());
             velocitiesPtr[index] = f;
         }
     }
 }
 
+std::vector<Vec3i>
+LevelSetModel::getNodesToUpdate() const
+{
+    std::vector<Vec3i> coords;
+    for (int i = 0; i < m_numActiveBricks; i++)
+    {
+        const Brick& brick = m_bricks[i];
+        for (int j = 0; j < Brick::NumNodes; j++)
+        {
+            if (brick.hasVelocity[j])
+            {
+                coords.push_back(brick.start + Vec3i(j % BrickSize, (j / BrickSize) % BrickSize, j / (BrickSize * BrickSize)));
+            }
+        }
+    }
+    return coords;
+}
+
+LevelSetModel::Brick&
+LevelSetModel::getBrick(const Vec3i& coord)
+{
+    const Vec3i brickCoord = coord / BrickSize;
+    const int   brickId    = brickCoord[0] + m_brickGridDim[0] * (brickCoord[1] + m_brickGridDim[1] * brickCoord[2]);
+    int&        index      = m_brickIndices[brickId];
+    if (index == -1)
+    {
+        // Activate a brick from the pool
+        index = m_numActiveBricks++;
+        if (index == static_cast<int>(m_bricks.size()))
+        {
+            m_bricks.emplace_back();
+        }
+        Brick& brick = m_bricks[index];
+        brick.brickId = brickId;
+        brick.start   = brickCoord * BrickSize;
+        brick.hasVelocity.fill(false);
+    }
+    return m_bricks[index];
+}
+
+void
+LevelSetModel::gatherDistances(Brick& brick, const SignedDistanceField& sdf) const
+{
+    std::shared_ptr<ImageData>        image  = sdf.getImage();
+    const Vec3i&                      dim    = image->getDimensions();
+    const double*                     imgPtr = static_cast<const double*>(image->getVoidPointer());
+    const double                      scale  = sdf.getScale();
+
+    // The halo starts one node before the brick
+    const Vec3i haloStart = brick.start - Vec3i(1, 1, 1);
+    const Vec3i haloEnd   = haloStart + Vec3i(Brick::HaloSize, Brick::HaloSize, Brick::HaloSize);
+    const bool  xInside   = haloStart[0] > 0 && haloEnd[0] <= dim[0];
+    int         i = 0;
+    for (int z = haloStart[2]; z < haloEnd[2]; z++)
+    {
+        for (int y = haloStart[1]; y < haloEnd[1]; y++, i += Brick::HaloSize)
+        {
+            if (xInside && y > 0 && y < dim[1] && z > 0 && z < dim[2])
+            {
+                // Contiguous row within the image
+                const double* rowPtr = imgPtr + haloStart[0] + dim[0] * (y + dim[1] * z);
+                for (int x = 0; x < Brick::HaloSize; x++)
+                {
+                    brick.distances[i + x] = rowPtr[x] * scale;
+                }
+            }
+            else
+            {
+                for (int x = 0; x < Brick::HaloSize; x++)
+                {
+                    brick.distances[i + x] = sdf.getFunctionValueCoord(Vec3i(haloStart[0] + x, y, z));
+                }
+            }
+        }
+    }
+}
+
+void
+LevelSetModel::evolveBrick(const Brick& brick, double* imgPtr, const Vec3i& dim, const double dt) const
+{
+    const double  constantVel = m_config->m_constantVelocity;
+    const double* distances   = brick.distances.data();
+    const int     strideY     = Brick::HaloSize;
+    const int     strideZ     = Brick::HaloSize * Brick::HaloSize;
+
+    // Squared gradient magnitudes for positive and negative speeds of a row
+    double posMag[BrickSize];
+    double negMag[BrickSize];
+    for (int z = 0; z < BrickSize; z++)
+    {
+        for (int y = 0; y < BrickSize; y++)
+        {
+            // Stencils along the row, branchless such that they vectorize
+            const int haloRowStart = 1 + (y + 1) * strideY + (z + 1) * strideZ;
+            for (int x = 0; x < BrickSize; x++)
+            {
+                const int    h = haloRowStart + x;
+                const double c = distances[h];
+
+                const double gradPosX = (distances[h + 1] - c) * m_invSpacing[0];
+                const double gradPosY = (distances[h + strideY] - c) * m_invSpacing[1];
+                const double gradPosZ = (distances[h + strideZ] - c) * m_invSpacing[2];
+                const double gradNegX = (c - distances[h - 1]) * m_invSpacing[0];
+                const double gradNegY = (c - distances[h - strideY]) * m_invSpacing[1];
+                const double gradNegZ = (c - distances[h - strideZ]) * m_invSpacing[2];
+
+                const double gradNegMaxX = std::max(gradNegX, 0.0);
+                const double gradNegMaxY = std::max(gradNegY, 0.0);
+                const double gradNegMaxZ = std::max(gradNegZ, 0.0);
+                const double gradNegMinX = std::min(gradNegX, 0.0);
+                const double gradNegMinY = std::min(gradNegY, 0.0);
+                const double gradNegMinZ = std::min(gradNegZ, 0.0);
+                const double gradPosMaxX = std::max(gradPosX, 0.0);
+                const double gradPosMaxY = std::max(gradPosY, 0.0);
+                const double gradPosMaxZ = std::max(gradPosZ, 0.0);
+                const double gradPosMinX = std::min(gradPosX, 0.0);
+                const double gradPosMinY = std::min(gradPosY, 0.0);
+                const double gradPosMinZ = std::min(gradPosZ, 0.0);
+
+                posMag[x] =
+                    gradNegMaxX * gradNegMaxX + gradNegMaxY * gradNegMaxY + gradNegMaxZ * gradNegMaxZ +
+                    gradPosMinX * gradPosMinX + gradPosMinY * gradPosMinY + gradPosMinZ * gradPosMinZ;
+                negMag[x] =
+                    gradNegMinX * gradNegMinX + gradNegMinY * gradNegMinY + gradNegMinZ * gradNegMinZ +
+                    gradPosMaxX * gradPosMaxX + gradPosMaxY * gradPosMaxY + gradPosMaxZ * gradPosMaxZ;
+            }
+
+            // Update the nodes with impulses
+            const Vec3i rowStart  = brick.start + Vec3i(0, y, z);
+            const int   nodeIndex = BrickSize * (y + BrickSize * z);
+            if (rowStart[1] >= dim[1] || rowStart[2] >= dim[2])
+            {
+                continue;
+            }
+            double*   rowPtr = imgPtr + rowStart[0] + dim[0] * (rowStart[1] + dim[1] * rowStart[2]);
+            const int rowEnd = std::min(BrickSize, dim[0] - rowStart[0]);
+            for (int x = 0; x < rowEnd; x++)
+            {
+                if (!brick.hasVelocity[nodeIndex + x])
+                {
+                    continue;
+                }
+                const double vel = brick.velocities[nodeIndex + x] + constantVel;
+                // If speed function positive
+                if (vel > 0.0)
+                {
+                    rowPtr[x] += dt * (vel * std::sqrt(negMag[x]) /*+ kappa * k*/);
+                }
+                // If speed function negative
+                else if (vel < 0.0)
+                {
+                    rowPtr[x] += dt * (vel * std::sqrt(posMag[x]) /*+ kappa * k*/);
+                }
+            }
+        }
+    }
+}
+
 void
 LevelSetModel::resetToInitialState()
 {
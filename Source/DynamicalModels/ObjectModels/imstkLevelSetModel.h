@@ -9,8 +9,7 @@
 #include "imstkDynamicalModel.h"
 #include "imstkImplicitFunctionFiniteDifferenceFunctor.h"
 
-#include <unordered_map>
-#include <tuple>
+#include <array>
 
 namespace imstk
 {
@@ -19,7 +18,7 @@ class ImageData;
 struct LevelSetModelConfig
 {
     double m_dt = 0.001;             ///< Time step size
-    bool m_sparseUpdate = false;     ///< Only updates nodes that recieve force
+    bool m_sparseUpdate = false;     ///< Only updates nodes that recieve force, tracked in bricks
     bool m_useCurvature = false;
     double m_k = 0.05;               // Curvature term
     double m_constantVelocity = 0.0; // Constant velocity
@@ -32,9 +31,18 @@ struct LevelSetModelConfig
 /// \brief This class implements a generic level set model, it requires both a forward
 /// and backward finite differencing method
 ///
+/// In sparse mode the impulses are stored in bricks of BrickSize^3 nodes, only allocated
+/// where impulses are given, ie: in a narrow band around the surface. The active bricks are
+/// kept in a flat list and evolved in parallel with brick local stencils
+///
+/// The bricks only bound the cost of the update. The distances stay in the dense image of
+/// the SignedDistanceField, which its sampling, the collision detection and LocalMarchingCubes
+/// read directly, so the memory is that of the dense grid plus the pool of bricks
+///
 class LevelSetModel : public AbstractDynamicalModel
 {
 public:
+    static constexpr int BrickSize = 8;
     LevelSetModel();
     ~LevelSetModel() override = default;
 
@@ -73,7 +81,16 @@ public:
     std::shared_ptr<TaskNode> getGenerateVelocitiesBeginNode() const { return m_generateVelocitiesBegin; }
     std::shared_ptr<TaskNode> getGenerateVelocitiesEndNode() const { return m_generateVelocitiesEnd; }
 
-    std::unordered_map<size_t, std::tuple<Vec3i, double>>& getNodesToUpdate() { return m_nodesToUpdate; }
+    ///
+    /// \brief Get the coordinates of the nodes given impulses since the last evolve,
+    /// only in sparse mode
+    ///
+    std::vector<Vec3i> getNodesToUpdate() const;
+
+    ///
+    /// \brief Get the number of bricks with impulses since the last evolve, only in sparse mode
+    ///
+    int getNumActiveBricks() const { return m_numActiveBricks; }
 
     void resetToInitialState() override;
 
@@ -83,6 +100,37 @@ protected:
     ///
     void initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink) override;
 
+    ///
+    /// \brief Block of BrickSize^3 nodes of the image with impulses
+    ///
+    struct Brick
+    {
+        static constexpr int NumNodes     = BrickSize * BrickSize * BrickSize;
+        static constexpr int HaloSize     = BrickSize + 2;
+        static constexpr int NumHaloNodes = HaloSize * HaloSize * HaloSize;
+
+        int brickId = -1;                          ///< Index in the grid of bricks
+        Vec3i start;                               ///< Coordinate of the first node of the brick
+        std::array<double, NumNodes> velocities;   ///< Impulse of every node
+        std::array<bool, NumNodes> hasVelocity;    ///< Whether the node received an impulse
+        std::array<double, NumHaloNodes> distances; ///< Distances of the nodes and their direct neighbors
+    };
+
+    ///
+    /// \brief Get the brick of the node, activates it if it has none
+    ///
+    Brick& getBrick(const Vec3i& coord);
+
+    ///
+    /// \brief Copy the distances of the brick and its neighboring nodes
+    ///
+    void gatherDistances(Brick& brick, const SignedDistanceField& sdf) const;
+
+    ///
+    /// \brief Evolve the nodes with impulses of the brick given its gathered distances
+    ///
+    void evolveBrick(const Brick& brick, double* imgPtr, const Vec3i& dim, const double dt) const;
+
     std::shared_ptr<ImplicitGeometry> m_mesh = nullptr; ///< Geometry on which the levelset evolves with
 
     std::vector<std::shared_ptr<TaskNode>> m_evolveQuantitiesNodes;
@@ -92,10 +140,11 @@ protected:
 
     std::shared_ptr<LevelSetModelConfig> m_config;
 
-    std::unordered_map<size_t, std::tuple<Vec3i, double>> m_nodesToUpdate;
-    std::vector<std::tuple<size_t, Vec3i, double, Vec2d, double>> m_nodeUpdatePool;
-    size_t noteUpdatePoolSize;
-    size_t m_maxVelocitiesParallel = 100;                      // In sparse mode, if surpass this value, switch to parallel
+    Vec3i m_brickGridDim = Vec3i::Zero();                      ///< Number of bricks along x, y, z
+    std::vector<int>   m_brickIndices;                         ///< Brick grid -> index in m_bricks, -1 if inactive
+    std::vector<Brick> m_bricks;                               ///< Pool of bricks, the first m_numActiveBricks are active
+    int m_numActiveBricks = 0;
+    Vec3d m_invSpacing    = Vec3d::Ones();
 
     std::shared_ptr<ImageData> m_gradientMagnitudes = nullptr; ///< Gradient magnitude field when using dense
     std::shared_ptr<ImageData> m_velocities = nullptr;
@@ -729,6 +729,7 @@ struct PbdConstantDensityConstraintFunctor : public PbdConstraintFunctor
                 << "PbdConstantDensityConstraint can only be generated with a PointSet";
 
             auto c = std::make_shared<PbdConstantDensityConstraint>();
+            c->setNeighborSkin(m_neighborSkin);
             c->initConstraint(*m_geom->getVertexPositions(), m_particleRadius, m_restDensity);
             constraints.addConstraint(c);
         }
@@ -752,11 +753,20 @@ struct PbdConstantDensityConstraintFunctor : public PbdConstraintFunctor
         ///@{
         void setRestDensity(const double restDensity) { m_restDensity = restDensity; }
         double getRestDensity() const { return m_restDensity; }
+        ///@}
+
+        ///
+        /// \brief Get/Set the neighbor skin, neighbors are reused until a particle moves
+        /// more than half of it, default 0 (search every solver iteration)
+        ///@{
+        void setNeighborSkin(const double neighborSkin) { m_neighborSkin = neighborSkin; }
+        double getNeighborSkin() const { return m_neighborSkin; }
     ///@}
 
     protected:
         double m_stiffness      = 0.0;
         double m_particleRadius = 0.2;
         double m_restDensity    = 6378.0;
+        double m_neighborSkin   = 0.0;
 };
 } // namespace imstk
\ No newline at end of file
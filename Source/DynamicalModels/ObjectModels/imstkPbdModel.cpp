@@ -10,6 +10,7 @@
 #include "imstkLogger.h"
 #include "imstkParallelUtils.h"
 #include "imstkPbdSolver.h"
+#include "imstkStateBuffers.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkTaskGraph.h"
 #include "imstkTetrahedralMesh.h"
@@ -134,7 +135,8 @@ PbdModelConfig::enableBendConstraint(const double stiffness, const int stride, c
 
 void
 PbdModelConfig::enableConstantDensityConstraint(const double stiffness,
-                                                const double particleRadius, const double restDensity)
+                                                const double particleRadius, const double restDensity,
+                                                const double neighborSkin)
 {
     auto& funcs = m_functors[ConstraintGenType::ConstantDensity];
 
@@ -155,6 +157,7 @@ PbdModelConfig::enableConstantDensityConstraint(const double stiffness,
     foundFunctor->setParticleRadius(particleRadius);
     foundFunctor->setStiffness(stiffness);
     foundFunctor->setRestDensity(restDensity);
+    foundFunctor->setNeighborSkin(neighborSkin);
 }
 
 void
@@ -174,6 +177,8 @@ PbdModel::PbdModel() : DynamicalModel(DynamicalModelType::PositionBasedDynamics)
     m_mass(std::make_shared<DataArray<double>>()),
     m_invMass(std::make_shared<DataArray<double>>()),
     m_fixedNodeInvMass(std::make_shared<std::unordered_map<size_t, double>>()),
+    m_positionsf(std::make_shared<VecDataArray<float, 3>>()),
+    m_invMassf(std::make_shared<DataArray<float>>()),
     m_config(std::make_shared<PbdModelConfig>())
 {
     m_validGeometryTypes = {
@@ -234,6 +239,45 @@ PbdModel::initialize()
         }
     }
 
+    // Single precision requires every constraint to provide it
+    m_singlePrecision = m_config->m_singlePrecision;
+    if (m_singlePrecision)
+    {
+        auto supported = [](const std::vector<std::shared_ptr<PbdConstraint>>& constraints)
+                         {
+                             for (const auto& constraint : constraints)
+                             {
+                                 if (!constraint->supportsSinglePrecision())
+                                 {
+                                     return false;
+                                 }
+                             }
+                             return true;
+                         };
+        bool allSupported = supported(m_constraints->getConstraints());
+        for (const auto& constraintPartition : m_constraints->getPartitionedConstraints())
+        {
+            allSupported = allSupported && supported(constraintPartition);
+        }
+        if (!allSupported)
+        {
+            LOG(WARNING) << "PbdModel single precision requested but not supported by all constraints, solving in double precision";
+            m_singlePrecision = false;
+        }
+    }
+    if (m_singlePrecision)
+    {
+        // Later synced at the start of every (sub)step, see integratePosition
+        const VecDataArray<double, 3>& pos = *m_currentState->getPositions();
+        m_positionsf->resize(pos.size());
+        m_invMassf->resize(m_invMass->size());
+        for (int i = 0; i < pos.size(); i++)
+        {
+            (*m_positionsf)[i] = pos[i].cast<float>();
+            (*m_invMassf)[i]   = static_cast<float>((*m_invMass)[i]);
+        }
+    }
+
     // Setup the default pbd solver if none was provided
     if (m_pbdSolver == nullptr)
     {
@@ -243,8 +287,11 @@ PbdModel::initialize()
     }
     m_pbdSolver->setPositions(getCurrentState()->getPositions());
     m_pbdSolver->setInvMasses(getInvMasses());
+    m_pbdSolver->setPositions(m_positionsf);
+    m_pbdSolver->setInvMasses(m_invMassf);
+    m_pbdSolver->setSinglePrecision(m_singlePrecision);
     m_pbdSolver->setConstraints(getConstraints());
-    m_pbdSolver->setTimeStep(m_config->m_dt);
+    m_pbdSolver->setTimeStep(getSubstepTimeStep());
 
     this->setTimeStepSizeType(m_timeStepSizeType);
 
@@ -382,6 +429,12 @@ PbdModel::setPointUnfixed(const size_t idx)
 
 void
 PbdModel::integratePosition()
+{
+    integratePosition(getSubstepTimeStep());
+}
+
+void
+PbdModel::integratePosition(const double dt)
 {
     std::shared_ptr<VecDataArray<double, 3>> prevPosPtr = m_previousState->getPositions();
     VecDataArray<double, 3>&                 prevPos    = *prevPosPtr;
@@ -396,21 +449,42 @@ PbdModel::integratePosition()
     VecDataArray<double, 3>&                 accn      = *accnPtr;
     const DataArray<double>&                 invMasses = *m_invMass;
 
+    // The single precision buffers are synced here, in the same pass, as the step starts.
+    // Fixed nodes are synced too as they may be moved or (un)fixed between steps
+    VecDataArray<float, 3>& posf     = *m_positionsf;
+    DataArray<float>&       invMassf = *m_invMassf;
+    if (m_singlePrecision)
+    {
+        posf.resize(pos.size());
+        invMassf.resize(invMasses.size());
+    }
+
     ParallelUtils::parallelFor(m_mesh->getNumVertices(),
         [&](const size_t i)
         {
             if (std::abs(invMasses[i]) > 0.0)
             {
-                vel[i]    += (accn[i] + m_config->m_gravity) * m_config->m_dt;
+                vel[i]    += (accn[i] + m_config->m_gravity) * dt;
                 accn[i]    = Vec3d::Zero();
                 prevPos[i] = pos[i];
-                pos[i]    += (1.0 - m_config->m_viscousDampingCoeff) * vel[i] * m_config->m_dt;
+                pos[i]    += (1.0 - m_config->m_viscousDampingCoeff) * vel[i] * dt;
+            }
+            if (m_singlePrecision)
+            {
+                posf[i]     = pos[i].cast<float>();
+                invMassf[i] = static_cast<float>(invMasses[i]);
             }
         }, m_mesh->getNumVertices() > 50);
 }
 
 void
 PbdModel::updateVelocity()
+{
+    updateVelocity(getSubstepTimeStep());
+}
+
+void
+PbdModel::updateVelocity(const double dt)
 {
     std::shared_ptr<VecDataArray<double, 3>> prevPosPtr = m_previousState->getPositions();
     const VecDataArray<double, 3>&           prevPos    = *prevPosPtr;
@@ -420,9 +494,9 @@ PbdModel::updateVelocity()
     VecDataArray<double, 3>&                 vel       = *velPtr;
     const DataArray<double>&                 invMasses = *m_invMass;
 
-    if (m_config->m_dt > 0.0)
+    if (dt > 0.0)
     {
-        const double invDt = 1.0 / m_config->m_dt;
+        const double invDt = 1.0 / dt;
         ParallelUtils::parallelFor(m_mesh->getNumVertices(),
             [&](const size_t i)
             {
@@ -434,15 +508,93 @@ PbdModel::updateVelocity()
     }
 }
 
+void
+PbdModel::addSubstepCollisionSolver(std::shared_ptr<PbdCollisionSolver> solver)
+{
+    if (std::find(m_substepCollisionSolvers.begin(), m_substepCollisionSolvers.end(), solver) == m_substepCollisionSolvers.end())
+    {
+        m_substepCollisionSolvers.push_back(solver);
+    }
+}
+
+void
+PbdModel::removeSubstepCollisionSolver(std::shared_ptr<PbdCollisionSolver> solver)
+{
+    m_substepCollisionSolvers.erase(std::remove(m_substepCollisionSolvers.begin(), m_substepCollisionSolvers.end(), solver),
+        m_substepCollisionSolvers.end());
+}
+
 void
 PbdModel::solveConstraints()
+{
+    // Integration of the first substep and velocity update of the last are separate
+    // steps in the graph such that collisions are handled at the end of the time step
+    const unsigned int numSubsteps = std::max(m_config->m_substeps, 1u);
+    const double       dt = getSubstepTimeStep();
+    for (unsigned int i = 0; i < numSubsteps; i++)
+    {
+        if (i > 0)
+        {
+            updateVelocity(dt);
+            integratePosition(dt);
+        }
+
+        solveInternalConstraints(dt);
+
+        // The contacts found at the end of the previous step are reused, the
+        // last substep is followed by collision detection and handling
+        if (i < numSubsteps - 1)
+        {
+            for (const auto& solver : m_substepCollisionSolvers)
+            {
+                solver->solveLastCollisionConstraints();
+            }
+        }
+    }
+}
+
+void
+PbdModel::solveInternalConstraints(const double dt)
 {
     m_pbdSolver->setPositions(m_currentState->getPositions());
     m_pbdSolver->setInvMasses(m_invMass);
     m_pbdSolver->setConstraints(getConstraints());
-    m_pbdSolver->setTimeStep(m_config->m_dt);
+    m_pbdSolver->setTimeStep(dt);
     m_pbdSolver->setIterations(m_config->m_iterations);
     m_pbdSolver->setSolverType(m_config->m_solverType);
+    m_pbdSolver->setSinglePrecision(m_singlePrecision);
+    if (!m_singlePrecision)
+    {
+        m_pbdSolver->solve();
+        return;
+    }
+
+    // Solve on the single precision buffers synced by integratePosition
+    VecDataArray<double, 3>&      pos          = *m_currentState->getPositions();
+    const VecDataArray<float, 3>& posf         = *m_positionsf;
+    const int                     numParticles = pos.size();
+    m_pbdSolver->setPositions(m_positionsf);
+    m_pbdSolver->setInvMasses(m_invMassf);
     m_pbdSolver->solve();
+
+    // Write back the displacements rather than the positions such that rounding
+    // does not accumulate in the double positions, unmoved nodes stay exact. The
+    // velocity update and the collision solvers that follow read the double positions
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t i)
+        {
+            pos[i] += (posf[i] - pos[i].cast<float>()).cast<double>();
+        }, numParticles > 50);
+}
+
+void
+PbdModel::getStateBuffers(StateBuffers& buffers)
+{
+    // The previous positions are written at the start of every step before being read
+    buffers.add(m_currentState->getPositions());
+    buffers.add(m_currentState->getVelocities());
+    buffers.add(m_currentState->getAccelerations());
+    buffers.add(m_mass);
+    buffers.add(m_invMass);
 }
 } // namespace imstk
\ No newline at end of file
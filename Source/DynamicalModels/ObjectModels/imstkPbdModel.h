@@ -18,6 +18,7 @@ namespace imstk
 {
 struct PbdConstraintFunctor;
 class PointSet;
+class PbdCollisionSolver;
 class PbdConstraintContainer;
 class PbdSolver;
 
@@ -69,9 +70,12 @@ struct PbdModelConfig
         /// \brief Enables constant density constraint given the stiffness and particleSize
         /// \param Stiffness, how much density is enforced
         /// \param ParticleRadius, radius of particle
+        /// \param RestDensity, density of the fluid at rest
+        /// \param NeighborSkin, distance particles may move before neighbors are searched again
         ///
         void enableConstantDensityConstraint(const double stiffness,
-                                             const double particleRadius, const double restDensity = 6378.0);
+                                             const double particleRadius, const double restDensity = 6378.0,
+                                             const double neighborSkin = 0.0);
 
         ///
         /// \brief Enable a Fem constraint with the material provided
@@ -93,9 +97,14 @@ struct PbdModelConfig
         double m_uniformMassValue    = 1.0;       ///< Mass properties, not used if per vertex masses are given in geometry attributes
         double m_viscousDampingCoeff = 0.01;      ///< Viscous damping coefficient [0, 1]
         double m_contactStiffness    = 1.0;       ///< Stiffness for contact
-        unsigned int m_iterations    = 10;        ///< Internal constraints pbd solver iterations
+        unsigned int m_iterations    = 10;        ///< Internal constraints pbd solver iterations (per substep)
+        unsigned int m_substeps      = 1;         ///< Substeps m_dt is split into, each integrating and solving the internal constraints.
+                                                  ///< Many substeps of a single iteration ("small steps" XPBD) converge stiffer at equal cost
         double m_dt = 0.0;                        ///< Time step size
         bool m_doPartitioning = true;             ///< Does graph coloring to solve in parallel
+        bool m_singlePrecision = false;           ///< Project constraints on single precision buffers of the positions and masses, kept
+                                                  ///< by the model and synced with the double state once per (sub)step, integration stays
+                                                  ///< double. Falls back to double if a constraint does not support it
 
         std::vector<std::size_t> m_fixedNodeIds;  ///< Nodal/vertex IDs of the nodes that are fixed
         Vec3d m_gravity = Vec3d(0.0, -9.81, 0.0); ///< Gravity acceleration
@@ -198,25 +207,51 @@ public:
     std::shared_ptr<DataArray<double>> getInvMasses() { return m_invMass; }
 
     ///
-    /// \brief Time integrate the position
+    /// \brief Time integrate the position over a substep
     ///
     void integratePosition();
 
     ///
-    /// \brief Time integrate the velocity
+    /// \brief Time integrate the velocity over a substep
     ///
     void updateVelocity();
 
     ///
-    /// \brief Solve the internal constraints
+    /// \brief Solve the internal constraints. When substepping, runs all substeps but the
+    /// integration of the first and the velocity update of the last
     ///
     void solveConstraints();
 
+    ///
+    /// \brief Returns the time step of a substep
+    ///
+    double getSubstepTimeStep() const { return m_config->m_dt / std::max(m_config->m_substeps, 1u); }
+
+    ///
+    /// \brief Adds a collision solver whose last constraints are solved again in the
+    /// intermediate substeps. Only for collisions whose other side is not simulated
+    /// in parallel to this model
+    ///
+    void addSubstepCollisionSolver(std::shared_ptr<PbdCollisionSolver> solver);
+
+    ///
+    /// \brief Removes a collision solver added with addSubstepCollisionSolver, ie: when its
+    /// interaction is disabled or destroyed
+    ///
+    void removeSubstepCollisionSolver(std::shared_ptr<PbdCollisionSolver> solver);
+
+    const std::vector<std::shared_ptr<PbdCollisionSolver>>& getSubstepCollisionSolvers() const { return m_substepCollisionSolvers; }
+
     ///
     /// \brief Initialize the PBD model
     ///
     virtual bool initialize() override;
 
+    ///
+    /// \brief Adds the current state and the masses
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
     ///
     /// \brief Initialize the PBD State
     ///
@@ -232,6 +267,12 @@ public:
     ///
     std::shared_ptr<PbdSolver> getSolver() const { return m_pbdSolver; }
 
+    ///
+    /// \brief Returns whether constraints are solved in single precision, only true
+    /// after initialize if requested in the config and supported by all constraints
+    ///
+    bool getSinglePrecision() const { return m_singlePrecision; }
+
     ///
     /// \brief Sets the solver used for internal constraints
     ///
@@ -249,6 +290,18 @@ protected:
     ///
     void initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink) override;
 
+    ///
+    /// \brief Time integrate the position/velocity over dt
+    ///@{
+    void integratePosition(const double dt);
+    void updateVelocity(const double dt);
+///@}
+
+    ///
+    /// \brief Solve the internal constraints over dt
+    ///
+    void solveInternalConstraints(const double dt);
+
     size_t m_partitionThreshold = 16;                                                 ///< Threshold for constraint partitioning
 
     std::shared_ptr<PbdSolver> m_pbdSolver       = nullptr;                           ///< PBD solver
@@ -257,9 +310,14 @@ protected:
     std::shared_ptr<DataArray<double>> m_invMass = nullptr;                           ///< Inverse of mass of nodes
     std::shared_ptr<std::unordered_map<size_t, double>> m_fixedNodeInvMass = nullptr; ///< Map for archiving fixed nodes' mass.
 
+    bool m_singlePrecision = false;                                                   ///< Constraints solved on the single precision buffers
+    std::shared_ptr<VecDataArray<float, 3>> m_positionsf = nullptr;                   ///< Single precision positions, synced on integration and written back after the solve
+    std::shared_ptr<DataArray<float>>       m_invMassf   = nullptr;                   ///< Single precision inverse masses, synced on integration
+
     std::shared_ptr<PbdModelConfig> m_config = nullptr;                               ///< Model parameters, must be set before simulation
 
     std::shared_ptr<PbdConstraintContainer> m_constraints;                            ///< The set of constraints to update/use
+    std::vector<std::shared_ptr<PbdCollisionSolver>> m_substepCollisionSolvers;       ///< Collision solvers reused between substeps
 
     // Computational Nodes
     std::shared_ptr<TaskNode> m_integrationPositionNode = nullptr;
@@ -8,6 +8,7 @@
 #include "imstkParallelFor.h"
 #include "imstkProjectedGaussSeidelSolver.h"
 #include "imstkRbdConstraint.h"
+#include "imstkStateBuffers.h"
 #include "imstkTaskGraph.h"
 #include "imstkLogger.h"
 
@@ -427,4 +428,19 @@ RigidBodyModel2::initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_pt
     m_taskGraph->addEdge(m_solveNode, m_integrateNode);
     m_taskGraph->addEdge(m_integrateNode, sink);
 }
+
+void
+RigidBodyModel2::getStateBuffers(StateBuffers& buffers)
+{
+    // The bodies point into the current state, it's written in place. The
+    // previous state is not used by the solver
+    buffers.add(m_currentState->getPositions());
+    buffers.add(m_currentState->getOrientations());
+    buffers.add(m_currentState->getVelocities());
+    buffers.add(m_currentState->getAngularVelocities());
+    buffers.add(m_currentState->getTentatveVelocities());
+    buffers.add(m_currentState->getTentativeAngularVelocities());
+    buffers.add(m_currentState->getForces());
+    buffers.add(m_currentState->getTorques());
+}
 } // namespace imstk
\ No newline at end of file
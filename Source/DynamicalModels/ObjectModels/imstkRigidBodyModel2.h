@@ -84,6 +84,11 @@ public:
     ///
     bool initialize() override;
 
+    ///
+    /// \brief Adds the current state
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
     ///
     /// \brief Updates mass and inertia matrices to those provided
     /// by the bodies. Not often needed unless mass/inertia is changing
@@ -5,6 +5,7 @@
 */
 
 #include "imstkSphBoundaryConditions.h"
+#include "imstkParallelUtils.h"
 
 #include <numeric>
 
@@ -12,14 +13,16 @@ namespace imstk
 {
 SphBoundaryConditions::SphBoundaryConditions(std::pair<Vec3d, Vec3d>& inletCoords, std::vector<std::pair<Vec3d, Vec3d>>& outletCoords, std::pair<Vec3d, Vec3d>& fluidCoords,
                                              const Vec3d& inletNormal, const StdVectorOfVec3d&, const double inletRadius, const Vec3d& inletCenterPt, const double inletFlowRate,
-                                             StdVectorOfVec3d& mainParticlePositions, const StdVectorOfVec3d& wallParticlePositions) :
+                                             StdVectorOfVec3d& mainParticlePositions, const StdVectorOfVec3d& wallParticlePositions,
+                                             const size_t numBufferParticles) :
     m_inletDomain(inletCoords), m_outletDomain(outletCoords),
     m_fluidDomain(fluidCoords),
     m_bufferCoord(Vec3d(100.0, 0.0, 0.0)),
     m_inletCenterPoint(inletCenterPt),
     m_inletRadius(inletRadius),
     m_inletNormal(inletNormal.normalized()),
-    m_inletCrossSectionalArea(PI * m_inletRadius * m_inletRadius)
+    m_inletCrossSectionalArea(PI * m_inletRadius * m_inletRadius),
+    m_numBufferParticles(numBufferParticles)
 {
     setInletVelocity(inletFlowRate);
     setParticleTypes(mainParticlePositions, wallParticlePositions.size());
@@ -28,7 +31,7 @@ SphBoundaryConditions::SphBoundaryConditions(std::pair<Vec3d, Vec3d>& inletCoord
 }
 
 bool
-SphBoundaryConditions::isInInletDomain(const Vec3d& position)
+SphBoundaryConditions::isInInletDomain(const Vec3d& position) const
 {
     if (position.x() >= m_inletDomain.first.x() && position.y() >= m_inletDomain.first.y() && position.z() >= m_inletDomain.first.z()
         && position.x() <= m_inletDomain.second.x() && position.y() <= m_inletDomain.second.y() && position.z() <= m_inletDomain.second.z())
@@ -40,7 +43,7 @@ SphBoundaryConditions::isInInletDomain(const Vec3d& position)
 }
 
 bool
-SphBoundaryConditions::isInOutletDomain(const Vec3d& position)
+SphBoundaryConditions::isInOutletDomain(const Vec3d& position) const
 {
     for (const auto& i : m_outletDomain)
     {
@@ -55,7 +58,7 @@ SphBoundaryConditions::isInOutletDomain(const Vec3d& position)
 }
 
 bool
-SphBoundaryConditions::isInFluidDomain(const Vec3d& position)
+SphBoundaryConditions::isInFluidDomain(const Vec3d& position) const
 {
     const double error = 0.1;
     if (position.x() >= m_fluidDomain.first.x() - error && position.y() >= m_fluidDomain.first.y() - error && position.z() >= m_fluidDomain.first.z() - error
@@ -74,24 +77,25 @@ void
 SphBoundaryConditions::setParticleTypes(const StdVectorOfVec3d& mainParticlePositions, const size_t numWallParticles)
 {
     m_particleTypes.reserve(mainParticlePositions.size() + numWallParticles + m_numBufferParticles);
+    m_particleTypes.resize(mainParticlePositions.size());
 
-    for (auto const& i : mainParticlePositions)
-    {
-        ParticleType type;
-        if (isInInletDomain(i))
-        {
-            type = ParticleType::Inlet;
-        }
-        else if (isInOutletDomain(i))
+    ParallelUtils::parallelFor(mainParticlePositions.size(),
+        [&](const size_t i)
         {
-            type = ParticleType::Outlet;
-        }
-        else
-        {
-            type = ParticleType::Fluid;
-        }
-        m_particleTypes.push_back(type);
-    }
+            const Vec3d& pos = mainParticlePositions[i];
+            if (isInInletDomain(pos))
+            {
+                m_particleTypes[i] = ParticleType::Inlet;
+            }
+            else if (isInOutletDomain(pos))
+            {
+                m_particleTypes[i] = ParticleType::Outlet;
+            }
+            else
+            {
+                m_particleTypes[i] = ParticleType::Fluid;
+            }
+        });
 
     m_particleTypes.insert(m_particleTypes.end(), numWallParticles, ParticleType::Wall);
     m_particleTypes.insert(m_particleTypes.end(), m_numBufferParticles, ParticleType::Buffer);
@@ -136,4 +140,19 @@ SphBoundaryConditions::placeParticleAtInlet(const Vec3d& position)
     const Vec3d inletPosition = (Vec3d(1.0, 1.0, 1.0) + m_inletNormal).cwiseProduct(position) - m_inletCenterPoint.cwiseProduct(m_inletNormal);
     return inletPosition;
 }
+
+void
+SphBoundaryConditions::addToBuffer(const std::vector<size_t>& particleIds)
+{
+    m_bufferIndices.insert(m_bufferIndices.end(), particleIds.begin(), particleIds.end());
+}
+
+size_t
+SphBoundaryConditions::takeFromBuffer(const size_t count, std::vector<size_t>& particleIds)
+{
+    const size_t numTaken = std::min(count, m_bufferIndices.size());
+    particleIds.assign(m_bufferIndices.rbegin(), m_bufferIndices.rbegin() + numTaken);
+    m_bufferIndices.resize(m_bufferIndices.size() - numTaken);
+    return numTaken;
+}
 } // namespace imstk
\ No newline at end of file
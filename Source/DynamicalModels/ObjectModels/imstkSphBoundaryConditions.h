@@ -31,14 +31,15 @@ public:
     SphBoundaryConditions(std::pair<Vec3d, Vec3d>& inletCoords, std::vector<std::pair<Vec3d, Vec3d>>& outletCoords, std::pair<Vec3d, Vec3d>& fluidCoords,
                           const Vec3d& inletNormal, const StdVectorOfVec3d& outletNormals, const double inletRadius, const Vec3d& inletCenterPt, const double inletFlowRate,
                           StdVectorOfVec3d& mainParticlePositions,
-                          const StdVectorOfVec3d& wallParticlePositions);
+                          const StdVectorOfVec3d& wallParticlePositions,
+                          const size_t numBufferParticles = 10000);
 
 public:
-    bool isInInletDomain(const Vec3d& position);
+    bool isInInletDomain(const Vec3d& position) const;
 
-    bool isInOutletDomain(const Vec3d& position);
+    bool isInOutletDomain(const Vec3d& position) const;
 
-    bool isInFluidDomain(const Vec3d& position);
+    bool isInFluidDomain(const Vec3d& position) const;
 
     void setParticleTypes(const StdVectorOfVec3d& mainParticlePositions, const size_t numWallParticles);
 
@@ -60,6 +61,22 @@ public:
 
     std::vector<size_t>& getBufferIndices() { return m_bufferIndices; }
 
+    ///
+    /// \brief Get the number of particles reserved for the buffer
+    ///
+    size_t getNumBufferParticles() const { return m_numBufferParticles; }
+
+    ///
+    /// \brief Return particles to the buffer, they must already be of type Buffer
+    ///
+    void addToBuffer(const std::vector<size_t>& particleIds);
+
+    ///
+    /// \brief Take up to count particles out of the buffer, last returned first.
+    /// Returns the number of particles taken, less than count when the buffer runs out
+    ///
+    size_t takeFromBuffer(const size_t count, std::vector<size_t>& particleIds);
+
     Vec3d placeParticleAtInlet(const Vec3d& position);
 
 private:
@@ -77,7 +94,7 @@ private:
 
     double m_inletCrossSectionalArea;
 
-    const size_t m_numBufferParticles = 10000;
-    std::vector<size_t> m_bufferIndices;
+    size_t m_numBufferParticles;
+    std::vector<size_t> m_bufferIndices; ///< Particles in the buffer, used as a stack
 };
 } // namespace imstk
\ No newline at end of file
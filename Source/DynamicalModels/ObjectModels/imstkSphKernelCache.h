@@ -0,0 +1,73 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+#include <vector>
+
+namespace imstk
+{
+///
+/// \class SphKernelCache
+///
+/// \brief The kernel values of every particle-neighbor pair of a step, evaluated once
+/// and stored one particle after the other in a flat buffer. The entries of particle p
+/// are [begin(p), end(p)), its fluid neighbors first then its boundary neighbors.
+/// T is the storage precision of the values
+///
+template<typename T>
+class SphKernelCache
+{
+public:
+    using Vec3 = Eigen::Matrix<T, 3, 1>;
+
+    struct Entry
+    {
+        Vec3 gradW;      ///< Spiky kernel gradient
+        Vec3 cohesion;   ///< Cohesion kernel times the unit relative position
+        T W;             ///< Poly6 kernel
+        T laplace;       ///< Viscosity kernel laplacian
+        size_t neighbor; ///< Index of the fluid or boundary neighbor
+    };
+
+public:
+    ///
+    /// \brief Set the number of fluid and boundary neighbors of every particle, and size the buffer
+    ///
+    void resize(const std::vector<size_t>& numFluidNeighbors, const std::vector<size_t>& numNeighbors)
+    {
+        m_offsets.resize(numNeighbors.size() + 1);
+        m_fluidEnds.resize(numNeighbors.size());
+        m_offsets[0] = 0;
+        for (size_t p = 0; p < numNeighbors.size(); p++)
+        {
+            m_fluidEnds[p]   = m_offsets[p] + numFluidNeighbors[p];
+            m_offsets[p + 1] = m_offsets[p] + numNeighbors[p];
+        }
+        m_entries.resize(m_offsets.back());
+    }
+
+    size_t begin(const size_t p) const { return m_offsets[p]; }
+    size_t fluidEnd(const size_t p) const { return m_fluidEnds[p]; }
+    size_t end(const size_t p) const { return m_offsets[p + 1]; }
+    size_t size(const size_t p) const { return m_offsets[p + 1] - m_offsets[p]; }
+
+    Entry& operator[](const size_t i) { return m_entries[i]; }
+    const Entry& operator[](const size_t i) const { return m_entries[i]; }
+
+    ///
+    /// \brief Get the size of the buffer in bytes
+    ///
+    size_t getNumBytes() const { return m_entries.size() * sizeof(Entry); }
+
+protected:
+    std::vector<size_t> m_offsets;   ///< Start of the entries of every particle, and the end of the last
+    std::vector<size_t> m_fluidEnds; ///< End of the fluid neighbor entries of every particle
+    std::vector<Entry>  m_entries;
+};
+} // namespace imstk
@@ -7,6 +7,7 @@
 #include "imstkSphModel.h"
 #include "imstkParallelUtils.h"
 #include "imstkPointSet.h"
+#include "imstkStateBuffers.h"
 #include "imstkTaskGraph.h"
 #include "imstkVTKMeshIO.h"
 
@@ -119,6 +120,32 @@ SphModel::SphModel() : DynamicalModel<SphState>(DynamicalModelType::SmoothedPart
                 moveParticles(getTimeStep());
         });
 
+    m_computeKernelCacheNode =
+        m_taskGraph->addFunction("SPHModel_ComputeKernelCache", [&]()
+            {
+                if (m_modelParameters->m_bFloatKernelCache)
+                {
+                    computeKernelCache(m_floatKernelCache);
+                }
+                else
+                {
+                    computeKernelCache(m_kernelCache);
+                }
+        });
+
+    m_computeFusedAccelsNode =
+        m_taskGraph->addFunction("SPHModel_ComputeFusedAccels", [&]()
+            {
+                if (m_modelParameters->m_bFloatKernelCache)
+                {
+                    computeFusedAccels(m_floatKernelCache);
+                }
+                else
+                {
+                    computeFusedAccels(m_kernelCache);
+                }
+        });
+
     //m_computePositionNode =
     //    m_taskGraph->addFunction("SPHModel_ComputePositions", [&]()
     //    {
@@ -191,6 +218,22 @@ SphModel::initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskN
 {
     // Setup graph connectivity
     m_taskGraph->addEdge(source, m_findParticleNeighborsNode);
+
+    if (m_modelParameters->m_bFusedKernels)
+    {
+        m_taskGraph->addEdge(m_findParticleNeighborsNode, m_computeKernelCacheNode);
+
+        m_taskGraph->addEdge(m_computeKernelCacheNode, m_computeFusedAccelsNode);
+        m_taskGraph->addEdge(m_computeKernelCacheNode, m_computeTimeStepSizeNode);
+
+        m_taskGraph->addEdge(m_computeFusedAccelsNode, m_updateVelocityNode);
+        m_taskGraph->addEdge(m_computeTimeStepSizeNode, m_updateVelocityNode);
+
+        m_taskGraph->addEdge(m_updateVelocityNode, m_moveParticlesNode);
+        m_taskGraph->addEdge(m_moveParticlesNode, sink);
+        return;
+    }
+
     m_taskGraph->addEdge(m_findParticleNeighborsNode, m_computeDensityNode);
     m_taskGraph->addEdge(m_computeDensityNode, m_normalizeDensityNode);
     m_taskGraph->addEdge(m_normalizeDensityNode, m_collectNeighborDensityNode);
@@ -242,13 +285,76 @@ SphModel::computeCFLTimeStepSize()
 void
 SphModel::findParticleNeighbors()
 {
-    m_neighborSearcher->getNeighbors(getCurrentState()->getFluidNeighborLists(), *getCurrentState()->getPositions());
+    if (!m_sphBoundaryConditions)
+    {
+        m_neighborSearcher->getNeighbors(getCurrentState()->getFluidNeighborLists(), *getCurrentState()->getPositions());
+
+        if (m_modelParameters->m_bDensityWithBoundary)   // if considering boundary particles for computing fluid density
+        {
+            m_neighborSearcher->getNeighbors(getCurrentState()->getBoundaryNeighborLists(),
+                *getCurrentState()->getPositions(),
+                *getCurrentState()->getBoundaryParticlePositions());
+        }
+        return;
+    }
+
+    // Searching the buffer particles would put all of them in one cell, each being the
+    // neighbor of every other. Search the compacted active particles then map back
+    const VecDataArray<double, 3>&                          positions     = *getCurrentState()->getPositions();
+    const std::vector<SphBoundaryConditions::ParticleType>& particleTypes = m_sphBoundaryConditions->getParticleTypes();
+    ParallelUtils::findIndices(positions.size(),
+        [&](const size_t p) { return particleTypes[p] != SphBoundaryConditions::ParticleType::Buffer; },
+        m_activeIds);
+
+    m_activePositions.resize(static_cast<int>(m_activeIds.size()));
+    ParallelUtils::parallelFor(m_activeIds.size(),
+        [&](const size_t i)
+        {
+            m_activePositions[i] = positions[m_activeIds[i]];
+        });
 
-    if (m_modelParameters->m_bDensityWithBoundary)   // if considering boundary particles for computing fluid density
+    std::vector<std::vector<size_t>>& neighborLists = getCurrentState()->getFluidNeighborLists();
+    std::vector<std::vector<size_t>>& boundaryNeighborLists = getCurrentState()->getBoundaryNeighborLists();
+    neighborLists.resize(positions.size());
+    if (m_modelParameters->m_bDensityWithBoundary)
     {
-        m_neighborSearcher->getNeighbors(getCurrentState()->getBoundaryNeighborLists(),
-            *getCurrentState()->getPositions(),
+        boundaryNeighborLists.resize(positions.size());
+    }
+    ParallelUtils::parallelFor(positions.size(),
+        [&](const size_t p)
+        {
+            if (particleTypes[p] == SphBoundaryConditions::ParticleType::Buffer)
+            {
+                neighborLists[p].resize(0);
+                if (m_modelParameters->m_bDensityWithBoundary)
+                {
+                    boundaryNeighborLists[p].resize(0);
+                }
+            }
+        });
+
+    m_neighborSearcher->getNeighbors(m_activeNeighborLists, m_activePositions);
+    ParallelUtils::parallelFor(m_activeIds.size(),
+        [&](const size_t i)
+        {
+            // Swap to reuse the memory of both lists
+            std::vector<size_t>& neighbors = neighborLists[m_activeIds[i]];
+            neighbors.swap(m_activeNeighborLists[i]);
+            for (size_t& q : neighbors)
+            {
+                q = m_activeIds[q];
+            }
+        });
+
+    if (m_modelParameters->m_bDensityWithBoundary)
+    {
+        m_neighborSearcher->getNeighbors(m_activeNeighborLists, m_activePositions,
             *getCurrentState()->getBoundaryParticlePositions());
+        ParallelUtils::parallelFor(m_activeIds.size(),
+            [&](const size_t i)
+            {
+                boundaryNeighborLists[m_activeIds[i]].swap(m_activeNeighborLists[i]);
+            });
     }
 }
 
@@ -518,7 +624,7 @@ SphModel::computeViscosity()
             }
             //diffuseFluid *= m_modelParameters->m_dynamicViscosityCoeff / getState().getDensities()[p];
             const double particleRadius = m_modelParameters->m_particleRadius;
-            particleShifts     *= 4 / 3 * PI * particleRadius * particleRadius * particleRadius * 0.5 * m_modelParameters->m_kernelRadius * halfStepVelocities[p].norm();
+            particleShifts     *= 4.0 / 3.0 * PI * particleRadius * particleRadius * particleRadius * 0.5 * m_modelParameters->m_kernelRadius * halfStepVelocities[p].norm();
             diffuseFluid       *= m_modelParameters->m_dynamicViscosityCoeff * m_modelParameters->m_particleMass;
             neighborVelContr[p] = neighborVelContributionsNumerator * m_modelParameters->m_eta / neighborVelContributionsDenominator;
             particleShift[p]    = -particleShifts;
@@ -644,6 +750,225 @@ SphModel::sumAccels()
       });
 }
 
+template<typename T>
+void
+SphModel::computeKernelCache(SphKernelCache<T>& kernelCache)
+{
+    const size_t                                  numParticles  = getCurrentState()->getNumParticles();
+    const std::vector<std::vector<size_t>>&       neighborLists = getCurrentState()->getFluidNeighborLists();
+    const std::vector<std::vector<size_t>>&       boundaryNeighborLists = getCurrentState()->getBoundaryNeighborLists();
+    const bool                                    withBoundary  = m_modelParameters->m_bDensityWithBoundary;
+    const SphBoundaryConditions::ParticleType*    particleTypes =
+        m_sphBoundaryConditions ? m_sphBoundaryConditions->getParticleTypes().data() : nullptr;
+    auto isBuffer = [&](const size_t p)
+                    {
+                        return particleTypes && particleTypes[p] == SphBoundaryConditions::ParticleType::Buffer;
+                    };
+
+    // Lay out the entries of every particle in the buffer
+    m_numFluidNeighbors.resize(numParticles);
+    m_numNeighbors.resize(numParticles);
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            m_numFluidNeighbors[p] = isBuffer(p) ? 0 : neighborLists[p].size();
+            m_numNeighbors[p]      = m_numFluidNeighbors[p] + ((withBoundary && !isBuffer(p)) ? boundaryNeighborLists[p].size() : 0);
+        });
+    kernelCache.resize(m_numFluidNeighbors, m_numNeighbors);
+
+    const VecDataArray<double, 3>& positions = *getCurrentState()->getPositions();
+    const VecDataArray<double, 3>* boundaryPositions = getCurrentState()->getBoundaryParticlePositions().get();
+    DataArray<double>&             densities = *getCurrentState()->getDensities();
+    const double                   particleMass = m_modelParameters->m_particleMass;
+
+    // Evaluate the kernels of every pair, computing the densities
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            if (kernelCache.size(p) == 0)
+            {
+                return;
+            }
+
+            const Vec3d& ppos     = positions[p];
+            double       pdensity = 0.0;
+            for (size_t i = kernelCache.begin(p); i < kernelCache.end(p); ++i)
+            {
+                const size_t j = i - kernelCache.begin(p);
+                const bool   isFluid = (i < kernelCache.fluidEnd(p));
+                const size_t q = isFluid ? neighborLists[p][j] : boundaryNeighborLists[p][j - m_numFluidNeighbors[p]];
+                const Vec3d  r = ppos - (isFluid ? positions[q] : (*boundaryPositions)[q]);
+
+                const double W  = m_kernels.W(r);
+                const double d2 = r.squaredNorm();
+                const Vec3d  cohesion = (d2 > 1.0e-20) ? Vec3d(r * (m_kernels.cohesionW(r) / std::sqrt(d2))) : Vec3d::Zero();
+                typename SphKernelCache<T>::Entry& entry = kernelCache[i];
+                entry.gradW    = m_kernels.gradW(r).template cast<T>();
+                entry.cohesion = cohesion.template cast<T>();
+                entry.W        = static_cast<T>(W);
+                entry.laplace  = static_cast<T>(m_kernels.laplace(r));
+                entry.neighbor = q;
+                pdensity      += W;
+            }
+
+            if (kernelCache.size(p) > 1)
+            {
+                densities[p] = pdensity * particleMass;
+            }
+        });
+
+    if (!m_modelParameters->m_bNormalizeDensity)
+    {
+        return;
+    }
+
+    // Normalize in place over the fluid neighbors, as normalizeDensity does
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            if (kernelCache.size(p) <= 1)
+            {
+                return; // the particle has no neighbor
+            }
+
+            double tmp = 0.0;
+            for (size_t i = kernelCache.begin(p); i < kernelCache.fluidEnd(p); ++i)
+            {
+                const typename SphKernelCache<T>::Entry& entry = kernelCache[i];
+                tmp += static_cast<double>(entry.W) / densities[entry.neighbor];
+            }
+            densities[p] /= (tmp * particleMass);
+        });
+}
+
+template<typename T>
+void
+SphModel::computeFusedAccels(const SphKernelCache<T>& kernelCache)
+{
+    const size_t                               numParticles = getCurrentState()->getNumParticles();
+    const SphBoundaryConditions::ParticleType* particleTypes =
+        m_sphBoundaryConditions ? m_sphBoundaryConditions->getParticleTypes().data() : nullptr;
+
+    const DataArray<double>&       densities = *getCurrentState()->getDensities();
+    const VecDataArray<double, 3>& halfStepVelocities = *getCurrentState()->getHalfStepVelocities();
+    VecDataArray<double, 3>&       surfaceNormals       = *getCurrentState()->getNormals();
+    VecDataArray<double, 3>&       accels               = *getCurrentState()->getAccelerations();
+    VecDataArray<double, 3>&       pressureAccels       = *m_pressureAccels;
+    VecDataArray<double, 3>&       viscousAccels        = *m_viscousAccels;
+    VecDataArray<double, 3>&       surfaceTensionAccels = *m_surfaceTensionAccels;
+    VecDataArray<double, 3>&       neighborVelContr     = *m_neighborVelContr;
+    VecDataArray<double, 3>&       particleShift        = *m_particleShift;
+
+    const double particleMass   = m_modelParameters->m_particleMass;
+    const double restDensity    = m_modelParameters->m_restDensity;
+    const double particleRadius = m_modelParameters->m_particleRadius;
+
+    // Pressure, viscosity and surface normals, one pass over the neighbors
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            const SphBoundaryConditions::ParticleType type = particleTypes ? particleTypes[p] : SphBoundaryConditions::ParticleType::Fluid;
+            if (type == SphBoundaryConditions::ParticleType::Buffer)
+            {
+                return;
+            }
+            const bool isWall = (type == SphBoundaryConditions::ParticleType::Wall);
+
+            if (kernelCache.size(p) <= 1)
+            {
+                pressureAccels[p] = Vec3d::Zero();
+                surfaceNormals[p] = Vec3d::Zero();
+                if (!isWall)
+                {
+                    neighborVelContr[p] = Vec3d::Zero();
+                    viscousAccels[p]    = Vec3d::Zero();
+                }
+                return;
+            }
+
+            const double pdensity  = densities[p];
+            const double ppressure = getParticlePressure(pdensity);
+            const Vec3d& pvel      = halfStepVelocities[p];
+
+            Vec3d  pressureAccel = Vec3d::Zero();
+            Vec3d  n = Vec3d::Zero();
+            Vec3d  diffuseFluid = Vec3d::Zero();
+            Vec3d  neighborVelContributionsNumerator   = Vec3d::Zero();
+            double neighborVelContributionsDenominator = 0.0;
+            Vec3d  particleShifts = Vec3d::Zero();
+            for (size_t i = kernelCache.begin(p); i < kernelCache.end(p); ++i)
+            {
+                const typename SphKernelCache<T>::Entry& entry = kernelCache[i];
+                const bool   isFluid   = (i < kernelCache.fluidEnd(p));
+                const double qdensity  = isFluid ? densities[entry.neighbor] : restDensity;
+                const double qpressure = getParticlePressure(qdensity);
+                const Vec3d  gradW     = entry.gradW.template cast<double>();
+
+                pressureAccel += -(ppressure / (pdensity * pdensity) + qpressure / (qdensity * qdensity)) * gradW;
+                n += (1.0 / qdensity) * gradW;
+
+                if (isFluid && !isWall)
+                {
+                    const Vec3d  dv = halfStepVelocities[entry.neighbor] - pvel;
+                    const double W  = static_cast<double>(entry.W);
+                    diffuseFluid += (1.0 / qdensity) * static_cast<double>(entry.laplace) * dv;
+                    neighborVelContributionsNumerator   += dv * W;
+                    neighborVelContributionsDenominator += W;
+                    particleShifts += gradW;
+                }
+            }
+
+            pressureAccels[p] = pressureAccel * particleMass;
+            surfaceNormals[p] = n * m_modelParameters->m_kernelRadius * particleMass;
+            if (!isWall)
+            {
+                particleShifts     *= 4.0 / 3.0 * PI * particleRadius * particleRadius * particleRadius * 0.5 * m_modelParameters->m_kernelRadius * pvel.norm();
+                viscousAccels[p]    = diffuseFluid * m_modelParameters->m_dynamicViscosityCoeff * particleMass;
+                neighborVelContr[p] = neighborVelContributionsNumerator * m_modelParameters->m_eta / neighborVelContributionsDenominator;
+                particleShift[p]    = -particleShifts;
+            }
+        });
+
+    // Surface tension, which needs the normals of the neighbors, and the sum of the accelerations
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            if (particleTypes
+                && (particleTypes[p] == SphBoundaryConditions::ParticleType::Buffer
+                    || particleTypes[p] == SphBoundaryConditions::ParticleType::Wall))
+            {
+                return;
+            }
+
+            if (kernelCache.fluidEnd(p) - kernelCache.begin(p) > 1)
+            {
+                const Vec3d& ni       = surfaceNormals[p];
+                const double pdensity = densities[p];
+
+                Vec3d accel = Vec3d::Zero();
+                for (size_t i = kernelCache.begin(p); i < kernelCache.fluidEnd(p); ++i)
+                {
+                    const typename SphKernelCache<T>::Entry& entry = kernelCache[i];
+                    const size_t q = entry.neighbor;
+                    if (p == q)
+                    {
+                        continue;
+                    }
+
+                    // Correction factor
+                    const double K_ij = 2.0 * restDensity / (pdensity + densities[q]);
+
+                    // Cohesion and curvature acc
+                    accel -= K_ij * particleMass * entry.cohesion.template cast<double>();
+                    accel -= K_ij * (ni - surfaceNormals[q]);
+                }
+                surfaceTensionAccels[p] = accel * m_modelParameters->m_surfaceTensionStiffness;
+            }
+
+            accels[p] = pressureAccels[p] + surfaceTensionAccels[p] + viscousAccels[p];
+        });
+}
+
 void
 SphModel::updateVelocity(const double timestep)
 {
@@ -684,55 +1009,58 @@ SphModel::updateVelocity(const double timestep)
 void
 SphModel::moveParticles(const double timestep)
 {
-    //ParallelUtils::parallelFor(getState().getNumParticles(),
-    //  [&](const size_t p) {
-
     VecDataArray<double, 3>& neighborVelContr = *m_neighborVelContr;
     VecDataArray<double, 3>& particleShift    = *m_particleShift;
     VecDataArray<double, 3>& positions = *getCurrentState()->getPositions();
     VecDataArray<double, 3>& halfStepVelocities = *getCurrentState()->getHalfStepVelocities();
     VecDataArray<double, 3>& fullStepVelocities = *getCurrentState()->getFullStepVelocities();
 
-    for (int p = 0; p < static_cast<int>(getCurrentState()->getNumParticles()); p++)
+    const size_t numParticles = getCurrentState()->getNumParticles();
+    if (m_sphBoundaryConditions == nullptr)
     {
-        if (m_sphBoundaryConditions
-            && (m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Buffer
-                || m_sphBoundaryConditions->getParticleTypes()[p] == SphBoundaryConditions::ParticleType::Wall))
-        {
-            continue;
-        }
+        ParallelUtils::parallelFor(numParticles,
+            [&](const size_t p)
+            {
+                positions[p] += particleShift[p] * timestep + (halfStepVelocities[p] + neighborVelContr[p]) * timestep;
+            });
+        m_timeStepCount++;
+        return;
+    }
 
-        Vec3d oldPosition = positions[p];
-        Vec3d newPosition = oldPosition + particleShift[p] * timestep + (halfStepVelocities[p] + neighborVelContr[p]) * timestep;
+    // Particles only change their own type and position such that they are moved in parallel,
+    // the particles leaving the inlet (emitting another into the inlet) and the particles
+    // leaving the domain (released to the buffer) are flagged
+    std::vector<SphBoundaryConditions::ParticleType>& particleTypes = m_sphBoundaryConditions->getParticleTypes();
+    m_particleEvents.assign(numParticles, ParticleEvent::None);
+    m_emissionPositions.resize(numParticles);
+    ParallelUtils::parallelFor(numParticles,
+        [&](const size_t p)
+        {
+            if (particleTypes[p] == SphBoundaryConditions::ParticleType::Buffer
+                || particleTypes[p] == SphBoundaryConditions::ParticleType::Wall)
+            {
+                return;
+            }
 
-        positions[p] = newPosition;
+            const Vec3d oldPosition = positions[p];
+            const Vec3d newPosition = oldPosition + particleShift[p] * timestep + (halfStepVelocities[p] + neighborVelContr[p]) * timestep;
+            positions[p] = newPosition;
 
-        if (m_sphBoundaryConditions)
-        {
-            std::vector<SphBoundaryConditions::ParticleType>& particleTypes = m_sphBoundaryConditions->getParticleTypes();
             if (particleTypes[p] == SphBoundaryConditions::ParticleType::Inlet
                 && !m_sphBoundaryConditions->isInInletDomain(newPosition))
             {
-                // change particle type to fluid
-                particleTypes[p] = SphBoundaryConditions::ParticleType::Fluid;
-                // insert particle into inlet domain from buffer domain
-                // todo: come up with a better way to find buffer indices
-                // right now, the buffer index is limiting the parallel ability of this function
-                const size_t bufferParticleIndex = m_sphBoundaryConditions->getBufferIndices().back();
-                m_sphBoundaryConditions->getBufferIndices().pop_back();
-                particleTypes[bufferParticleIndex] = SphBoundaryConditions::ParticleType::Inlet;
-
-                positions[bufferParticleIndex] = m_sphBoundaryConditions->placeParticleAtInlet(oldPosition);
-                halfStepVelocities[bufferParticleIndex] = m_sphBoundaryConditions->computeParabolicInletVelocity(positions[bufferParticleIndex]);
-                fullStepVelocities[bufferParticleIndex] = m_sphBoundaryConditions->computeParabolicInletVelocity(positions[bufferParticleIndex]);
+                // change particle type to fluid, a buffer particle takes its place in the inlet
+                particleTypes[p]       = SphBoundaryConditions::ParticleType::Fluid;
+                m_particleEvents[p]    = ParticleEvent::Emit;
+                m_emissionPositions[p] = m_sphBoundaryConditions->placeParticleAtInlet(oldPosition);
             }
             else if (particleTypes[p] == SphBoundaryConditions::ParticleType::Outlet
                      && !m_sphBoundaryConditions->isInOutletDomain(newPosition))
             {
-                particleTypes[p] = SphBoundaryConditions::ParticleType::Buffer;
                 // insert particle into buffer domain after it leaves outlet domain
-                positions[p] = m_sphBoundaryConditions->getBufferCoord();
-                m_sphBoundaryConditions->getBufferIndices().push_back(p);
+                particleTypes[p]    = SphBoundaryConditions::ParticleType::Buffer;
+                positions[p]        = m_sphBoundaryConditions->getBufferCoord();
+                m_particleEvents[p] = ParticleEvent::Release;
             }
             else if (particleTypes[p] == SphBoundaryConditions::ParticleType::Fluid
                      && m_sphBoundaryConditions->isInOutletDomain(newPosition))
@@ -742,12 +1070,33 @@ SphModel::moveParticles(const double timestep)
             else if (particleTypes[p] == SphBoundaryConditions::ParticleType::Fluid
                      && !m_sphBoundaryConditions->isInFluidDomain(newPosition))
             {
-                particleTypes[p] = SphBoundaryConditions::ParticleType::Buffer;
-                positions[p]     = m_sphBoundaryConditions->getBufferCoord();
-                m_sphBoundaryConditions->getBufferIndices().push_back(p);
+                particleTypes[p]    = SphBoundaryConditions::ParticleType::Buffer;
+                positions[p]        = m_sphBoundaryConditions->getBufferCoord();
+                m_particleEvents[p] = ParticleEvent::Release;
             }
-        }
-    }
+        });
+
+    // Compact the flagged particles, in order of index such that the result doesn't
+    // depend on the scheduling
+    ParallelUtils::findIndices(numParticles, [&](const size_t p) { return m_particleEvents[p] == ParticleEvent::Release; }, m_releasedIds);
+    ParallelUtils::findIndices(numParticles, [&](const size_t p) { return m_particleEvents[p] == ParticleEvent::Emit; }, m_emitterIds);
+
+    // Released particles are recycled first, then the emitted particles are taken out of the buffer
+    m_sphBoundaryConditions->addToBuffer(m_releasedIds);
+    const size_t numEmitted = m_sphBoundaryConditions->takeFromBuffer(m_emitterIds.size(), m_emittedIds);
+    LOG_IF(WARNING, numEmitted < m_emitterIds.size()) << "SPH particle buffer ran out, "
+                                                      << m_emitterIds.size() - numEmitted << " particles not emitted";
+
+    ParallelUtils::parallelFor(numEmitted,
+        [&](const size_t i)
+        {
+            const size_t bufferParticleIndex = m_emittedIds[i];
+            particleTypes[bufferParticleIndex]      = SphBoundaryConditions::ParticleType::Inlet;
+            positions[bufferParticleIndex]          = m_emissionPositions[m_emitterIds[i]];
+            halfStepVelocities[bufferParticleIndex] = m_sphBoundaryConditions->computeParabolicInletVelocity(positions[bufferParticleIndex]);
+            fullStepVelocities[bufferParticleIndex] = halfStepVelocities[bufferParticleIndex];
+        });
+
     m_timeStepCount++;
 }
 
@@ -803,4 +1152,24 @@ SphModel::findNearestParticleToVertex(const VecDataArray<double, 3>& points, con
         m_minIndices[i] = minIndex;
     }
 }
+
+void
+SphModel::getStateBuffers(StateBuffers& buffers)
+{
+    // Boundary particles are static
+    for (const auto& arr : { m_currentState->getPositions(), m_currentState->getVelocities(),
+                             m_currentState->getFullStepVelocities(), m_currentState->getHalfStepVelocities(),
+                             m_currentState->getNormals(), m_currentState->getAccelerations(),
+                             m_currentState->getDiffuseVelocities() })
+    {
+        if (arr != nullptr)
+        {
+            buffers.add(arr);
+        }
+    }
+    if (m_currentState->getDensities() != nullptr)
+    {
+        buffers.add(m_currentState->getDensities());
+    }
+}
 } // namespace imstk
\ No newline at end of file
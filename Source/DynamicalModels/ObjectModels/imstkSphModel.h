@@ -9,6 +9,7 @@
 #include "imstkDynamicalModel.h"
 #include "imstkSphState.h"
 #include "imstkSPHKernels.h"
+#include "imstkSphKernelCache.h"
 #include "imstkNeighborSearch.h"
 #include "imstkSphBoundaryConditions.h"
 
@@ -50,6 +51,11 @@ public:
     bool m_bNormalizeDensity    = false;
     bool m_bDensityWithBoundary = false;
 
+    // fused execution, the kernels are evaluated once per neighbor pair into a cache then
+    // the density, pressure, viscosity and surface tension are computed in a few passes over it
+    bool m_bFusedKernels     = false;
+    bool m_bFloatKernelCache = false; ///< store the cached kernel values in single precision
+
     // pressure
     double m_pressureStiffness = 50000.0;
 
@@ -99,6 +105,11 @@ public:
     ///
     void resetToInitialState() override { this->m_currentState->setState(this->m_initialState); }
 
+    ///
+    /// \brief Adds the current state, neighbors are found anew every step
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
     ///
     /// \brief Get the simulation parameters
     ///
@@ -150,6 +161,8 @@ public:
     std::shared_ptr<TaskNode> getComputeViscosityNode() const { return m_computeViscosityNode; }
     std::shared_ptr<TaskNode> getUpdateVelocityNode() const { return m_updateVelocityNode; }
     std::shared_ptr<TaskNode> getMoveParticlesNode() const { return m_moveParticlesNode; }
+    std::shared_ptr<TaskNode> getComputeKernelCacheNode() const { return m_computeKernelCacheNode; }
+    std::shared_ptr<TaskNode> getComputeFusedAccelsNode() const { return m_computeFusedAccelsNode; }
 
 protected:
     ///
@@ -169,7 +182,8 @@ private:
     double computeCFLTimeStepSize();
 
     ///
-    /// \brief Find the neighbors for each particle
+    /// \brief Find the neighbors for each particle. With boundary conditions the buffer
+    /// particles, all parked at one point, are left out of the search
     ///
     void findParticleNeighbors();
 
@@ -222,7 +236,22 @@ private:
     void computeSurfaceTension();
 
     ///
-    /// \brief Move particles
+    /// \brief Fused execution, evaluate the kernels of every neighbor pair into the cache
+    /// while computing the densities, then normalize the densities
+    ///
+    template<typename T>
+    void computeKernelCache(SphKernelCache<T>& kernelCache);
+
+    ///
+    /// \brief Fused execution, compute the pressure, viscous and surface tension accelerations
+    /// from the cache and sum them
+    ///
+    template<typename T>
+    void computeFusedAccels(const SphKernelCache<T>& kernelCache);
+
+    ///
+    /// \brief Move particles, and with boundary conditions, emit particles from the buffer
+    /// into the inlet and return the particles leaving the domain to the buffer
     ///
     void moveParticles(const double timestep);
 
@@ -241,6 +270,8 @@ protected:
     std::shared_ptr<TaskNode> m_moveParticlesNode          = nullptr;
     std::shared_ptr<TaskNode> m_normalizeDensityNode       = nullptr;
     std::shared_ptr<TaskNode> m_collectNeighborDensityNode = nullptr;
+    std::shared_ptr<TaskNode> m_computeKernelCacheNode     = nullptr;
+    std::shared_ptr<TaskNode> m_computeFusedAccelsNode     = nullptr;
 
 private:
     std::shared_ptr<PointSet> m_pointSetGeometry;
@@ -265,6 +296,30 @@ private:
 
     std::shared_ptr<SphBoundaryConditions> m_sphBoundaryConditions = nullptr;
 
+    // Particle lifecycle with boundary conditions, see moveParticles
+    enum class ParticleEvent : unsigned char
+    {
+        None,
+        Emit,   ///< Left the inlet, a buffer particle is emitted in its place
+        Release ///< Left the domain, returned to the buffer
+    };
+    std::vector<ParticleEvent> m_particleEvents;
+    StdVectorOfVec3d    m_emissionPositions; ///< Where the particle emitted for an Emit particle is placed
+    std::vector<size_t> m_emitterIds;
+    std::vector<size_t> m_releasedIds;
+    std::vector<size_t> m_emittedIds;
+
+    // Particles not in the buffer, searched for neighbors, see findParticleNeighbors
+    std::vector<size_t>              m_activeIds;
+    VecDataArray<double, 3>          m_activePositions;
+    std::vector<std::vector<size_t>> m_activeNeighborLists;
+
+    // Fused execution
+    SphKernelCache<double> m_kernelCache;
+    SphKernelCache<float>  m_floatKernelCache;
+    std::vector<size_t>    m_numFluidNeighbors;
+    std::vector<size_t>    m_numNeighbors;
+
     std::vector<size_t> m_minIndices;
 };
 } // namespace imstk
\ No newline at end of file
@@ -0,0 +1,151 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkDataArray.h"
+#include "imstkImageData.h"
+#include "imstkLevelSetModel.h"
+#include "imstkSignedDistanceField.h"
+
+#include <map>
+
+using namespace imstk;
+
+///
+/// \brief Creates the signed distance image of a sphere that crosses the image boundary,
+/// the dimensions are not a multiple of the brick size
+///
+static std::shared_ptr<ImageData>
+makeSphereImage()
+{
+    auto image = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(29, 21, 19), Vec3d(0.1, 0.1, 0.1), Vec3d(0.0, 0.0, 0.0));
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    for (int z = 0; z < 19; z++)
+    {
+        for (int y = 0; y < 21; y++)
+        {
+            for (int x = 0; x < 29; x++)
+            {
+                scalars[image->getScalarIndex(x, y, z)] = (Vec3d(x, y, z) - Vec3d(4.0, 10.0, 9.0)).norm() * 0.1 - 0.8;
+            }
+        }
+    }
+    return image;
+}
+
+///
+/// \brief Test the bricked sparse update matches evolving only the nodes given
+/// impulses with the finite difference functors, the former sparse update
+///
+TEST(imstkLevelSetModelTest, SparseUpdate)
+{
+    std::shared_ptr<ImageData> image = makeSphereImage();
+    auto                       sdf   = std::make_shared<SignedDistanceField>(image);
+    sdf->setScale(0.5);
+
+    auto config = std::make_shared<LevelSetModelConfig>();
+    config->m_sparseUpdate     = true;
+    config->m_substeps         = 3;
+    config->m_dt               = 0.03;
+    config->m_constantVelocity = -0.2;
+
+    auto model = std::make_shared<LevelSetModel>();
+    model->setModelGeometry(sdf);
+    model->configure(config);
+    ASSERT_TRUE(model->initialize());
+
+    // Impulses across bricks and the image boundary, some replaced or maxed
+    std::map<size_t, std::pair<Vec3i, double>> impulses;
+    for (int z = 3; z < 19; z += 2)
+    {
+        for (int y = 0; y < 21; y += 3)
+        {
+            for (int x = 0; x < 12; x++)
+            {
+                const Vec3i  coord(x, y, z);
+                const double f = 0.1 * ((x + y + z) % 7);
+                model->addImpulse(coord, f);
+                model->addImpulse(coord, 0.35);
+                impulses[image->getScalarIndex(coord)] = std::make_pair(coord, std::max(f, 0.35));
+            }
+        }
+    }
+    model->setImpulse(Vec3i(5, 6, 7), 0.05);
+    impulses[image->getScalarIndex(Vec3i(5, 6, 7))] = std::make_pair(Vec3i(5, 6, 7), 0.05);
+    model->addImpulse(Vec3i(28, 20, 18), 1.0);
+    impulses[image->getScalarIndex(Vec3i(28, 20, 18))] = std::make_pair(Vec3i(28, 20, 18), 1.0);
+    model->addImpulse(Vec3i(29, 0, 0), 1.0); // Out of bounds
+
+    EXPECT_EQ(model->getNodesToUpdate().size(), impulses.size());
+    EXPECT_GT(model->getNumActiveBricks(), 1);
+
+    // Evolve a copy with the functors
+    auto referenceImage = std::make_shared<ImageData>();
+    referenceImage->allocate(IMSTK_DOUBLE, 1, image->getDimensions(), image->getSpacing(), image->getOrigin());
+    const int numScalars = image->getScalars()->size();
+    std::copy_n(static_cast<double*>(image->getVoidPointer()), numScalars, static_cast<double*>(referenceImage->getVoidPointer()));
+    auto referenceSdf = std::make_shared<SignedDistanceField>(referenceImage);
+    referenceSdf->setScale(0.5);
+    StructuredForwardGradient  forwardGrad;
+    StructuredBackwardGradient backwardGrad;
+    forwardGrad.setFunction(referenceSdf);
+    backwardGrad.setFunction(referenceSdf);
+    forwardGrad.setDx(Vec3i(1, 1, 1), image->getSpacing());
+    backwardGrad.setDx(Vec3i(1, 1, 1), image->getSpacing());
+
+    double*      refPtr = static_cast<double*>(referenceImage->getVoidPointer());
+    const double dt     = config->m_dt / config->m_substeps;
+    for (int i = 0; i < config->m_substeps; i++)
+    {
+        std::map<size_t, Vec2d> gradientMags;
+        for (const auto& impulse : impulses)
+        {
+            const Vec3d coord   = impulse.second.first.cast<double>();
+            const Vec3d gradPos = forwardGrad(coord);
+            const Vec3d gradNeg = backwardGrad(coord);
+            const double posMag = gradNeg.cwiseMax(0.0).squaredNorm() + gradPos.cwiseMin(0.0).squaredNorm();
+            const double negMag = gradNeg.cwiseMin(0.0).squaredNorm() + gradPos.cwiseMax(0.0).squaredNorm();
+            gradientMags[impulse.first] = Vec2d(negMag, posMag);
+        }
+        for (const auto& impulse : impulses)
+        {
+            const double vel = impulse.second.second + config->m_constantVelocity;
+            const Vec2d& g   = gradientMags[impulse.first];
+            if (vel > 0.0)
+            {
+                refPtr[impulse.first] += dt * vel * std::sqrt(g[0]);
+            }
+            else if (vel < 0.0)
+            {
+                refPtr[impulse.first] += dt * vel * std::sqrt(g[1]);
+            }
+        }
+    }
+
+    model->evolve();
+
+    // Only the nodes given impulses change
+    std::shared_ptr<ImageData> initialImage = makeSphereImage();
+    const double*              imgPtr       = static_cast<const double*>(image->getVoidPointer());
+    const double*              initialPtr   = static_cast<const double*>(initialImage->getVoidPointer());
+    int                        numChanged   = 0;
+    for (int i = 0; i < numScalars; i++)
+    {
+        EXPECT_NEAR(imgPtr[i], refPtr[i], 1.0e-12);
+        if (imgPtr[i] != initialPtr[i])
+        {
+            EXPECT_EQ(impulses.count(static_cast<size_t>(i)), 1u);
+            numChanged++;
+        }
+    }
+    EXPECT_GT(numChanged, 0);
+
+    // Impulses are consumed
+    EXPECT_EQ(model->getNumActiveBricks(), 0);
+    EXPECT_TRUE(model->getNodesToUpdate().empty());
+}
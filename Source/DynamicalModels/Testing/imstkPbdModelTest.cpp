@@ -0,0 +1,203 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkGeometryUtilities.h"
+#include "imstkLineMesh.h"
+#include "imstkPbdModel.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+using namespace imstk;
+
+///
+/// \brief Hangs a stiff chain of numVerts vertices fixed at its first vertex and
+/// returns its stretch after numSteps
+///
+static double
+hangChain(const int numVerts, const unsigned int numSubsteps, const unsigned int numIterations, const int numSteps)
+{
+    auto lineMesh = std::make_shared<LineMesh>();
+    auto vertices = std::make_shared<VecDataArray<double, 3>>(numVerts);
+    auto indices  = std::make_shared<VecDataArray<int, 2>>(numVerts - 1);
+    for (int i = 0; i < numVerts; i++)
+    {
+        (*vertices)[i] = Vec3d(0.0, -0.1 * i, 0.0);
+    }
+    for (int i = 0; i < numVerts - 1; i++)
+    {
+        (*indices)[i] = Vec2i(i, i + 1);
+    }
+    lineMesh->initialize(vertices, indices);
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e8);
+    pbdParams->m_fixedNodeIds     = { 0 };
+    pbdParams->m_uniformMassValue = 1.0;
+    pbdParams->m_gravity    = Vec3d(0.0, -10.0, 0.0);
+    pbdParams->m_dt         = 0.01;
+    pbdParams->m_substeps   = numSubsteps;
+    pbdParams->m_iterations = numIterations;
+    pbdParams->m_viscousDampingCoeff = 0.0;
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(lineMesh);
+    pbdModel->configure(pbdParams);
+    pbdModel->initialize();
+
+    for (int i = 0; i < numSteps; i++)
+    {
+        pbdModel->integratePosition();
+        pbdModel->solveConstraints();
+        pbdModel->updateVelocity();
+    }
+
+    const double length = ((*vertices)[numVerts - 1] - (*vertices)[0]).norm();
+    return length / (0.1 * (numVerts - 1)) - 1.0;
+}
+
+///
+/// \brief Simulates the mesh made by makeMesh, fixed at its vertices of minimal x and
+/// bending under gravity, in double then in single precision. Returns the largest
+/// distance of a vertex between the two runs and the largest displacement of a vertex
+///
+static double
+singlePrecisionDrift(const std::function<std::shared_ptr<PointSet>()>& makeMesh,
+                     const std::function<void(PbdModelConfig&)>& enableConstraints,
+                     double& displacement)
+{
+    auto run = [&](const bool singlePrecision)
+               {
+                   std::shared_ptr<PointSet> mesh     = makeMesh();
+                   VecDataArray<double, 3>&  vertices = *mesh->getVertexPositions();
+
+                   auto pbdParams = std::make_shared<PbdModelConfig>();
+                   enableConstraints(*pbdParams);
+                   double minX = IMSTK_DOUBLE_MAX;
+                   for (int i = 0; i < vertices.size(); i++)
+                   {
+                       minX = std::min(minX, vertices[i][0]);
+                   }
+                   for (int i = 0; i < vertices.size(); i++)
+                   {
+                       if (vertices[i][0] < minX + 1.0e-6)
+                       {
+                           pbdParams->m_fixedNodeIds.push_back(i);
+                       }
+                   }
+                   pbdParams->m_uniformMassValue = 0.1;
+                   pbdParams->m_gravity         = Vec3d(0.0, -10.0, 0.0);
+                   pbdParams->m_dt              = 0.01;
+                   pbdParams->m_iterations      = 5;
+                   pbdParams->m_singlePrecision = singlePrecision;
+
+                   auto pbdModel = std::make_shared<PbdModel>();
+                   pbdModel->setModelGeometry(mesh);
+                   pbdModel->configure(pbdParams);
+                   pbdModel->initialize();
+                   EXPECT_EQ(pbdModel->getSinglePrecision(), singlePrecision);
+
+                   for (int i = 0; i < 20; i++)
+                   {
+                       pbdModel->integratePosition();
+                       pbdModel->solveConstraints();
+                       pbdModel->updateVelocity();
+                   }
+                   return mesh;
+               };
+    std::shared_ptr<PointSet> mesh  = run(false);
+    std::shared_ptr<PointSet> meshf = run(true);
+
+    double drift = 0.0;
+    displacement = 0.0;
+    for (int i = 0; i < mesh->getNumVertices(); i++)
+    {
+        drift        = std::max(drift, (mesh->getVertexPosition(i) - meshf->getVertexPosition(i)).norm());
+        displacement = std::max(displacement, (mesh->getVertexPosition(i) - mesh->getInitialVertexPosition(i)).norm());
+    }
+    return drift;
+}
+
+///
+/// \brief Test that the time step is split into the substeps
+///
+TEST(imstkPbdModelTest, TestSubstepTimeStep)
+{
+    auto pbdModel = std::make_shared<PbdModel>();
+    EXPECT_EQ(pbdModel->getConfig()->m_substeps, 1u);
+    pbdModel->getConfig()->m_dt = 0.01;
+    EXPECT_DOUBLE_EQ(pbdModel->getSubstepTimeStep(), 0.01);
+    pbdModel->getConfig()->m_substeps = 4;
+    EXPECT_DOUBLE_EQ(pbdModel->getSubstepTimeStep(), 0.0025);
+}
+
+///
+/// \brief Test that at the same number of constraint projections, many substeps
+/// of one iteration stretch a stiff chain less than one step of many iterations
+///
+TEST(imstkPbdModelTest, TestSubsteppingStiffness)
+{
+    const double stretchIterations = hangChain(30, 1, 20, 50);
+    const double stretchSubsteps   = hangChain(30, 20, 1, 50);
+    EXPECT_GT(stretchIterations, 0.0);
+    EXPECT_LT(stretchSubsteps, 0.5 * stretchIterations);
+}
+
+///
+/// \brief Test that distance and volume constraints solved in single precision
+/// follow the double precision solution
+///
+TEST(imstkPbdModelTest, TestSinglePrecisionDistanceVolume)
+{
+    double       displacement;
+    const double drift = singlePrecisionDrift(
+        []() { return GeometryUtils::toTetGrid(Vec3d::Zero(), Vec3d(1.0, 0.25, 0.25), Vec3i(8, 3, 3)); },
+        [](PbdModelConfig& config)
+        {
+            config.enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+            config.enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 1.0e2);
+        }, displacement);
+    EXPECT_GT(displacement, 1.0e-2);
+    EXPECT_LT(drift, 1.0e-4 * displacement);
+}
+
+///
+/// \brief Test that distance and dihedral constraints solved in single precision
+/// follow the double precision solution
+///
+TEST(imstkPbdModelTest, TestSinglePrecisionDistanceDihedral)
+{
+    double       displacement;
+    const double drift = singlePrecisionDrift(
+        []() { return GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(1.0, 1.0), Vec2i(8, 8)); },
+        [](PbdModelConfig& config)
+        {
+            config.enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+            config.enableConstraint(PbdModelConfig::ConstraintGenType::Dihedral, 1.0e1);
+        }, displacement);
+    EXPECT_GT(displacement, 1.0e-2);
+    EXPECT_LT(drift, 1.0e-4 * displacement);
+}
+
+///
+/// \brief Test that distance and bend constraints solved in single precision
+/// follow the double precision solution
+///
+TEST(imstkPbdModelTest, TestSinglePrecisionDistanceBend)
+{
+    double       displacement;
+    const double drift = singlePrecisionDrift(
+        []() { return GeometryUtils::toLineGrid(Vec3d::Zero(), Vec3d(1.0, 0.0, 0.0), 1.0, 10); },
+        [](PbdModelConfig& config)
+        {
+            config.enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+            config.enableBendConstraint(1.0e1, 1);
+        }, displacement);
+    EXPECT_GT(displacement, 1.0e-2);
+    EXPECT_LT(drift, 1.0e-4 * displacement);
+}
@@ -0,0 +1,115 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPointSet.h"
+#include "imstkSequentialTaskGraphController.h"
+#include "imstkSphModel.h"
+#include "imstkTaskGraph.h"
+
+namespace imstk
+{
+///
+/// \brief How the sph model executes its kernels, see SphModelConfig
+///
+enum class SphKernelExecution
+{
+    MultiPass,      ///< One pass over the particles per quantity
+    Fused,          ///< Density and forces fused in fewer passes
+    FusedFloatCache ///< Fused with a single precision kernel cache
+};
+
+///
+/// \brief Fluid flowing along x in a channel walled in y and z, entering through an
+/// inlet at x = 0 and leaving through an outlet at the other end. Shared by the sph
+/// tests and benchmarks, the model is configured but not initialized
+/// \param dim number of fluid particles along every axis
+/// \param particleRadius radius of a particle, particles are spaced by its diameter
+/// \param numBufferParticles number of particles kept to be emitted at the inlet
+/// \param execution how the model executes its kernels
+///
+inline std::shared_ptr<SphModel>
+makeSphChannelFlow(const Vec3i& dim, const double particleRadius, const size_t numBufferParticles,
+                   const SphKernelExecution execution = SphKernelExecution::MultiPass)
+{
+    const double spacing = 2.0 * particleRadius;
+    const Vec3d  size    = dim.cast<double>() * spacing;
+
+    StdVectorOfVec3d fluidPositions;
+    fluidPositions.reserve(dim[0] * dim[1] * dim[2]);
+    for (int i = 0; i < dim[0]; i++)
+    {
+        for (int j = 0; j < dim[1]; j++)
+        {
+            for (int k = 0; k < dim[2]; k++)
+            {
+                fluidPositions.push_back((Vec3d(i, j, k) + Vec3d::Constant(0.5)) * spacing);
+            }
+        }
+    }
+    StdVectorOfVec3d wallPositions;
+    for (int i = 0; i < dim[0]; i++)
+    {
+        for (int k = 0; k < dim[2]; k++)
+        {
+            wallPositions.push_back(Vec3d(i + 0.5, -0.5, k + 0.5) * spacing);
+            wallPositions.push_back(Vec3d(i + 0.5, dim[1] + 0.5, k + 0.5) * spacing);
+        }
+        for (int j = 0; j < dim[1]; j++)
+        {
+            wallPositions.push_back(Vec3d(i + 0.5, j + 0.5, -0.5) * spacing);
+            wallPositions.push_back(Vec3d(i + 0.5, j + 0.5, dim[2] + 0.5) * spacing);
+        }
+    }
+
+    std::pair<Vec3d, Vec3d>              inletCoords(Vec3d::Zero(), Vec3d(0.2 * size[0], size[1], size[2]));
+    std::vector<std::pair<Vec3d, Vec3d>> outletCoords = { { Vec3d(0.8 * size[0], 0.0, 0.0), Vec3d(size[0] + spacing, size[1], size[2]) } };
+    std::pair<Vec3d, Vec3d>              fluidCoords(Vec3d::Zero(), size);
+    const double                         inletRadius = std::max(size[1], size[2]);
+    const double                         inletSpeed  = 1.0;
+    auto                                 boundaryConditions = std::make_shared<SphBoundaryConditions>(
+        inletCoords, outletCoords, fluidCoords, Vec3d(-1.0, 0.0, 0.0), StdVectorOfVec3d{ Vec3d(1.0, 0.0, 0.0) },
+        inletRadius, Vec3d(0.5 * spacing, 0.5 * size[1], 0.5 * size[2]), 0.5 * PI * inletRadius * inletRadius * inletSpeed,
+        fluidPositions, wallPositions, numBufferParticles);
+
+    auto vertices = std::make_shared<VecDataArray<double, 3>>(static_cast<int>(fluidPositions.size()));
+    for (size_t i = 0; i < fluidPositions.size(); i++)
+    {
+        (*vertices)[i] = fluidPositions[i];
+    }
+    auto pointSet = std::make_shared<PointSet>();
+    pointSet->initialize(vertices);
+
+    auto sphParams = std::make_shared<SphModelConfig>(particleRadius);
+    sphParams->m_bNormalizeDensity = true;
+    sphParams->m_gravity = Vec3d::Zero();
+    sphParams->m_bFusedKernels     = (execution != SphKernelExecution::MultiPass);
+    sphParams->m_bFloatKernelCache = (execution == SphKernelExecution::FusedFloatCache);
+
+    auto sphModel = std::make_shared<SphModel>();
+    sphModel->setModelGeometry(pointSet);
+    sphModel->configure(sphParams);
+    sphModel->setBoundaryConditions(boundaryConditions);
+    sphModel->setTimeStepSizeType(TimeSteppingType::Fixed);
+    sphModel->setDefaultTimeStep(5.0e-4);
+    return sphModel;
+}
+
+///
+/// \brief Initialize the model and get a controller running its task graph
+///
+inline std::shared_ptr<TaskGraphController>
+initSphController(std::shared_ptr<SphModel> sphModel)
+{
+    sphModel->initialize();
+    std::static_pointer_cast<AbstractDynamicalModel>(sphModel)->initGraphEdges();
+    auto taskGraphController = std::make_shared<SequentialTaskGraphController>();
+    taskGraphController->setTaskGraph(TaskGraph::removeUnusedNodes(sphModel->getTaskGraph()));
+    taskGraphController->initialize();
+    return taskGraphController;
+}
+} // namespace imstk
@@ -0,0 +1,91 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkSphChannelFlow.h"
+
+#include <unordered_set>
+
+using namespace imstk;
+
+///
+/// \brief Test particles flow from the buffer into the inlet and from the outlet back
+/// into the buffer, every particle being either in the buffer or in the domain
+///
+TEST(imstkSphModelTest, TestParticleBuffer)
+{
+    std::shared_ptr<SphModel>            sphModel = makeSphChannelFlow(Vec3i(20, 4, 4), 0.005, 2000);
+    std::shared_ptr<TaskGraphController> taskGraphController = initSphController(sphModel);
+
+    std::shared_ptr<SphBoundaryConditions> boundaryConditions = sphModel->getBoundaryConditions();
+    const std::vector<SphBoundaryConditions::ParticleType>& particleTypes = boundaryConditions->getParticleTypes();
+    const size_t numParticles = particleTypes.size();
+    ASSERT_EQ(numParticles, sphModel->getCurrentState()->getNumParticles());
+    const size_t numFluidAndWall = numParticles - boundaryConditions->getNumBufferParticles();
+
+    for (int i = 0; i < 200; i++)
+    {
+        taskGraphController->execute();
+    }
+
+    // Buffer particles were emitted, particles left the domain
+    size_t numEmitted = 0;
+    for (size_t i = numFluidAndWall; i < numParticles; i++)
+    {
+        numEmitted += (particleTypes[i] != SphBoundaryConditions::ParticleType::Buffer) ? 1 : 0;
+    }
+    EXPECT_GT(numEmitted, 0);
+
+    // The buffer holds exactly the buffer particles, once each
+    const std::vector<size_t>& bufferIndices = boundaryConditions->getBufferIndices();
+    std::unordered_set<size_t> bufferSet(bufferIndices.begin(), bufferIndices.end());
+    EXPECT_EQ(bufferSet.size(), bufferIndices.size());
+    size_t numBuffer = 0;
+    for (size_t i = 0; i < numParticles; i++)
+    {
+        const bool isBuffer = (particleTypes[i] == SphBoundaryConditions::ParticleType::Buffer);
+        numBuffer += isBuffer ? 1 : 0;
+        EXPECT_EQ(isBuffer, bufferSet.count(i) == 1) << "particle " << i;
+    }
+    EXPECT_EQ(numBuffer, bufferIndices.size());
+    EXPECT_LT(numBuffer, boundaryConditions->getNumBufferParticles());
+}
+
+///
+/// \brief Test the fused execution gives the same flow as the multi-pass execution,
+/// up to the precision of the kernel cache
+///
+TEST(imstkSphModelTest, TestFusedKernels)
+{
+    std::shared_ptr<SphModel> sphModel      = makeSphChannelFlow(Vec3i(20, 4, 4), 0.005, 2000);
+    std::shared_ptr<SphModel> fusedModel    = makeSphChannelFlow(Vec3i(20, 4, 4), 0.005, 2000, SphKernelExecution::Fused);
+    std::shared_ptr<SphModel> floatSphModel = makeSphChannelFlow(Vec3i(20, 4, 4), 0.005, 2000, SphKernelExecution::FusedFloatCache);
+    std::shared_ptr<TaskGraphController> taskGraphController      = initSphController(sphModel);
+    std::shared_ptr<TaskGraphController> fusedTaskGraphController = initSphController(fusedModel);
+    std::shared_ptr<TaskGraphController> floatTaskGraphController = initSphController(floatSphModel);
+
+    for (int i = 0; i < 20; i++)
+    {
+        taskGraphController->execute();
+        fusedTaskGraphController->execute();
+        floatTaskGraphController->execute();
+    }
+
+    const VecDataArray<double, 3>& positions      = *sphModel->getCurrentState()->getPositions();
+    const VecDataArray<double, 3>& fusedPositions = *fusedModel->getCurrentState()->getPositions();
+    const VecDataArray<double, 3>& floatPositions = *floatSphModel->getCurrentState()->getPositions();
+    const DataArray<double>&       densities      = *sphModel->getCurrentState()->getDensities();
+    const DataArray<double>&       fusedDensities = *fusedModel->getCurrentState()->getDensities();
+    ASSERT_EQ(positions.size(), fusedPositions.size());
+    ASSERT_EQ(positions.size(), floatPositions.size());
+    for (int i = 0; i < positions.size(); i++)
+    {
+        EXPECT_NEAR((positions[i] - fusedPositions[i]).norm(), 0.0, 1.0e-10) << "particle " << i;
+        EXPECT_NEAR(densities[i], fusedDensities[i], 1.0e-6) << "particle " << i;
+        EXPECT_NEAR((positions[i] - floatPositions[i]).norm(), 0.0, 1.0e-4) << "particle " << i;
+    }
+}
@@ -0,0 +1,314 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDataArray.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkImageData.h"
+#include "imstkImageGradient.h"
+#include "imstkImageResample.h"
+#include "imstkImageReslice.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkSurfaceMeshFlyingEdges.h"
+#include "imstkSurfaceMeshImageMask.h"
+
+#include <benchmark/benchmark.h>
+
+#include <vtkImageData.h>
+#include <vtkImageGradient.h>
+#include <vtkImageGradientMagnitude.h>
+#include <vtkImageResample.h>
+#include <vtkImageReslice.h>
+#include <vtkImageStencil.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataToImageStencil.h>
+#include <vtkTransform.h>
+
+using namespace imstk;
+
+///
+/// \brief Creates the signed distance image of a sphere in [-1, 1]^3 with dim voxels per side
+///
+static std::shared_ptr<ImageData>
+makeSphereImage(const int dim)
+{
+    const double spacing = 2.0 / dim;
+    auto         image   = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(dim, dim, dim), Vec3d(spacing, spacing, spacing), Vec3d(-1.0, -1.0, -1.0));
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                const Vec3d pos = Vec3d(x + 0.5, y + 0.5, z + 0.5) * spacing - Vec3d(1.0, 1.0, 1.0);
+                scalars[image->getScalarIndex(x, y, z)] = pos.norm() - 0.7;
+            }
+        }
+    }
+    return image;
+}
+
+///
+/// \brief Transform mapping the output of a reslice to its input, a rotation
+/// of 0.5 radians about y
+///
+static Mat4d
+getResliceTransform()
+{
+    return mat4dRotation(Rotd(0.5, Vec3d(0.0, 1.0, 0.0)));
+}
+
+///
+/// \brief Gradient of the image with VTK
+///
+static void
+BM_VtkImageGradient(benchmark::State& state)
+{
+    vtkSmartPointer<vtkImageData> imageVtk = GeometryUtils::coupleVtkImageData(makeSphereImage(state.range(0)));
+
+    vtkNew<vtkImageGradient> gradients;
+    gradients->SetInputData(imageVtk);
+    gradients->SetDimensionality(3);
+    gradients->SetHandleBoundaries(true);
+    for (auto _ : state)
+    {
+        gradients->Modified();
+        gradients->Update();
+    }
+}
+
+BENCHMARK(BM_VtkImageGradient)
+->Unit(benchmark::kMillisecond)
+->Name("VTK image gradient")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Gradient of the image with ImageGradient
+///
+static void
+BM_ImageGradient(benchmark::State& state)
+{
+    ImageGradient gradient;
+    gradient.setInputImage(makeSphereImage(state.range(0)));
+    for (auto _ : state)
+    {
+        gradient.update();
+    }
+}
+
+BENCHMARK(BM_ImageGradient)
+->Unit(benchmark::kMillisecond)
+->Name("Image gradient")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Gradient magnitude of the image with VTK
+///
+static void
+BM_VtkImageGradientMagnitude(benchmark::State& state)
+{
+    vtkSmartPointer<vtkImageData> imageVtk = GeometryUtils::coupleVtkImageData(makeSphereImage(state.range(0)));
+
+    vtkNew<vtkImageGradientMagnitude> gradientMagnitude;
+    gradientMagnitude->SetInputData(imageVtk);
+    gradientMagnitude->SetDimensionality(3);
+    for (auto _ : state)
+    {
+        gradientMagnitude->Modified();
+        gradientMagnitude->Update();
+    }
+}
+
+BENCHMARK(BM_VtkImageGradientMagnitude)
+->Unit(benchmark::kMillisecond)
+->Name("VTK image gradient magnitude")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Gradient magnitude of the image with ImageGradient
+///
+static void
+BM_ImageGradientMagnitude(benchmark::State& state)
+{
+    ImageGradient gradient;
+    gradient.setInputImage(makeSphereImage(state.range(0)));
+    gradient.setComputeMagnitude(true);
+    for (auto _ : state)
+    {
+        gradient.update();
+    }
+}
+
+BENCHMARK(BM_ImageGradientMagnitude)
+->Unit(benchmark::kMillisecond)
+->Name("Image gradient magnitude")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Trilinear (0) or cubic (1) upsampling of the image to twice its dimensions with VTK
+///
+static void
+BM_VtkImageResample(benchmark::State& state)
+{
+    vtkSmartPointer<vtkImageData> imageVtk = GeometryUtils::coupleVtkImageData(makeSphereImage(state.range(0)));
+
+    vtkNew<vtkImageResample> resample;
+    resample->SetInputData(imageVtk);
+    resample->SetMagnificationFactors(2.0, 2.0, 2.0);
+    if (state.range(1) == 0)
+    {
+        resample->SetInterpolationModeToLinear();
+    }
+    else
+    {
+        resample->SetInterpolationModeToCubic();
+    }
+    for (auto _ : state)
+    {
+        resample->Modified();
+        resample->Update();
+    }
+}
+
+BENCHMARK(BM_VtkImageResample)
+->Unit(benchmark::kMillisecond)
+->Name("VTK image resample")
+->ArgsProduct({ { 64, 128 }, { 0, 1 } });
+
+///
+/// \brief Trilinear (0) or cubic (1) upsampling of the image to twice its dimensions with ImageResample
+///
+static void
+BM_ImageResample(benchmark::State& state)
+{
+    ImageResample resample;
+    resample.setInputImage(makeSphereImage(state.range(0)));
+    resample.setDimensions(Vec3i(state.range(0) * 2, state.range(0) * 2, state.range(0) * 2));
+    resample.setInterpolationType(state.range(1) == 0 ? ImageInterpolationType::Linear : ImageInterpolationType::Cubic);
+    for (auto _ : state)
+    {
+        resample.update();
+    }
+}
+
+BENCHMARK(BM_ImageResample)
+->Unit(benchmark::kMillisecond)
+->Name("Image resample")
+->ArgsProduct({ { 64, 128 }, { 0, 1 } });
+
+///
+/// \brief Trilinear reslice of the rotated image with VTK
+///
+static void
+BM_VtkImageReslice(benchmark::State& state)
+{
+    vtkSmartPointer<vtkImageData> imageVtk = GeometryUtils::coupleVtkImageData(makeSphereImage(state.range(0)));
+
+    const Mat4d        transform = getResliceTransform().transpose();
+    vtkNew<vtkTransform> transformVtk;
+    transformVtk->SetMatrix(transform.data());
+
+    vtkNew<vtkImageReslice> reslice;
+    reslice->SetInputData(imageVtk);
+    reslice->SetResliceTransform(transformVtk);
+    reslice->SetInterpolationModeToLinear();
+    reslice->AutoCropOutputOn();
+    for (auto _ : state)
+    {
+        reslice->Modified();
+        reslice->Update();
+    }
+}
+
+BENCHMARK(BM_VtkImageReslice)
+->Unit(benchmark::kMillisecond)
+->Name("VTK image reslice")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Trilinear reslice of the rotated image with ImageReslice
+///
+static void
+BM_ImageReslice(benchmark::State& state)
+{
+    ImageReslice reslice;
+    reslice.setInputImage(makeSphereImage(state.range(0)));
+    reslice.setTransform(getResliceTransform());
+    reslice.setInterpolationType(ImageInterpolationType::Linear);
+    for (auto _ : state)
+    {
+        reslice.update();
+    }
+}
+
+BENCHMARK(BM_ImageReslice)
+->Unit(benchmark::kMillisecond)
+->Name("Image reslice")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Mask of the sphere surface over the image with VTK's stencils
+///
+static void
+BM_VtkImageMask(benchmark::State& state)
+{
+    std::shared_ptr<ImageData> image = makeSphereImage(state.range(0));
+
+    SurfaceMeshFlyingEdges isoExtract;
+    isoExtract.setInputImage(image);
+    isoExtract.update();
+    vtkSmartPointer<vtkPolyData> surfMeshVtk = GeometryUtils::copyToVtkPolyData(isoExtract.getOutputMesh());
+
+    vtkSmartPointer<vtkImageData> imageVtk = GeometryUtils::coupleVtkImageData(image);
+
+    vtkNew<vtkPolyDataToImageStencil> poly2Stencil;
+    poly2Stencil->SetInputData(surfMeshVtk);
+    poly2Stencil->SetInformationInput(imageVtk);
+    vtkNew<vtkImageStencil> imgStencil;
+    imgStencil->SetInputData(imageVtk);
+    imgStencil->SetStencilConnection(poly2Stencil->GetOutputPort());
+    imgStencil->ReverseStencilOff();
+    imgStencil->SetBackgroundValue(0.0);
+    for (auto _ : state)
+    {
+        poly2Stencil->Modified();
+        imgStencil->Update();
+    }
+}
+
+BENCHMARK(BM_VtkImageMask)
+->Unit(benchmark::kMillisecond)
+->Name("VTK surface mesh image mask")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Mask of the sphere surface over the image with SurfaceMeshImageMask
+///
+static void
+BM_SurfaceMeshImageMask(benchmark::State& state)
+{
+    std::shared_ptr<ImageData> image = makeSphereImage(state.range(0));
+
+    SurfaceMeshFlyingEdges isoExtract;
+    isoExtract.setInputImage(image);
+    isoExtract.update();
+
+    SurfaceMeshImageMask imageMask;
+    imageMask.setInputMesh(isoExtract.getOutputMesh());
+    imageMask.setReferenceImage(image);
+    for (auto _ : state)
+    {
+        imageMask.update();
+    }
+}
+
+BENCHMARK(BM_SurfaceMeshImageMask)
+->Unit(benchmark::kMillisecond)
+->Name("Surface mesh image mask")
+->Arg(64)->Arg(128)->Arg(256);
+
+BENCHMARK_MAIN();
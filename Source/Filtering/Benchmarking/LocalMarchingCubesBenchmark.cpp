@@ -0,0 +1,186 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDataArray.h"
+#include "imstkImageData.h"
+#include "imstkLocalMarchingCubes.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkSurfaceMeshFlyingEdges.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Creates the signed distance image of a sphere in [-1, 1]^3 with dim voxels per side
+///
+static std::shared_ptr<ImageData>
+makeSphereImage(const int dim)
+{
+    const double spacing = 2.0 / dim;
+    auto         image   = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(dim, dim, dim), Vec3d(spacing, spacing, spacing), Vec3d(-1.0, -1.0, -1.0));
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                const Vec3d pos = Vec3d(x + 0.5, y + 0.5, z + 0.5) * spacing - Vec3d(1.0, 1.0, 1.0);
+                scalars[image->getScalarIndex(x, y, z)] = pos.norm() - 0.7;
+            }
+        }
+    }
+    return image;
+}
+
+///
+/// \brief Removes a ball of radius 4 voxels around the drill, moving the drill along the
+/// equator of the sphere every frame as in level set bone drilling
+/// \return the drilled voxels
+///
+static std::vector<Vec3i>
+drill(ImageData& image, const int frame)
+{
+    const int    dim    = image.getDimensions()[0];
+    const double angle  = frame * 0.02;
+    const Vec3d  center = Vec3d(std::cos(angle) * 0.35 * dim, std::sin(angle) * 0.35 * dim, 0.0) + Vec3d(dim, dim, dim) * 0.5;
+    const double radius = 4.0;
+
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image.getScalars());
+    std::vector<Vec3i> modifiedVoxels;
+    const Vec3i        min = (center - Vec3d(radius, radius, radius)).cast<int>().cwiseMax(0);
+    const Vec3i        max = (center + Vec3d(radius, radius, radius)).cast<int>().cwiseMin(dim - 1);
+    for (int z = min[2]; z <= max[2]; z++)
+    {
+        for (int y = min[1]; y <= max[1]; y++)
+        {
+            for (int x = min[0]; x <= max[0]; x++)
+            {
+                const double dist = (Vec3d(x, y, z) - center).norm();
+                if (dist < radius)
+                {
+                    double& val = scalars[image.getScalarIndex(x, y, z)];
+                    val = std::max(val, (radius - dist) * image.getSpacing()[0]);
+                    modifiedVoxels.push_back(Vec3i(x, y, z));
+                }
+            }
+        }
+    }
+    return modifiedVoxels;
+}
+
+///
+/// \brief Extraction of the whole image by VTK's flying edges
+///
+static void
+BM_FlyingEdges(benchmark::State& state)
+{
+    std::shared_ptr<ImageData> image = makeSphereImage(state.range(0) + 1);
+
+    SurfaceMeshFlyingEdges isoExtract;
+    isoExtract.setInputImage(image);
+    isoExtract.setIsoValue(0.0);
+    for (auto _ : state)
+    {
+        isoExtract.update();
+    }
+
+    state.counters["Triangles"] = isoExtract.getOutputMesh()->getNumCells();
+}
+
+BENCHMARK(BM_FlyingEdges)
+->Unit(benchmark::kMillisecond)
+->Name("Flying edges")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Extraction of the whole image by local marching cubes in chunks^3 chunks
+///
+static void
+BM_LocalMarchingCubes(benchmark::State& state)
+{
+    std::shared_ptr<ImageData> image = makeSphereImage(state.range(0) + 1);
+
+    LocalMarchingCubes isoExtract;
+    isoExtract.setInputImage(image);
+    isoExtract.setIsoValue(0.0);
+    isoExtract.setNumberOfChunks(Vec3i(state.range(1), state.range(1), state.range(1)));
+    for (auto _ : state)
+    {
+        isoExtract.setAllModified(true);
+        isoExtract.update();
+    }
+
+    int numTriangles = 0;
+    for (int i = 0; i < state.range(1) * state.range(1) * state.range(1); i++)
+    {
+        numTriangles += isoExtract.getOutputMesh(i)->getNumCells();
+    }
+    state.counters["Triangles"] = numTriangles;
+}
+
+BENCHMARK(BM_LocalMarchingCubes)
+->Unit(benchmark::kMillisecond)
+->Name("Local marching cubes")
+->ArgsProduct({ { 64, 128, 256 }, { 1, 8 } });
+
+///
+/// \brief Drilling a frame, then extracting the whole image by VTK's flying edges
+///
+static void
+BM_FlyingEdgesDrilling(benchmark::State& state)
+{
+    std::shared_ptr<ImageData> image = makeSphereImage(state.range(0) + 1);
+
+    SurfaceMeshFlyingEdges isoExtract;
+    isoExtract.setInputImage(image);
+    isoExtract.setIsoValue(0.0);
+    int frame = 0;
+    for (auto _ : state)
+    {
+        drill(*image, frame++);
+        image->postModified();
+        isoExtract.update();
+    }
+}
+
+BENCHMARK(BM_FlyingEdgesDrilling)
+->Unit(benchmark::kMillisecond)
+->Name("Flying edges drilling")
+->Arg(64)->Arg(128)->Arg(256);
+
+///
+/// \brief Drilling a frame, then updating only the chunks of the drilled voxels
+///
+static void
+BM_LocalMarchingCubesDrilling(benchmark::State& state)
+{
+    std::shared_ptr<ImageData> image = makeSphereImage(state.range(0) + 1);
+
+    LocalMarchingCubes isoExtract;
+    isoExtract.setInputImage(image);
+    isoExtract.setIsoValue(0.0);
+    isoExtract.setNumberOfChunks(Vec3i(state.range(1), state.range(1), state.range(1)));
+    isoExtract.update();
+    int frame = 0;
+    for (auto _ : state)
+    {
+        for (const Vec3i& voxel : drill(*image, frame++))
+        {
+            isoExtract.setModified(voxel);
+        }
+        isoExtract.update();
+    }
+}
+
+BENCHMARK(BM_LocalMarchingCubesDrilling)
+->Unit(benchmark::kMillisecond)
+->Name("Local marching cubes drilling")
+->ArgsProduct({ { 64, 128, 256 }, { 8, 16 } });
+
+BENCHMARK_MAIN();
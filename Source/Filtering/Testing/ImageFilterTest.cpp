@@ -0,0 +1,214 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDataArray.h"
+#include "imstkImageData.h"
+#include "imstkImageGradient.h"
+#include "imstkImageResample.h"
+#include "imstkImageReslice.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkSurfaceMeshImageMask.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Create an image of the linear function x + 2y + 3z over voxel centers
+///
+std::shared_ptr<ImageData>
+createRampImage(const Vec3i& dim)
+{
+    auto image = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, dim, Vec3d(0.1, 0.1, 0.1), Vec3d(-1.0, -1.0, -1.0));
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    for (int z = 0; z < dim[2]; z++)
+    {
+        for (int y = 0; y < dim[1]; y++)
+        {
+            for (int x = 0; x < dim[0]; x++)
+            {
+                const Vec3d pos = image->getOrigin() + (Vec3d(x, y, z) + Vec3d(0.5, 0.5, 0.5)) * 0.1;
+                scalars[image->getScalarIndex(x, y, z)] = pos[0] + 2.0 * pos[1] + 3.0 * pos[2];
+            }
+        }
+    }
+    return image;
+}
+
+///
+/// \brief Create a closed box surface of the given bounds
+///
+std::shared_ptr<SurfaceMesh>
+createBoxMesh(const Vec3d& min, const Vec3d& max)
+{
+    auto vertices = std::make_shared<VecDataArray<double, 3>>(8);
+    for (int i = 0; i < 8; i++)
+    {
+        (*vertices)[i] = Vec3d((i & 1) ? max[0] : min[0], (i & 2) ? max[1] : min[1], (i & 4) ? max[2] : min[2]);
+    }
+    auto cells = std::make_shared<VecDataArray<int, 3>>(12);
+    *cells = {
+        Vec3i(0, 2, 1), Vec3i(1, 2, 3), Vec3i(4, 5, 6), Vec3i(5, 7, 6),
+        Vec3i(0, 1, 4), Vec3i(1, 5, 4), Vec3i(2, 6, 3), Vec3i(3, 6, 7),
+        Vec3i(0, 4, 2), Vec3i(2, 4, 6), Vec3i(1, 3, 5), Vec3i(3, 7, 5)
+    };
+    auto surfMesh = std::make_shared<SurfaceMesh>();
+    surfMesh->initialize(vertices, cells);
+    return surfMesh;
+}
+} // namespace
+
+///
+/// \brief Test that resampling a linear function reproduces it within the image
+/// for every interpolation
+///
+TEST(ImageFilterTest, Resample)
+{
+    std::shared_ptr<ImageData> image = createRampImage(Vec3i(10, 12, 8));
+
+    for (auto type : { ImageInterpolationType::Linear, ImageInterpolationType::Cubic })
+    {
+        ImageResample resample;
+        resample.setInputImage(image);
+        resample.setDimensions(Vec3i(20, 24, 16));
+        resample.setInterpolationType(type);
+        resample.update();
+
+        std::shared_ptr<ImageData> outputImage = resample.getOutputImage();
+        ASSERT_EQ(outputImage->getDimensions(), Vec3i(20, 24, 16));
+        EXPECT_TRUE(outputImage->getSpacing().isApprox(Vec3d(0.05, 0.05, 0.05)));
+        EXPECT_TRUE(outputImage->getOrigin().isApprox(image->getOrigin()));
+
+        // Away from the border, where the cubic neighbors are clamped, the linear function is exact
+        const double* outputPtr = static_cast<const double*>(outputImage->getVoidPointer());
+        for (int z = 3; z < 13; z++)
+        {
+            for (int y = 3; y < 21; y++)
+            {
+                for (int x = 3; x < 17; x++)
+                {
+                    const Vec3d pos = outputImage->getOrigin() + (Vec3d(x, y, z) + Vec3d(0.5, 0.5, 0.5)) * 0.05;
+                    EXPECT_NEAR(outputPtr[outputImage->getScalarIndex(x, y, z)], pos[0] + 2.0 * pos[1] + 3.0 * pos[2], 1.0e-10);
+                }
+            }
+        }
+    }
+}
+
+///
+/// \brief Test reslicing by a rotation of a quarter turn and a translation of whole
+/// voxels, which maps every output voxel exactly on an input voxel
+///
+TEST(ImageFilterTest, Reslice)
+{
+    std::shared_ptr<ImageData> image = createRampImage(Vec3i(10, 12, 8));
+
+    Mat4d transform = Mat4d::Identity();
+    transform.block<3, 3>(0, 0) = Rotd(PI_2, Vec3d(0.0, 0.0, 1.0)).toRotationMatrix();
+    transform.block<3, 1>(0, 3) = Vec3d(0.2, -0.3, 0.1);
+
+    for (auto type : { ImageInterpolationType::NearestNeighbor, ImageInterpolationType::Linear, ImageInterpolationType::Cubic })
+    {
+        ImageReslice reslice;
+        reslice.setInputImage(image);
+        reslice.setTransform(transform);
+        reslice.setInterpolationType(type);
+        reslice.update();
+
+        std::shared_ptr<ImageData> outputImage = reslice.getOutputImage();
+        ASSERT_EQ(outputImage->getDimensions(), Vec3i(12, 10, 8));
+        EXPECT_TRUE(outputImage->getSpacing().isApprox(image->getSpacing()));
+
+        const double* outputPtr = static_cast<const double*>(outputImage->getVoidPointer());
+        for (int z = 0; z < 8; z++)
+        {
+            for (int y = 0; y < 10; y++)
+            {
+                for (int x = 0; x < 12; x++)
+                {
+                    const Vec3d pos = outputImage->getOrigin() + (Vec3d(x, y, z) + Vec3d(0.5, 0.5, 0.5)) * 0.1;
+                    const Vec3d inputPos = (transform * pos.homogeneous()).head<3>();
+                    EXPECT_NEAR(outputPtr[outputImage->getScalarIndex(x, y, z)],
+                        inputPos[0] + 2.0 * inputPos[1] + 3.0 * inputPos[2], 1.0e-10);
+                }
+            }
+        }
+    }
+}
+
+///
+/// \brief Test the gradient and its magnitude of a linear function, including on the border
+///
+TEST(ImageFilterTest, Gradient)
+{
+    std::shared_ptr<ImageData> image = createRampImage(Vec3i(10, 12, 8));
+
+    ImageGradient gradient;
+    gradient.setInputImage(image);
+    gradient.update();
+
+    std::shared_ptr<ImageData> gradientImage = gradient.getOutputImage();
+    ASSERT_EQ(gradientImage->getNumComponents(), 3);
+    ASSERT_EQ(gradientImage->getScalarType(), IMSTK_DOUBLE);
+    const double* gradientPtr = static_cast<const double*>(gradientImage->getVoidPointer());
+    for (int i = 0; i < 10 * 12 * 8; i++)
+    {
+        EXPECT_NEAR(gradientPtr[i * 3], 1.0, 1.0e-10);
+        EXPECT_NEAR(gradientPtr[i * 3 + 1], 2.0, 1.0e-10);
+        EXPECT_NEAR(gradientPtr[i * 3 + 2], 3.0, 1.0e-10);
+    }
+
+    gradient.setComputeMagnitude(true);
+    gradient.update();
+
+    std::shared_ptr<ImageData> magnitudeImage = gradient.getOutputImage();
+    ASSERT_EQ(magnitudeImage->getNumComponents(), 1);
+    const double* magnitudePtr = static_cast<const double*>(magnitudeImage->getVoidPointer());
+    for (int i = 0; i < 10 * 12 * 8; i++)
+    {
+        EXPECT_NEAR(magnitudePtr[i], std::sqrt(14.0), 1.0e-10);
+    }
+}
+
+///
+/// \brief Test the mask of a box covers exactly the voxels with centers in the box
+///
+TEST(ImageFilterTest, SurfaceMeshImageMask)
+{
+    auto referenceImage = std::make_shared<ImageData>();
+    referenceImage->allocate(IMSTK_DOUBLE, 1, Vec3i(20, 20, 20), Vec3d(0.1, 0.1, 0.1), Vec3d(-1.0, -1.0, -1.0));
+
+    const Vec3d min(-0.5, -0.3, -0.8);
+    const Vec3d max(0.4, 0.6, 0.2);
+
+    SurfaceMeshImageMask imageMask;
+    imageMask.setInputMesh(createBoxMesh(min, max));
+    imageMask.setReferenceImage(referenceImage);
+    imageMask.update();
+
+    std::shared_ptr<ImageData> maskImage = imageMask.getOutputImage();
+    ASSERT_EQ(maskImage->getDimensions(), Vec3i(20, 20, 20));
+    ASSERT_EQ(maskImage->getScalarType(), IMSTK_FLOAT);
+    EXPECT_TRUE(maskImage->getOrigin().isApprox(referenceImage->getOrigin()));
+
+    const float* maskPtr = static_cast<const float*>(maskImage->getVoidPointer());
+    for (int z = 0; z < 20; z++)
+    {
+        for (int y = 0; y < 20; y++)
+        {
+            for (int x = 0; x < 20; x++)
+            {
+                const Vec3d pos    = Vec3d(-0.95, -0.95, -0.95) + Vec3d(x, y, z) * 0.1;
+                const bool  inside = (pos.array() > min.array()).all() && (pos.array() < max.array()).all();
+                EXPECT_EQ(maskPtr[maskImage->getScalarIndex(x, y, z)], inside ? 1.0f : 0.0f);
+            }
+        }
+    }
+}
@@ -0,0 +1,186 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDataArray.h"
+#include "imstkImageData.h"
+#include "imstkLocalMarchingCubes.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+using namespace imstk;
+
+namespace
+{
+using Position = std::array<double, 3>;
+using Triangle = std::array<Position, 3>;
+
+///
+/// \brief Create the signed distance image of a sphere of radius 0.7 in [-1, 1]^3
+///
+std::shared_ptr<ImageData>
+createSphereImage(const int dim)
+{
+    const double spacing = 2.0 / dim;
+    auto         image   = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(dim, dim, dim), Vec3d(spacing, spacing, spacing), Vec3d(-1.0, -1.0, -1.0));
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                const Vec3d pos = Vec3d(x + 0.5, y + 0.5, z + 0.5) * spacing - Vec3d(1.0, 1.0, 1.0);
+                scalars[image->getScalarIndex(x, y, z)] = pos.norm() - 0.7;
+            }
+        }
+    }
+    return image;
+}
+
+Position
+toPosition(const Vec3d& pos)
+{
+    return { { pos[0], pos[1], pos[2] } };
+}
+
+///
+/// \brief Get the triangles of a chunk by their vertex positions, rotated to start
+/// at the smallest position to compare independent of the vertex order
+///
+std::set<Triangle>
+getTriangles(const SurfaceMesh& surfMesh)
+{
+    const VecDataArray<double, 3>& vertices = *surfMesh.getVertexPositions();
+    std::set<Triangle>             triangles;
+    for (const Vec3i& cell : *surfMesh.getCells())
+    {
+        Triangle tri = { { toPosition(vertices[cell[0]]), toPosition(vertices[cell[1]]), toPosition(vertices[cell[2]]) } };
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        triangles.insert(tri);
+    }
+    return triangles;
+}
+} // namespace
+
+///
+/// \brief Test that the chunks share their vertices and together give a closed
+/// surface, the vertices along the seams of the chunks being identical
+///
+TEST(LocalMarchingCubesTest, Watertight)
+{
+    std::shared_ptr<ImageData> image = createSphereImage(33);
+
+    LocalMarchingCubes isoExtract;
+    isoExtract.setInputImage(image);
+    isoExtract.setNumberOfChunks(Vec3i(4, 4, 4));
+    isoExtract.update();
+
+    // Merge the chunks by vertex position
+    std::map<Position, int>          mergedIds;
+    std::map<std::pair<int, int>, int> edgeUseCount;
+    int                              numTriangles = 0;
+    for (int i = 0; i < 64; i++)
+    {
+        std::shared_ptr<SurfaceMesh>   surfMesh = isoExtract.getOutputMesh(i);
+        const VecDataArray<double, 3>& vertices = *surfMesh->getVertexPositions();
+
+        // No duplicate vertices within a chunk
+        std::vector<int> ids(vertices.size());
+        for (int j = 0; j < vertices.size(); j++)
+        {
+            const size_t numMerged = mergedIds.size();
+            auto         iter      = mergedIds.insert(std::make_pair(toPosition(vertices[j]), static_cast<int>(numMerged))).first;
+            ids[j] = iter->second;
+        }
+        std::set<Position> chunkPositions;
+        for (const Vec3d& pos : vertices)
+        {
+            chunkPositions.insert(toPosition(pos));
+        }
+        EXPECT_EQ(static_cast<int>(chunkPositions.size()), vertices.size());
+        EXPECT_EQ(surfMesh->getVertexNormals()->size(), vertices.size());
+
+        for (const Vec3i& cell : *surfMesh->getCells())
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                const int id1 = ids[cell[j]];
+                const int id2 = ids[cell[(j + 1) % 3]];
+                edgeUseCount[std::make_pair(std::min(id1, id2), std::max(id1, id2))]++;
+            }
+        }
+        numTriangles += surfMesh->getNumCells();
+    }
+    EXPECT_GT(numTriangles, 0);
+
+    // Every edge of a closed surface is used by two triangles
+    for (const auto& edge : edgeUseCount)
+    {
+        EXPECT_EQ(edge.second, 2);
+    }
+
+    // The same surface results from a single chunk
+    LocalMarchingCubes singleExtract;
+    singleExtract.setInputImage(image);
+    singleExtract.setNumberOfChunks(Vec3i(1, 1, 1));
+    singleExtract.update();
+    EXPECT_EQ(singleExtract.getOutputMesh(0)->getNumCells(), numTriangles);
+    EXPECT_EQ(singleExtract.getOutputMesh(0)->getNumVertices(), static_cast<int>(mergedIds.size()));
+}
+
+///
+/// \brief Test that updating the modified voxels gives the same chunks as extracting
+/// the modified image from scratch, reusing the buffers of the chunks
+///
+TEST(LocalMarchingCubesTest, LocalUpdate)
+{
+    std::shared_ptr<ImageData> image = createSphereImage(33);
+
+    LocalMarchingCubes isoExtract;
+    isoExtract.setInputImage(image);
+    isoExtract.setNumberOfChunks(Vec3i(4, 4, 4));
+    isoExtract.update();
+
+    std::vector<std::shared_ptr<VecDataArray<double, 3>>> vertexBuffers;
+    for (int i = 0; i < 64; i++)
+    {
+        vertexBuffers.push_back(isoExtract.getOutputMesh(i)->getVertexPositions());
+    }
+
+    // Carve a hole in the sphere around a seam between chunks
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    for (int z = 12; z < 21; z++)
+    {
+        for (int y = 12; y < 21; y++)
+        {
+            for (int x = 24; x < 33; x++)
+            {
+                const size_t index = image->getScalarIndex(x, y, z);
+                scalars[index] = std::max(scalars[index], 0.3 - (Vec3d(x, y, z) - Vec3d(32.0, 16.0, 16.0)).norm() / 16.0);
+                isoExtract.setModified(Vec3i(x, y, z));
+            }
+        }
+    }
+    isoExtract.update();
+
+    LocalMarchingCubes reference;
+    reference.setInputImage(image);
+    reference.setNumberOfChunks(Vec3i(4, 4, 4));
+    reference.update();
+
+    for (int i = 0; i < 64; i++)
+    {
+        EXPECT_EQ(isoExtract.getOutputMesh(i)->getVertexPositions(), vertexBuffers[i]);
+        EXPECT_EQ(getTriangles(*isoExtract.getOutputMesh(i)), getTriangles(*reference.getOutputMesh(i)));
+    }
+}
@@ -5,13 +5,10 @@
 */
 
 #include "imstkImageGradient.h"
-#include "imstkGeometryUtilities.h"
+#include "imstkDataArray.h"
 #include "imstkImageData.h"
 #include "imstkLogger.h"
-
-#include <vtkImageData.h>
-#include <vtkImageGradient.h>
-#include <vtkImageGradientMagnitude.h>
+#include "imstkParallelFor.h"
 
 namespace imstk
 {
@@ -21,7 +18,13 @@ ImageGradient::ImageGradient()
     setRequiredInputType<ImageData>(0);
 
     setNumOutputPorts(1);
-    setOutput(std::make_shared<PointSet>());
+    setOutput(std::make_shared<ImageData>());
+}
+
+std::shared_ptr<ImageData>
+ImageGradient::getOutputImage() const
+{
+    return std::dynamic_pointer_cast<ImageData>(getOutput(0));
 }
 
 void
@@ -30,6 +33,102 @@ ImageGradient::setInputImage(std::shared_ptr<ImageData> inputImage)
     setInput(inputImage, 0);
 }
 
+///
+/// \brief Get the neighbors of index i along an axis of size dim, clamped to the image,
+/// and the inverse of the distance between them
+///
+static void
+getNeighbors(const int i, const int dim, const double invSpacing, int& prev, int& next, double& invDist)
+{
+    prev    = std::max(i - 1, 0);
+    next    = std::min(i + 1, dim - 1);
+    invDist = (next > prev) ? invSpacing / (next - prev) : 0.0;
+}
+
+///
+/// \brief Compute the gradient by central differences, one sided on the border. Each row
+/// is differenced separately along every axis into contiguous buffers
+///
+template<typename T>
+static void
+computeGradient(const ImageData& inputImage, ImageData& outputImage, const bool computeMagnitude)
+{
+    const T*     inputPtr   = static_cast<const T*>(inputImage.getScalars()->getVoidPointer());
+    double*      outputPtr  = static_cast<double*>(outputImage.getScalars()->getVoidPointer());
+    const Vec3i& dim        = inputImage.getDimensions();
+    const Vec3d  invSpacing = inputImage.getInvSpacing();
+    const size_t sliceSize  = static_cast<size_t>(dim[0]) * dim[1];
+
+    ParallelUtils::parallelFor(dim[2], [&](const int z)
+        {
+            std::vector<double> gradX(dim[0]);
+            std::vector<double> gradY(dim[0]);
+            std::vector<double> gradZ(dim[0]);
+
+            int    z0, z1;
+            double invDz;
+            getNeighbors(z, dim[2], invSpacing[2], z0, z1, invDz);
+            for (int y = 0; y < dim[1]; y++)
+            {
+                int    y0, y1;
+                double invDy;
+                getNeighbors(y, dim[1], invSpacing[1], y0, y1, invDy);
+
+                const size_t rowIndex = z * sliceSize + static_cast<size_t>(y) * dim[0];
+                const T*     row      = inputPtr + rowIndex;
+                const T*     rowY0    = inputPtr + z * sliceSize + static_cast<size_t>(y0) * dim[0];
+                const T*     rowY1    = inputPtr + z * sliceSize + static_cast<size_t>(y1) * dim[0];
+                const T*     rowZ0    = inputPtr + z0 * sliceSize + static_cast<size_t>(y) * dim[0];
+                const T*     rowZ1    = inputPtr + z1 * sliceSize + static_cast<size_t>(y) * dim[0];
+
+                // Along x, the border voxels are one sided
+                if (dim[0] > 1)
+                {
+                    const double invDx = invSpacing[0] * 0.5;
+                    for (int x = 1; x < dim[0] - 1; x++)
+                    {
+                        gradX[x] = (static_cast<double>(row[x + 1]) - static_cast<double>(row[x - 1])) * invDx;
+                    }
+                    gradX[0]          = (static_cast<double>(row[1]) - static_cast<double>(row[0])) * invSpacing[0];
+                    gradX[dim[0] - 1] = (static_cast<double>(row[dim[0] - 1]) - static_cast<double>(row[dim[0] - 2])) * invSpacing[0];
+                }
+                else
+                {
+                    gradX[0] = 0.0;
+                }
+
+                // Along y and z whole rows are differenced
+                for (int x = 0; x < dim[0]; x++)
+                {
+                    gradY[x] = (static_cast<double>(rowY1[x]) - static_cast<double>(rowY0[x])) * invDy;
+                }
+                for (int x = 0; x < dim[0]; x++)
+                {
+                    gradZ[x] = (static_cast<double>(rowZ1[x]) - static_cast<double>(rowZ0[x])) * invDz;
+                }
+
+                if (computeMagnitude)
+                {
+                    double* outputRow = outputPtr + rowIndex;
+                    for (int x = 0; x < dim[0]; x++)
+                    {
+                        outputRow[x] = std::sqrt(gradX[x] * gradX[x] + gradY[x] * gradY[x] + gradZ[x] * gradZ[x]);
+                    }
+                }
+                else
+                {
+                    double* outputRow = outputPtr + rowIndex * 3;
+                    for (int x = 0; x < dim[0]; x++)
+                    {
+                        outputRow[x * 3]     = gradX[x];
+                        outputRow[x * 3 + 1] = gradY[x];
+                        outputRow[x * 3 + 2] = gradZ[x];
+                    }
+                }
+            }
+        });
+}
+
 void
 ImageGradient::requestUpdate()
 {
@@ -44,21 +143,19 @@ ImageGradient::requestUpdate()
         LOG(WARNING) << "Can only compute gradient on single channel image";
         return;
     }
-    vtkSmartPointer<vtkImageData> inputImageVtk = GeometryUtils::coupleVtkImageData(inputImage);
-    if (m_ComputeMagnitude)
-    {
-        vtkNew<vtkImageGradientMagnitude> gradientMagnitude;
-        gradientMagnitude->SetInputData(inputImageVtk);
-        gradientMagnitude->Update();
-        setOutput(GeometryUtils::copyToImageData(gradientMagnitude->GetOutput()));
-    }
-    else
+
+    auto outputImage = std::make_shared<ImageData>();
+    outputImage->allocate(IMSTK_DOUBLE, m_ComputeMagnitude ? 1 : 3,
+        inputImage->getDimensions(), inputImage->getSpacing(), inputImage->getOrigin());
+
+    switch (inputImage->getScalarType())
     {
-        vtkNew<vtkImageGradient> gradients;
-        gradients->SetInputData(inputImageVtk);
-        gradients->SetHandleBoundaries(true);
-        gradients->Update();
-        setOutput(GeometryUtils::copyToImageData(gradients->GetOutput()));
+        TemplateMacro(computeGradient<IMSTK_TT>(*inputImage, *outputImage, m_ComputeMagnitude));
+    default:
+        LOG(WARNING) << "Unknown scalar type";
+        return;
     }
+
+    setOutput(outputImage);
 }
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
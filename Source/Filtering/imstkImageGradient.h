@@ -15,7 +15,8 @@ class ImageData;
 ///
 /// \class ImageGradient
 ///
-/// \brief This filter computes the gradient or magnitude using sobels kernel over an image
+/// \brief This filter computes the gradient or its magnitude over a single channel
+/// image by central differences, one sided on the border. The output is a double image
 ///
 class ImageGradient : public GeometryAlgorithm
 {
@@ -24,6 +25,8 @@ public:
     ~ImageGradient() override = default;
 
 public:
+    std::shared_ptr<ImageData> getOutputImage() const;
+
     ///
     /// \brief Required input, port 0
     ///
@@ -41,6 +44,6 @@ protected:
     void requestUpdate() override;
 
 private:
-    bool m_ComputeMagnitude;
+    bool m_ComputeMagnitude = false;
 };
 } // namespace imstk
\ No newline at end of file
@@ -6,13 +6,9 @@
 
 #include "imstkImageResample.h"
 #include "imstkDataArray.h"
-#include "imstkGeometryUtilities.h"
 #include "imstkImageData.h"
 #include "imstkLogger.h"
 #include "imstkParallelFor.h"
-#include <vtkImageData.h>
-#include <vtkImageResample.h>
-#include <vtkSmartPointer.h>
 
 namespace imstk
 {
@@ -37,6 +33,38 @@ ImageResample::setInputImage(std::shared_ptr<ImageData> inputData)
     setInput(inputData, 0);
 }
 
+///
+/// \brief Resample every voxel of the output image from the input image
+///
+template<typename T>
+static void
+resampleImage(const ImageData& inputImage, ImageData& outputImage, const ImageInterpolationType type)
+{
+    const T*     inputPtr    = static_cast<const T*>(inputImage.getScalars()->getVoidPointer());
+    T*           outputPtr   = static_cast<T*>(outputImage.getScalars()->getVoidPointer());
+    const Vec3i& inputDim    = inputImage.getDimensions();
+    const Vec3i& outputDim   = outputImage.getDimensions();
+    const int    numComps    = inputImage.getNumComponents();
+    const Vec3d  outputScale = inputDim.cast<double>().cwiseQuotient(outputDim.cast<double>());
+
+    ParallelUtils::parallelFor(outputDim[2], [&](const int z)
+        {
+            size_t i = static_cast<size_t>(z) * outputDim[0] * outputDim[1] * numComps;
+            for (int y = 0; y < outputDim[1]; y++)
+            {
+                for (int x = 0; x < outputDim[0]; x++)
+                {
+                    // Structured coordinate of the output voxel center in the input
+                    const Vec3d pt = (Vec3d(x, y, z) + Vec3d(0.5, 0.5, 0.5)).cwiseProduct(outputScale) - Vec3d(0.5, 0.5, 0.5);
+                    for (int c = 0; c < numComps; c++, i++)
+                    {
+                        outputPtr[i] = ImageSampling::castSample<T>(ImageSampling::sample(type, inputPtr, inputDim, numComps, c, pt));
+                    }
+                }
+            }
+        });
+}
+
 void
 ImageResample::requestUpdate()
 {
@@ -46,13 +74,26 @@ ImageResample::requestUpdate()
         LOG(WARNING) << "No inputImage to resample";
         return;
     }
+    if (m_Dimensions[0] < 1 || m_Dimensions[1] < 1 || m_Dimensions[2] < 1)
+    {
+        LOG(WARNING) << "Invalid dimensions to resample to";
+        return;
+    }
+
+    // Same bounds as the input
+    const Vec3d spacing = inputImage->getSpacing().cwiseProduct(
+        inputImage->getDimensions().cast<double>().cwiseQuotient(m_Dimensions.cast<double>()));
+    auto outputImage = std::make_shared<ImageData>();
+    outputImage->allocate(inputImage->getScalarType(), inputImage->getNumComponents(), m_Dimensions, spacing, inputImage->getOrigin());
 
-    vtkNew<vtkImageResample> resample;
-    resample->SetInputData(GeometryUtils::copyToVtkImageData(inputImage));
-    resample->SetInterpolationModeToLinear();
-    resample->SetOutputExtent(0, m_Dimensions[0] - 1, 0, m_Dimensions[1] - 1, 0, m_Dimensions[2] - 1);
-    resample->Update();
+    switch (inputImage->getScalarType())
+    {
+        TemplateMacro(resampleImage<IMSTK_TT>(*inputImage, *outputImage, m_InterpolationType));
+    default:
+        LOG(WARNING) << "Unknown scalar type";
+        return;
+    }
 
-    setOutput(GeometryUtils::copyToImageData(resample->GetOutput()));
+    setOutput(outputImage);
 }
 } // namespace imstk
\ No newline at end of file
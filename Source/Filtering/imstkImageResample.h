@@ -7,6 +7,7 @@
 #pragma once
 
 #include "imstkGeometryAlgorithm.h"
+#include "imstkImageSampling.h"
 #include "imstkMath.h"
 
 namespace imstk
@@ -16,7 +17,8 @@ class ImageData;
 ///
 /// \class ImageResample
 ///
-/// \brief Trilinearly Resamples a 3d image to different dimensions
+/// \brief Resamples a 3d image to different dimensions covering the same bounds,
+/// trilinearly by default. The output keeps the scalar type and components of the input
 ///
 class ImageResample : public GeometryAlgorithm
 {
@@ -33,10 +35,18 @@ public:
 
     imstkSetMacro(Dimensions, const Vec3i&);
 
+    ///
+    /// \brief Get/Set the interpolation type to use when resampling
+    ///@{
+    imstkSetMacro(InterpolationType, ImageInterpolationType);
+    imstkGetMacro(InterpolationType, ImageInterpolationType);
+///@}
+
 protected:
     void requestUpdate() override;
 
 private:
     Vec3i m_Dimensions;
+    ImageInterpolationType m_InterpolationType = ImageInterpolationType::Linear;
 };
 } // namespace imstk
\ No newline at end of file
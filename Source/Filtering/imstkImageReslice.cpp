@@ -5,13 +5,10 @@
 */
 
 #include "imstkImageReslice.h"
-#include "imstkGeometryUtilities.h"
+#include "imstkDataArray.h"
 #include "imstkImageData.h"
 #include "imstkLogger.h"
-
-#include <vtkImageData.h>
-#include <vtkImageReslice.h>
-#include <vtkTransform.h>
+#include "imstkParallelFor.h"
 
 namespace imstk
 {
@@ -36,6 +33,53 @@ ImageReslice::setInputImage(std::shared_ptr<ImageData> inputData)
     setInput(inputData, 0);
 }
 
+///
+/// \brief Sample every voxel of the output image at its transformed position in the input
+///
+template<typename T>
+static void
+resliceImage(const ImageData& inputImage, ImageData& outputImage, const Mat4d& transform, const ImageInterpolationType type)
+{
+    const T*     inputPtr  = static_cast<const T*>(inputImage.getScalars()->getVoidPointer());
+    T*           outputPtr = static_cast<T*>(outputImage.getScalars()->getVoidPointer());
+    const Vec3i& inputDim  = inputImage.getDimensions();
+    const Vec3i& outputDim = outputImage.getDimensions();
+    const int    numComps  = inputImage.getNumComponents();
+
+    // Transform from the output voxel coordinates to the input structured coordinates
+    const Vec3d inputShift   = inputImage.getOrigin() + inputImage.getSpacing() * 0.5;
+    const Vec3d outputShift  = outputImage.getOrigin() + outputImage.getSpacing() * 0.5;
+    const Mat3d linear       = inputImage.getInvSpacing().asDiagonal() * transform.block<3, 3>(0, 0) * outputImage.getSpacing().asDiagonal();
+    const Vec3d translation  = inputImage.getInvSpacing().asDiagonal() *
+                               (transform.block<3, 3>(0, 0) * outputShift + transform.block<3, 1>(0, 3) - inputShift);
+    const Vec3d maxPt        = (inputDim - Vec3i(1, 1, 1)).cast<double>();
+    const double tol         = 1.0e-6;
+
+    ParallelUtils::parallelFor(outputDim[2], [&](const int z)
+        {
+            size_t i = static_cast<size_t>(z) * outputDim[0] * outputDim[1] * numComps;
+            for (int y = 0; y < outputDim[1]; y++)
+            {
+                const Vec3d rowStart = linear * Vec3d(0.0, y, z) + translation;
+                for (int x = 0; x < outputDim[0]; x++)
+                {
+                    const Vec3d pt = rowStart + linear.col(0) * x;
+                    if ((pt.array() < -tol).any() || ((pt - maxPt).array() > tol).any())
+                    {
+                        // Outside of the input
+                        std::fill_n(outputPtr + i, numComps, T(0));
+                        i += numComps;
+                        continue;
+                    }
+                    for (int c = 0; c < numComps; c++, i++)
+                    {
+                        outputPtr[i] = ImageSampling::castSample<T>(ImageSampling::sample(type, inputPtr, inputDim, numComps, c, pt));
+                    }
+                }
+            }
+        });
+}
+
 void
 ImageReslice::requestUpdate()
 {
@@ -46,30 +90,45 @@ ImageReslice::requestUpdate()
         return;
     }
 
-    vtkNew<vtkTransform> transform;
-    Mat4d                test = m_Transform.transpose();
-    transform->SetMatrix(test.data());
+    const Mat4d  invTransform = m_Transform.inverse();
+    const Vec3d& spacing      = inputImage->getSpacing();
+    const Vec3i& dim          = inputImage->getDimensions();
 
-    vtkNew<vtkImageReslice> reslice;
-    reslice->SetResliceTransform(transform);
-    if (m_InterpolationType == InterpolateType::NearestNeighbor)
+    // Bounds of the input voxel centers mapped to the output
+    const Vec3d inputMin = inputImage->getOrigin() + spacing * 0.5;
+    const Vec3d inputMax = inputMin + (dim - Vec3i(1, 1, 1)).cast<double>().cwiseProduct(spacing);
+    Vec3d       outputMin = Vec3d::Constant(IMSTK_DOUBLE_MAX);
+    Vec3d       outputMax = Vec3d::Constant(IMSTK_DOUBLE_MIN);
+    for (int i = 0; i < 8; i++)
     {
-        reslice->SetInterpolationModeToNearestNeighbor();
+        const Vec3d corner((i & 1) ? inputMax[0] : inputMin[0], (i & 2) ? inputMax[1] : inputMin[1], (i & 4) ? inputMax[2] : inputMin[2]);
+        const Vec3d pt = (invTransform * corner.homogeneous()).hnormalized();
+        outputMin = outputMin.cwiseMin(pt);
+        outputMax = outputMax.cwiseMax(pt);
     }
-    else if (m_InterpolationType == InterpolateType::Linear)
+
+    // The output voxels lie on the grid of the input voxels
+    const double tol = 1.0e-6;
+    Vec3i        startIndex;
+    Vec3i        outputDim;
+    for (int i = 0; i < 3; i++)
     {
-        reslice->SetInterpolationModeToLinear();
+        startIndex[i] = static_cast<int>(std::floor((outputMin[i] - inputMin[i]) / spacing[i] + tol));
+        outputDim[i]  = static_cast<int>(std::ceil((outputMax[i] - inputMin[i]) / spacing[i] - tol)) - startIndex[i] + 1;
     }
-    else if (m_InterpolationType == InterpolateType::Cubic)
+    const Vec3d outputOrigin = inputMin + startIndex.cast<double>().cwiseProduct(spacing) - spacing * 0.5;
+
+    auto outputImage = std::make_shared<ImageData>();
+    outputImage->allocate(inputImage->getScalarType(), inputImage->getNumComponents(), outputDim, spacing, outputOrigin);
+
+    switch (inputImage->getScalarType())
     {
-        reslice->SetInterpolationModeToCubic();
+        TemplateMacro(resliceImage<IMSTK_TT>(*inputImage, *outputImage, m_Transform, m_InterpolationType));
+    default:
+        LOG(WARNING) << "Unknown scalar type";
+        return;
     }
-    vtkSmartPointer<vtkImageData> vtkInputImage = GeometryUtils::copyToVtkImageData(inputImage);
-    reslice->SetInputData(vtkInputImage);
-    reslice->SetResliceTransform(transform);
-    reslice->SetAutoCropOutput(true);
-    reslice->Update();
 
-    setOutput(GeometryUtils::copyToImageData(reslice->GetOutput()));
+    setOutput(outputImage);
 }
 } // namespace imstk
\ No newline at end of file
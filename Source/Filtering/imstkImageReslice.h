@@ -7,6 +7,7 @@
 #pragma once
 
 #include "imstkGeometryAlgorithm.h"
+#include "imstkImageSampling.h"
 #include "imstkMath.h"
 
 namespace imstk
@@ -16,17 +17,14 @@ class ImageData;
 ///
 /// \class ImageReslice
 ///
-/// \brief Resamples an image using a transform
+/// \brief Resamples an image using a transform. The transform maps the points of the
+/// output to the input. The output keeps the spacing and scalar type of the input and
+/// is sized to contain the whole transformed input, voxels outside of the input are 0
 ///
 class ImageReslice : public GeometryAlgorithm
 {
 public:
-    enum class InterpolateType
-    {
-        Linear,
-        Cubic,
-        NearestNeighbor
-    };
+    using InterpolateType = ImageInterpolationType;
 
 public:
     ImageReslice();
@@ -55,7 +53,7 @@ protected:
     void requestUpdate() override;
 
 private:
-    Mat4d m_Transform;
+    Mat4d m_Transform = Mat4d::Identity();
     InterpolateType m_InterpolationType = InterpolateType::Linear;
 };
 } // namespace imstk
\ No newline at end of file
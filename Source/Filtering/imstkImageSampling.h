@@ -0,0 +1,176 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace imstk
+{
+///
+/// \brief Interpolation used when sampling an image between its voxels
+///
+enum class ImageInterpolationType
+{
+    Linear,
+    Cubic,
+    NearestNeighbor
+};
+
+///
+/// \brief Sampling of the scalars of an image at structured coordinates, that is
+/// continuous voxel coordinates with the voxel centers at the integers. Neighbors
+/// beyond the image are clamped to its border
+///
+namespace ImageSampling
+{
+///
+/// \brief Convert a sample to the scalar type, integers are rounded and clamped to
+/// the range of the type
+///
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value, T>::type
+castSample(const double val)
+{
+    const double rounded = std::floor(val + 0.5);
+    return static_cast<T>(std::min(std::max(rounded,
+        static_cast<double>(std::numeric_limits<T>::lowest())), static_cast<double>(std::numeric_limits<T>::max())));
+}
+
+template<typename T>
+inline typename std::enable_if<!std::is_integral<T>::value, T>::type
+castSample(const double val)
+{
+    return static_cast<T>(val);
+}
+
+///
+/// \brief Get the index of the first of two voxels to interpolate between along an
+/// axis of size dim and the fraction between them
+///
+inline int
+getInterval(const double pt, const int dim, double& t)
+{
+    const double clampedPt = std::min(std::max(pt, 0.0), static_cast<double>(dim - 1));
+    const int    i1 = std::min(static_cast<int>(clampedPt), std::max(dim - 2, 0));
+    t = clampedPt - i1;
+    return i1;
+}
+
+template<typename T>
+inline double
+sampleNearest(const T* data, const Vec3i& dim, const int numComps, const int comp, const Vec3d& pt)
+{
+    const int x = std::min(std::max(static_cast<int>(std::floor(pt[0] + 0.5)), 0), dim[0] - 1);
+    const int y = std::min(std::max(static_cast<int>(std::floor(pt[1] + 0.5)), 0), dim[1] - 1);
+    const int z = std::min(std::max(static_cast<int>(std::floor(pt[2] + 0.5)), 0), dim[2] - 1);
+    return static_cast<double>(data[(x + dim[0] * (y + dim[1] * z)) * numComps + comp]);
+}
+
+template<typename T>
+inline double
+sampleLinear(const T* data, const Vec3i& dim, const int numComps, const int comp, const Vec3d& pt)
+{
+    Vec3d     t;
+    const int x1 = getInterval(pt[0], dim[0], t[0]);
+    const int y1 = getInterval(pt[1], dim[1], t[1]);
+    const int z1 = getInterval(pt[2], dim[2], t[2]);
+
+    // Offsets to the next voxel, none along axes of a single voxel
+    const size_t dx = (dim[0] > 1) ? numComps : 0;
+    const size_t dy = (dim[1] > 1) ? static_cast<size_t>(dim[0]) * numComps : 0;
+    const size_t dz = (dim[2] > 1) ? static_cast<size_t>(dim[0]) * dim[1] * numComps : 0;
+
+    const T* ptr = data + (x1 + dim[0] * (y1 + static_cast<size_t>(dim[1]) * z1)) * numComps + comp;
+
+    // Interpolate along x
+    const double v00 = ptr[0] + (static_cast<double>(ptr[dx]) - ptr[0]) * t[0];
+    const double v10 = ptr[dy] + (static_cast<double>(ptr[dy + dx]) - ptr[dy]) * t[0];
+    const double v01 = ptr[dz] + (static_cast<double>(ptr[dz + dx]) - ptr[dz]) * t[0];
+    const double v11 = ptr[dz + dy] + (static_cast<double>(ptr[dz + dy + dx]) - ptr[dz + dy]) * t[0];
+
+    // Interpolate along y
+    const double v0 = v00 + (v10 - v00) * t[1];
+    const double v1 = v01 + (v11 - v01) * t[1];
+
+    // Interpolate along z
+    return v0 + (v1 - v0) * t[2];
+}
+
+///
+/// \brief Catmull-Rom weights of the 4 voxels around fraction t
+///
+inline void
+getCubicWeights(const double t, double w[4])
+{
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    w[0] = 0.5 * (-t3 + 2.0 * t2 - t);
+    w[1] = 0.5 * (3.0 * t3 - 5.0 * t2 + 2.0);
+    w[2] = 0.5 * (-3.0 * t3 + 4.0 * t2 + t);
+    w[3] = 0.5 * (t3 - t2);
+}
+
+template<typename T>
+inline double
+sampleCubic(const T* data, const Vec3i& dim, const int numComps, const int comp, const Vec3d& pt)
+{
+    // Indices and weights of the 4 voxels along every axis
+    int    indices[3][4];
+    double weights[3][4];
+    for (int i = 0; i < 3; i++)
+    {
+        double    t;
+        const int i1 = getInterval(pt[i], dim[i], t);
+        for (int j = 0; j < 4; j++)
+        {
+            indices[i][j] = std::min(std::max(i1 - 1 + j, 0), dim[i] - 1);
+        }
+        getCubicWeights(t, weights[i]);
+    }
+
+    double val = 0.0;
+    for (int k = 0; k < 4; k++)
+    {
+        const size_t zOffset = static_cast<size_t>(indices[2][k]) * dim[1];
+        for (int j = 0; j < 4; j++)
+        {
+            const T* rowPtr = data + (zOffset + indices[1][j]) * dim[0] * numComps + comp;
+            double   rowVal = 0.0;
+            for (int i = 0; i < 4; i++)
+            {
+                rowVal += weights[0][i] * static_cast<double>(rowPtr[indices[0][i] * numComps]);
+            }
+            val += weights[2][k] * weights[1][j] * rowVal;
+        }
+    }
+    return val;
+}
+
+///
+/// \brief Sample component comp of the image at the structured coordinate
+///
+template<typename T>
+inline double
+sample(const ImageInterpolationType type, const T* data, const Vec3i& dim, const int numComps, const int comp, const Vec3d& pt)
+{
+    switch (type)
+    {
+    case ImageInterpolationType::NearestNeighbor:
+        return sampleNearest(data, dim, numComps, comp, pt);
+    case ImageInterpolationType::Cubic:
+        return sampleCubic(data, dim, numComps, comp, pt);
+    default:
+        return sampleLinear(data, dim, numComps, comp, pt);
+    }
+}
+} // namespace ImageSampling
+} // namespace imstk
@@ -7,12 +7,12 @@
 #include "imstkLocalMarchingCubes.h"
 #include "imstkGeometryUtilities.h"
 #include "imstkLogger.h"
+#include "imstkParallelFor.h"
 #include "imstkSurfaceMesh.h"
 #include "imstkImageData.h"
 #include "imstkVecDataArray.h"
 
-#include <vtkImageData.h>
-#include <vtkFlyingEdges3D.h>
+#include <numeric>
 
 namespace imstk
 {
@@ -343,6 +343,36 @@ lerp(double val1, double val2, double isovalue, double spacing)
     return (isovalue - val1) * spacing / (val2 - val1);
 }
 
+///
+/// \brief Each of the 12 edges of the above cube given by its lower and upper cube
+/// vertex, the grid offset of its lower vertex from v0 and the axis it runs along
+///
+struct CubeEdge
+{
+    int v1;
+    int v2;
+    int dx;
+    int dy;
+    int dz;
+    int axis;
+};
+
+static const CubeEdge cubeEdges[12] =
+{
+    { 0, 1, 0, 0, 0, 0 }, // e0
+    { 1, 2, 1, 0, 0, 2 }, // e1
+    { 3, 2, 0, 0, 1, 0 }, // e2
+    { 0, 3, 0, 0, 0, 2 }, // e3
+    { 4, 5, 0, 1, 0, 0 }, // e4
+    { 5, 6, 1, 1, 0, 2 }, // e5
+    { 7, 6, 0, 1, 1, 0 }, // e6
+    { 4, 7, 0, 1, 0, 2 }, // e7
+    { 0, 4, 0, 0, 0, 1 }, // e8
+    { 1, 5, 1, 0, 0, 1 }, // e9
+    { 2, 6, 1, 0, 1, 1 }, // e10
+    { 3, 7, 0, 0, 1, 1 }  // e11
+};
+
 LocalMarchingCubes::LocalMarchingCubes()
 {
     setNumInputPorts(1);
@@ -385,32 +415,57 @@ LocalMarchingCubes::setNumberOfChunks(const Vec3i& numChunks)
     m_allModified = true;
 }
 
-void
-mcSubImage(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> outputSurf, const Vec3i& start, const Vec3i& end, const double isoValue)
+///
+/// \brief Marching cubes over the blocks [start, end) of the image into outputSurf.
+///
+/// Vertices are shared between the cubes of the chunk, the ids of the vertices on the
+/// edges of the current layer of cubes are cached. A vertex is computed only from the
+/// global grid position and values of its edge so neighboring chunks produce bitwise
+/// identical vertices along their seams.
+///
+/// The buffers of outputSurf are reused, only reallocated when they need to grow. Does not
+/// post modified, such that chunks may be processed in parallel
+///
+static void
+mcSubImage(const ImageData& imageData, SurfaceMesh& outputSurf, const Vec3i& start, const Vec3i& end, const double isoValue)
 {
-    const Vec3i& fullDims = imageData->getDimensions();
-    const Vec3d& spacing  = imageData->getSpacing();
-    const Vec3d& origin   = imageData->getOrigin();
+    const Vec3i& fullDims = imageData.getDimensions();
+    const Vec3d& spacing  = imageData.getSpacing();
+    const Vec3d& origin   = imageData.getOrigin();
     const Vec3d  shift    = origin + spacing * 0.5;
 
-    std::list<Vec3d> vertices;
-    std::list<Vec3i> indices;
+    const Vec3i chunkDims = end - start;
+    const int   rowSize   = chunkDims[0] + 1;
+    const int   sliceSize = rowSize * (chunkDims[1] + 1);
+
+    // Vertex ids of the x and y edges on the lower [0] and upper [1] plane of the current
+    // layer of cubes and of the z edges inbetween, -1 when no vertex was generated yet
+    std::vector<int> xEdgeIds[2] = { std::vector<int>(sliceSize, -1), std::vector<int>(sliceSize, -1) };
+    std::vector<int> yEdgeIds[2] = { std::vector<int>(sliceSize, -1), std::vector<int>(sliceSize, -1) };
+    std::vector<int> zEdgeIds(sliceSize, -1);
+
+    std::vector<Vec3d> vertices;
+    std::vector<Vec3i> indices;
 
-    // For every voxel, identify case
-    double* imgPtr = static_cast<double*>(imageData->getScalars()->getVoidPointer());
-    //int blockIndex = 0;
+    const double* imgPtr = static_cast<const double*>(imageData.getScalars()->getVoidPointer());
     // Iterate along the dual, assigning case numbers per paper
     for (int z1 = start[2]; z1 < end[2]; z1++)
     {
-        const int z2 = z1 + 1;
+        if (z1 != start[2])
+        {
+            // The upper plane becomes the lower one
+            std::swap(xEdgeIds[0], xEdgeIds[1]);
+            std::swap(yEdgeIds[0], yEdgeIds[1]);
+            std::fill(xEdgeIds[1].begin(), xEdgeIds[1].end(), -1);
+            std::fill(yEdgeIds[1].begin(), yEdgeIds[1].end(), -1);
+            std::fill(zEdgeIds.begin(), zEdgeIds.end(), -1);
+        }
+
         for (int y1 = start[1]; y1 < end[1]; y1++)
         {
-            const int y2 = y1 + 1;
-            for (int x1 = start[0]; x1 < end[0]; x1++ /*, blockIndex++*/)
+            for (int x1 = start[0]; x1 < end[0]; x1++)
             {
-                const int x2 = x1 + 1;
-
-                const int i000 = static_cast<int>(imageData->getScalarIndex(Vec3i(x1, y1, z1)));
+                const int i000 = x1 + fullDims[0] * (y1 + fullDims[1] * z1);
                 const int i001 = i000 + 1;
 
                 const int i010 = i000 + fullDims[0];
@@ -435,152 +490,83 @@ mcSubImage(std::shared_ptr<ImageData> imageData, std::shared_ptr<SurfaceMesh> ou
 
                 // Assign a case
                 int mcCase = 0;
+                for (int i = 0; i < 8; i++)
                 {
-                    for (int i = 0; i < 8; i++)
+                    if (vals[i] < isoValue)
                     {
-                        if (vals[i] < isoValue)
-                        {
-                            mcCase |= (1 << i);
-                        }
+                        mcCase |= (1 << i);
                     }
                 }
 
-                // Generate the vertices
-                int cubeIndices[12] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };                                       // Map of local cube indices -> global vertex indices
+                const int packedEdges = edgeTable[mcCase];
+                if (packedEdges == 0)
                 {
-                    const Vec3d min = Vec3d(x1, y1, z1).cwiseProduct(spacing);
-                    const Vec3d max = Vec3d(x2, y2, z2).cwiseProduct(spacing);
-
-                    const int packedEdges = edgeTable[mcCase];
+                    continue;
+                }
 
-                    if (packedEdges == 0)
+                // Get or generate the vertices on the edges, map of local cube indices -> vertex indices
+                int cubeIndices[12] = { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+                for (int i = 0; i < 12; i++)
+                {
+                    if ((packedEdges & (1 << i)) == 0)
                     {
                         continue;
                     }
 
-                    // If vertex from e1 should be added
-                    if (packedEdges & 1)
-                    {
-                        const double x = lerp(vals[0], vals[1], isoValue, spacing[0]);
-                        cubeIndices[0] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(min[0] + x, min[1], min[2]) + shift);
-                    }
-                    // If vertex from e2 should be added
-                    if (packedEdges & 2)
-                    {
-                        const double z = lerp(vals[1], vals[2], isoValue, spacing[2]);
-                        cubeIndices[1] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(max[0], min[1], min[2] + z) + shift);
-                    }
-                    // If vertex from e3 should be added
-                    if (packedEdges & 4)
-                    {
-                        const double x = lerp(vals[3], vals[2], isoValue, spacing[0]);
-                        cubeIndices[2] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(min[0] + x, min[1], max[2]) + shift);
-                    }
-                    // If vertex from e4 should be added
-                    if (packedEdges & 8)
-                    {
-                        const double z = lerp(vals[0], vals[3], isoValue, spacing[2]);
-                        cubeIndices[3] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(min[0], min[1], min[2] + z) + shift);
-                    }
-                    // If vertex from e5 should be added
-                    if (packedEdges & 16)
-                    {
-                        const double x = lerp(vals[4], vals[5], isoValue, spacing[0]);
-                        cubeIndices[4] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(min[0] + x, max[1], min[2]) + shift);
-                    }
-                    // If vertex from e6 should be added
-                    if (packedEdges & 32)
-                    {
-                        const double z = lerp(vals[5], vals[6], isoValue, spacing[2]);
-                        cubeIndices[5] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(max[0], max[1], min[2] + z) + shift);
-                    }
-                    // If vertex from e7 should be added
-                    if (packedEdges & 64)
-                    {
-                        const double x = lerp(vals[7], vals[6], isoValue, spacing[0]);
-                        cubeIndices[6] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(min[0] + x, max[1], max[2]) + shift);
-                    }
-                    // If vertex from e8 should be added
-                    if (packedEdges & 128)
-                    {
-                        const double z = lerp(vals[4], vals[7], isoValue, spacing[2]);
-                        cubeIndices[7] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(min[0], max[1], min[2] + z) + shift);
-                    }
-                    // If vertex from e9 should be added
-                    if (packedEdges & 256)
-                    {
-                        const double y = lerp(vals[0], vals[4], isoValue, spacing[1]);
-                        cubeIndices[8] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(min[0], min[1] + y, min[2]) + shift);
-                    }
-                    // If vertex from e10 should be added
-                    if (packedEdges & 512)
+                    const CubeEdge& edge     = cubeEdges[i];
+                    const int       slotId   = (x1 - start[0] + edge.dx) + (y1 - start[1] + edge.dy) * rowSize;
+                    int&            vertexId = (edge.axis == 0) ? xEdgeIds[edge.dz][slotId] :
+                                               ((edge.axis == 1) ? yEdgeIds[edge.dz][slotId] : zEdgeIds[slotId]);
+                    if (vertexId == -1)
                     {
-                        const double y = lerp(vals[1], vals[5], isoValue, spacing[1]);
-                        cubeIndices[9] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(max[0], min[1] + y, min[2]) + shift);
-                    }
-                    // If vertex from e11 should be added
-                    if (packedEdges & 1024)
-                    {
-                        const double y = lerp(vals[2], vals[6], isoValue, spacing[1]);
-                        cubeIndices[10] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(max[0], min[1] + y, max[2]) + shift);
-                    }
-                    // If vertex from e12 should be added
-                    if (packedEdges & 2048)
-                    {
-                        const double y = lerp(vals[3], vals[7], isoValue, spacing[1]);
-                        cubeIndices[11] = static_cast<int>(vertices.size());
-                        vertices.push_back(Vec3d(min[0], min[1] + y, max[2]) + shift);
+                        Vec3d pos = Vec3d(x1 + edge.dx, y1 + edge.dy, z1 + edge.dz).cwiseProduct(spacing) + shift;
+                        pos[edge.axis] += lerp(vals[edge.v1], vals[edge.v2], isoValue, spacing[edge.axis]);
+                        vertexId        = static_cast<int>(vertices.size());
+                        vertices.push_back(pos);
                     }
+                    cubeIndices[i] = vertexId;
                 }
 
                 // Generate the triangles
+                for (int i = 0; triTable[mcCase][i] != -1; i += 3)
                 {
-                    for (int i = 0; triTable[mcCase][i] != -1; i += 3)
-                    {
-                        // Local cube index
-                        const int i1Local = triTable[mcCase][i];
-                        const int i2Local = triTable[mcCase][i + 1];
-                        const int i3Local = triTable[mcCase][i + 2];
-
-                        indices.push_back(Vec3i(static_cast<size_t>(cubeIndices[i1Local]), static_cast<size_t>(cubeIndices[i2Local]), static_cast<size_t>(cubeIndices[i3Local])));
-                    }
+                    indices.push_back(Vec3i(
+                        cubeIndices[triTable[mcCase][i]],
+                        cubeIndices[triTable[mcCase][i + 1]],
+                        cubeIndices[triTable[mcCase][i + 2]]));
                 }
             }
         }
     }
 
-    // Temp
-    std::shared_ptr<VecDataArray<double, 3>> vecVerticesPtr = std::make_shared<VecDataArray<double, 3>>(static_cast<int>(vertices.size()));
-    VecDataArray<double, 3>&                 vecVertices    = *vecVerticesPtr;
-    //std::copy(vertices.begin(), vertices.end(), vecVertices->begin());
-    std::shared_ptr<VecDataArray<int, 3>> vecIndicesPtr = std::make_shared<VecDataArray<int, 3>>(static_cast<int>(indices.size()));
-    VecDataArray<int, 3>&                 vecIndices    = *vecIndicesPtr;
-    //std::copy(indices.begin(), indices.end(), vecIndices->begin());
-
-    int j = 0;
-    for (auto i : indices)
-    {
-        vecIndices[j++] = i;
-    }
-    j = 0;
-    for (auto i : vertices)
+    // Copy to the existing buffers of the mesh
+    if (outputSurf.getVertexPositions() == nullptr)
     {
-        vecVertices[j++] = i;
+        outputSurf.initialize(std::make_shared<VecDataArray<double, 3>>(), std::make_shared<VecDataArray<int, 3>>());
     }
+    VecDataArray<double, 3>& outVertices = *outputSurf.getVertexPositions();
+    outVertices.resize(static_cast<int>(vertices.size()));
+    std::copy(vertices.begin(), vertices.end(), outVertices.begin());
+    VecDataArray<double, 3>& outInitVertices = *outputSurf.getInitialVertexPositions();
+    outInitVertices.resize(static_cast<int>(vertices.size()));
+    std::copy(vertices.begin(), vertices.end(), outInitVertices.begin());
+    VecDataArray<int, 3>& outIndices = *outputSurf.getCells();
+    outIndices.resize(static_cast<int>(indices.size()));
+    std::copy(indices.begin(), indices.end(), outIndices.begin());
+
+    outputSurf.computeVertexNormals();
+}
 
-    outputSurf->initialize(vecVerticesPtr, vecIndicesPtr);
-    outputSurf->computeVertexNormals();
+///
+/// \brief Post modified on the buffers of a chunk mesh, reused buffers may have been reallocated
+///
+static void
+postChunkModified(SurfaceMesh& surfMesh)
+{
+    surfMesh.getVertexPositions()->postModified();
+    surfMesh.getCells()->postModified();
+    surfMesh.getVertexNormals()->postModified();
+    surfMesh.postModified();
 }
 
 void
@@ -633,32 +619,20 @@ LocalMarchingCubes::requestUpdate()
 
     const Vec3i chunkDimensions = (dims - Vec3i(1, 1, 1)).cwiseQuotient(m_numChunks);
 
+    // Collect the chunks to update
+    std::vector<int> chunkIds;
     if (m_allModified)
     {
-        // For every chunk
-        size_t i = 0;
-        for (int z = 0; z < m_numChunks[2]; z++)
-        {
-            for (int y = 0; y < m_numChunks[1]; y++)
-            {
-                for (int x = 0; x < m_numChunks[0]; x++, i++)
-                {
-                    const Vec3i                  chunkCoord = Vec3i(x, y, z);
-                    std::shared_ptr<SurfaceMesh> outputSurf = std::dynamic_pointer_cast<SurfaceMesh>(getOutput(i));
-                    const Vec3i                  coordStart = chunkCoord.cwiseProduct(chunkDimensions);
-
-                    mcSubImage(imageData, outputSurf, coordStart, coordStart + chunkDimensions, m_isoValue);
-                }
-            }
-        }
+        chunkIds.resize(m_chunkCount);
+        std::iota(chunkIds.begin(), chunkIds.end(), 0);
         m_allModified = false;
     }
     else
     {
         const Vec3i dim1 = dims - Vec3i(1, 1, 1);
 
-        // Set of modified blocks (all in one map to remove duplicates)
-        std::unordered_map<int, Vec3i> modifiedBlocks;
+        // Set of modified chunks (all in one set to remove duplicates)
+        std::unordered_set<int> modifiedChunks;
         {
             // We need to compute the set of blocks that are modified given the modified voxels
             // then we can compute the set of chunks modified
@@ -668,45 +642,41 @@ LocalMarchingCubes::requestUpdate()
 
                 // 2x2 iteration, index space for blocks is -(1, 1, 1)
                 const Vec3i minCoord = (voxelCoord - Vec3i(1, 1, 1)).cwiseMax(Vec3i(0, 0, 0));
-                const Vec3i maxCoord = (voxelCoord + Vec3i(1, 1, 1)).cwiseMin(dim1 - Vec3i(1, 1, 1));
+                const Vec3i maxCoord = (voxelCoord + Vec3i(1, 1, 1)).cwiseMin(dim1);
                 for (int z = minCoord[2]; z < maxCoord[2]; z++)
                 {
                     for (int y = minCoord[1]; y < maxCoord[1]; y++)
                     {
                         for (int x = minCoord[0]; x < maxCoord[0]; x++)
                         {
-                            modifiedBlocks[x + dim1[0] * (y + z * dim1[1])] = Vec3i(x, y, z);
+                            // Compute the chunk of the block
+                            const Vec3i chunkCoord = Vec3i(x, y, z).cwiseQuotient(chunkDimensions);
+                            modifiedChunks.insert(chunkCoord[0] + (chunkCoord[1] + chunkCoord[2] * m_numChunks[1]) * m_numChunks[0]);
                         }
                     }
                 }
             }
         }
+        chunkIds.assign(modifiedChunks.begin(), modifiedChunks.end());
+        m_modifiedVoxels.clear();
+    }
 
-        // Set of modified chunks (all in one map to remove duplicates)
-        std::unordered_map<int, Vec3i> modifiedChunks;
-        {
-            for (auto modifiedBlock : modifiedBlocks)
-            {
-                //const int    blockIndex = modifiedBlock.first;
-                const Vec3i& blockCoord = modifiedBlock.second;
-
-                // Compute the chunk
-                const Vec3i chunkCoord = blockCoord.cast<double>().cwiseQuotient(dim1.cast<double>()).cwiseProduct(m_numChunks.cast<double>()).cast<int>();
-
-                const int chunkId = chunkCoord[0] + (chunkCoord[1] + chunkCoord[2] * m_numChunks[1]) * m_numChunks[0];
-                modifiedChunks.insert(std::pair<int, Vec3i>(chunkId, chunkCoord));
-            }
-        }
-        // Updates all the modified chunks
-        for (auto i : modifiedChunks)
+    // Update the chunks in parallel, each writes only to its own mesh
+    ParallelUtils::parallelFor(chunkIds.size(),
+        [&](const size_t i)
         {
-            const Vec3i&                 chunkCoord = i.second;
-            std::shared_ptr<SurfaceMesh> outputSurf = std::dynamic_pointer_cast<SurfaceMesh>(getOutput(i.first));
-            const Vec3i                  coordStart = chunkCoord.cwiseProduct(chunkDimensions);
-            mcSubImage(imageData, outputSurf, coordStart, coordStart + chunkDimensions, m_isoValue);
-            outputSurf->postModified();
-        }
-        m_modifiedVoxels.clear();
+            const int   chunkId    = chunkIds[i];
+            const Vec3i chunkCoord = Vec3i(chunkId % m_numChunks[0],
+                (chunkId / m_numChunks[0]) % m_numChunks[1],
+                chunkId / (m_numChunks[0] * m_numChunks[1]));
+            const Vec3i coordStart = chunkCoord.cwiseProduct(chunkDimensions);
+            mcSubImage(*imageData, *getOutputMesh(chunkId), coordStart, coordStart + chunkDimensions, m_isoValue);
+        });
+
+    // Events are posted after so they are not emitted from the worker threads
+    for (const int chunkId : chunkIds)
+    {
+        postChunkModified(*getOutputMesh(chunkId));
     }
 }
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
@@ -30,6 +30,10 @@ class SurfaceMesh;
 /// It works in chunks, so a set of SurfaceMesh's are the output. One can provide
 /// the filter with the number of divisions on each axes to split up the image
 ///
+/// Modified chunks are updated in parallel, each reusing the buffers of its
+/// SurfaceMesh. Vertices are shared within a chunk and are identical along the
+/// seams of neighboring chunks
+///
 class LocalMarchingCubes : public GeometryAlgorithm
 {
 public:
@@ -5,16 +5,12 @@
 */
 
 #include "imstkSurfaceMeshImageMask.h"
-#include "imstkCleanMesh.h"
-#include "imstkGeometryUtilities.h"
+#include "imstkDataArray.h"
 #include "imstkImageData.h"
 #include "imstkLogger.h"
+#include "imstkParallelFor.h"
 #include "imstkSurfaceMesh.h"
-
-#include <vtkImageData.h>
-#include <vtkImageStencil.h>
-#include <vtkPolyData.h>
-#include <vtkPolyDataToImageStencil.h>
+#include "imstkVecDataArray.h"
 
 namespace imstk
 {
@@ -46,6 +42,118 @@ SurfaceMeshImageMask::getOutputImage() const
     return std::static_pointer_cast<ImageData>(getOutput(0));
 }
 
+///
+/// \brief Get whether the point p of the yz plane lies on the inner side of the edge a, b
+/// of a counter clockwise triangle. Points on the edge are inside only for top and left
+/// edges so that a point on an edge shared by two triangles lies in exactly one of them
+///
+static bool
+isInsideEdge(const Vec2d& a, const Vec2d& b, const Vec2d& p)
+{
+    const Vec2d  ab = b - a;
+    const double e  = ab[0] * (p[1] - a[1]) - ab[1] * (p[0] - a[0]);
+    if (e != 0.0)
+    {
+        return e > 0.0;
+    }
+    return (ab[1] < 0.0) || (ab[1] == 0.0 && ab[0] > 0.0);
+}
+
+///
+/// \brief Rasterize a closed surface into the mask, for every row of voxels along x the
+/// crossings of the surface are sorted and the voxels between pairs of them are filled.
+/// Slices are rasterized in parallel
+///
+static void
+rasterizeSurface(const SurfaceMesh& surfMesh, ImageData& maskImage)
+{
+    const VecDataArray<double, 3>& vertices = *surfMesh.getVertexPositions();
+    const VecDataArray<int, 3>&    cells    = *surfMesh.getCells();
+    float*                         maskPtr  = static_cast<float*>(maskImage.getScalars()->getVoidPointer());
+    const Vec3i&                   dim      = maskImage.getDimensions();
+    const Vec3d&                   spacing  = maskImage.getSpacing();
+    const Vec3d                    shift    = maskImage.getOrigin() + spacing * 0.5;
+
+    // Bounds of the triangles in the yz plane
+    std::vector<Vec4d> triBounds(cells.size());
+    for (int i = 0; i < cells.size(); i++)
+    {
+        const Vec3i& cell = cells[i];
+        const Vec3d  min  = vertices[cell[0]].cwiseMin(vertices[cell[1]]).cwiseMin(vertices[cell[2]]);
+        const Vec3d  max  = vertices[cell[0]].cwiseMax(vertices[cell[1]]).cwiseMax(vertices[cell[2]]);
+        triBounds[i] = Vec4d(min[1], max[1], min[2], max[2]);
+    }
+
+    ParallelUtils::parallelFor(dim[2], [&](const int z)
+        {
+            const double posZ = shift[2] + z * spacing[2];
+
+            // Triangles crossing the slice
+            std::vector<int> sliceCells;
+            for (int i = 0; i < cells.size(); i++)
+            {
+                if (triBounds[i][2] <= posZ && posZ <= triBounds[i][3])
+                {
+                    sliceCells.push_back(i);
+                }
+            }
+
+            std::vector<double> crossings;
+            for (int y = 0; y < dim[1]; y++)
+            {
+                const Vec2d p(shift[1] + y * spacing[1], posZ);
+
+                crossings.clear();
+                for (const int i : sliceCells)
+                {
+                    if (p[0] < triBounds[i][0] || p[0] > triBounds[i][1])
+                    {
+                        continue;
+                    }
+                    const Vec3i& cell = cells[i];
+                    const Vec3d& a    = vertices[cell[0]];
+                    Vec3d        b    = vertices[cell[1]];
+                    Vec3d        c    = vertices[cell[2]];
+
+                    // Orient the triangle counter clockwise in the yz plane, skip edge on ones
+                    const double area = (b[1] - a[1]) * (c[2] - a[2]) - (b[2] - a[2]) * (c[1] - a[1]);
+                    if (area == 0.0)
+                    {
+                        continue;
+                    }
+                    if (area < 0.0)
+                    {
+                        std::swap(b, c);
+                    }
+                    const Vec2d a2(a[1], a[2]);
+                    const Vec2d b2(b[1], b[2]);
+                    const Vec2d c2(c[1], c[2]);
+                    if (isInsideEdge(a2, b2, p) && isInsideEdge(b2, c2, p) && isInsideEdge(c2, a2, p))
+                    {
+                        // Barycentric interpolation of x
+                        const double absArea = std::abs(area);
+                        const double wA      = ((b2 - p)[0] * (c2 - p)[1] - (b2 - p)[1] * (c2 - p)[0]) / absArea;
+                        const double wB      = ((c2 - p)[0] * (a2 - p)[1] - (c2 - p)[1] * (a2 - p)[0]) / absArea;
+                        crossings.push_back(wA * a[0] + wB * b[0] + (1.0 - wA - wB) * c[0]);
+                    }
+                }
+                std::sort(crossings.begin(), crossings.end());
+
+                // Fill the voxels with centers between pairs of crossings
+                float* row = maskPtr + (static_cast<size_t>(z) * dim[1] + y) * dim[0];
+                for (size_t i = 0; i + 1 < crossings.size(); i += 2)
+                {
+                    const int x0 = std::max(static_cast<int>(std::ceil((crossings[i] - shift[0]) / spacing[0])), 0);
+                    const int x1 = std::min(static_cast<int>(std::ceil((crossings[i + 1] - shift[0]) / spacing[0])), dim[0]);
+                    if (x0 < x1)
+                    {
+                        std::fill(row + x0, row + x1, 1.0f);
+                    }
+                }
+            }
+        });
+}
+
 void
 SurfaceMeshImageMask::requestUpdate()
 {
@@ -59,21 +167,13 @@ SurfaceMeshImageMask::requestUpdate()
     }
 
     Vec3d spacing;
-    int   extent[6];
+    Vec3i dim;
     Vec3d origin;
     if (refImageInput != nullptr)
     {
         spacing = refImageInput->getSpacing();
-
-        origin = refImageInput->getOrigin();
-
-        const Vec3i& dim = refImageInput->getDimensions();
-        extent[0] = 0;
-        extent[1] = dim[0] - 1;
-        extent[2] = 0;
-        extent[3] = dim[1] - 1;
-        extent[4] = 0;
-        extent[5] = dim[2] - 1;
+        origin  = refImageInput->getOrigin();
+        dim     = refImageInput->getDimensions();
     }
     else
     {
@@ -86,51 +186,22 @@ SurfaceMeshImageMask::requestUpdate()
         Vec3d max;
         surfMeshInput->computeBoundingBox(min, max);
 
-        Vec3d size = max - min;
-
         // Compute spacing required for given dimension
-        spacing = size.cwiseQuotient(m_Dimensions.cast<double>());
-
-        // Increase bounds by px length
-        min -= spacing * m_BorderExtent;
-        max += spacing * m_BorderExtent;
-
-        size = max - min;
+        spacing = (max - min).cwiseQuotient(m_Dimensions.cast<double>());
 
-        extent[0] = 0;
-        extent[1] = (m_Dimensions[0] + m_BorderExtent) - 1;
-        extent[2] = 0;
-        extent[3] = (m_Dimensions[1] + m_BorderExtent) - 1;
-        extent[4] = 0;
-        extent[5] = (m_Dimensions[2] + m_BorderExtent) - 1;
-
-        origin = min - m_BorderExtent * spacing;
+        // Add a border of voxels around the bounds
+        dim    = m_Dimensions + Vec3i::Constant(2 * m_BorderExtent);
+        origin = min - spacing * m_BorderExtent;
     }
 
-    // Allocate a new white image
-    vtkNew<vtkImageData> baseImage;
-    baseImage->SetSpacing(spacing.data());
-    baseImage->SetExtent(extent);
-    baseImage->SetOrigin(origin.data());
-    baseImage->AllocateScalars(VTK_FLOAT, 1);
-    int* dim = baseImage->GetDimensions();
-    std::fill_n(static_cast<float*>(baseImage->GetScalarPointer()), dim[0] * dim[1] * dim[2], 1.0f);
-
-    // Creates a new image mask from this polygon using a reference mask
-    vtkNew<vtkPolyDataToImageStencil> poly2Stencil;
-    poly2Stencil->SetInputData(GeometryUtils::copyToVtkPolyData(surfMeshInput));
-    poly2Stencil->SetOutputOrigin(origin.data());
-    poly2Stencil->SetOutputSpacing(spacing.data());
-    poly2Stencil->SetOutputWholeExtent(extent);
-    poly2Stencil->Update();
-    vtkNew<vtkImageStencil> imgStencil;
-    imgStencil->SetInputData(baseImage);
-    imgStencil->SetStencilData(poly2Stencil->GetOutput());
-    imgStencil->ReverseStencilOff();
-    imgStencil->SetBackgroundValue(0.0);
-    imgStencil->Update();
+    // Allocate a new black image
+    auto maskImage = std::make_shared<ImageData>();
+    maskImage->allocate(IMSTK_FLOAT, 1, dim, spacing, origin);
+    std::fill_n(static_cast<float*>(maskImage->getVoidPointer()), maskImage->getScalars()->size(), 0.0f);
+
+    rasterizeSurface(*surfMeshInput, *maskImage);
 
     // Set the output
-    setOutput(GeometryUtils::copyToImageData(imgStencil->GetOutput()));
+    setOutput(maskImage);
 }
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
@@ -21,6 +21,9 @@ class SurfaceMesh;
 /// one may provide a reference image for which to use its spacing, origin, dimensions
 /// It can also work with some geometry that is non-manifold, but results are ambiguous
 ///
+/// Voxels are 1 inside and 0 outside. Without a reference image the image spans the
+/// bounds of the mesh with a border of voxels around it
+///
 class SurfaceMeshImageMask : public GeometryAlgorithm
 {
 public:
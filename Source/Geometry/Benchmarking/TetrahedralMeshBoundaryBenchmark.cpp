@@ -0,0 +1,139 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkGeometryUtilities.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkTetrahedralMeshBoundary.h"
+#include "imstkVecDataArray.h"
+
+#include <benchmark/benchmark.h>
+#include <vtkCellArray.h>
+#include <vtkSmartPointer.h>
+#include <vtkTypeInt32Array.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace imstk;
+
+///
+/// \brief Creates a tetrahedral grid of dim^3 cubes
+///
+static std::shared_ptr<TetrahedralMesh>
+makeTetGrid(const int dim)
+{
+    return GeometryUtils::createUniformMesh(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0), dim, dim, dim);
+}
+
+///
+/// \brief Preparation of the cell buffer by the tetrahedral mesh render delegate,
+/// every tetrahedron is copied to VTK which extracts their faces again on render
+///
+static void
+BM_CopyAllTetrahedra(benchmark::State& state)
+{
+    std::shared_ptr<TetrahedralMesh> mesh      = makeTetGrid(state.range(0));
+    auto                             cellArray = vtkSmartPointer<vtkCellArray>::New();
+
+    for (auto _ : state)
+    {
+        cellArray->Reset();
+        vtkIdType cell[4];
+        for (const Vec4i& t : *mesh->getCells())
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                cell[i] = t[i];
+            }
+            cellArray->InsertNextCell(4, cell);
+        }
+        cellArray->Modified();
+    }
+
+    state.counters["Tets"] = mesh->getNumCells();
+}
+
+BENCHMARK(BM_CopyAllTetrahedra)
+->Unit(benchmark::kMillisecond)
+->Name("Copy all tetrahedra")
+->Arg(16)->Arg(32)->Arg(48);
+
+///
+/// \brief Computation of the boundary from scratch, done when the cells are replaced
+///
+static void
+BM_ComputeBoundary(benchmark::State& state)
+{
+    std::shared_ptr<TetrahedralMesh> mesh = makeTetGrid(state.range(0));
+    TetrahedralMeshBoundary          boundary;
+
+    for (auto _ : state)
+    {
+        boundary.compute(mesh);
+    }
+
+    state.counters["Tets"]  = mesh->getNumCells();
+    state.counters["Faces"] = boundary.getNumFaces();
+}
+
+BENCHMARK(BM_ComputeBoundary)
+->Unit(benchmark::kMillisecond)
+->Name("Compute boundary")
+->Arg(16)->Arg(32)->Arg(48);
+
+///
+/// \brief Incremental update of the boundary for the given number of tetrahedra removed
+/// per frame and coupling of the faces to VTK, as the boundary render delegate does
+///
+static void
+BM_RemoveTetrahedra(benchmark::State& state)
+{
+    std::shared_ptr<TetrahedralMesh> mesh = makeTetGrid(state.range(0));
+    const int                        numRemovedPerFrame = state.range(1);
+
+    TetrahedralMeshBoundary boundary;
+    boundary.compute(mesh);
+
+    auto faceArray = vtkSmartPointer<vtkTypeInt32Array>::New();
+    auto cellArray = vtkSmartPointer<vtkCellArray>::New();
+
+    // Remove in random order
+    std::vector<int> removalOrder(mesh->getNumCells());
+    std::iota(removalOrder.begin(), removalOrder.end(), 0);
+    std::shuffle(removalOrder.begin(), removalOrder.end(), std::mt19937(0));
+    size_t next = 0;
+
+    for (auto _ : state)
+    {
+        if (next + numRemovedPerFrame > removalOrder.size())
+        {
+            state.PauseTiming();
+            mesh = makeTetGrid(state.range(0));
+            boundary.compute(mesh);
+            next = 0;
+            state.ResumeTiming();
+        }
+        for (int i = 0; i < numRemovedPerFrame; i++)
+        {
+            mesh->setTetrahedraAsRemoved(removalOrder[next++]);
+        }
+
+        boundary.update();
+        std::shared_ptr<VecDataArray<int, 3>> faces = boundary.getFaces();
+        faceArray->SetArray(reinterpret_cast<int*>(faces->getPointer()), faces->size() * 3, 1);
+        cellArray->SetData(3, faceArray);
+    }
+
+    state.counters["Tets"] = mesh->getNumCells();
+}
+
+BENCHMARK(BM_RemoveTetrahedra)
+->Unit(benchmark::kMicrosecond)
+->Name("Remove tetrahedra")
+->ArgsProduct({ { 16, 32, 48 }, { 1, 100 } });
+
+BENCHMARK_MAIN();
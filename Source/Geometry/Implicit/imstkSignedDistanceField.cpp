@@ -8,6 +8,7 @@
 #include "imstkDataArray.h"
 #include "imstkImageData.h"
 #include "imstkLogger.h"
+#include "imstkStateBuffers.h"
 
 namespace imstk
 {
@@ -103,4 +104,11 @@ SignedDistanceField::computeBoundingBox(Vec3d& min, Vec3d& max, const double pad
 {
     return m_imageDataSdf->computeBoundingBox(min, max, paddingPercent);
 }
+
+void
+SignedDistanceField::getStateBuffers(StateBuffers& buffers)
+{
+    Geometry::getStateBuffers(buffers);
+    m_imageDataSdf->getStateBuffers(buffers);
+}
 } // namespace imstk
\ No newline at end of file
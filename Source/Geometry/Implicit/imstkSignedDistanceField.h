@@ -81,6 +81,11 @@ public:
 
     void computeBoundingBox(Vec3d& min, Vec3d& max, const double paddingPercent) override;
 
+    ///
+    /// \brief Adds the transform and the field, ie: when evolved by a LevelSetModel
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
 protected:
     std::shared_ptr<ImageData> m_imageDataSdf;
 
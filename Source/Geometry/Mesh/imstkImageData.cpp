@@ -6,6 +6,7 @@
 
 #include "imstkImageData.h"
 #include "imstkLogger.h"
+#include "imstkStateBuffers.h"
 #include "imstkVecDataArray.h"
 
 namespace imstk
@@ -121,4 +122,19 @@ ImageData::clear()
     //this->m_dataTransform->Identity();
     this->postModified();
 }
+
+void
+ImageData::getStateBuffers(StateBuffers& buffers)
+{
+    Geometry::getStateBuffers(buffers);
+    if (m_scalarArray != nullptr)
+    {
+        switch (m_scalarArray->getScalarType())
+        {
+            TemplateMacro(buffers.add(m_scalarArray->getVoidPointer(), sizeof(IMSTK_TT) * m_scalarArray->size(), m_scalarArray); );
+        default:
+            break;
+        }
+    }
+}
 } // namespace imstk
\ No newline at end of file
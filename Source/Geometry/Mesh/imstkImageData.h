@@ -104,6 +104,11 @@ public:
         upperCorner = Vec3d(bounds[1], bounds[3], bounds[5]);
     }
 
+    ///
+    /// \brief Adds the transform and the scalars, the points are not state
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
     ///
     /// \brief Get/Set the scalars
     ///@{
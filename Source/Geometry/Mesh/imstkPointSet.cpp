@@ -7,6 +7,7 @@
 #include "imstkPointSet.h"
 #include "imstkParallelUtils.h"
 #include "imstkLogger.h"
+#include "imstkStateBuffers.h"
 #include "imstkVecDataArray.h"
 
 namespace imstk
@@ -184,6 +185,26 @@ PointSet::updatePostTransformData() const
     m_transformApplied = true;
 }
 
+void
+PointSet::getStateBuffers(StateBuffers& buffers)
+{
+    // Geometry shared by many objects
+    if (!buffers.addValue(m_transform))
+    {
+        return;
+    }
+
+    // Vertices hold the transform once applied, both are restored together
+    this->updatePostTransformData();
+    buffers.add(m_vertexPositions);
+    buffers.addRestoreCallback([this]()
+        {
+            m_transformApplied = true;
+            m_vertexPositions->postModified();
+            this->postModified();
+        });
+}
+
 bool
 PointSet::hasVertexAttribute(const std::string& arrayName) const
 {
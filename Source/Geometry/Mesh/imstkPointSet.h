@@ -160,6 +160,11 @@ public:
     ///
     void updatePostTransformData() const override;
 
+    ///
+    /// \brief Adds the transform and the vertices
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
 protected:
     ///
     /// \brief Applies transformation m directly the initial and post transform data
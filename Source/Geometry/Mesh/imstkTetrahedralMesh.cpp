@@ -30,6 +30,20 @@ TetrahedralMesh::getVolume()
     return volume;
 }
 
+void
+TetrahedralMesh::setTetrahedraAsRemoved(const unsigned int tetId)
+{
+    if (m_removedMeshElems.size() < static_cast<size_t>(getNumCells()))
+    {
+        m_removedMeshElems.resize(getNumCells(), false);
+    }
+    if (!m_removedMeshElems[tetId])
+    {
+        m_removedMeshElems[tetId] = true;
+        m_removedMeshElemIds.push_back(static_cast<int>(tetId));
+    }
+}
+
 std::shared_ptr<SurfaceMesh>
 TetrahedralMesh::extractSurfaceMesh()
 {
@@ -47,10 +47,16 @@ public:
     ///
     /// \brief Get/set method for removed elements from the mesh
     ///@{
-    void setTetrahedraAsRemoved(const unsigned int tetId) { m_removedMeshElems[tetId] = true; }
+    void setTetrahedraAsRemoved(const unsigned int tetId);
     const std::vector<bool>& getRemovedTetrahedra() const { return m_removedMeshElems; }
     ///@}
 
+    ///
+    /// \brief Get the ids of the removed elements in the order they were removed,
+    /// consumers can process only the removals since they last looked
+    ///
+    const std::vector<int>& getRemovedTetrahedraIds() const { return m_removedMeshElemIds; }
+
     ///
     /// \brief Compute and return the volume of the tetrahedral mesh
     ///
@@ -62,5 +68,6 @@ public:
 
 protected:
     std::vector<bool> m_removedMeshElems;
+    std::vector<int>  m_removedMeshElemIds;
 };
 } // namespace imstk
@@ -0,0 +1,196 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkTetrahedralMeshBoundary.h"
+#include "imstkLogger.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <algorithm>
+
+namespace imstk
+{
+int
+TetrahedralMeshBoundary::getNumFaces() const
+{
+    return (m_faces == nullptr) ? 0 : m_faces->size();
+}
+
+void
+TetrahedralMeshBoundary::compute(std::shared_ptr<TetrahedralMesh> mesh)
+{
+    CHECK(mesh != nullptr) << "TetrahedralMeshBoundary requires a mesh";
+
+    m_mesh     = mesh;
+    m_cells    = mesh->getCells();
+    m_numCells = mesh->getNumCells();
+    if (m_faces == nullptr)
+    {
+        m_faces = std::make_shared<VecDataArray<int, 3>>();
+    }
+    m_faces->resize(0);
+    m_faceInfo.clear();
+    m_faceInfo.reserve(m_numCells * 2 + 1);
+
+    // Count the uses of every face by the remaining tetrahedra
+    const std::vector<bool>& removed = mesh->getRemovedTetrahedra();
+    for (int i = 0; i < m_numCells; i++)
+    {
+        if (i < static_cast<int>(removed.size()) && removed[i])
+        {
+            continue;
+        }
+        for (int j = 0; j < 4; j++)
+        {
+            FaceInfo& info = m_faceInfo[getFaceKey(i, j)];
+            info.tets[(info.tets[0] == -1) ? 0 : 1] = i;
+        }
+    }
+
+    // Faces used once are on the boundary
+    m_faces->reserve(static_cast<int>(m_faceInfo.size() / 4) + 1);
+    for (auto& face : m_faceInfo)
+    {
+        if (face.second.tets[1] == -1)
+        {
+            addBoundaryFace(face.first, face.second, face.second.tets[0]);
+        }
+    }
+
+    m_numRemoved = mesh->getRemovedTetrahedraIds().size();
+    m_faces->postModified();
+}
+
+bool
+TetrahedralMeshBoundary::update()
+{
+    CHECK(m_mesh != nullptr) << "TetrahedralMeshBoundary::compute must be called before update";
+
+    if (m_mesh->getCells() != m_cells || m_mesh->getNumCells() != m_numCells)
+    {
+        compute(m_mesh);
+        return true;
+    }
+
+    const std::vector<int>& removedIds = m_mesh->getRemovedTetrahedraIds();
+    if (removedIds.size() == m_numRemoved)
+    {
+        return false;
+    }
+    for (size_t i = m_numRemoved; i < removedIds.size(); i++)
+    {
+        removeTetrahedron(removedIds[i]);
+    }
+    m_numRemoved = removedIds.size();
+    m_faces->postModified();
+    return true;
+}
+
+TetrahedralMeshBoundary::FaceKey
+TetrahedralMeshBoundary::getFaceKey(const int tetId, const int j) const
+{
+    // Face j is opposite vertex j
+    const Vec4i& tet = (*m_cells)[tetId];
+    FaceKey      key = { { tet[(j + 1) % 4], tet[(j + 2) % 4], tet[(j + 3) % 4] } };
+    std::sort(key.begin(), key.end());
+    return key;
+}
+
+void
+TetrahedralMeshBoundary::addBoundaryFace(const FaceKey& key, FaceInfo& info, const int tetId)
+{
+    // The vertex of the tetrahedron not on the face
+    const Vec4i& tet = (*m_cells)[tetId];
+    int          unusedVertex = tet[0];
+    for (int j = 0; j < 4; j++)
+    {
+        if (std::find(key.begin(), key.end(), tet[j]) == key.end())
+        {
+            unusedVertex = tet[j];
+            break;
+        }
+    }
+
+    // Wind such that the normal points away from the unused vertex
+    const VecDataArray<double, 3>& vertices = *m_mesh->getVertexPositions();
+    const Vec3d&                   v0       = vertices[key[0]];
+    const Vec3d&                   v1       = vertices[key[1]];
+    const Vec3d&                   v2       = vertices[key[2]];
+    const Vec3d                    normal   = (v1 - v0).cross(v2 - v0);
+    const Vec3d                    centroid = (v0 + v1 + v2) / 3.0;
+    Vec3i                          face(key[0], key[1], key[2]);
+    if (normal.dot(centroid - vertices[unusedVertex]) < 0.0)
+    {
+        std::swap(face[1], face[2]);
+    }
+
+    info.faceIndex = m_faces->size();
+    m_faces->push_back(face);
+}
+
+void
+TetrahedralMeshBoundary::removeBoundaryFace(FaceInfo& info)
+{
+    VecDataArray<int, 3>& faces     = *m_faces;
+    const int             lastIndex = faces.size() - 1;
+    if (info.faceIndex != lastIndex)
+    {
+        // Move the last face in the hole
+        Vec3i   lastFace = faces[lastIndex];
+        FaceKey lastKey  = { { lastFace[0], lastFace[1], lastFace[2] } };
+        std::sort(lastKey.begin(), lastKey.end());
+        faces[info.faceIndex] = lastFace;
+        m_faceInfo[lastKey].faceIndex = info.faceIndex;
+    }
+    faces.resize(lastIndex);
+    info.faceIndex = -1;
+}
+
+void
+TetrahedralMeshBoundary::removeTetrahedron(const int tetId)
+{
+    if (tetId < 0 || tetId >= m_numCells)
+    {
+        LOG(WARNING) << "Removed tetrahedron " << tetId << " out of range";
+        return;
+    }
+
+    for (int j = 0; j < 4; j++)
+    {
+        const FaceKey key  = getFaceKey(tetId, j);
+        auto          iter = m_faceInfo.find(key);
+        if (iter == m_faceInfo.end())
+        {
+            continue;
+        }
+        FaceInfo& info = iter->second;
+
+        // Drop the tetrahedron from the users of the face
+        if (info.tets[0] == tetId)
+        {
+            info.tets[0] = info.tets[1];
+        }
+        else if (info.tets[1] != tetId)
+        {
+            // Already removed
+            continue;
+        }
+        info.tets[1] = -1;
+
+        if (info.tets[0] == -1)
+        {
+            // Was on the boundary, now unused
+            removeBoundaryFace(info);
+            m_faceInfo.erase(iter);
+        }
+        else
+        {
+            // Was interior, exposed now
+            addBoundaryFace(key, info, info.tets[0]);
+        }
+    }
+}
+} // namespace imstk
@@ -0,0 +1,108 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+
+namespace imstk
+{
+class TetrahedralMesh;
+template<typename T, int N> class VecDataArray;
+
+///
+/// \class TetrahedralMeshBoundary
+///
+/// \brief Maintains the boundary triangles of a TetrahedralMesh, those faces used by
+/// only one tetrahedron that is not removed. The faces index the vertices of the tetrahedral
+/// mesh and are wound such that their normals point out of their tetrahedron.
+///
+/// After the initial computation the boundary is updated incrementally as tetrahedra are
+/// removed (\see TetrahedralMesh::setTetrahedraAsRemoved), which costs in the number of
+/// removed tetrahedra rather than the size of the mesh. The order of the faces is not
+/// preserved across updates.
+///
+class TetrahedralMeshBoundary
+{
+public:
+    TetrahedralMeshBoundary() = default;
+    virtual ~TetrahedralMeshBoundary() = default;
+
+public:
+    ///
+    /// \brief Compute the boundary of the mesh from scratch
+    ///
+    void compute(std::shared_ptr<TetrahedralMesh> mesh);
+
+    ///
+    /// \brief Update the boundary to the tetrahedra removed since the last compute/update.
+    /// Recomputes from scratch when the cells of the mesh were replaced or resized
+    /// \return true if the faces changed
+    ///
+    bool update();
+
+    ///
+    /// \brief Get the boundary faces, the array may be reallocated by an update
+    ///
+    std::shared_ptr<VecDataArray<int, 3>> getFaces() const { return m_faces; }
+
+    int getNumFaces() const;
+
+    std::shared_ptr<TetrahedralMesh> getMesh() const { return m_mesh; }
+
+protected:
+    using FaceKey = std::array<int, 3>;
+
+    struct FaceKeyHash
+    {
+        size_t operator()(const FaceKey& key) const
+        {
+            size_t h = std::hash<int>()(key[0]);
+            h ^= std::hash<int>()(key[1]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            h ^= std::hash<int>()(key[2]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    struct FaceInfo
+    {
+        std::array<int, 2> tets  = { { -1, -1 } }; ///< Tetrahedra using the face, -1 if none
+        int faceIndex = -1;                        ///< Index in the boundary faces, -1 if interior
+    };
+
+    ///
+    /// \brief Get the sorted vertices of local face j of tetrahedron tetId
+    ///
+    FaceKey getFaceKey(const int tetId, const int j) const;
+
+    ///
+    /// \brief Add face of the key to the boundary, wound outwards of tetrahedron tetId
+    ///
+    void addBoundaryFace(const FaceKey& key, FaceInfo& info, const int tetId);
+
+    ///
+    /// \brief Remove the face from the boundary by moving the last face in its place
+    ///
+    void removeBoundaryFace(FaceInfo& info);
+
+    ///
+    /// \brief Update the faces for the removal of tetrahedron tetId
+    ///
+    void removeTetrahedron(const int tetId);
+
+    std::shared_ptr<TetrahedralMesh>      m_mesh;
+    std::shared_ptr<VecDataArray<int, 4>> m_cells;    ///< Cells the boundary was computed on
+    int    m_numCells   = 0;
+    size_t m_numRemoved = 0;                          ///< Number of removals of the mesh processed
+
+    std::shared_ptr<VecDataArray<int, 3>> m_faces;
+    std::unordered_map<FaceKey, FaceInfo, FaceKeyHash> m_faceInfo;
+};
+} // namespace imstk
@@ -6,21 +6,23 @@
 
 #include "imstkRenderParticles.h"
 #include "imstkLogger.h"
+#include "imstkVecDataArray.h"
+
+#include <algorithm>
+#include <functional>
 
 namespace imstk
 {
-RenderParticles::RenderParticles(const unsigned int maxNumParticles)
+RenderParticles::RenderParticles(const int maxNumParticles) :
+    m_maxNumParticles(std::max(maxNumParticles, 0)),
+    m_positions(std::make_shared<VecDataArray<float, 3>>(m_maxNumParticles)),
+    m_velocities(std::make_shared<VecDataArray<float, 3>>(m_maxNumParticles)),
+    m_ages(std::make_shared<DataArray<float>>(m_maxNumParticles)),
+    m_colors(std::make_shared<VecDataArray<float, 4>>(m_maxNumParticles)),
+    m_scales(std::make_shared<DataArray<float>>(m_maxNumParticles)),
+    m_rotations(std::make_shared<DataArray<float>>(m_maxNumParticles)),
+    m_rotationalVelocities(std::make_shared<DataArray<float>>(m_maxNumParticles))
 {
-    if (maxNumParticles <= 128)
-    {
-        m_maxNumParticles = maxNumParticles;
-    }
-    else
-    {
-        m_maxNumParticles = 128;
-        LOG(WARNING) << "The maximum number of decals is 128";
-    }
-
     m_vertexPositions[0] = Vec3d(0.5, 0.5, 0);
     m_vertexPositions[1] = Vec3d(0.5, -0.5, 0);
     m_vertexPositions[2] = Vec3d(-0.5, 0.5, 0);
@@ -46,34 +48,61 @@ RenderParticles::setParticleSize(const float size)
     m_particleSize = size;
 }
 
-std::vector<std::unique_ptr<RenderParticle>>&
-RenderParticles::getParticles()
+int
+RenderParticles::addParticle()
 {
-    return m_particles;
-}
+    if (m_numParticles >= m_maxNumParticles)
+    {
+        return -1;
+    }
 
-void
-RenderParticles::reset()
-{
-    m_numParticles = 0;
+    const int i = m_numParticles++;
+    (*m_positions)[i]  = Vec3f::Zero();
+    (*m_velocities)[i] = Vec3f::Zero();
+    (*m_ages)[i]       = 0.0f;
+    (*m_colors)[i]     = Vec4f::Ones();
+    (*m_scales)[i]     = 1.0f;
+    (*m_rotations)[i]  = 0.0f;
+    (*m_rotationalVelocities)[i] = 0.0f;
+    return i;
 }
 
 void
-RenderParticles::incrementNumOfParticles()
+RenderParticles::removeParticles(std::vector<int> ids)
 {
-    m_numParticles++;
+    // Remove from the back so the particles moved into freed slots are never removed ones
+    std::sort(ids.begin(), ids.end(), std::greater<int>());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    for (const int i : ids)
+    {
+        if (i < 0 || i >= m_numParticles)
+        {
+            continue;
+        }
+        m_numParticles--;
+        if (i != m_numParticles)
+        {
+            copyParticle(i, m_numParticles);
+        }
+    }
 }
 
-unsigned int
-RenderParticles::getNumParticles()
+void
+RenderParticles::reset()
 {
-    return m_numParticles;
+    m_numParticles = 0;
 }
 
-unsigned int
-RenderParticles::getMaxNumParticles()
+void
+RenderParticles::copyParticle(const int i, const int j)
 {
-    return m_maxNumParticles;
+    (*m_positions)[i]  = (*m_positions)[j];
+    (*m_velocities)[i] = (*m_velocities)[j];
+    (*m_ages)[i]       = (*m_ages)[j];
+    (*m_colors)[i]     = (*m_colors)[j];
+    (*m_scales)[i]     = (*m_scales)[j];
+    (*m_rotations)[i]  = (*m_rotations)[j];
+    (*m_rotationalVelocities)[i] = (*m_rotationalVelocities)[j];
 }
 
 void
@@ -10,94 +10,101 @@
 #include "imstkMath.h"
 #include "imstkMacros.h"
 
-#ifdef WIN32
-#pragma warning( push )
-#pragma warning( disable : 4201 )
-#endif
-
-#ifdef WIN32
-#pragma warning( pop )
-#endif
+#include <vector>
 
 namespace imstk
 {
-///
-/// \struct RenderParticle
-///
-/// \brief Particle data
-///
-struct RenderParticle
-{
-    Vec3f m_position     = Vec3f(0, 0, 0);
-    Vec3f m_velocity     = Vec3f(0, 0, 0);
-    Vec3f m_acceleration = Vec3f(0, 0, 0);
-    Vec4d m_color    = Vec4d(1., 1., 1., 1.);
-    float m_age      = 0;
-    bool m_created   = false;
-    float m_scale    = 1.0f;
-    float m_rotation = 0;
-    float m_rotationalVelocity     = 0;
-    float m_rotationalAcceleration = 0;
-};
+template<typename T> class DataArray;
+template<typename T, int N> class VecDataArray;
 
 ///
 /// \class RenderParticles
 ///
-/// \brief Particles for rendering
+/// \brief Particles for rendering. The attributes of the particles are stored as
+/// structure of arrays, allocated once for the maximum number of particles so they
+/// may be mapped by a renderer without copies. The active particles are always the
+/// first getNumParticles() of every array, removing particles moves the last active
+/// particles into the freed slots
 ///
 class RenderParticles : public Geometry
 {
 public:
     ///
     /// \brief Constructor
-    /// \param maxNumParticles Number of particles this emitter can produce
-    /// \param time Lifespan of each particle (in milliseconds)
-    /// \param mode Mode for emitter
+    /// \param maxNumParticles Number of particles that may be active at once
     ///
-    RenderParticles(const unsigned int maxNumParticles = 128);
+    RenderParticles(const int maxNumParticles = 128);
     ~RenderParticles() override = default;
 
     IMSTK_TYPE_NAME(RenderParticles)
 
     ///
-    /// \brief Set size of particle
+    /// \brief Set/Get size of particle
     /// \param size Particle size, this determines how much each keyframe
     ///        scales by
-    ///
+    ///@{
     void setParticleSize(const float size);
+    float getParticleSize() const { return m_particleSize; }
+    ///@}
 
     ///
-    /// \brief Get particles
-    /// \returns particles
+    /// \brief Activate a particle at the end of the active particles, its attributes
+    /// are left to the caller
+    /// \returns index of the particle, -1 if the maximum number of particles are active
     ///
-    std::vector<std::unique_ptr<RenderParticle>>& getParticles();
+    int addParticle();
 
     ///
-    /// \brief Reset number of particles
+    /// \brief Deactivate the particles at the given indices, moving the last active
+    /// particles into their slots. Indices are of the active particles before removal
     ///
-    void reset();
+    void removeParticles(std::vector<int> ids);
 
     ///
-    /// \brief Increment number of particles
+    /// \brief Deactivate all particles
     ///
-    void incrementNumOfParticles();
+    void reset();
 
     ///
-    /// \brief Get number of particles
+    /// \brief Get number of active particles
     ///
-    unsigned int getNumParticles();
+    int getNumParticles() const { return m_numParticles; }
 
     ///
     /// \brief Get maximum number of particles
     ///
-    unsigned int getMaxNumParticles();
+    int getMaxNumParticles() const { return m_maxNumParticles; }
+
+    ///
+    /// \brief Get the particle attributes, sized to the maximum number of particles
+    ///@{
+    std::shared_ptr<VecDataArray<float, 3>> getPositions() const { return m_positions; }
+    std::shared_ptr<VecDataArray<float, 3>> getVelocities() const { return m_velocities; }
+    std::shared_ptr<DataArray<float>> getAges() const { return m_ages; }
+    std::shared_ptr<VecDataArray<float, 4>> getColors() const { return m_colors; }
+    std::shared_ptr<DataArray<float>> getScales() const { return m_scales; }
+    std::shared_ptr<DataArray<float>> getRotations() const { return m_rotations; }
+    std::shared_ptr<DataArray<float>> getRotationalVelocities() const { return m_rotationalVelocities; }
+    ///@}
 
 protected:
-    unsigned int m_numParticles    = 0;
-    unsigned int m_maxNumParticles = 128; ///< Maximum particles
-    float m_particleSize = 0.1f;
+    ///
+    /// \brief Copy the attributes of particle j to particle i
+    ///
+    void copyParticle(const int i, const int j);
+
+    int   m_numParticles    = 0;
+    int   m_maxNumParticles = 128; ///< Maximum particles
+    float m_particleSize    = 0.1f;
+
+    std::shared_ptr<VecDataArray<float, 3>> m_positions;
+    std::shared_ptr<VecDataArray<float, 3>> m_velocities;
+    std::shared_ptr<DataArray<float>>       m_ages;   ///< Time since emission, ms
+    std::shared_ptr<VecDataArray<float, 4>> m_colors; ///< RGBA
+    std::shared_ptr<DataArray<float>>       m_scales;
+    std::shared_ptr<DataArray<float>>       m_rotations;
+    std::shared_ptr<DataArray<float>>       m_rotationalVelocities;
 
-    std::vector<std::unique_ptr<RenderParticle>> m_particles; ///< Particle objects
     Vec3d m_vertexPositions[4];
     Vec3d m_vertexNormals[4];
     Vec3d m_vertexTangents[4];
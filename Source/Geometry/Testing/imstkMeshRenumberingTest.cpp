@@ -0,0 +1,200 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDataArray.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Largest index difference between two vertices of a cell
+///
+int
+getBandwidth(const TetrahedralMesh& mesh)
+{
+    int bandwidth = 0;
+    for (const Vec4i& cell : *mesh.getCells())
+    {
+        bandwidth = std::max(bandwidth, cell.maxCoeff() - cell.minCoeff());
+    }
+    return bandwidth;
+}
+
+///
+/// \brief Mean index difference between the vertices of a cell
+///
+double
+getMeanCellSpan(const TetrahedralMesh& mesh)
+{
+    double span = 0.0;
+    for (const Vec4i& cell : *mesh.getCells())
+    {
+        span += cell.maxCoeff() - cell.minCoeff();
+    }
+    return span / mesh.getNumCells();
+}
+
+///
+/// \brief Create a tetrahedral grid with its vertices randomly shuffled, each vertex
+/// and cell has its original index as attribute
+///
+std::shared_ptr<TetrahedralMesh>
+createScrambledMesh()
+{
+    std::shared_ptr<TetrahedralMesh> mesh =
+        GeometryUtils::createUniformMesh(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0), 8, 8, 8);
+
+    auto vertexIds = std::make_shared<DataArray<int>>(mesh->getNumVertices());
+    std::iota(vertexIds->begin(), vertexIds->end(), 0);
+    mesh->setVertexAttribute("VertexIds", vertexIds);
+    auto cellIds = std::make_shared<DataArray<int>>(mesh->getNumCells());
+    std::iota(cellIds->begin(), cellIds->end(), 0);
+    mesh->setCellAttribute("CellIds", cellIds);
+
+    std::vector<size_t> newToOld(mesh->getNumVertices());
+    std::iota(newToOld.begin(), newToOld.end(), 0);
+    std::shuffle(newToOld.begin(), newToOld.end(), std::mt19937(0));
+    GeometryUtils::permuteVertices(mesh, newToOld);
+    return mesh;
+}
+
+///
+/// \brief Copy a mesh, deepCopy shares the attributes
+///
+std::shared_ptr<TetrahedralMesh>
+copyMesh(std::shared_ptr<TetrahedralMesh> srcMesh)
+{
+    auto mesh = std::make_shared<TetrahedralMesh>();
+    mesh->deepCopy(srcMesh);
+    mesh->setVertexAttribute("VertexIds",
+        std::make_shared<DataArray<int>>(*std::dynamic_pointer_cast<DataArray<int>>(srcMesh->getVertexAttribute("VertexIds"))));
+    mesh->setCellAttribute("CellIds",
+        std::make_shared<DataArray<int>>(*std::dynamic_pointer_cast<DataArray<int>>(srcMesh->getCellAttribute("CellIds"))));
+    return mesh;
+}
+
+///
+/// \brief Check the renumbered mesh describes the same cells at the same positions
+/// as the original, with the attributes following their vertices and cells
+///
+void
+checkSameMesh(const TetrahedralMesh& original, const TetrahedralMesh& renumbered)
+{
+    ASSERT_EQ(original.getNumVertices(), renumbered.getNumVertices());
+    ASSERT_EQ(original.getNumCells(), renumbered.getNumCells());
+
+    const VecDataArray<double, 3>& origVertices = *original.getVertexPositions();
+    const VecDataArray<double, 3>& vertices     = *renumbered.getVertexPositions();
+    const VecDataArray<int, 4>&    origCells    = *original.getCells();
+    const VecDataArray<int, 4>&    cells        = *renumbered.getCells();
+    const DataArray<int>&          origVertexIds = *std::dynamic_pointer_cast<DataArray<int>>(original.getVertexAttribute("VertexIds"));
+    const DataArray<int>&          vertexIds     = *std::dynamic_pointer_cast<DataArray<int>>(renumbered.getVertexAttribute("VertexIds"));
+    const DataArray<int>&          cellIds       = *std::dynamic_pointer_cast<DataArray<int>>(renumbered.getCellAttribute("CellIds"));
+
+    // Original index of every grid vertex in the original mesh
+    std::vector<int> origIndex(original.getNumVertices());
+    for (int i = 0; i < original.getNumVertices(); i++)
+    {
+        origIndex[origVertexIds[i]] = i;
+    }
+
+    for (int i = 0; i < renumbered.getNumVertices(); i++)
+    {
+        EXPECT_TRUE(vertices[i].isApprox(origVertices[origIndex[vertexIds[i]]]));
+    }
+    for (int i = 0; i < renumbered.getNumCells(); i++)
+    {
+        const Vec4i& cell     = cells[i];
+        const Vec4i& origCell = origCells[cellIds[i]];
+        for (int j = 0; j < 4; j++)
+        {
+            EXPECT_TRUE(vertices[cell[j]].isApprox(origVertices[origCell[j]]));
+        }
+    }
+}
+} // namespace
+
+///
+/// \brief Test that permuting the vertices moves the positions and attributes
+/// and remaps the cells
+///
+TEST(imstkMeshRenumberingTest, PermuteVertices)
+{
+    std::shared_ptr<TetrahedralMesh> mesh =
+        GeometryUtils::createUniformMesh(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0), 2, 2, 2);
+    auto vertexIds = std::make_shared<DataArray<int>>(mesh->getNumVertices());
+    std::iota(vertexIds->begin(), vertexIds->end(), 0);
+    mesh->setVertexAttribute("VertexIds", vertexIds);
+    const VecDataArray<double, 3> origVertices = *mesh->getVertexPositions();
+    const VecDataArray<int, 4>    origCells    = *mesh->getCells();
+
+    std::vector<size_t> newToOld(mesh->getNumVertices());
+    std::iota(newToOld.rbegin(), newToOld.rend(), 0);
+    GeometryUtils::permuteVertices(mesh, newToOld);
+
+    const VecDataArray<double, 3>& vertices        = *mesh->getVertexPositions();
+    const VecDataArray<double, 3>& initialVertices = *mesh->getInitialVertexPositions();
+    for (int i = 0; i < mesh->getNumVertices(); i++)
+    {
+        EXPECT_EQ((*vertexIds)[i], static_cast<int>(newToOld[i]));
+        EXPECT_TRUE(vertices[i].isApprox(origVertices[newToOld[i]]));
+        EXPECT_TRUE(initialVertices[i].isApprox(origVertices[newToOld[i]]));
+    }
+    const VecDataArray<int, 4>& cells = *mesh->getCells();
+    for (int i = 0; i < mesh->getNumCells(); i++)
+    {
+        for (int j = 0; j < 4; j++)
+        {
+            EXPECT_EQ(static_cast<int>(newToOld[cells[i][j]]), origCells[i][j]);
+        }
+    }
+}
+
+///
+/// \brief Test that Reverse Cuthill-Mckee renumbering of a scrambled mesh keeps the
+/// mesh intact, reduces its bandwidth and orders the cells by their lowest vertex
+///
+TEST(imstkMeshRenumberingTest, RenumberReverseCuthillMckee)
+{
+    std::shared_ptr<TetrahedralMesh> original = createScrambledMesh();
+    std::shared_ptr<TetrahedralMesh> mesh     = copyMesh(original);
+
+    GeometryUtils::renumberMesh(mesh, GeometryUtils::MeshNodeRenumberingStrategy::ReverseCuthillMckee);
+
+    checkSameMesh(*original, *mesh);
+    EXPECT_LT(getBandwidth(*mesh), getBandwidth(*original) / 4);
+
+    const VecDataArray<int, 4>& cells = *mesh->getCells();
+    for (int i = 1; i < mesh->getNumCells(); i++)
+    {
+        EXPECT_LE(cells[i - 1].minCoeff(), cells[i].minCoeff());
+    }
+}
+
+///
+/// \brief Test that space filling curve renumbering of a scrambled mesh keeps the
+/// mesh intact and brings the vertices of its cells closer together
+///
+TEST(imstkMeshRenumberingTest, RenumberSpaceFillingCurve)
+{
+    std::shared_ptr<TetrahedralMesh> original = createScrambledMesh();
+    std::shared_ptr<TetrahedralMesh> mesh     = copyMesh(original);
+
+    GeometryUtils::renumberMesh(mesh, GeometryUtils::MeshNodeRenumberingStrategy::SpaceFillingCurve);
+
+    checkSameMesh(*original, *mesh);
+    EXPECT_LT(getMeanCellSpan(*mesh), getMeanCellSpan(*original) / 4.0);
+}
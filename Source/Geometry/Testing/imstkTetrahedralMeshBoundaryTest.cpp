@@ -0,0 +1,162 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkGeometryUtilities.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkTetrahedralMeshBoundary.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Get the faces as sorted vertex triples
+///
+std::set<std::array<int, 3>>
+getFaceSet(const VecDataArray<int, 3>& faces)
+{
+    std::set<std::array<int, 3>> faceSet;
+    for (const Vec3i& face : faces)
+    {
+        std::array<int, 3> key = { { face[0], face[1], face[2] } };
+        std::sort(key.begin(), key.end());
+        faceSet.insert(key);
+    }
+    return faceSet;
+}
+
+///
+/// \brief Check every face points away from the tetrahedron that uses it
+///
+void
+checkWindings(const TetrahedralMesh& mesh, const VecDataArray<int, 3>& faces)
+{
+    const VecDataArray<double, 3>& vertices = *mesh.getVertexPositions();
+    const VecDataArray<int, 4>&    tets     = *mesh.getCells();
+    for (const Vec3i& face : faces)
+    {
+        const Vec3d normal   = (vertices[face[1]] - vertices[face[0]]).cross(vertices[face[2]] - vertices[face[0]]);
+        const Vec3d centroid = (vertices[face[0]] + vertices[face[1]] + vertices[face[2]]) / 3.0;
+        for (int i = 0; i < tets.size(); i++)
+        {
+            if (i < static_cast<int>(mesh.getRemovedTetrahedra().size()) && mesh.getRemovedTetrahedra()[i])
+            {
+                continue;
+            }
+            const Vec4i& tet = tets[i];
+            int          numShared = 0;
+            int          unusedVertex = -1;
+            for (int j = 0; j < 4; j++)
+            {
+                if (tet[j] == face[0] || tet[j] == face[1] || tet[j] == face[2])
+                {
+                    numShared++;
+                }
+                else
+                {
+                    unusedVertex = tet[j];
+                }
+            }
+            if (numShared == 3)
+            {
+                EXPECT_GT(normal.dot(centroid - vertices[unusedVertex]), 0.0);
+            }
+        }
+    }
+}
+} // namespace
+
+///
+/// \brief Test the boundary of a grid matches its extracted surface, wound outwards
+///
+TEST(imstkTetrahedralMeshBoundaryTest, Compute)
+{
+    std::shared_ptr<TetrahedralMesh> mesh =
+        GeometryUtils::createUniformMesh(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0), 4, 4, 4);
+
+    TetrahedralMeshBoundary boundary;
+    boundary.compute(mesh);
+
+    // Each side has 4x4 quads, 2 triangles per quad
+    EXPECT_EQ(boundary.getNumFaces(), 6 * 16 * 2);
+    checkWindings(*mesh, *boundary.getFaces());
+
+    // All faces lie on the sides of the box
+    const VecDataArray<double, 3>& vertices = *mesh->getVertexPositions();
+    for (const Vec3i& face : *boundary.getFaces())
+    {
+        const Vec3d centroid = (vertices[face[0]] + vertices[face[1]] + vertices[face[2]]) / 3.0;
+        EXPECT_NEAR(centroid.cwiseAbs().maxCoeff(), 1.0, 1.0e-12);
+    }
+    EXPECT_FALSE(boundary.update());
+}
+
+///
+/// \brief Test that removing tetrahedra incrementally gives the same boundary
+/// as computing it from scratch
+///
+TEST(imstkTetrahedralMeshBoundaryTest, RemoveTetrahedra)
+{
+    std::shared_ptr<TetrahedralMesh> mesh =
+        GeometryUtils::createUniformMesh(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0), 4, 4, 4);
+
+    TetrahedralMeshBoundary boundary;
+    boundary.compute(mesh);
+
+    // Drill through the mesh, removing a tetrahedron twice does nothing
+    for (int i = 0; i < mesh->getNumCells(); i += 3)
+    {
+        mesh->setTetrahedraAsRemoved(i);
+        mesh->setTetrahedraAsRemoved(i);
+        if (i % 4 == 0)
+        {
+            EXPECT_TRUE(boundary.update());
+
+            TetrahedralMeshBoundary reference;
+            reference.compute(mesh);
+            EXPECT_EQ(getFaceSet(*boundary.getFaces()), getFaceSet(*reference.getFaces()));
+        }
+    }
+    EXPECT_TRUE(boundary.update());
+    EXPECT_FALSE(boundary.update());
+    checkWindings(*mesh, *boundary.getFaces());
+
+    // Removing all gives no boundary
+    for (int i = 0; i < mesh->getNumCells(); i++)
+    {
+        mesh->setTetrahedraAsRemoved(i);
+    }
+    EXPECT_TRUE(boundary.update());
+    EXPECT_EQ(boundary.getNumFaces(), 0);
+}
+
+///
+/// \brief Test the boundary is recomputed when the cells are replaced
+///
+TEST(imstkTetrahedralMeshBoundaryTest, ReplaceCells)
+{
+    std::shared_ptr<TetrahedralMesh> mesh =
+        GeometryUtils::createUniformMesh(Vec3d(-1.0, -1.0, -1.0), Vec3d(1.0, 1.0, 1.0), 2, 2, 2);
+
+    TetrahedralMeshBoundary boundary;
+    boundary.compute(mesh);
+    EXPECT_EQ(boundary.getNumFaces(), 6 * 4 * 2);
+
+    // Single tetrahedron
+    auto cells = std::make_shared<VecDataArray<int, 4>>(1);
+    (*cells)[0] = (*mesh->getCells())[0];
+    mesh->setCells(cells);
+
+    EXPECT_TRUE(boundary.update());
+    EXPECT_EQ(boundary.getNumFaces(), 4);
+    checkWindings(*mesh, *boundary.getFaces());
+}
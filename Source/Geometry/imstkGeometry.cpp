@@ -7,6 +7,7 @@
 #include "imstkGeometry.h"
 #include "imstkLogger.h"
 #include "imstkParallelUtils.h"
+#include "imstkStateBuffers.h"
 
 namespace imstk
 {
@@ -193,4 +194,21 @@ Geometry::getScaling() const
         m_transform.block<3, 1>(0, 1).norm(),
         m_transform.block<3, 1>(0, 2).norm());
 }
+
+void
+Geometry::getStateBuffers(StateBuffers& buffers)
+{
+    // Geometry shared by many objects
+    if (!buffers.addValue(m_transform))
+    {
+        return;
+    }
+
+    // The post transform data is recomputed from the restored transform
+    buffers.addRestoreCallback([this]()
+        {
+            m_transformApplied = false;
+            this->postModified();
+        });
+}
 } // namespace imstk
\ No newline at end of file
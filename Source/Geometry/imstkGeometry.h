@@ -15,6 +15,8 @@
 
 namespace imstk
 {
+class StateBuffers;
+
 ///
 /// \class Geometry
 /// \brief Base class for any geometrical representation
@@ -192,6 +194,12 @@ public:
 
     virtual void updatePostTransformData() const { }
 
+    ///
+    /// \brief Add the memory holding the state of the geometry that changes as it's
+    /// simulated, see Scene::captureSnapshot. The transform by default
+    ///
+    virtual void getStateBuffers(StateBuffers& buffers);
+
 protected:
     ///
     /// \brief Directly apply transform to data
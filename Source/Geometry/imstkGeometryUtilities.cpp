@@ -1318,6 +1318,55 @@ RCM(const std::vector<ElemConn>& conn, const size_t numVerts)
     return RCM(vertToVert);
 }
 
+///
+/// \brief Reorder the tuples of an array such that tuple i is old tuple newToOld[i]
+///
+template<typename T>
+static void
+permuteTuples(AbstractDataArray& arr, const std::vector<size_t>& newToOld)
+{
+    const int      numComps = arr.getNumberOfComponents();
+    T*             data     = static_cast<T*>(arr.getVoidPointer());
+    const std::vector<T> oldData(data, data + arr.size());
+    for (size_t i = 0; i < newToOld.size(); i++)
+    {
+        std::copy_n(&oldData[newToOld[i] * numComps], numComps, &data[i * numComps]);
+    }
+}
+
+static void
+permuteTuples(AbstractDataArray& arr, const std::vector<size_t>& newToOld, const std::string& name)
+{
+    if (arr.size() != static_cast<int>(newToOld.size()) * arr.getNumberOfComponents())
+    {
+        LOG(WARNING) << "Cannot permute array " << name << ", its size does not match";
+        return;
+    }
+    switch (arr.getScalarType())
+    {
+        TemplateMacro(permuteTuples<IMSTK_TT>(arr, newToOld));
+    default:
+        LOG(WARNING) << "Cannot permute array " << name << ", unknown scalar type";
+        return;
+    }
+    arr.postModified();
+}
+
+///
+/// \brief Spread the lower 21 bits of x such that there are two 0 bits between each
+///
+static uint64_t
+spreadBits3(uint64_t x)
+{
+    x &= 0x1fffff;
+    x  = (x | x << 32) & 0x1f00000000ffff;
+    x  = (x | x << 16) & 0x1f0000ff0000ff;
+    x  = (x | x << 8) & 0x100f00f00f00f00f;
+    x  = (x | x << 4) & 0x10c30c30c30c30c3;
+    x  = (x | x << 2) & 0x1249249249249249;
+    return x;
+}
+
 ///
 /// \brief Given a set of points mark them as inside (true) and outside
 /// \param surfaceMesh a \ref SurfaceMesh
@@ -1982,6 +2031,166 @@ GeometryUtils::reorderConnectivity(const std::vector<ElemConn>& conn, const size
         return RCM(conn, numVerts);
     }
 }
+
+std::vector<size_t>
+GeometryUtils::spaceFillingCurveOrder(const VecDataArray<double, 3>& vertices)
+{
+    const size_t        numVerts = static_cast<size_t>(vertices.size());
+    std::vector<size_t> order(numVerts);
+    std::iota(order.begin(), order.end(), 0);
+    if (numVerts == 0)
+    {
+        return order;
+    }
+
+    Vec3d lowerCorner, upperCorner;
+    ParallelUtils::findAABB(vertices, lowerCorner, upperCorner);
+    const Vec3d size = (upperCorner - lowerCorner).cwiseMax(Vec3d::Constant(IMSTK_DOUBLE_EPS));
+
+    // Quantize to 21 bits per axis and interleave them
+    const double          maxCoord = static_cast<double>((1 << 21) - 1);
+    std::vector<uint64_t> codes(numVerts);
+    for (size_t i = 0; i < numVerts; i++)
+    {
+        const Vec3d p = (vertices[i] - lowerCorner).cwiseQuotient(size) * maxCoord;
+        codes[i] = spreadBits3(static_cast<uint64_t>(p[0]))
+                   | (spreadBits3(static_cast<uint64_t>(p[1])) << 1)
+                   | (spreadBits3(static_cast<uint64_t>(p[2])) << 2);
+    }
+    std::stable_sort(order.begin(), order.end(), [&codes](const size_t a, const size_t b) { return codes[a] < codes[b]; });
+    return order;
+}
+
+void
+GeometryUtils::permuteVertices(std::shared_ptr<PointSet> pointSet, const std::vector<size_t>& newToOld)
+{
+    const int numVerts = pointSet->getNumVertices();
+    CHECK(static_cast<int>(newToOld.size()) == numVerts) << "Permutation size must match the number of vertices";
+
+    // Fetch the current positions first, fetching updates them from the initial positions if the transform changed
+    std::shared_ptr<VecDataArray<double, 3>> initialVertices = pointSet->getInitialVertexPositions();
+    std::shared_ptr<VecDataArray<double, 3>> vertices = pointSet->getVertexPositions();
+
+    // Arrays may be shared between positions and attributes, permute each once
+    std::unordered_set<AbstractDataArray*> permuted;
+    if (initialVertices != nullptr && permuted.insert(initialVertices.get()).second)
+    {
+        permuteTuples(*initialVertices, newToOld, "InitialVertexPositions");
+    }
+    if (vertices != nullptr && permuted.insert(vertices.get()).second)
+    {
+        permuteTuples(*vertices, newToOld, "VertexPositions");
+    }
+    for (const auto& attribute : pointSet->getVertexAttributes())
+    {
+        if (attribute.second != nullptr && permuted.insert(attribute.second.get()).second)
+        {
+            permuteTuples(*attribute.second, newToOld, attribute.first);
+        }
+    }
+
+    if (auto cellMesh = std::dynamic_pointer_cast<AbstractCellMesh>(pointSet))
+    {
+        std::vector<int> oldToNew(newToOld.size());
+        for (size_t i = 0; i < newToOld.size(); i++)
+        {
+            oldToNew[newToOld[i]] = static_cast<int>(i);
+        }
+
+        std::shared_ptr<AbstractDataArray> cells = cellMesh->getAbstractCells();
+        int*                               cellIds = static_cast<int*>(cells->getVoidPointer());
+        for (int i = 0; i < cells->size(); i++)
+        {
+            cellIds[i] = oldToNew[cellIds[i]];
+        }
+        cells->postModified();
+
+        // Recompute the vertex maps if in use
+        if (!cellMesh->getVertexToCellMap().empty())
+        {
+            cellMesh->computeVertexToCellMap();
+        }
+        if (!cellMesh->getVertexNeighbors().empty())
+        {
+            cellMesh->computeVertexNeighbors();
+        }
+    }
+    pointSet->postModified();
+}
+
+void
+GeometryUtils::permuteCells(std::shared_ptr<AbstractCellMesh> mesh, const std::vector<size_t>& newToOld)
+{
+    CHECK(static_cast<int>(newToOld.size()) == mesh->getNumCells()) << "Permutation size must match the number of cells";
+
+    std::shared_ptr<AbstractDataArray> cells = mesh->getAbstractCells();
+    permuteTuples(*cells, newToOld, "Cells");
+    for (const auto& attribute : mesh->getCellAttributes())
+    {
+        if (attribute.second != nullptr && attribute.second != cells)
+        {
+            permuteTuples(*attribute.second, newToOld, attribute.first);
+        }
+    }
+
+    if (!mesh->getVertexToCellMap().empty())
+    {
+        mesh->computeVertexToCellMap();
+    }
+    mesh->postModified();
+}
+
+std::vector<size_t>
+GeometryUtils::renumberMesh(std::shared_ptr<AbstractCellMesh> mesh, const MeshNodeRenumberingStrategy& method)
+{
+    const size_t                       numVerts = static_cast<size_t>(mesh->getNumVertices());
+    std::shared_ptr<AbstractDataArray> cells    = mesh->getAbstractCells();
+    const int                          numCellVerts = cells->getNumberOfComponents();
+    const int                          numCells     = mesh->getNumCells();
+
+    // Vertices
+    std::vector<size_t> newToOld;
+    if (method == MeshNodeRenumberingStrategy::SpaceFillingCurve)
+    {
+        newToOld = spaceFillingCurveOrder(*mesh->getVertexPositions());
+    }
+    else
+    {
+        const int* cellIds = static_cast<const int*>(cells->getVoidPointer());
+        std::vector<std::set<size_t>> neighbors(numVerts);
+        for (int i = 0; i < numCells; i++)
+        {
+            const int* cell = &cellIds[i * numCellVerts];
+            for (int j = 0; j < numCellVerts; j++)
+            {
+                for (int k = 0; k < numCellVerts; k++)
+                {
+                    if (j != k)
+                    {
+                        neighbors[cell[j]].insert(static_cast<size_t>(cell[k]));
+                    }
+                }
+            }
+        }
+        newToOld = reorderConnectivity(neighbors, method);
+    }
+    permuteVertices(mesh, newToOld);
+
+    // Cells, by their lowest vertex
+    const int*       cellIds = static_cast<const int*>(cells->getVoidPointer());
+    std::vector<int> minVertex(numCells);
+    for (int i = 0; i < numCells; i++)
+    {
+        minVertex[i] = *std::min_element(&cellIds[i * numCellVerts], &cellIds[(i + 1) * numCellVerts]);
+    }
+    std::vector<size_t> cellNewToOld(numCells);
+    std::iota(cellNewToOld.begin(), cellNewToOld.end(), 0);
+    std::stable_sort(cellNewToOld.begin(), cellNewToOld.end(),
+        [&minVertex](const size_t a, const size_t b) { return minVertex[a] < minVertex[b]; });
+    permuteCells(mesh, cellNewToOld);
+
+    return newToOld;
+}
 } // namespace imstk
 
 template std::vector<size_t> imstk::GeometryUtils::reorderConnectivity<std::set<size_t>>(const std::vector<std::set<size_t>>&, const GeometryUtils::MeshNodeRenumberingStrategy&);
@@ -269,7 +269,8 @@ std::shared_ptr<TetrahedralMesh> createTetrahedralMeshCover(std::shared_ptr<Surf
 ///
 enum class MeshNodeRenumberingStrategy
 {
-    ReverseCuthillMckee     // Reverse Cuthill-Mckee
+    ReverseCuthillMckee,    // Reverse Cuthill-Mckee
+    SpaceFillingCurve       // Z-order (Morton) curve over the vertex positions
 };
 
 ///
@@ -294,5 +295,39 @@ std::vector<size_t> reorderConnectivity(const std::vector<NeighborContainer>& ne
 ///
 template<typename ElemConn>
 std::vector<size_t> reorderConnectivity(const std::vector<ElemConn>& conn, const size_t numVerts, const MeshNodeRenumberingStrategy& method = MeshNodeRenumberingStrategy::ReverseCuthillMckee);
+
+///
+/// \brief Order vertices along a Z-order (Morton) space filling curve of their positions
+///
+/// \return the permutation vector that maps from new indices to old indices
+///
+std::vector<size_t> spaceFillingCurveOrder(const VecDataArray<double, 3>& vertices);
+
+///
+/// \brief Permute the vertices of a PointSet, its initial and current positions and all
+/// vertex attributes. The cells of a cell mesh are remapped to the new vertex indices
+///
+/// \param[in] newToOld permutation vector that maps from new indices to old indices
+///
+void permuteVertices(std::shared_ptr<PointSet> pointSet, const std::vector<size_t>& newToOld);
+
+///
+/// \brief Permute the cells of a cell mesh and all cell attributes
+///
+/// \param[in] newToOld permutation vector that maps from new indices to old indices
+///
+void permuteCells(std::shared_ptr<AbstractCellMesh> mesh, const std::vector<size_t>& newToOld);
+
+///
+/// \brief Renumber a mesh for memory locality. Vertices are renumbered with the given
+/// method then cells are sorted by their lowest vertex, such that vertices and cells
+/// close in the mesh are close in memory. All vertex and cell attributes are permuted
+///
+/// \param[in] mesh mesh to renumber in place
+/// \param[in] method reordering method; see \ref MeshNodeRenumberingStrategy
+///
+/// \return the vertex permutation vector that maps from new indices to old indices
+///
+std::vector<size_t> renumberMesh(std::shared_ptr<AbstractCellMesh> mesh, const MeshNodeRenumberingStrategy& method = MeshNodeRenumberingStrategy::ReverseCuthillMckee);
 } // namespace GeometryUtils
 } // namespace imstk
\ No newline at end of file
@@ -0,0 +1,138 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+#include "imstkVecDataArray.h"
+
+#include <functional>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace imstk
+{
+///
+/// \class StateBuffers
+///
+/// \brief The memory holding the dynamic state of a scene, as gathered by its objects,
+/// models and geometries for Scene::captureSnapshot/restoreSnapshot. Every buffer is a
+/// range of bytes copied as is. A buffer added twice (ie: a geometry shared by two objects,
+/// or a state array also used as the geometry vertices) is kept once. The restore callbacks
+/// are called once the buffers are written back. Buffers of data arrays keep the array to
+/// tell when it was freed, reallocated or resized since, see isStale
+///
+class StateBuffers
+{
+public:
+    struct Buffer
+    {
+        void* data      = nullptr;
+        size_t numBytes = 0;
+        std::weak_ptr<AbstractDataArray> array; ///< Array owning the memory, if any
+        int arraySize = -1;                     ///< Size of the array when added
+
+        ///
+        /// \brief True if the array owning the memory was freed, reallocated or resized
+        ///
+        bool isStale() const
+        {
+            if (arraySize == -1)
+            {
+                return false;
+            }
+            std::shared_ptr<AbstractDataArray> arr = array.lock();
+            return arr == nullptr || arr->getVoidPointer() != data || arr->size() != arraySize;
+        }
+    };
+
+public:
+    ///
+    /// \brief Add numBytes of memory at data, returns false if it was already added.
+    /// The array owning the memory may be given to check it later, see isStale
+    ///
+    bool add(void* data, const size_t numBytes, std::shared_ptr<AbstractDataArray> array = nullptr)
+    {
+        if (numBytes == 0 || !m_bufferData.insert(data).second)
+        {
+            return false;
+        }
+        Buffer buffer;
+        buffer.data     = data;
+        buffer.numBytes = numBytes;
+        if (array != nullptr)
+        {
+            buffer.array     = array;
+            buffer.arraySize = array->size();
+        }
+        m_buffers.push_back(buffer);
+        m_numBytes += numBytes;
+        return true;
+    }
+
+    ///
+    /// \brief Add the values of an array
+    ///@{
+    template<typename T>
+    bool add(std::shared_ptr<DataArray<T>> arr) { return add(arr->getPointer(), sizeof(T) * arr->size(), arr); }
+    template<typename T, int N>
+    bool add(std::shared_ptr<VecDataArray<T, N>> arr) { return add(arr->getPointer(), sizeof(T) * N * arr->size(), arr); }
+    template<typename T, typename Allocator>
+    bool add(std::vector<T, Allocator>& arr) { return add(arr.data(), sizeof(T) * arr.size()); }
+    bool add(Vectord& arr) { return add(arr.data(), sizeof(double) * arr.size()); }
+    ///@}
+
+    ///
+    /// \brief Add a single value, it must not hold pointers
+    ///
+    template<typename T>
+    bool addValue(T& value) { return add(&value, sizeof(T)); }
+
+    ///
+    /// \brief Add a function to call after restoring, ie: to flag a geometry as modified
+    ///
+    void addRestoreCallback(std::function<void()> callback) { m_restoreCallbacks.push_back(callback); }
+
+    const std::vector<Buffer>& getBuffers() const { return m_buffers; }
+    const std::vector<std::function<void()>>& getRestoreCallbacks() const { return m_restoreCallbacks; }
+
+    ///
+    /// \brief True if the memory of any buffer was freed, reallocated or resized since
+    /// it was added, the buffers then need to be gathered again
+    ///
+    bool isStale() const
+    {
+        for (const Buffer& buffer : m_buffers)
+        {
+            if (buffer.isStale())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    ///
+    /// \brief Total size of the buffers
+    ///
+    size_t getNumBytes() const { return m_numBytes; }
+
+    void clear()
+    {
+        m_buffers.clear();
+        m_bufferData.clear();
+        m_restoreCallbacks.clear();
+        m_numBytes = 0;
+    }
+
+protected:
+    std::vector<Buffer> m_buffers;
+    std::unordered_set<void*> m_bufferData; ///< Start of every buffer, to skip duplicates
+    std::vector<std::function<void()>> m_restoreCallbacks;
+    size_t m_numBytes = 0;
+};
+} // namespace imstk
@@ -0,0 +1,212 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkVTKTetrahedralMeshBoundaryRenderDelegate.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkLogger.h"
+#include "imstkRenderMaterial.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVisualModel.h"
+
+#include <vtkActor.h>
+#include <vtkCellArray.h>
+#include <vtkDoubleArray.h>
+#include <vtkPointData.h>
+#include <vtkPolyData.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkTransform.h>
+#include <vtkTypeInt32Array.h>
+
+namespace imstk
+{
+VTKTetrahedralMeshBoundaryRenderDelegate::VTKTetrahedralMeshBoundaryRenderDelegate(std::shared_ptr<VisualModel> visualModel) : VTKPolyDataRenderDelegate(visualModel),
+    m_polydata(vtkSmartPointer<vtkPolyData>::New()),
+    m_mappedVertexArray(vtkSmartPointer<vtkDoubleArray>::New()),
+    m_mappedFaceArray(vtkSmartPointer<vtkTypeInt32Array>::New()),
+    m_cellArray(vtkSmartPointer<vtkCellArray>::New())
+{
+    m_geometry = std::static_pointer_cast<TetrahedralMesh>(visualModel->getGeometry());
+
+    // Create vtkPolyData vtkPoints
+    m_mappedVertexArray->SetNumberOfComponents(3);
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->SetNumberOfPoints(0);
+    points->SetData(m_mappedVertexArray);
+    m_polydata->SetPoints(points);
+
+    setVertexBuffer(m_geometry->getVertexPositions());
+
+    m_mappedFaceArray->SetNumberOfComponents(1);
+    setIndexBuffer(m_geometry->getCells());
+    m_polydata->SetPolys(m_cellArray);
+
+    // Map vertex scalars if it has them
+    if (m_geometry->getVertexScalars() != nullptr)
+    {
+        m_mappedVertexScalarArray = GeometryUtils::coupleVtkDataArray(m_geometry->getVertexScalars());
+        m_polydata->GetPointData()->SetScalars(m_mappedVertexScalarArray);
+    }
+
+    // When geometry is modified, update data source, mostly for when an entirely new array/buffer was set
+    queueConnect<Event>(m_geometry, &Geometry::modified, this, &VTKTetrahedralMeshBoundaryRenderDelegate::geometryModified);
+
+    // Setup the mapper
+    {
+        vtkNew<vtkPolyDataMapper> mapper;
+        mapper->SetInputData(m_polydata);
+        vtkNew<vtkActor> actor;
+        actor->SetMapper(mapper);
+        actor->SetUserTransform(m_transform);
+        m_actor  = actor;
+        m_mapper = mapper;
+    }
+
+    update();
+    updateRenderProperties();
+}
+
+void
+VTKTetrahedralMeshBoundaryRenderDelegate::processEvents()
+{
+    // Custom handling of events
+    std::shared_ptr<VecDataArray<double, 3>> vertices = m_geometry->getVertexPositions();
+    std::shared_ptr<VecDataArray<int, 4>>    indices  = m_geometry->getCells();
+
+    // Only use the most recent event from respective sender
+    std::array<Command, 5> cmds;
+    std::array<bool, 5>    contains = { false, false, false, false, false };
+    rforeachEvent([&](Command cmd)
+        {
+            if (cmd.m_event->m_sender == m_visualModel.get() && !contains[0])
+            {
+                cmds[0]     = cmd;
+                contains[0] = true;
+            }
+            else if (cmd.m_event->m_sender == m_material.get() && !contains[1])
+            {
+                cmds[1]     = cmd;
+                contains[1] = true;
+            }
+            else if (cmd.m_event->m_sender == m_geometry.get() && !contains[2])
+            {
+                cmds[2]     = cmd;
+                contains[2] = true;
+            }
+            else if (cmd.m_event->m_sender == vertices.get() && !contains[3])
+            {
+                cmds[3]     = cmd;
+                contains[3] = true;
+            }
+            else if (cmd.m_event->m_sender == indices.get() && !contains[4])
+            {
+                cmds[4]     = cmd;
+                contains[4] = true;
+            }
+        });
+
+    cmds[0].invoke();
+    cmds[1].invoke();
+    cmds[3].invoke();
+    cmds[4].invoke();
+    cmds[2].invoke(); // Process geometry changes last
+}
+
+void
+VTKTetrahedralMeshBoundaryRenderDelegate::vertexDataModified(Event* imstkNotUsed(e))
+{
+    setVertexBuffer(m_geometry->getVertexPositions());
+}
+
+void
+VTKTetrahedralMeshBoundaryRenderDelegate::indexDataModified(Event* imstkNotUsed(e))
+{
+    // The tetrahedra changed in place, start over
+    m_boundary.compute(m_geometry);
+    updateFaceBuffer();
+}
+
+void
+VTKTetrahedralMeshBoundaryRenderDelegate::geometryModified(Event* imstkNotUsed(e))
+{
+    // If the vertices were reallocated
+    if (m_vertices != m_geometry->getVertexPositions())
+    {
+        setVertexBuffer(m_geometry->getVertexPositions());
+    }
+
+    // Assume vertices are always changed
+    m_mappedVertexArray->Modified();
+
+    if (m_indices != m_geometry->getCells())
+    {
+        setIndexBuffer(m_geometry->getCells());
+    }
+    // Apply the tetrahedra removed since last update
+    else if (m_boundary.update())
+    {
+        updateFaceBuffer();
+    }
+}
+
+void
+VTKTetrahedralMeshBoundaryRenderDelegate::setVertexBuffer(std::shared_ptr<VecDataArray<double, 3>> vertices)
+{
+    // If the buffer changed
+    if (m_vertices != vertices)
+    {
+        // If previous buffer exist
+        if (m_vertices != nullptr)
+        {
+            // stop observing its changes
+            disconnect(m_vertices, this, &VecDataArray<double, 3>::modified);
+        }
+        // Set new buffer and observe
+        m_vertices = vertices;
+        queueConnect<Event>(m_vertices, &VecDataArray<double, 3>::modified, this, &VTKTetrahedralMeshBoundaryRenderDelegate::vertexDataModified);
+    }
+
+    // Couple the buffer
+    m_mappedVertexArray->SetNumberOfComponents(3);
+    m_mappedVertexArray->SetArray(reinterpret_cast<double*>(m_vertices->getPointer()), m_vertices->size() * 3, 1);
+    m_mappedVertexArray->Modified();
+    m_polydata->GetPoints()->SetNumberOfPoints(m_vertices->size());
+}
+
+void
+VTKTetrahedralMeshBoundaryRenderDelegate::setIndexBuffer(std::shared_ptr<VecDataArray<int, 4>> indices)
+{
+    // If the buffer changed
+    if (m_indices != indices)
+    {
+        // If previous buffer exist
+        if (m_indices != nullptr)
+        {
+            // stop observing its changes
+            disconnect(m_indices, this, &VecDataArray<int, 4>::modified);
+        }
+        // Set new buffer and observe
+        m_indices = indices;
+        queueConnect<Event>(m_indices, &VecDataArray<int, 4>::modified, this, &VTKTetrahedralMeshBoundaryRenderDelegate::indexDataModified);
+    }
+
+    m_boundary.compute(m_geometry);
+    updateFaceBuffer();
+}
+
+void
+VTKTetrahedralMeshBoundaryRenderDelegate::updateFaceBuffer()
+{
+    // Couple the faces, they may have been reallocated
+    std::shared_ptr<VecDataArray<int, 3>> faces = m_boundary.getFaces();
+    m_mappedFaceArray->SetArray(reinterpret_cast<int*>(faces->getPointer()), faces->size() * 3, 1);
+    if (!m_cellArray->SetData(3, m_mappedFaceArray))
+    {
+        LOG(WARNING) << "Failed to set the boundary faces of " << m_visualModel->getName();
+    }
+    m_cellArray->Modified();
+    m_polydata->Modified();
+}
+} // namespace imstk
@@ -0,0 +1,85 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkVTKPolyDataRenderDelegate.h"
+#include "imstkTetrahedralMeshBoundary.h"
+
+class vtkCellArray;
+class vtkDataArray;
+class vtkDoubleArray;
+class vtkPolyData;
+class vtkTypeInt32Array;
+
+namespace imstk
+{
+class TetrahedralMesh;
+template<typename T, int N> class VecDataArray;
+
+///
+/// \class VTKTetrahedralMeshBoundaryRenderDelegate
+///
+/// \brief Renders only the boundary triangles of a tetrahedral mesh, selected with the
+/// "TetrahedralMeshBoundary" delegate hint. The boundary is kept in a cached index buffer
+/// updated incrementally as tetrahedra are removed (ie: drilling, cutting) and handed to
+/// VTK without copy, as are the vertices. The interior is never sent to VTK, unlike
+/// VTKTetrahedralMeshRenderDelegate where VTK extracts the faces of every tetrahedron
+/// whenever the mesh is modified
+///
+class VTKTetrahedralMeshBoundaryRenderDelegate : public VTKPolyDataRenderDelegate
+{
+public:
+    VTKTetrahedralMeshBoundaryRenderDelegate(std::shared_ptr<VisualModel> visualModel);
+    ~VTKTetrahedralMeshBoundaryRenderDelegate() override = default;
+
+    ///
+    /// \brief Process handling of messages recieved
+    ///
+    void processEvents() override;
+
+    ///
+    /// \brief Get the boundary rendered
+    ///
+    const TetrahedralMeshBoundary& getBoundary() const { return m_boundary; }
+
+protected:
+    ///
+    /// \brief Callback for when vertex values are modified
+    ///
+    void vertexDataModified(Event* e);
+
+    ///
+    /// \brief Callback for when index values are modified, recomputes the boundary
+    ///
+    void indexDataModified(Event* e);
+
+    ///
+    /// \brief Callback for when geometry is modified
+    ///
+    void geometryModified(Event* e);
+
+    void setVertexBuffer(std::shared_ptr<VecDataArray<double, 3>> vertices);
+    void setIndexBuffer(std::shared_ptr<VecDataArray<int, 4>> indices);
+
+    ///
+    /// \brief Couple the boundary faces to the cell array
+    ///
+    void updateFaceBuffer();
+
+    std::shared_ptr<TetrahedralMesh>         m_geometry;
+    std::shared_ptr<VecDataArray<double, 3>> m_vertices;
+    std::shared_ptr<VecDataArray<int, 4>>    m_indices;
+    TetrahedralMeshBoundary m_boundary;
+
+    vtkSmartPointer<vtkPolyData> m_polydata;
+
+    vtkSmartPointer<vtkDoubleArray>    m_mappedVertexArray;       ///< Mapped array of vertices
+    vtkSmartPointer<vtkDataArray>      m_mappedVertexScalarArray; ///< Mapped array of scalars
+    vtkSmartPointer<vtkTypeInt32Array> m_mappedFaceArray;         ///< Mapped array of boundary faces
+    vtkSmartPointer<vtkCellArray>      m_cellArray;               ///< Array of cells
+};
+} // namespace imstk
@@ -31,6 +31,7 @@
 #include "imstkVTKSphereRenderDelegate.h"
 #include "imstkVTKSurfaceMeshRenderDelegate.h"
 #include "imstkVTKSurfaceNormalRenderDelegate.h"
+#include "imstkVTKTetrahedralMeshBoundaryRenderDelegate.h"
 #include "imstkVTKTetrahedralMeshRenderDelegate.h"
 #include "imstkVTKTextRenderDelegate.h"
 #include "imstkVTKVertexLabelRenderDelegate.h"
@@ -55,8 +56,9 @@ IMSTK_REGISTER_RENDERDELEGATE(VertexLabel, VTKVertexLabelRenderDelegate)
 IMSTK_REGISTER_RENDERDELEGATE(TextRenderDelegate, VTKTextRenderDelegate)
 
 // Custom algorithms
-RenderDelegateRegistrar<VTKFluidRenderDelegate>         _imstk_registerrenderdelegate_fluid("Fluid");
-RenderDelegateRegistrar<VTKSurfaceNormalRenderDelegate> _imstk_registerrenderdelegate_surfacenormals("SurfaceNormals");
+RenderDelegateRegistrar<VTKFluidRenderDelegate>                   _imstk_registerrenderdelegate_fluid("Fluid");
+RenderDelegateRegistrar<VTKSurfaceNormalRenderDelegate>           _imstk_registerrenderdelegate_surfacenormals("SurfaceNormals");
+RenderDelegateRegistrar<VTKTetrahedralMeshBoundaryRenderDelegate> _imstk_registerrenderdelegate_tetrahedralmeshboundary("TetrahedralMeshBoundary");
 
 std::shared_ptr<VTKRenderDelegate>
 RenderDelegateObjectFactory::makeRenderDelegate(std::shared_ptr<VisualModel> visualModel)
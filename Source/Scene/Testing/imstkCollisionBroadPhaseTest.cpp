@@ -0,0 +1,166 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkCollidingObject.h"
+#include "imstkCollisionBroadPhase.h"
+#include "imstkCollisionInteraction.h"
+#include "imstkPlane.h"
+#include "imstkScene.h"
+#include "imstkSphere.h"
+#include "imstkTaskNode.h"
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief CollisionInteraction without any response
+///
+class TestCollisionInteraction : public CollisionInteraction
+{
+public:
+    TestCollisionInteraction(std::shared_ptr<CollidingObject> objA, std::shared_ptr<CollidingObject> objB) :
+        CollisionInteraction(objA->getName() + "_vs_" + objB->getName(), objA, objB, "") { }
+    ~TestCollisionInteraction() override = default;
+
+    IMSTK_TYPE_NAME(TestCollisionInteraction)
+};
+
+std::shared_ptr<CollidingObject>
+makeSphereObject(const std::string& name, const Vec3d& pos)
+{
+    auto obj = std::make_shared<CollidingObject>(name);
+    obj->setCollidingGeometry(std::make_shared<Sphere>(pos, 1.0));
+    return obj;
+}
+} // namespace
+
+TEST(imstkCollisionBroadPhaseTest, CullSeparatedPairs)
+{
+    auto sceneConfig = std::make_shared<SceneConfig>();
+    sceneConfig->collisionBroadPhaseEnabled = true;
+    auto scene = std::make_shared<Scene>("BroadPhaseScene", sceneConfig);
+
+    std::shared_ptr<CollidingObject> sphereObj0 = makeSphereObject("Sphere0", Vec3d(0.0, 0.0, 0.0));
+    std::shared_ptr<CollidingObject> sphereObj1 = makeSphereObject("Sphere1", Vec3d(10.0, 0.0, 0.0));
+    std::shared_ptr<CollidingObject> sphereObj2 = makeSphereObject("Sphere2", Vec3d(1.5, 0.0, 0.0));
+
+    auto planeObj = std::make_shared<CollidingObject>("Plane");
+    planeObj->setCollidingGeometry(std::make_shared<Plane>(Vec3d(0.0, -100.0, 0.0)));
+
+    auto farInteraction   = std::make_shared<TestCollisionInteraction>(sphereObj0, sphereObj1);
+    auto nearInteraction  = std::make_shared<TestCollisionInteraction>(sphereObj0, sphereObj2);
+    auto planeInteraction = std::make_shared<TestCollisionInteraction>(sphereObj1, planeObj);
+
+    scene->addSceneObject(sphereObj0);
+    scene->addSceneObject(sphereObj1);
+    scene->addSceneObject(sphereObj2);
+    scene->addSceneObject(planeObj);
+    scene->addInteraction(farInteraction);
+    scene->addInteraction(nearInteraction);
+    scene->addInteraction(planeInteraction);
+    scene->initialize();
+    scene->advance(0.01);
+
+    std::shared_ptr<CollisionBroadPhase> broadPhase = scene->getCollisionBroadPhase();
+    EXPECT_EQ(broadPhase->getNumPairs(), 3);
+    EXPECT_EQ(broadPhase->getNumCulledPairs(), 1);
+
+    EXPECT_TRUE(farInteraction->getCulled());
+    EXPECT_FALSE(farInteraction->getCollisionDetectionNode()->m_enabled);
+    EXPECT_FALSE(farInteraction->getCollisionHandlingANode()->m_enabled);
+    EXPECT_FALSE(farInteraction->getCollisionHandlingBNode()->m_enabled);
+    // Culled but still enabled
+    EXPECT_TRUE(farInteraction->getEnabled());
+
+    EXPECT_FALSE(nearInteraction->getCulled());
+    EXPECT_TRUE(nearInteraction->getCollisionDetectionNode()->m_enabled);
+
+    // Planes are unbounded and never culled
+    EXPECT_FALSE(planeInteraction->getCulled());
+
+    // Bring the far sphere in range
+    std::dynamic_pointer_cast<Sphere>(sphereObj1->getCollidingGeometry())->setPosition(Vec3d(2.5, 0.0, 0.0));
+    scene->advance(0.01);
+    EXPECT_FALSE(farInteraction->getCulled());
+    EXPECT_TRUE(farInteraction->getCollisionDetectionNode()->m_enabled);
+    EXPECT_EQ(broadPhase->getNumCulledPairs(), 0);
+    EXPECT_EQ(broadPhase->getTotalNumCulledPairs(), 1);
+    EXPECT_EQ(broadPhase->getNumUpdates(), 2);
+}
+
+TEST(imstkCollisionBroadPhaseTest, RespectUserDisabled)
+{
+    auto sceneConfig = std::make_shared<SceneConfig>();
+    sceneConfig->collisionBroadPhaseEnabled = true;
+    auto scene = std::make_shared<Scene>("BroadPhaseScene", sceneConfig);
+
+    std::shared_ptr<CollidingObject> sphereObj0 = makeSphereObject("Sphere0", Vec3d(0.0, 0.0, 0.0));
+    std::shared_ptr<CollidingObject> sphereObj1 = makeSphereObject("Sphere1", Vec3d(10.0, 0.0, 0.0));
+
+    auto interaction = std::make_shared<TestCollisionInteraction>(sphereObj0, sphereObj1);
+    scene->addSceneObject(sphereObj0);
+    scene->addSceneObject(sphereObj1);
+    scene->addInteraction(interaction);
+    scene->initialize();
+
+    interaction->setEnabled(false);
+    scene->advance(0.01);
+    EXPECT_TRUE(interaction->getCulled());
+
+    // Unculled, the detection of the disabled interaction stays disabled
+    std::dynamic_pointer_cast<Sphere>(sphereObj1->getCollidingGeometry())->setPosition(Vec3d(1.0, 0.0, 0.0));
+    scene->advance(0.01);
+    EXPECT_FALSE(interaction->getCulled());
+    EXPECT_FALSE(interaction->getEnabled());
+    EXPECT_FALSE(interaction->getCollisionDetectionNode()->m_enabled);
+
+    // Move the sphere away and enable the interaction. The box is padded by the jump
+    // on the first frame, the pair is culled on the next one
+    std::dynamic_pointer_cast<Sphere>(sphereObj1->getCollidingGeometry())->setPosition(Vec3d(20.0, 0.0, 0.0));
+    interaction->setEnabled(true);
+    scene->advance(0.01);
+    scene->advance(0.01);
+    EXPECT_TRUE(interaction->getCulled());
+
+    // Turning the broad phase off unculls the pair, the detection is enabled again
+    sceneConfig->collisionBroadPhaseEnabled = false;
+    scene->advance(0.01);
+    EXPECT_FALSE(interaction->getCulled());
+    EXPECT_TRUE(interaction->getCollisionDetectionNode()->m_enabled);
+}
+
+TEST(imstkCollisionBroadPhaseTest, RespectUserDisabledNodes)
+{
+    auto sceneConfig = std::make_shared<SceneConfig>();
+    sceneConfig->collisionBroadPhaseEnabled = true;
+    auto scene = std::make_shared<Scene>("BroadPhaseScene", sceneConfig);
+
+    std::shared_ptr<CollidingObject> sphereObj0 = makeSphereObject("Sphere0", Vec3d(0.0, 0.0, 0.0));
+    std::shared_ptr<CollidingObject> sphereObj1 = makeSphereObject("Sphere1", Vec3d(10.0, 0.0, 0.0));
+
+    auto interaction = std::make_shared<TestCollisionInteraction>(sphereObj0, sphereObj1);
+    scene->addSceneObject(sphereObj0);
+    scene->addSceneObject(sphereObj1);
+    scene->addInteraction(interaction);
+    scene->initialize();
+
+    // Only respond on B
+    interaction->getCollisionHandlingANode()->setEnabled(false);
+    scene->advance(0.01);
+    EXPECT_TRUE(interaction->getCulled());
+    EXPECT_FALSE(interaction->getCollisionHandlingBNode()->m_enabled);
+
+    // Unculled, handling A stays disabled while B is enabled again
+    std::dynamic_pointer_cast<Sphere>(sphereObj1->getCollidingGeometry())->setPosition(Vec3d(1.0, 0.0, 0.0));
+    scene->advance(0.01);
+    EXPECT_FALSE(interaction->getCulled());
+    EXPECT_TRUE(interaction->getCollisionDetectionNode()->m_enabled);
+    EXPECT_FALSE(interaction->getCollisionHandlingANode()->m_enabled);
+    EXPECT_TRUE(interaction->getCollisionHandlingBNode()->m_enabled);
+}
@@ -0,0 +1,172 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "gtest/gtest.h"
+
+#include "imstkCollidingObject.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdObject.h"
+#include "imstkPbdObjectCollision.h"
+#include "imstkPlane.h"
+#include "imstkScene.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkVecDataArray.h"
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Substepped cloth falling on a plane
+///
+std::shared_ptr<PbdObject>
+makeSubsteppedCloth()
+{
+    std::shared_ptr<SurfaceMesh> clothMesh =
+        GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(1.0, 1.0), Vec2i(8, 8));
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+    pbdParams->m_uniformMassValue = 1.0;
+    pbdParams->m_gravity    = Vec3d(0.0, -9.8, 0.0);
+    pbdParams->m_dt         = 0.01;
+    pbdParams->m_substeps   = 4;
+    pbdParams->m_iterations = 2;
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(clothMesh);
+    pbdModel->configure(pbdParams);
+
+    auto clothObj = std::make_shared<PbdObject>("Cloth");
+    clothObj->setVisualGeometry(clothMesh);
+    clothObj->setCollidingGeometry(clothMesh);
+    clothObj->setPhysicsGeometry(clothMesh);
+    clothObj->setDynamicalModel(pbdModel);
+    return clothObj;
+}
+} // namespace
+
+///
+/// \brief Test the substeps of the pbd model only reuse the contacts of enabled,
+/// unculled and living interactions
+///
+TEST(imstkPbdObjectCollisionTest, SubstepCollisionSolverLifetime)
+{
+    auto scene = std::make_shared<Scene>("PbdObjectCollisionScene");
+
+    std::shared_ptr<PbdObject> clothObj = makeSubsteppedCloth();
+    scene->addSceneObject(clothObj);
+
+    auto planeObj = std::make_shared<CollidingObject>("Plane");
+    planeObj->setCollidingGeometry(std::make_shared<Plane>(Vec3d(0.0, -0.05, 0.0)));
+    scene->addSceneObject(planeObj);
+
+    auto interaction = std::make_shared<PbdObjectCollision>(clothObj, planeObj, "PointSetToPlaneCD");
+    scene->addInteraction(interaction);
+    scene->initialize();
+
+    std::shared_ptr<PbdModel> pbdModel = clothObj->getPbdModel();
+    EXPECT_EQ(pbdModel->getSubstepCollisionSolvers().size(), 1);
+
+    // Rest on the plane
+    for (int i = 0; i < 20; i++)
+    {
+        scene->advance(0.01);
+    }
+
+    interaction->setEnabled(false);
+    EXPECT_EQ(pbdModel->getSubstepCollisionSolvers().size(), 0);
+    interaction->setEnabled(true);
+    interaction->setEnabled(true);
+    EXPECT_EQ(pbdModel->getSubstepCollisionSolvers().size(), 1);
+
+    interaction->setCulled(true);
+    EXPECT_EQ(pbdModel->getSubstepCollisionSolvers().size(), 0);
+    interaction->setCulled(false);
+    EXPECT_EQ(pbdModel->getSubstepCollisionSolvers().size(), 1);
+
+    // Destroy the interaction, holding contacts, then keep stepping
+    scene->advance(0.01);
+    scene->removeSceneObject(interaction);
+    scene->buildTaskGraph();
+    scene->initTaskGraph();
+    interaction = nullptr;
+    EXPECT_EQ(pbdModel->getSubstepCollisionSolvers().size(), 0);
+    for (int i = 0; i < 5; i++)
+    {
+        scene->advance(0.01);
+    }
+
+    // Re-create it, the solvers do not stack
+    interaction = std::make_shared<PbdObjectCollision>(clothObj, planeObj, "PointSetToPlaneCD");
+    scene->addInteraction(interaction);
+    scene->buildTaskGraph();
+    scene->initTaskGraph();
+    EXPECT_EQ(pbdModel->getSubstepCollisionSolvers().size(), 1);
+    for (int i = 0; i < 5; i++)
+    {
+        scene->advance(0.01);
+    }
+}
+
+///
+/// \brief Test the self collision contacts of a mesh, a vertex poking through a non
+/// adjacent triangle of the same mesh, are solved by the pbd collision handling
+///
+TEST(imstkPbdObjectCollisionTest, SurfaceMeshSelfCollision)
+{
+    auto vertices = std::make_shared<VecDataArray<double, 3>>();
+    auto indices  = std::make_shared<VecDataArray<int, 3>>();
+    // Triangle in the xy plane, and a fan around a vertex below it, poking through it
+    for (const Vec3d& pos : { Vec3d(0.0, 0.0, 0.0), Vec3d(1.0, 0.0, 0.0), Vec3d(0.0, 1.0, 0.0),
+                              Vec3d(0.25, 0.25, -0.05), Vec3d(0.2, 0.3, 0.5), Vec3d(0.3, 0.2, 0.5), Vec3d(0.3, 0.3, 0.5) })
+    {
+        vertices->push_back(pos);
+    }
+    indices->push_back(Vec3i(0, 1, 2));
+    indices->push_back(Vec3i(3, 4, 5));
+    indices->push_back(Vec3i(3, 5, 6));
+    auto surfMesh = std::make_shared<SurfaceMesh>();
+    surfMesh->initialize(vertices, indices);
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+    pbdParams->m_uniformMassValue = 1.0;
+    pbdParams->m_gravity    = Vec3d::Zero();
+    pbdParams->m_dt         = 0.01;
+    pbdParams->m_iterations = 5;
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(surfMesh);
+    pbdModel->configure(pbdParams);
+
+    auto meshObj = std::make_shared<PbdObject>("Mesh");
+    meshObj->setVisualGeometry(surfMesh);
+    meshObj->setCollidingGeometry(surfMesh);
+    meshObj->setPhysicsGeometry(surfMesh);
+    meshObj->setDynamicalModel(pbdModel);
+
+    auto scene = std::make_shared<Scene>("SelfCollisionScene");
+    scene->addSceneObject(meshObj);
+    auto interaction = std::make_shared<PbdObjectCollision>(meshObj, meshObj, "SurfaceMeshSelfCD");
+    scene->addInteraction(interaction);
+    ASSERT_TRUE(scene->initialize());
+    ASSERT_LT((*vertices)[3][2], 0.0);
+
+    for (int i = 0; i < 10; i++)
+    {
+        scene->advance(0.01);
+    }
+
+    // Both sides are solved, the triangle is pushed down and the vertex up, until the
+    // vertex no longer penetrates the triangle
+    const VecDataArray<double, 3>& positions = *surfMesh->getVertexPositions();
+    const Vec3d                    normal    = (positions[1] - positions[0]).cross(positions[2] - positions[0]).normalized();
+    EXPECT_GT((positions[3] - positions[0]).dot(normal), -1.0e-8);
+    EXPECT_GT(positions[3][2], -0.05);
+    EXPECT_LT((positions[0][2] + positions[1][2] + positions[2][2]) / 3.0, 0.0);
+}
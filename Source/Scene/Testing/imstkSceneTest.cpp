@@ -8,9 +8,22 @@
 
 #include "imstkScene.h"
 #include "imstkCamera.h"
+#include "imstkDeviceControl.h"
 #include "imstkDirectionalLight.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdObject.h"
+#include "imstkPbdObjectGrasping.h"
+#include "imstkPbdRigidObjectCollision.h"
+#include "imstkRbdConstraint.h"
+#include "imstkRigidBodyModel2.h"
+#include "imstkRigidObject2.h"
+#include "imstkSceneSnapshot.h"
+#include "imstkSceneTestingUtils.h"
 #include "imstkSpotLight.h"
 #include "imstkSceneObject.h"
+#include "imstkSphere.h"
+#include "imstkSurfaceMesh.h"
 #include "imstkTaskGraph.h"
 
 using namespace imstk;
@@ -197,4 +210,241 @@ TEST(imstkSceneTest, add_same_name_scene_objects)
     EXPECT_EQ(m_scene.getSceneObject("TestObj_1"), obj2);
     EXPECT_EQ(obj2->getName(), "TestObj_1");
     EXPECT_EQ(m_scene.getSceneObjects().size(), 2);
-}
\ No newline at end of file
+}
+
+namespace
+{
+///
+/// \brief Cloth pinned at two corners, a rigid sphere thrown down onto it
+///
+std::shared_ptr<Scene>
+makeClothAndSphereScene()
+{
+    auto scene = std::make_shared<Scene>("ClothAndSphere");
+
+    std::shared_ptr<PbdObject> clothObj =
+        makePbdCloth("Cloth", GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(1.0, 1.0), Vec2i(8, 8)), 8);
+    scene->addSceneObject(clothObj);
+
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_gravity = Vec3d(0.0, -9.8, 0.0);
+
+    auto sphere    = std::make_shared<Sphere>(Vec3d::Zero(), 0.1);
+    auto sphereObj = std::make_shared<RigidObject2>("Sphere");
+    sphereObj->setVisualGeometry(sphere);
+    sphereObj->setCollidingGeometry(sphere);
+    sphereObj->setPhysicsGeometry(sphere);
+    sphereObj->setDynamicalModel(rbdModel);
+    sphereObj->getRigidBody()->m_mass    = 1.0;
+    sphereObj->getRigidBody()->m_initPos = Vec3d(0.0, 0.3, 0.0);
+    sphereObj->getRigidBody()->m_initVelocity = Vec3d(0.0, -2.0, 0.0);
+    scene->addSceneObject(sphereObj);
+
+    scene->addInteraction(std::make_shared<PbdRigidObjectCollision>(clothObj, sphereObj, "SurfaceMeshToSphereCD"));
+
+    return scene;
+}
+
+std::shared_ptr<SurfaceMesh>
+getClothMesh(std::shared_ptr<Scene> scene)
+{
+    return std::dynamic_pointer_cast<SurfaceMesh>(
+        std::dynamic_pointer_cast<PbdObject>(scene->getSceneObject("Cloth"))->getPhysicsGeometry());
+}
+
+std::shared_ptr<RigidBody>
+getSphereBody(std::shared_ptr<Scene> scene)
+{
+    return std::dynamic_pointer_cast<RigidObject2>(scene->getSceneObject("Sphere"))->getRigidBody();
+}
+} // namespace
+
+///
+/// \brief Test restoring a snapshot brings back the captured state and that the
+/// simulation continues from it as it did after capturing
+///
+TEST(imstkSceneTest, snapshot_restore)
+{
+    std::shared_ptr<Scene> scene = makeClothAndSphereScene();
+    ASSERT_TRUE(scene->initialize());
+    for (int i = 0; i < 10; i++)
+    {
+        scene->advance(0.01);
+    }
+
+    SceneSnapshot snapshot;
+    scene->captureSnapshot(snapshot);
+    EXPECT_FALSE(snapshot.isEmpty());
+    EXPECT_DOUBLE_EQ(snapshot.getSceneTime(), scene->getSceneTime());
+    const VecDataArray<double, 3> capturedVertices = *getClothMesh(scene)->getVertexPositions();
+    const Vec3d                   capturedSpherePos = getSphereBody(scene)->getPosition();
+
+    for (int i = 0; i < 10; i++)
+    {
+        scene->advance(0.01);
+    }
+    const VecDataArray<double, 3> advancedVertices = *getClothMesh(scene)->getVertexPositions();
+    const Vec3d                   advancedSpherePos = getSphereBody(scene)->getPosition();
+    const double                  advancedTime      = scene->getSceneTime();
+    EXPECT_FALSE(advancedSpherePos.isApprox(capturedSpherePos));
+
+    // The cloth caught the sphere, which is above where it would have fallen to
+    const double t = scene->getSceneTime();
+    EXPECT_GT(advancedSpherePos[1], 0.3 - 2.0 * t - 0.5 * 9.8 * t * t + 0.1);
+
+    // Restore the captured state
+    ASSERT_TRUE(scene->restoreSnapshot(snapshot));
+    EXPECT_DOUBLE_EQ(scene->getSceneTime(), snapshot.getSceneTime());
+    EXPECT_EQ(getSphereBody(scene)->getPosition(), capturedSpherePos);
+    const VecDataArray<double, 3>& vertices = *getClothMesh(scene)->getVertexPositions();
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        EXPECT_EQ(vertices[i], capturedVertices[i]);
+    }
+
+    // The same steps lead to the same state
+    for (int i = 0; i < 10; i++)
+    {
+        scene->advance(0.01);
+    }
+    EXPECT_DOUBLE_EQ(scene->getSceneTime(), advancedTime);
+    EXPECT_TRUE(getSphereBody(scene)->getPosition().isApprox(advancedSpherePos));
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        EXPECT_TRUE(vertices[i].isApprox(advancedVertices[i])) << vertices[i].transpose() << " vs " << advancedVertices[i].transpose();
+    }
+}
+
+///
+/// \brief Test a snapshot is not restored once the scene changed
+///
+TEST(imstkSceneTest, snapshot_restore_changed_scene)
+{
+    std::shared_ptr<Scene> scene = makeClothAndSphereScene();
+    ASSERT_TRUE(scene->initialize());
+
+    SceneSnapshot snapshot;
+    scene->captureSnapshot(snapshot);
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->m_uniformMassValue = 1.0;
+    auto pbdModel = std::make_shared<PbdModel>();
+    auto mesh     = GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(1.0, 1.0), Vec2i(4, 4));
+    pbdModel->setModelGeometry(mesh);
+    pbdModel->configure(pbdParams);
+    auto obj = std::make_shared<PbdObject>("Cloth2");
+    obj->setPhysicsGeometry(mesh);
+    obj->setDynamicalModel(pbdModel);
+    scene->addSceneObject(obj);
+    ASSERT_TRUE(obj->initialize());
+
+    EXPECT_FALSE(scene->restoreSnapshot(snapshot));
+}
+
+///
+/// \brief Test a snapshot is not restored once an array of the state was resized, after
+/// the buffers were reused by a first restore
+///
+TEST(imstkSceneTest, snapshot_restore_resized_array)
+{
+    std::shared_ptr<Scene> scene = makeClothAndSphereScene();
+    ASSERT_TRUE(scene->initialize());
+
+    SceneSnapshot snapshot;
+    scene->captureSnapshot(snapshot);
+    scene->advance(0.01);
+    ASSERT_TRUE(scene->restoreSnapshot(snapshot));
+
+    std::shared_ptr<VecDataArray<double, 3>> vertices = getClothMesh(scene)->getVertexPositions();
+    vertices->resize(vertices->size() + 1);
+    EXPECT_FALSE(scene->restoreSnapshot(snapshot));
+}
+
+///
+/// \brief Test the grasp constraints, added at runtime, are not part of a snapshot and
+/// stay in place when restoring it until the grasp ends
+///
+TEST(imstkSceneTest, snapshot_restore_keeps_grasp)
+{
+    std::shared_ptr<Scene> scene    = makeClothAndSphereScene();
+    auto                   clothObj = std::dynamic_pointer_cast<PbdObject>(scene->getSceneObject("Cloth"));
+    auto                   grasping = std::make_shared<PbdObjectGrasping>(clothObj);
+    scene->addInteraction(grasping);
+    ASSERT_TRUE(scene->initialize());
+
+    SceneSnapshot snapshot;
+    scene->captureSnapshot(snapshot);
+
+    // Grasp the free corner
+    const Vec3d corner = (*getClothMesh(scene)->getVertexPositions())[63];
+    grasping->beginVertexGrasp(std::make_shared<Sphere>(corner, 0.05));
+    scene->advance(0.01);
+    ASSERT_TRUE(grasping->hasConstraints());
+
+    ASSERT_TRUE(scene->restoreSnapshot(snapshot));
+    EXPECT_TRUE(grasping->hasConstraints());
+
+    grasping->endGrasp();
+    scene->advance(0.01);
+    EXPECT_FALSE(grasping->hasConstraints());
+}
+
+namespace
+{
+class TestControl : public DeviceControl
+{
+public:
+    TestControl(const std::string& name) : DeviceControl(name) { }
+
+    void update(const double dt) override { m_totalTime += dt; }
+
+    double m_totalTime = 0.0;
+};
+} // namespace
+
+///
+/// \brief Test the objects of a type are kept up to date as objects are added and removed
+///
+TEST(imstkSceneTest, typed_scene_objects)
+{
+    std::shared_ptr<Scene> scene      = makeClothAndSphereScene();
+    const size_t           numObjects = scene->getSceneObjects().size();
+    auto                   control    = std::make_shared<TestControl>("Control");
+    scene->addControl(control);
+    scene->addSceneObject(std::make_shared<SceneObject>("Static"));
+
+    EXPECT_EQ(scene->getSceneObjects().size(), numObjects + 2);
+    ASSERT_EQ(scene->getDynamicObjects().size(), 2);
+    EXPECT_EQ(scene->getDynamicObjects()[0]->getName(), "Cloth");
+    EXPECT_EQ(scene->getDynamicObjects()[1]->getName(), "Sphere");
+    EXPECT_EQ(scene->getFeDeformableObjects().size(), 0);
+    ASSERT_EQ(scene->getDeviceControls().size(), 1);
+    EXPECT_EQ(scene->getDeviceControls()[0], control);
+
+    // Real time models get the time step, controls are updated
+    std::shared_ptr<SceneObject>            clothObj    = scene->getSceneObject("Cloth");
+    std::shared_ptr<AbstractDynamicalModel> clothModel  = scene->getDynamicObjects()[0]->getDynamicalModel();
+    std::shared_ptr<AbstractDynamicalModel> sphereModel = scene->getDynamicObjects()[1]->getDynamicalModel();
+    clothModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+    sphereModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+    ASSERT_TRUE(scene->initialize());
+    EXPECT_EQ(scene->getDynamicalModels().size(), 2);
+    scene->advance(0.02);
+    scene->advance(0.02);
+    EXPECT_DOUBLE_EQ(sphereModel->getTimeStep(), 0.02);
+    EXPECT_DOUBLE_EQ(control->m_totalTime, 0.04);
+
+    scene->removeSceneObject("Cloth");
+    scene->removeSceneObject(control);
+    ASSERT_EQ(scene->getDynamicObjects().size(), 1);
+    EXPECT_EQ(scene->getDynamicObjects()[0]->getName(), "Sphere");
+    EXPECT_EQ(scene->getDeviceControls().size(), 0);
+
+    // The model of the removed object is no longer given the time step, even before the
+    // task graph is rebuilt (the object is kept alive as the old graph still refers to it)
+    ASSERT_EQ(scene->getDynamicalModels().size(), 1);
+    EXPECT_EQ(scene->getDynamicalModels()[0], sphereModel);
+    scene->advance(0.03);
+    EXPECT_DOUBLE_EQ(sphereModel->getTimeStep(), 0.03);
+    EXPECT_DOUBLE_EQ(clothModel->getTimeStep(), 0.02);
+}
@@ -0,0 +1,219 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCollisionBroadPhase.h"
+#include "imstkCapsule.h"
+#include "imstkCollidingObject.h"
+#include "imstkCollisionInteraction.h"
+#include "imstkCylinder.h"
+#include "imstkOrientedBox.h"
+#include "imstkPointSet.h"
+#include "imstkSphere.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace imstk
+{
+///
+/// \brief Returns true if the geometry has a finite bounding box that
+/// encloses everything it can collide with
+///
+static bool
+isBoundedGeometry(std::shared_ptr<Geometry> geom)
+{
+    return geom != nullptr && (
+        std::dynamic_pointer_cast<PointSet>(geom) != nullptr
+        || std::dynamic_pointer_cast<Sphere>(geom) != nullptr
+        || std::dynamic_pointer_cast<Capsule>(geom) != nullptr
+        || std::dynamic_pointer_cast<Cylinder>(geom) != nullptr
+        || std::dynamic_pointer_cast<OrientedBox>(geom) != nullptr);
+}
+
+void
+CollisionBroadPhase::setInteractions(const std::vector<std::shared_ptr<CollisionInteraction>>& interactions)
+{
+    clear();
+
+    m_interactions = interactions;
+    m_interactionObjectIds.clear();
+    m_objects.clear();
+    m_overlappingPairs.clear();
+    m_numCulledPairs      = 0;
+    m_totalNumCulledPairs = 0;
+    m_numUpdates = 0;
+
+    // Gather the unique objects, an object may take part in many interactions
+    std::unordered_map<CollidingObject*, int> objIds;
+    for (const auto& interaction : m_interactions)
+    {
+        int ids[2] = { -1, -1 };
+        std::shared_ptr<CollidingObject> objs[2] = { interaction->getObjectA(), interaction->getObjectB() };
+        for (int i = 0; i < 2; i++)
+        {
+            auto iter = objIds.find(objs[i].get());
+            if (iter != objIds.end())
+            {
+                ids[i] = iter->second;
+                continue;
+            }
+            ids[i] = static_cast<int>(m_objects.size());
+            objIds[objs[i].get()] = ids[i];
+
+            ObjectBounds bounds;
+            bounds.obj       = objs[i];
+            bounds.isBounded = isBoundedGeometry(objs[i]->getCollidingGeometry());
+            m_objects.push_back(bounds);
+        }
+        m_interactionObjectIds.push_back({ ids[0], ids[1] });
+    }
+
+    m_sortedIds.resize(m_objects.size());
+    for (int i = 0; i < static_cast<int>(m_sortedIds.size()); i++)
+    {
+        m_sortedIds[i] = i;
+    }
+    m_activeIds.reserve(m_objects.size());
+}
+
+void
+CollisionBroadPhase::update()
+{
+    if (m_interactions.empty())
+    {
+        return;
+    }
+
+    computeBounds();
+    sweep();
+
+    m_numCulledPairs = 0;
+    for (size_t i = 0; i < m_interactions.size(); i++)
+    {
+        const std::pair<int, int>& ids = m_interactionObjectIds[i];
+        const bool                 culled = (ids.first != ids.second)
+                                            && (m_overlappingPairs.count(getPairKey(ids.first, ids.second)) == 0);
+        m_interactions[i]->setCulled(culled);
+        if (culled)
+        {
+            m_numCulledPairs++;
+        }
+    }
+    m_totalNumCulledPairs += static_cast<size_t>(m_numCulledPairs);
+    m_numUpdates++;
+}
+
+void
+CollisionBroadPhase::clear()
+{
+    for (const auto& interaction : m_interactions)
+    {
+        interaction->setCulled(false);
+    }
+    for (auto& bounds : m_objects)
+    {
+        bounds.hasPrevBounds = false;
+    }
+    m_numCulledPairs = 0;
+}
+
+void
+CollisionBroadPhase::computeBounds()
+{
+    for (auto& bounds : m_objects)
+    {
+        if (!bounds.isBounded)
+        {
+            bounds.min = Vec3d::Constant(IMSTK_DOUBLE_MIN);
+            bounds.max = Vec3d::Constant(IMSTK_DOUBLE_MAX);
+            continue;
+        }
+
+        Vec3d min, max;
+        bounds.obj->getCollidingGeometry()->computeBoundingBox(min, max);
+
+        // Expect the box to move at most as much as it did the last frame
+        double margin = m_padding;
+        if (bounds.hasPrevBounds)
+        {
+            margin += std::max((min - bounds.prevMin).cwiseAbs().maxCoeff(),
+                (max - bounds.prevMax).cwiseAbs().maxCoeff());
+        }
+        bounds.prevMin       = min;
+        bounds.prevMax       = max;
+        bounds.hasPrevBounds = true;
+
+        bounds.min = min - Vec3d::Constant(margin);
+        bounds.max = max + Vec3d::Constant(margin);
+    }
+}
+
+void
+CollisionBroadPhase::sweep()
+{
+    m_overlappingPairs.clear();
+
+    // Sweep along the axis the bounded objects are most spread out on
+    Vec3d centerSum   = Vec3d::Zero();
+    Vec3d centerSqSum = Vec3d::Zero();
+    int   numBounded  = 0;
+    for (const auto& bounds : m_objects)
+    {
+        if (bounds.isBounded)
+        {
+            const Vec3d center = (bounds.min + bounds.max) * 0.5;
+            centerSum   += center;
+            centerSqSum += center.cwiseProduct(center);
+            numBounded++;
+        }
+    }
+    int axis = 0;
+    if (numBounded > 0)
+    {
+        const Vec3d mean = centerSum / numBounded;
+        (centerSqSum / numBounded - mean.cwiseProduct(mean)).maxCoeff(&axis);
+    }
+
+    // Objects barely move between frames so the previous order is nearly sorted,
+    // insertion sort is linear in that case
+    for (size_t i = 1; i < m_sortedIds.size(); i++)
+    {
+        const int    id  = m_sortedIds[i];
+        const double key = m_objects[id].min[axis];
+        size_t       j   = i;
+        while (j > 0 && m_objects[m_sortedIds[j - 1]].min[axis] > key)
+        {
+            m_sortedIds[j] = m_sortedIds[j - 1];
+            j--;
+        }
+        m_sortedIds[j] = id;
+    }
+
+    // Sweep, keeping a list of the objects whose interval contains the sweep position
+    m_activeIds.clear();
+    for (const int id : m_sortedIds)
+    {
+        const ObjectBounds& boundsA = m_objects[id];
+
+        // Remove the objects that ended before this one starts
+        m_activeIds.erase(std::remove_if(m_activeIds.begin(), m_activeIds.end(),
+            [&](const int activeId) { return m_objects[activeId].max[axis] < boundsA.min[axis]; }),
+            m_activeIds.end());
+
+        // Remaining intervals overlap along the axis, test the others
+        for (const int activeId : m_activeIds)
+        {
+            const ObjectBounds& boundsB = m_objects[activeId];
+            if ((boundsA.min.array() <= boundsB.max.array()).all()
+                && (boundsB.min.array() <= boundsA.max.array()).all())
+            {
+                m_overlappingPairs.insert(getPairKey(id, activeId));
+            }
+        }
+        m_activeIds.push_back(id);
+    }
+}
+} // namespace imstk
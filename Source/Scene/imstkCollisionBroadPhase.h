@@ -0,0 +1,131 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMath.h"
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+namespace imstk
+{
+class CollidingObject;
+class CollisionInteraction;
+
+///
+/// \class CollisionBroadPhase
+///
+/// \brief Scene wide broad phase over the CollidingObjects of a set of
+/// CollisionInteractions. Every update the axis aligned bounding boxes of the
+/// colliding geometries are computed, padded and swept along the axis of largest
+/// spread (sweep and prune). Interactions whose padded boxes do not overlap are
+/// culled for the frame, which disables their detection, handling and solve steps.
+///
+/// Boxes are padded by a user given distance plus the displacement of the box since
+/// the previous update, such that an object moving at constant speed is never culled
+/// the frame before it contacts another.
+/// Geometries without finite bounds (planes, implicit geometries, images) are never culled.
+///
+class CollisionBroadPhase
+{
+public:
+    CollisionBroadPhase() = default;
+    virtual ~CollisionBroadPhase() = default;
+
+public:
+    ///
+    /// \brief Set the interactions to cull, rebuilds the object list
+    ///
+    void setInteractions(const std::vector<std::shared_ptr<CollisionInteraction>>& interactions);
+    const std::vector<std::shared_ptr<CollisionInteraction>>& getInteractions() const { return m_interactions; }
+
+    ///
+    /// \brief Get/Set the absolute distance boxes are padded with before testing, default 0
+    ///@{
+    void setPadding(const double padding) { m_padding = padding; }
+    double getPadding() const { return m_padding; }
+    ///@}
+
+    ///
+    /// \brief Compute the bounds, sweep, and cull the interactions that cannot collide
+    ///
+    void update();
+
+    ///
+    /// \brief Uncull all interactions, ie: when the broad phase is turned off
+    ///
+    void clear();
+
+    ///
+    /// \brief Number of interaction pairs considered by the broad phase
+    ///
+    int getNumPairs() const { return static_cast<int>(m_interactions.size()); }
+
+    ///
+    /// \brief Number of interaction pairs culled in the last update
+    ///
+    int getNumCulledPairs() const { return m_numCulledPairs; }
+
+    ///
+    /// \brief Number of object pairs whose padded boxes overlapped in the last update
+    ///
+    int getNumOverlappingObjectPairs() const { return static_cast<int>(m_overlappingPairs.size()); }
+
+    ///
+    /// \brief Sum of culled pairs over all updates since the interactions were set
+    ///
+    size_t getTotalNumCulledPairs() const { return m_totalNumCulledPairs; }
+
+    ///
+    /// \brief Number of updates since the interactions were set
+    ///
+    size_t getNumUpdates() const { return m_numUpdates; }
+
+protected:
+    ///
+    /// \brief Computes the padded bounds of every object
+    ///
+    void computeBounds();
+
+    ///
+    /// \brief Sorts the objects along the axis of largest spread and
+    /// gathers all overlapping pairs
+    ///
+    void sweep();
+
+    static size_t getPairKey(const int i, const int j)
+    {
+        return (i < j) ?
+               (static_cast<size_t>(i) << 32) | static_cast<size_t>(j) :
+               (static_cast<size_t>(j) << 32) | static_cast<size_t>(i);
+    }
+
+    struct ObjectBounds
+    {
+        std::shared_ptr<CollidingObject> obj = nullptr;
+        bool isBounded = true;   ///< False for geometries that have no finite box
+        bool hasPrevBounds = false;
+        Vec3d min = Vec3d::Zero(); ///< Padded lower corner
+        Vec3d max = Vec3d::Zero(); ///< Padded upper corner
+        Vec3d prevMin = Vec3d::Zero();
+        Vec3d prevMax = Vec3d::Zero();
+    };
+
+    std::vector<std::shared_ptr<CollisionInteraction>> m_interactions;
+    std::vector<std::pair<int, int>> m_interactionObjectIds; ///< Index of object A and B per interaction
+    std::vector<ObjectBounds>        m_objects;
+    std::vector<int> m_sortedIds;      ///< Objects ordered by lower bound along the sweep axis
+    std::vector<int> m_activeIds;      ///< Objects currently spanning the sweep position
+    std::unordered_set<size_t> m_overlappingPairs;
+
+    double m_padding = 0.0;
+    int    m_numCulledPairs      = 0;
+    size_t m_totalNumCulledPairs = 0;
+    size_t m_numUpdates = 0;
+};
+} // namespace imstk
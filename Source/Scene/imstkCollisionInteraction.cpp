@@ -4,9 +4,11 @@
 ** See accompanying NOTICE for details.
 */
 
+#include "imstkCCDAlgorithm.h"
 #include "imstkCDObjectFactory.h"
 #include "imstkCollisionInteraction.h"
 #include "imstkCollidingObject.h"
+#include "imstkCollisionData.h"
 #include "imstkCollisionDetectionAlgorithm.h"
 #include "imstkCollisionHandling.h"
 #include "imstkTaskGraph.h"
@@ -37,6 +39,10 @@ CollisionInteraction::CollisionInteraction(
         objA->getName() + "_vs_" + objB->getName() + "_CollisionGeometryUpdate", true);
     m_taskGraph->addNode(m_collisionGeometryUpdateNode);
 
+    addCulledNode(m_collisionDetectionNode);
+    addCulledNode(m_collisionHandleANode);
+    addCulledNode(m_collisionHandleBNode);
+
     // Get default cdType if one not provided
     if (cdType.empty())
     {
@@ -120,12 +126,27 @@ CollisionInteraction::updateCollisionGeometry()
 void
 CollisionInteraction::setEnabled(const bool enabled)
 {
-    m_collisionDetectionNode->setEnabled(enabled);
+    m_enabled = enabled;
+    if (m_culled)
+    {
+        // Applied when unculled
+        for (auto& culledNode : m_culledNodes)
+        {
+            if (culledNode.first == m_collisionDetectionNode)
+            {
+                culledNode.second = enabled;
+            }
+        }
+    }
+    else
+    {
+        m_collisionDetectionNode->setEnabled(enabled);
+    }
     if (m_colDetect != nullptr)
     {
         // Clear the data (since CD clear is only run before CD is performed)
         m_colDetect->getCollisionData()->elementsA.resize(0);
-        m_colDetect->getCollisionData()->elementsA.resize(0);
+        m_colDetect->getCollisionData()->elementsB.resize(0);
     }
     else
     {
@@ -136,6 +157,52 @@ CollisionInteraction::setEnabled(const bool enabled)
 bool
 CollisionInteraction::getEnabled() const
 {
-    return m_collisionDetectionNode->m_enabled;
+    return m_enabled;
+}
+
+void
+CollisionInteraction::setCulled(const bool culled)
+{
+    if (m_culled == culled)
+    {
+        return;
+    }
+    m_culled = culled;
+
+    // Only the culling is undone, nodes disabled before stay disabled
+    for (auto& culledNode : m_culledNodes)
+    {
+        if (m_culled)
+        {
+            culledNode.second = culledNode.first->m_enabled;
+            culledNode.first->setEnabled(false);
+        }
+        else
+        {
+            culledNode.first->setEnabled(culledNode.second);
+        }
+    }
+
+    if (m_colDetect == nullptr)
+    {
+        return;
+    }
+    if (m_culled)
+    {
+        // Don't leave stale contacts around for anything reading the data
+        m_colDetect->getCollisionData()->elementsA.resize(0);
+        m_colDetect->getCollisionData()->elementsB.resize(0);
+    }
+    else if (auto ccd = std::dynamic_pointer_cast<CCDAlgorithm>(m_colDetect))
+    {
+        // The previous geometry was not tracked while culled, sweep from the current state
+        ccd->updatePreviousTimestepGeometry(ccd->getInput(0), ccd->getInput(1));
+    }
+}
+
+void
+CollisionInteraction::addCulledNode(std::shared_ptr<TaskNode> node)
+{
+    m_culledNodes.push_back(std::pair<std::shared_ptr<TaskNode>, bool>(node, node->m_enabled));
 }
-} // namespace imstk
\ No newline at end of file
+} // namespace imstk
@@ -58,6 +58,9 @@ public:
     std::shared_ptr<TaskNode> getCollisionHandlingANode() const { return m_collisionHandleANode; }
     std::shared_ptr<TaskNode> getCollisionHandlingBNode() const { return m_collisionHandleBNode; }
 
+    std::shared_ptr<CollidingObject> getObjectA() const { return m_objA; }
+    std::shared_ptr<CollidingObject> getObjectB() const { return m_objB; }
+
     void updateCollisionGeometry();
 
     ///
@@ -67,6 +70,16 @@ public:
     virtual bool getEnabled() const;
 ///@}
 
+    ///
+    /// \brief Cull or uncull the interaction for the coming frame. A culled interaction skips
+    /// detection, handling and the response steps, used by the scene broad phase when the objects
+    /// cannot touch. Independent of setEnabled, unculling gives the nodes back the enabled
+    /// state they had when culled
+    ///@{
+    virtual void setCulled(const bool culled);
+    bool getCulled() const { return m_culled; }
+///@}
+
 protected:
     ///
     /// \brief Update collision
@@ -94,5 +107,14 @@ protected:
     std::shared_ptr<TaskNode> m_collisionHandleANode        = nullptr;
     std::shared_ptr<TaskNode> m_collisionHandleBNode        = nullptr;
     std::shared_ptr<TaskNode> m_collisionGeometryUpdateNode = nullptr;
+
+    ///
+    /// \brief Disable a node while the interaction is culled
+    ///
+    void addCulledNode(std::shared_ptr<TaskNode> node);
+
+    bool m_enabled = true;
+    bool m_culled  = false;
+    std::vector<std::pair<std::shared_ptr<TaskNode>, bool>> m_culledNodes; ///< Nodes disabled while culled, with the enabled state to restore
 };
 } // namespace imstk
\ No newline at end of file
@@ -66,6 +66,10 @@ PbdObjectCollision::PbdObjectCollision(std::shared_ptr<PbdObject> obj1, std::sha
         obj1->getName() + "_vs_" + obj2->getName() + "_VelocityCorrect", true);
     m_taskGraph->addNode(m_correctVelocitiesNode);
 
+    // Also skipped when culled
+    addCulledNode(m_collisionSolveNode);
+    addCulledNode(m_correctVelocitiesNode);
+
     if (auto pbdObj2 = std::dynamic_pointer_cast<PbdObject>(obj2))
     {
         std::shared_ptr<PbdModel> pbdModel2 = pbdObj2->getPbdModel();
@@ -78,6 +82,10 @@ PbdObjectCollision::PbdObjectCollision(std::shared_ptr<PbdObject> obj1, std::sha
     {
         m_taskGraph->addNode(obj2->getUpdateGeometryNode());
         m_taskGraph->addNode(obj2->getTaskGraph()->getSink());
+
+        // The contacts only move pbdModel1 so its substeps may reuse them
+        m_substepCollisionSolver = ch->getCollisionSolver();
+        pbdModel1->addSubstepCollisionSolver(m_substepCollisionSolver);
     }
 
     m_taskGraph->addNode(pbdModel1->getIntegratePositionNode());
@@ -86,6 +94,15 @@ PbdObjectCollision::PbdObjectCollision(std::shared_ptr<PbdObject> obj1, std::sha
     m_taskGraph->addNode(pbdModel1->getTaskGraph()->getSink());
 }
 
+PbdObjectCollision::~PbdObjectCollision()
+{
+    // The model must not solve the constraints of the handler once it is gone
+    if (m_substepCollisionSolver != nullptr)
+    {
+        std::dynamic_pointer_cast<PbdObject>(m_objA)->getPbdModel()->removeSubstepCollisionSolver(m_substepCollisionSolver);
+    }
+}
+
 void
 PbdObjectCollision::setRestitution(const double restitution)
 {
@@ -110,6 +127,44 @@ PbdObjectCollision::getFriction() const
     return std::dynamic_pointer_cast<PbdCollisionHandling>(getCollisionHandlingA())->getFriction();
 }
 
+void
+PbdObjectCollision::setEnabled(const bool enabled)
+{
+    CollisionInteraction::setEnabled(enabled);
+    updateSubstepCollisionSolver();
+}
+
+void
+PbdObjectCollision::setCulled(const bool culled)
+{
+    CollisionInteraction::setCulled(culled);
+    if (culled)
+    {
+        std::dynamic_pointer_cast<PbdCollisionHandling>(getCollisionHandlingAB())->getCollisionSolver()->clearLastCollisionConstraints();
+    }
+    updateSubstepCollisionSolver();
+}
+
+void
+PbdObjectCollision::updateSubstepCollisionSolver()
+{
+    if (m_substepCollisionSolver == nullptr)
+    {
+        return;
+    }
+
+    std::shared_ptr<PbdModel> pbdModel = std::dynamic_pointer_cast<PbdObject>(m_objA)->getPbdModel();
+    if (getEnabled() && !getCulled())
+    {
+        pbdModel->addSubstepCollisionSolver(m_substepCollisionSolver);
+    }
+    else
+    {
+        pbdModel->removeSubstepCollisionSolver(m_substepCollisionSolver);
+        m_substepCollisionSolver->clearLastCollisionConstraints();
+    }
+}
+
 void
 PbdObjectCollision::initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink)
 {
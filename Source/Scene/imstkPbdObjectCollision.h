@@ -11,6 +11,7 @@
 
 namespace imstk
 {
+class PbdCollisionSolver;
 class PbdObject;
 
 ///
@@ -28,7 +29,7 @@ public:
     PbdObjectCollision(std::shared_ptr<PbdObject> obj1, std::shared_ptr<CollidingObject> obj2,
                        std::string cdType = "");
 
-    ~PbdObjectCollision() override = default;
+    ~PbdObjectCollision() override;
 
     IMSTK_TYPE_NAME(PbdObjectCollision)
 
@@ -38,12 +39,30 @@ public:
     void setFriction(const double friction);
     const double getFriction() const;
 
+    ///
+    /// \brief Also stops reusing the contacts in the substeps of the pbd model when disabled
+    ///
+    void setEnabled(const bool enabled) override;
+
+    ///
+    /// \brief Also stops reusing the contacts in the substeps of the pbd model when culled
+    ///
+    void setCulled(const bool culled) override;
+
     ///
     /// \brief Setup connectivity of task graph
     ///
     void initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink) override;
 
 protected:
+    ///
+    /// \brief Add the collision solver to the substeps of the pbd model while the
+    /// interaction is enabled and not culled, remove it otherwise
+    ///
+    void updateSubstepCollisionSolver();
+
+    std::shared_ptr<PbdCollisionSolver> m_substepCollisionSolver = nullptr; ///< Solver reused in the substeps, null when both objects are pbd
+
     // Steps introduced in interaction
     std::shared_ptr<TaskNode> m_collisionSolveNode    = nullptr;
     std::shared_ptr<TaskNode> m_correctVelocitiesNode = nullptr;
@@ -54,6 +54,10 @@ PbdRigidObjectCollision::PbdRigidObjectCollision(std::shared_ptr<PbdObject> obj1
         obj1->getName() + "_vs_" + obj2->getName() + "_PBDVelocityCorrect", true);
     m_taskGraph->addNode(m_correctVelocitiesNode);
 
+    // Also skipped when culled
+    addCulledNode(m_pbdCollisionSolveNode);
+    addCulledNode(m_correctVelocitiesNode);
+
     // Nodes from objectA
     auto pbdObj = std::dynamic_pointer_cast<PbdObject>(m_objA);
     m_taskGraph->addNode(pbdObj->getPbdModel()->getTaskGraph()->getSource());
@@ -7,14 +7,18 @@
 #include "imstkScene.h"
 #include "imstkCamera.h"
 #include "imstkCameraController.h"
+#include "imstkCollisionBroadPhase.h"
+#include "imstkCollisionInteraction.h"
 #include "imstkCollisionDetectionAlgorithm.h"
 #include "imstkFeDeformableObject.h"
 #include "imstkFemDeformableBodyModel.h"
 #include "imstkLight.h"
 #include "imstkLogger.h"
 #include "imstkParallelUtils.h"
+#include "imstkSceneSnapshot.h"
 
 #include "imstkSequentialTaskGraphController.h"
+#include "imstkStateBuffers.h"
 #include "imstkTaskGraph.h"
 #include "imstkTaskGraphVizWriter.h"
 #include "imstkTbbTaskGraphController.h"
@@ -22,13 +26,36 @@
 #include "imstkTrackingDeviceControl.h"
 #include "imstkVisualModel.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace imstk
 {
+namespace
+{
+///
+/// \brief Erase the object from the list of objects of a type, if in it
+///
+template<typename T>
+void
+eraseObject(std::vector<std::shared_ptr<T>>& objects, const SceneObject* obj)
+{
+    auto iter = std::find_if(objects.begin(), objects.end(),
+        [obj](const std::shared_ptr<T>& i) { return static_cast<const SceneObject*>(i.get()) == obj; });
+    if (iter != objects.end())
+    {
+        objects.erase(iter);
+    }
+}
+} // namespace
+
 Scene::Scene(const std::string& name, std::shared_ptr<SceneConfig> config) :
     m_config(config),
     m_name(name),
     m_activeCamera(nullptr),
     m_taskGraph(std::make_shared<TaskGraph>("Scene_" + name + "_Source", "Scene_" + name + "_Sink")),
+    m_collisionBroadPhase(std::make_shared<CollisionBroadPhase>()),
+    m_stateBuffers(std::make_shared<StateBuffers>()),
     m_computeTimesLock(std::make_shared<ParallelUtils::SpinLock>())
 {
     auto defaultCam = std::make_shared<Camera>();
@@ -51,12 +78,13 @@ Scene::initialize()
     for (const auto& obj : m_sceneObjects)
     {
         CHECK(obj->initialize()) << "Error initializing scene object: " << obj->getName();
+    }
+    m_stateBuffersGathered = false;
 
-        // Print any controls
-        if (auto deviceObj = std::dynamic_pointer_cast<DeviceControl>(obj))
-        {
-            deviceObj->printControls();
-        }
+    // Print any controls
+    for (const auto& control : m_deviceControls)
+    {
+        control->printControls();
     }
 
     // Build the compute graph
@@ -149,12 +177,42 @@ Scene::buildTaskGraph()
 
     // Remove any possible unused nodes
     m_taskGraph = TaskGraph::removeUnusedNodes(m_taskGraph);
+
+    // Gather the models the time step is given to, models may be shared by objects
+    m_dynamicalModels.clear();
+    std::unordered_set<std::shared_ptr<AbstractDynamicalModel>> models;
+    for (const auto& dynaObj : m_dynamicObjects)
+    {
+        std::shared_ptr<AbstractDynamicalModel> model = dynaObj->getDynamicalModel();
+        if (model != nullptr && models.insert(model).second)
+        {
+            m_dynamicalModels.push_back(model);
+        }
+    }
+
+    // Gather the interactions for the broad phase
+    std::vector<std::shared_ptr<CollisionInteraction>> interactions;
+    for (const auto& obj : m_sceneObjects)
+    {
+        if (auto interaction = std::dynamic_pointer_cast<CollisionInteraction>(obj))
+        {
+            interactions.push_back(interaction);
+        }
+    }
+    m_collisionBroadPhase->setInteractions(interactions);
 }
 
 void
 Scene::initTaskGraph()
 {
-    m_taskGraphController = std::make_shared<SequentialTaskGraphController>();
+    if (m_config->taskParallelizationEnabled)
+    {
+        m_taskGraphController = std::make_shared<TbbTaskGraphController>();
+    }
+    else
+    {
+        m_taskGraphController = std::make_shared<SequentialTaskGraphController>();
+    }
 
     if (TaskGraph::isCyclic(m_taskGraph))
     {
@@ -241,6 +299,19 @@ Scene::addSceneObject(std::shared_ptr<SceneObject> newSceneObject)
     }
 
     m_sceneObjects.insert(newSceneObject);
+    m_stateBuffersGathered = false;
+    if (auto dynaObj = std::dynamic_pointer_cast<DynamicObject>(newSceneObject))
+    {
+        m_dynamicObjects.push_back(dynaObj);
+    }
+    if (auto defObj = std::dynamic_pointer_cast<FeDeformableObject>(newSceneObject))
+    {
+        m_feDeformableObjects.push_back(defObj);
+    }
+    if (auto control = std::dynamic_pointer_cast<DeviceControl>(newSceneObject))
+    {
+        m_deviceControls.push_back(control);
+    }
     this->postEvent(Event(modified()));
     LOG(INFO) << uniqueName << " object added to " << m_name << " scene";
 }
@@ -264,6 +335,21 @@ Scene::removeSceneObject(std::shared_ptr<SceneObject> sceneObject)
     if (m_sceneObjects.count(sceneObject) != 0)
     {
         m_sceneObjects.erase(sceneObject);
+        m_stateBuffersGathered = false;
+        eraseObject(m_dynamicObjects, sceneObject.get());
+        if (auto dynaObj = std::dynamic_pointer_cast<DynamicObject>(sceneObject))
+        {
+            // Stop stepping the model, unless another object of the scene shares it
+            std::shared_ptr<AbstractDynamicalModel> model = dynaObj->getDynamicalModel();
+            if (std::none_of(m_dynamicObjects.begin(), m_dynamicObjects.end(),
+                [&model](const std::shared_ptr<DynamicObject>& i) { return i->getDynamicalModel() == model; }))
+            {
+                m_dynamicalModels.erase(std::remove(m_dynamicalModels.begin(), m_dynamicalModels.end(), model),
+                    m_dynamicalModels.end());
+            }
+        }
+        eraseObject(m_feDeformableObjects, sceneObject.get());
+        eraseObject(m_deviceControls, sceneObject.get());
         this->postEvent(Event(modified()));
         LOG(INFO) << sceneObject->getName() << " object removed from scene " << m_name;
     }
@@ -434,40 +520,124 @@ Scene::resetSceneObjects()
     }
 }
 
+void
+Scene::gatherStateBuffers()
+{
+    // Objects are visited in the order of their names, which are unique, such that the
+    // buffers are gathered in the same order on capture and restore
+    std::vector<std::shared_ptr<SceneObject>> sceneObjects(m_sceneObjects.begin(), m_sceneObjects.end());
+    std::sort(sceneObjects.begin(), sceneObjects.end(),
+        [](const std::shared_ptr<SceneObject>& a, const std::shared_ptr<SceneObject>& b)
+        {
+            return a->getName() < b->getName();
+        });
+
+    m_stateBuffers->clear();
+    for (const auto& obj : sceneObjects)
+    {
+        obj->getStateBuffers(*m_stateBuffers);
+    }
+    m_stateBuffersGathered = true;
+}
+
+void
+Scene::captureSnapshot(SceneSnapshot& snapshot)
+{
+    gatherStateBuffers();
+
+    const std::vector<StateBuffers::Buffer>& buffers = m_stateBuffers->getBuffers();
+    snapshot.m_data.resize(m_stateBuffers->getNumBytes());
+    snapshot.m_bufferSizes.resize(buffers.size());
+    char* data = snapshot.m_data.data();
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        std::memcpy(data, buffers[i].data, buffers[i].numBytes);
+        snapshot.m_bufferSizes[i] = buffers[i].numBytes;
+        data += buffers[i].numBytes;
+    }
+    snapshot.m_sceneTime = m_sceneTime;
+}
+
+bool
+Scene::restoreSnapshot(const SceneSnapshot& snapshot)
+{
+    // Reuse the buffers of the last gather until objects are added, removed or initialized,
+    // or an array they point into was reallocated (ie: a cut mesh)
+    if (!m_stateBuffersGathered || m_stateBuffers->isStale())
+    {
+        gatherStateBuffers();
+    }
+
+    const std::vector<StateBuffers::Buffer>& buffers = m_stateBuffers->getBuffers();
+    if (buffers.size() != snapshot.m_bufferSizes.size())
+    {
+        LOG(WARNING) << "Scene " << m_name << " cannot restore snapshot, captured " << snapshot.m_bufferSizes.size()
+                     << " buffers but the scene has " << buffers.size();
+        return false;
+    }
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        if (buffers[i].numBytes != snapshot.m_bufferSizes[i])
+        {
+            LOG(WARNING) << "Scene " << m_name << " cannot restore snapshot, size of buffer " << i << " changed from "
+                         << snapshot.m_bufferSizes[i] << " to " << buffers[i].numBytes << " bytes";
+            return false;
+        }
+    }
+
+    const char* data = snapshot.m_data.data();
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        std::memcpy(buffers[i].data, data, buffers[i].numBytes);
+        data += buffers[i].numBytes;
+    }
+    for (const auto& callback : m_stateBuffers->getRestoreCallbacks())
+    {
+        callback();
+    }
+    m_sceneTime = snapshot.m_sceneTime;
+    return true;
+}
+
 void
 Scene::advance(const double dt)
 {
     StopWatch wwt;
     wwt.start();
 
-    for (auto obj : this->getSceneObjects())
-    {
-        if (auto dynaObj = std::dynamic_pointer_cast<DynamicObject>(obj))
+    // Give the time step to the real time models
+    ParallelUtils::parallelFor(m_dynamicalModels.size(),
+        [&](const size_t i)
         {
-            if (dynaObj->getDynamicalModel()->getTimeStepSizeType() == TimeSteppingType::RealTime)
+            if (m_dynamicalModels[i]->getTimeStepSizeType() == TimeSteppingType::RealTime)
             {
-                dynaObj->getDynamicalModel()->setTimeStep(dt);
+                m_dynamicalModels[i]->setTimeStep(dt);
             }
-        }
-    }
+        }, m_config->taskParallelizationEnabled);
 
     // Reset Contact forces to 0
-    for (auto obj : this->getSceneObjects())
-    {
-        if (auto defObj = std::dynamic_pointer_cast<FeDeformableObject>(obj))
+    ParallelUtils::parallelFor(m_feDeformableObjects.size(),
+        [&](const size_t i)
         {
-            defObj->getFEMModel()->getContactForce().setConstant(0.0);
-        }
-    }
+            m_feDeformableObjects[i]->getFEMModel()->getContactForce().setConstant(0.0);
+        }, m_config->taskParallelizationEnabled);
 
     // Process all inputs (haptics, keyboard, mouse, VR control)
     // before updating the scene
-    for (auto obj : this->getSceneObjects())
-    {
-        if (auto controlObj = std::dynamic_pointer_cast<DeviceControl>(obj))
+    ParallelUtils::parallelFor(m_deviceControls.size(),
+        [&](const size_t i)
         {
-            controlObj->update(dt);
-        }
+            m_deviceControls[i]->update(dt);
+        }, m_config->controlParallelizationEnabled);
+
+    // Cull the collision interactions whose objects are too far apart to touch
+    if (m_config->collisionBroadPhaseEnabled)
+    {
+        m_collisionBroadPhase->update();
+    }
+    else if (m_collisionBroadPhase->getNumCulledPairs() > 0)
+    {
+        m_collisionBroadPhase->clear();
     }
 
     // Execute the computational graph
@@ -18,12 +18,18 @@
 
 namespace imstk
 {
+class AbstractDynamicalModel;
 class Camera;
 class CameraController;
+class CollisionBroadPhase;
 class DeviceControl;
+class DynamicObject;
+class FeDeformableObject;
 class IblProbe;
 class Light;
 class SceneObject;
+class SceneSnapshot;
+class StateBuffers;
 class TaskGraph;
 class TaskGraphController;
 class TrackingDeviceControl;
@@ -49,6 +55,13 @@ struct SceneConfig
 
     // If on, debug camera is positioned at scene bounding box
     bool debugCamBoundingBox = true;
+
+    // If on, collision interactions whose objects' bounds don't overlap are skipped each frame
+    bool collisionBroadPhaseEnabled = false;
+
+    // If on, device controls are updated in parallel at the start of every frame, only
+    // enable when no two controls act on the same object
+    bool controlParallelizationEnabled = false;
 };
 
 ///
@@ -104,6 +117,24 @@ public:
     ///
     void resetSceneObjects();
 
+    ///
+    /// \brief Capture the dynamic state of the scene objects (model states, masses, vertices
+    /// and transforms of their geometries) and the scene time into the snapshot. The
+    /// memory of the snapshot is reused when capturing into it again
+    ///
+    void captureSnapshot(SceneSnapshot& snapshot);
+
+    ///
+    /// \brief Write the state captured in the snapshot back into the scene objects, a
+    /// cheaper alternative to resetSceneObjects when resetting often to the same state.
+    /// The buffers of the last capture are reused, such that restoring is a copy of the
+    /// snapshot. Returns false and leaves the scene untouched if the scene objects, or
+    /// the size of their states, changed since capturing (ie: objects added, meshes cut).
+    /// Constraints added at runtime by grasping and stitching are not part of the
+    /// snapshot, they stay as they are, end the grasp or stitch before restoring
+    ///
+    bool restoreSnapshot(const SceneSnapshot& snapshot);
+
     ///
     /// \brief Advance the scene from current to next frame with specified timestep
     ///
@@ -125,6 +156,21 @@ public:
     ///
     const std::unordered_set<std::shared_ptr<SceneObject>>& getSceneObjects() const { return m_sceneObjects; }
 
+    ///
+    /// \brief Get the SceneObjects of the scene of a type, in the order they were added.
+    /// Kept up to date as objects are added and removed
+    ///@{
+    const std::vector<std::shared_ptr<DynamicObject>>& getDynamicObjects() const { return m_dynamicObjects; }
+    const std::vector<std::shared_ptr<FeDeformableObject>>& getFeDeformableObjects() const { return m_feDeformableObjects; }
+    const std::vector<std::shared_ptr<DeviceControl>>& getDeviceControls() const { return m_deviceControls; }
+    ///@}
+
+    ///
+    /// \brief Get the models of the DynamicObjects the scene steps, once each. Gathered
+    /// on task graph build, models of removed objects are dropped on removal
+    ///
+    const std::vector<std::shared_ptr<AbstractDynamicalModel>>& getDynamicalModels() const { return m_dynamicalModels; }
+
     ///
     /// \brief Get SceneObject by name, returns nullptr if doesn't exist
     ///
@@ -257,16 +303,33 @@ public:
     void unlockComputeTimes();
     ///@}
 
+    ///
+    /// \brief Get the broad phase that culls the collision interactions
+    /// of the scene, see SceneConfig::collisionBroadPhaseEnabled
+    ///
+    std::shared_ptr<CollisionBroadPhase> getCollisionBroadPhase() const { return m_collisionBroadPhase; }
+
     ///
     /// \brief Get the configuration
     ///
     std::shared_ptr<SceneConfig> getConfig() const { return m_config; };
 
 protected:
+    ///
+    /// \brief Gather the state buffers of the scene objects, see captureSnapshot
+    ///
+    void gatherStateBuffers();
+
     std::shared_ptr<SceneConfig> m_config;
 
     std::string m_name; ///< Name of the scene
     std::unordered_set<std::shared_ptr<SceneObject>> m_sceneObjects;
+
+    // SceneObjects by type, such that per frame dispatch needs no casts
+    std::vector<std::shared_ptr<DynamicObject>>      m_dynamicObjects;
+    std::vector<std::shared_ptr<FeDeformableObject>> m_feDeformableObjects;
+    std::vector<std::shared_ptr<DeviceControl>>      m_deviceControls;
+    std::vector<std::shared_ptr<AbstractDynamicalModel>> m_dynamicalModels; ///< Models of the DynamicObjects, once each, gathered on task graph build, pruned on removal
     std::unordered_map<std::string, std::shared_ptr<Light>> m_lightsMap;
     std::shared_ptr<IblProbe> m_globalIBLProbe = nullptr;
 
@@ -277,6 +340,11 @@ protected:
     std::shared_ptr<TaskGraphController> m_taskGraphController   = nullptr;    ///< Controller for the computational graph
     std::function<void(Scene*)> m_postTaskGraphConfigureCallback = nullptr;
 
+    std::shared_ptr<CollisionBroadPhase> m_collisionBroadPhase; ///< Culls interactions that cannot collide
+
+    std::shared_ptr<StateBuffers> m_stateBuffers; ///< Gathered on snapshot capture, reused by restore
+    bool m_stateBuffersGathered = false;          ///< False once objects are added, removed or initialized
+
     std::shared_ptr<ParallelUtils::SpinLock> m_computeTimesLock;
     std::unordered_map<std::string, double>  m_nodeComputeTimes; ///< Map of ComputeNode names to elapsed times for benchmarking
 
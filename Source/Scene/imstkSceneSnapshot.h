@@ -0,0 +1,52 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include <vector>
+
+namespace imstk
+{
+///
+/// \class SceneSnapshot
+///
+/// \brief The dynamic state of a scene at some time, captured by Scene::captureSnapshot
+/// in one contiguous block and written back by Scene::restoreSnapshot. A snapshot may
+/// only be restored into the scene it was captured from, as long as the scene objects
+/// and the sizes of their meshes and states did not change. The constraints of grasps
+/// and stitches made at runtime are not captured
+///
+class SceneSnapshot
+{
+friend class Scene;
+
+public:
+    ///
+    /// \brief Get the size of the captured state in bytes
+    ///
+    size_t getNumBytes() const { return m_data.size(); }
+
+    ///
+    /// \brief Get the number of memory buffers captured
+    ///
+    size_t getNumBuffers() const { return m_bufferSizes.size(); }
+
+    ///
+    /// \brief Get the time of the scene when it was captured
+    ///
+    double getSceneTime() const { return m_sceneTime; }
+
+    ///
+    /// \brief Returns true if nothing was captured
+    ///
+    bool isEmpty() const { return m_bufferSizes.empty(); }
+
+protected:
+    std::vector<char>   m_data;        ///< Every buffer, one after the other
+    std::vector<size_t> m_bufferSizes; ///< Size of every buffer in bytes, to check the restore
+    double m_sceneTime = 0.0;
+};
+} // namespace imstk
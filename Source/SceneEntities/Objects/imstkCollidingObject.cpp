@@ -8,6 +8,7 @@
 #include "imstkCDObjectFactory.h"
 #include "imstkGeometry.h"
 #include "imstkGeometryMap.h"
+#include "imstkStateBuffers.h"
 
 namespace imstk
 {
@@ -62,6 +63,16 @@ CollidingObject::updateGeometries()
     SceneObject::updateGeometries();
 }
 
+void
+CollidingObject::getStateBuffers(StateBuffers& buffers)
+{
+    SceneObject::getStateBuffers(buffers);
+    if (m_collidingGeometry != nullptr)
+    {
+        m_collidingGeometry->getStateBuffers(buffers);
+    }
+}
+
 std::string
 getCDType(const CollidingObject& obj1, const CollidingObject& obj2)
 {
@@ -52,6 +52,11 @@ public:
     ///
     bool initialize() override;
 
+    ///
+    /// \brief Adds the colliding geometry to the visual geometries
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
 protected:
     std::shared_ptr<Geometry>    m_collidingGeometry    = nullptr; ///< Geometry for collisions
     std::shared_ptr<GeometryMap> m_collidingToVisualMap = nullptr; ///< Maps transformations to visual geometry
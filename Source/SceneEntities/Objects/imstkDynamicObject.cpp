@@ -6,13 +6,21 @@
 
 #include "imstkDynamicObject.h"
 #include "imstkAbstractDynamicalModel.h"
+#include "imstkAbstractCellMesh.h"
 #include "imstkGeometryMap.h"
+#include "imstkGeometryUtilities.h"
 #include "imstkLogger.h"
+#include "imstkStateBuffers.h"
 #include "imstkTaskGraph.h"
 #include "imstkVisualModel.h"
 
 namespace imstk
 {
+DynamicObject::DynamicObject(const std::string& name) : CollidingObject(name),
+    m_renumberingStrategy(GeometryUtils::MeshNodeRenumberingStrategy::ReverseCuthillMckee)
+{
+}
+
 size_t
 DynamicObject::getNumOfDOF() const
 {
@@ -57,6 +65,12 @@ DynamicObject::updatePhysicsGeometry()
 bool
 DynamicObject::initialize()
 {
+    // Before anything computes on the vertex indices
+    if (m_renumberPhysicsMesh)
+    {
+        renumberPhysicsMesh();
+    }
+
     if (CollidingObject::initialize())
     {
         if (m_physicsToCollidingGeomMap)
@@ -77,6 +91,25 @@ DynamicObject::initialize()
     }
 }
 
+void
+DynamicObject::renumberPhysicsMesh()
+{
+    auto mesh = std::dynamic_pointer_cast<AbstractCellMesh>(m_physicsGeometry);
+    if (mesh == nullptr)
+    {
+        LOG(WARNING) << "Cannot renumber the physics geometry of " << m_name << ", it is not a cell mesh";
+        return;
+    }
+
+    const std::vector<size_t> newToOld = GeometryUtils::renumberMesh(mesh, m_renumberingStrategy);
+    std::vector<size_t>       oldToNew(newToOld.size());
+    for (size_t i = 0; i < newToOld.size(); i++)
+    {
+        oldToNew[newToOld[i]] = i;
+    }
+    remapNodeIds(oldToNew);
+}
+
 void
 DynamicObject::initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink)
 {
@@ -100,4 +133,18 @@ DynamicObject::reset()
     m_dynamicalModel->resetToInitialState();
     this->updateGeometries();
 };
+
+void
+DynamicObject::getStateBuffers(StateBuffers& buffers)
+{
+    CollidingObject::getStateBuffers(buffers);
+    if (m_physicsGeometry != nullptr)
+    {
+        m_physicsGeometry->getStateBuffers(buffers);
+    }
+    if (m_dynamicalModel != nullptr)
+    {
+        m_dynamicalModel->getStateBuffers(buffers);
+    }
+}
 } // namespace imstk
\ No newline at end of file
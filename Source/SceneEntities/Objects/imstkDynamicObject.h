@@ -14,6 +14,11 @@ class Geometry;
 class GeometryMap;
 class AbstractDynamicalModel;
 
+namespace GeometryUtils
+{
+enum class MeshNodeRenumberingStrategy;
+} // namespace GeometryUtils
+
 ///
 /// \class DynamicObject
 ///
@@ -52,6 +57,25 @@ public:
     virtual void setDynamicalModel(std::shared_ptr<AbstractDynamicalModel> dynaModel) { m_dynamicalModel = dynaModel; }
     ///@}
 
+    ///
+    /// \brief Set/Get whether to renumber the physics mesh on initialize for memory
+    /// locality, off by default. Vertices and cells are reordered such that those close in
+    /// the mesh are close in memory which speeds up solvers on meshes with poor ordering.
+    /// Vertex and cell attributes and the fixed node ids of the model are remapped, maps
+    /// are computed after. Only applies to cell meshes, vertex indices set by the user
+    /// on other objects are invalidated
+    ///@{
+    void setRenumberPhysicsMesh(const bool renumber) { m_renumberPhysicsMesh = renumber; }
+    bool getRenumberPhysicsMesh() const { return m_renumberPhysicsMesh; }
+    ///@}
+
+    ///
+    /// \brief Set/Get the method used to renumber the physics mesh, default Reverse Cuthill-Mckee
+    ///@{
+    void setRenumberingStrategy(const GeometryUtils::MeshNodeRenumberingStrategy strategy) { m_renumberingStrategy = strategy; }
+    GeometryUtils::MeshNodeRenumberingStrategy getRenumberingStrategy() const { return m_renumberingStrategy; }
+    ///@}
+
     ///
     /// \brief Returns the number of degree of freedom
     ///
@@ -77,13 +101,30 @@ public:
     ///
     void reset() override;
 
+    ///
+    /// \brief Adds the physics geometry and the state of the model to the colliding
+    /// and visual geometries
+    ///
+    void getStateBuffers(StateBuffers& buffers) override;
+
 protected:
     ///
     /// \brief Setup connectivity of task graph
     ///
     void initGraphEdges(std::shared_ptr<TaskNode> source, std::shared_ptr<TaskNode> sink) override;
 
-    DynamicObject(const std::string& name) : CollidingObject(name) { }
+    ///
+    /// \brief Renumber the physics mesh, see setRenumberPhysicsMesh
+    ///
+    void renumberPhysicsMesh();
+
+    ///
+    /// \brief Remap the vertex indices held by the object after the physics mesh was renumbered
+    /// \param oldToNew new index of every old vertex index
+    ///
+    virtual void remapNodeIds(const std::vector<size_t>& imstkNotUsed(oldToNew)) { }
+
+    DynamicObject(const std::string& name);
 
     std::shared_ptr<AbstractDynamicalModel> m_dynamicalModel = nullptr; ///< Dynamical model
     std::shared_ptr<Geometry> m_physicsGeometry = nullptr;              ///< Geometry used for Physics
@@ -91,5 +132,8 @@ protected:
     // Maps
     std::shared_ptr<GeometryMap> m_physicsToCollidingGeomMap = nullptr; ///< Maps from Physics to collision geometry
     std::shared_ptr<GeometryMap> m_physicsToVisualGeomMap    = nullptr; ///< Maps from Physics to visual geometry
+
+    bool m_renumberPhysicsMesh = false;
+    GeometryUtils::MeshNodeRenumberingStrategy m_renumberingStrategy;
 };
 } // namespace imstk
\ No newline at end of file
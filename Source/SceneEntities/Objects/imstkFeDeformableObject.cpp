@@ -32,4 +32,23 @@ FeDeformableObject::getFEMModel()
     m_femModel = std::dynamic_pointer_cast<FemDeformableBodyModel>(m_dynamicalModel);
     return m_femModel;
 }
+
+void
+FeDeformableObject::remapNodeIds(const std::vector<size_t>& oldToNew)
+{
+    std::shared_ptr<FemModelConfig> config = m_femModel->getForceModelConfiguration();
+    if (config == nullptr)
+    {
+        return;
+    }
+    for (size_t& id : config->m_fixedNodeIds)
+    {
+        id = oldToNew[id];
+    }
+    if (!config->m_fixedDOFFilename.empty())
+    {
+        LOG(WARNING) << "Physics mesh of " << m_name << " renumbered, the fixed nodes read from "
+                     << config->m_fixedDOFFilename << " are not remapped";
+    }
+}
 } // namespace imstk
\ No newline at end of file
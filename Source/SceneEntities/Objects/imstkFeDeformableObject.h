@@ -35,6 +35,11 @@ public:
     std::shared_ptr<FemDeformableBodyModel> getFEMModel();
 
 protected:
+    ///
+    /// \brief Remap the fixed node ids of the model
+    ///
+    void remapNodeIds(const std::vector<size_t>& oldToNew) override;
+
     std::shared_ptr<FemDeformableBodyModel> m_femModel = nullptr;
 };
 } // namespace imstk
\ No newline at end of file
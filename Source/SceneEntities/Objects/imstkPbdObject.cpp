@@ -31,4 +31,13 @@ PbdObject::initialize()
 
     return true;
 }
+
+void
+PbdObject::remapNodeIds(const std::vector<size_t>& oldToNew)
+{
+    for (size_t& id : m_pbdModel->getConfig()->m_fixedNodeIds)
+    {
+        id = oldToNew[id];
+    }
+}
 } // namespace imstk
\ No newline at end of file
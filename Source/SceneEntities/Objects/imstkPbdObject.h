@@ -38,6 +38,11 @@ public:
     bool initialize() override;
 
 protected:
+    ///
+    /// \brief Remap the fixed node ids of the model
+    ///
+    void remapNodeIds(const std::vector<size_t>& oldToNew) override;
+
     std::shared_ptr<PbdModel> m_pbdModel = nullptr; ///< Pbd mathematical model
 };
 } // namespace imstk
\ No newline at end of file
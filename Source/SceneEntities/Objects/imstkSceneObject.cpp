@@ -6,6 +6,7 @@
 
 #include "imstkSceneObject.h"
 #include "imstkGeometry.h"
+#include "imstkStateBuffers.h"
 #include "imstkTaskGraph.h"
 #include "imstkVisualModel.h"
 
@@ -47,6 +48,18 @@ SceneObject::setVisualGeometry(std::shared_ptr<Geometry> geometry)
     }
 }
 
+void
+SceneObject::getStateBuffers(StateBuffers& buffers)
+{
+    for (const auto& visualModel : m_visualModels)
+    {
+        if (visualModel->getGeometry() != nullptr)
+        {
+            visualModel->getGeometry()->getStateBuffers(buffers);
+        }
+    }
+}
+
 void
 SceneObject::initGraphEdges()
 {
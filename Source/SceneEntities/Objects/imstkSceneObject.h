@@ -17,6 +17,7 @@ namespace imstk
 class VisualModel;
 class DeviceClient;
 class Geometry;
+class StateBuffers;
 class TaskGraph;
 class TaskNode;
 
@@ -125,6 +126,12 @@ public:
     ///
     virtual void reset() { }
 
+    ///
+    /// \brief Add the memory holding the dynamic state of the object, see Scene::captureSnapshot.
+    /// Adds the visual geometries
+    ///
+    virtual void getStateBuffers(StateBuffers& buffers);
+
 protected:
     ///
     /// \brief Setup connectivity of the compute graph
@@ -0,0 +1,205 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkClosedSurfaceMeshToMeshCD.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkLineMesh.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdObject.h"
+#include "imstkPbdRigidObjectCollision.h"
+#include "imstkPointwiseMap.h"
+#include "imstkRbdConstraint.h"
+#include "imstkRigidBodyModel2.h"
+#include "imstkRigidObject2.h"
+#include "imstkScene.h"
+#include "imstkSceneBatchManager.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+using namespace imstk;
+
+///
+/// \brief Aggregate throughput of many instances of a small scene, a PBD tissue flap
+/// fixed on one side and pushed by a rigid tool, advanced in lockstep by a
+/// SceneBatchManager versus advanced one after another
+///
+namespace
+{
+const double s_dt = 0.005;
+
+///
+/// \brief Flap fixed along x = -1 pushed by a line tool. The tet cells and the initial
+/// positions of the flap come from the given rest mesh
+///
+std::shared_ptr<Scene>
+makeTissueFlapScene(std::shared_ptr<TetrahedralMesh> restMesh, const Vec3i& dim)
+{
+    auto scene = std::make_shared<Scene>("TissueFlap");
+
+    // Tissue
+    auto tissueMesh = std::make_shared<TetrahedralMesh>();
+    tissueMesh->initialize(std::make_shared<VecDataArray<double, 3>>(*restMesh->getInitialVertexPositions()),
+        restMesh->getCells());
+    tissueMesh->setInitialVertexPositions(restMesh->getInitialVertexPositions());
+    std::shared_ptr<SurfaceMesh> surfMesh = tissueMesh->extractSurfaceMesh();
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 0.9);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 0.95);
+    pbdParams->m_uniformMassValue = 0.05;
+    pbdParams->m_gravity    = Vec3d(0.0, -1.0, 0.0);
+    pbdParams->m_iterations = 5;
+    pbdParams->m_viscousDampingCoeff = 0.1;
+    for (int z = 0; z < dim[2]; z++)
+    {
+        for (int y = 0; y < dim[1]; y++)
+        {
+            pbdParams->m_fixedNodeIds.push_back(dim[0] * (y + dim[1] * z));
+        }
+    }
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(tissueMesh);
+    pbdModel->configure(pbdParams);
+    pbdModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    auto tissueObj = std::make_shared<PbdObject>("Tissue");
+    tissueObj->setVisualGeometry(surfMesh);
+    tissueObj->setPhysicsGeometry(tissueMesh);
+    tissueObj->setCollidingGeometry(surfMesh);
+    tissueObj->setPhysicsToCollidingMap(std::make_shared<PointwiseMap>(tissueMesh, surfMesh));
+    tissueObj->setDynamicalModel(pbdModel);
+    scene->addSceneObject(tissueObj);
+
+    // Tool
+    auto toolGeometry = std::make_shared<LineMesh>();
+    auto verticesPtr  = std::make_shared<VecDataArray<double, 3>>(2);
+    (*verticesPtr)[0] = Vec3d(0.0, 0.0, 0.0);
+    (*verticesPtr)[1] = Vec3d(0.0, 1.0, 0.0);
+    auto indicesPtr = std::make_shared<VecDataArray<int, 2>>(1);
+    (*indicesPtr)[0] = Vec2i(0, 1);
+    toolGeometry->initialize(verticesPtr, indicesPtr);
+
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_gravity = Vec3d::Zero();
+    rbdModel->getConfig()->m_maxNumIterations       = 7;
+    rbdModel->getConfig()->m_velocityDamping        = 0.95;
+    rbdModel->getConfig()->m_angularVelocityDamping = 1.0;
+    rbdModel->getConfig()->m_maxNumConstraints      = 40;
+    rbdModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    auto toolObj = std::make_shared<RigidObject2>("Tool");
+    toolObj->setVisualGeometry(toolGeometry);
+    toolObj->setCollidingGeometry(toolGeometry);
+    toolObj->setPhysicsGeometry(toolGeometry);
+    toolObj->setDynamicalModel(rbdModel);
+    toolObj->getRigidBody()->m_mass = 0.2;
+    toolObj->getRigidBody()->m_intertiaTensor = Mat3d::Identity() * 10000.0;
+    toolObj->getRigidBody()->m_initPos        = Vec3d(0.5, 0.4, 0.0);
+    scene->addSceneObject(toolObj);
+
+    auto interaction = std::make_shared<PbdRigidObjectCollision>(tissueObj, toolObj, "ClosedSurfaceMeshToMeshCD");
+    std::dynamic_pointer_cast<ClosedSurfaceMeshToMeshCD>(interaction->getCollisionDetection())->setGenerateEdgeEdgeContacts(true);
+    scene->addInteraction(interaction);
+
+    return scene;
+}
+
+///
+/// \brief Pull the tool of the instance under the flap and lift it, every instance
+/// with its own phase
+///
+void
+driveTool(const int instanceId, std::shared_ptr<Scene> scene)
+{
+    auto         toolObj = std::dynamic_pointer_cast<RigidObject2>(scene->getSceneObject("Tool"));
+    const double t       = scene->getSceneTime() + 0.1 * instanceId;
+    const Vec3d  target  = Vec3d(0.5 + 0.3 * std::sin(t), 0.4 - 0.5 * std::abs(std::sin(2.0 * t)), 0.3 * std::cos(t));
+    const Vec3d  fS      = (target - toolObj->getRigidBody()->getPosition()) * 100.0;
+    const Vec3d  fD      = -toolObj->getRigidBody()->getVelocity() * 1.0;
+    (*toolObj->getRigidBody()->m_force) += (fS + fD);
+}
+
+const Vec3i s_flapDim(8, 2, 8);
+
+std::shared_ptr<TetrahedralMesh>
+makeFlapRestMesh()
+{
+    return GeometryUtils::toTetGrid(Vec3d::Zero(), Vec3d(2.0, 0.25, 2.0), s_flapDim);
+}
+} // namespace
+
+///
+/// \brief N instances advanced in lockstep by a SceneBatchManager, sharing the rest mesh
+///
+static void
+BM_SceneBatch(benchmark::State& state)
+{
+    const int numInstances = static_cast<int>(state.range(0));
+
+    auto batch = std::make_shared<SceneBatchManager>();
+    batch->setNumInstances(numInstances);
+    batch->setSceneFactory([&](const int)
+        {
+            return makeTissueFlapScene(batch->getSharedData<TetrahedralMesh>("FlapRestMesh", makeFlapRestMesh), s_flapDim);
+        });
+    batch->setPreAdvanceCallback(driveTool);
+    batch->init();
+
+    for (auto _ : state)
+    {
+        batch->advance(s_dt);
+    }
+    state.counters["InstanceSteps"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * numInstances), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_SceneBatch)
+->Unit(benchmark::kMillisecond)
+->Name("Scene batch, lockstep")
+->RangeMultiplier(4)->Range(1, 256)
+->UseRealTime();
+
+///
+/// \brief N instances advanced one after another on the calling thread, each with its
+/// own copy of the data
+///
+static void
+BM_SceneSequence(benchmark::State& state)
+{
+    const int numInstances = static_cast<int>(state.range(0));
+
+    std::vector<std::shared_ptr<Scene>> scenes;
+    for (int i = 0; i < numInstances; i++)
+    {
+        scenes.push_back(makeTissueFlapScene(makeFlapRestMesh(), s_flapDim));
+        scenes.back()->initialize();
+    }
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < numInstances; i++)
+        {
+            driveTool(i, scenes[i]);
+            scenes[i]->advance(s_dt);
+        }
+    }
+    state.counters["InstanceSteps"] = benchmark::Counter(
+        static_cast<double>(state.iterations() * numInstances), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(BM_SceneSequence)
+->Unit(benchmark::kMillisecond)
+->Name("Scene sequence")
+->RangeMultiplier(4)->Range(1, 256)
+->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,681 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkBackwardEuler.h"
+#include "imstkClosedSurfaceMeshToMeshCD.h"
+#include "imstkDataArray.h"
+#include "imstkFeDeformableObject.h"
+#include "imstkFemDeformableBodyModel.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkImageData.h"
+#include "imstkLevelSetCH.h"
+#include "imstkLevelSetDeformableObject.h"
+#include "imstkLevelSetModel.h"
+#include "imstkLineMesh.h"
+#include "imstkLogger.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdObject.h"
+#include "imstkPbdRigidObjectCollision.h"
+#include "imstkPlane.h"
+#include "imstkPointSet.h"
+#include "imstkPointwiseMap.h"
+#include "imstkRbdConstraint.h"
+#include "imstkReplayDriver.h"
+#include "imstkRigidBodyCH.h"
+#include "imstkRigidBodyModel2.h"
+#include "imstkRigidObject2.h"
+#include "imstkRigidObjectCollision.h"
+#include "imstkRigidObjectLevelSetCollision.h"
+#include "imstkScene.h"
+#include "imstkSceneManager.h"
+#include "imstkSceneTestingUtils.h"
+#include "imstkSignedDistanceField.h"
+#include "imstkSphere.h"
+#include "imstkSphModel.h"
+#include "imstkSphObject.h"
+#include "imstkSphObjectCollision.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkTetrahedralMesh.h"
+#include "imstkThreadManager.h"
+#include "imstkVecDataArray.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <sstream>
+
+using namespace imstk;
+
+///
+/// \brief Headless end-to-end benchmark of representative scenes. Every scene is
+/// built procedurally after its example, without data files or viewer, then its
+/// SceneManager is stepped a fixed number of times with a fixed dt by a ReplayDriver.
+/// The frame times and the compute times of every TaskNode are reported in json for
+/// every thread count of the sweep
+///
+/// Usage: SceneBenchmark [--scene name|all] [--steps N] [--dt dt]
+///                       [--threads 1,2,4] [--out file.json]
+///
+namespace
+{
+///
+/// \brief Scripted motion of a tool, the position the tool is pulled to at time t
+///
+using ToolPath = std::function<Vec3d(const double t)>;
+
+///
+/// \brief Drive a rigid body along the path with a damped spring every update, as the
+/// examples do with the mouse
+///
+void
+driveAlongPath(std::shared_ptr<SceneManager> sceneManager, std::shared_ptr<Scene> scene,
+               std::shared_ptr<RigidObject2> toolObj, ToolPath path, const double ks, const double kd)
+{
+    connect<Event>(sceneManager, &SceneManager::postUpdate, [ = ](Event*)
+        {
+            const Vec3d target = path(scene->getSceneTime());
+            const Vec3d fS     = (target - toolObj->getRigidBody()->getPosition()) * ks;
+            const Vec3d fD     = -toolObj->getRigidBody()->getVelocity() * kd;
+            (*toolObj->getRigidBody()->m_force) += (fS + fD);
+        });
+}
+
+///
+/// \brief Cloth pinned at two corners falling under gravity (PBDCloth)
+///
+std::shared_ptr<Scene>
+makePbdClothScene(std::shared_ptr<SceneManager>)
+{
+    auto scene = std::make_shared<Scene>("PbdCloth");
+
+    const int                  dim      = 32;
+    std::shared_ptr<PbdObject> clothObj = makePbdCloth("Cloth",
+        GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(10.0, 10.0), Vec2i(dim, dim)), dim, 100.0 / (dim * dim));
+    clothObj->getPbdModel()->setTimeStepSizeType(TimeSteppingType::RealTime);
+    scene->addSceneObject(clothObj);
+
+    return scene;
+}
+
+///
+/// \brief Tet tissue block fixed on two sides, pushed into by a rigid line tool
+/// (PBDTissueContact)
+///
+std::shared_ptr<Scene>
+makePbdTissueContactScene(std::shared_ptr<SceneManager> sceneManager)
+{
+    auto scene = std::make_shared<Scene>("PbdTissueContact");
+
+    // Tissue
+    const Vec3i                      dim(8, 3, 8);
+    std::shared_ptr<TetrahedralMesh> tissueMesh = GeometryUtils::toTetGrid(Vec3d::Zero(), Vec3d(8.0, 1.0, 8.0), dim);
+    std::shared_ptr<SurfaceMesh>     surfMesh   = tissueMesh->extractSurfaceMesh();
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Volume, 0.9);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 0.95);
+    pbdParams->m_doPartitioning   = true;
+    pbdParams->m_uniformMassValue = 0.05;
+    pbdParams->m_gravity    = Vec3d(0.0, 0.0, 0.0);
+    pbdParams->m_iterations = 5;
+    pbdParams->m_viscousDampingCoeff = 0.1;
+    for (int z = 0; z < dim[2]; z++)
+    {
+        for (int y = 0; y < dim[1]; y++)
+        {
+            pbdParams->m_fixedNodeIds.push_back(dim[0] * (y + dim[1] * z));
+            pbdParams->m_fixedNodeIds.push_back(dim[0] - 1 + dim[0] * (y + dim[1] * z));
+        }
+    }
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(tissueMesh);
+    pbdModel->configure(pbdParams);
+    pbdModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    auto tissueObj = std::make_shared<PbdObject>("Tissue");
+    tissueObj->setVisualGeometry(surfMesh);
+    tissueObj->setPhysicsGeometry(tissueMesh);
+    tissueObj->setCollidingGeometry(surfMesh);
+    tissueObj->setPhysicsToCollidingMap(std::make_shared<PointwiseMap>(tissueMesh, surfMesh));
+    tissueObj->setDynamicalModel(pbdModel);
+    scene->addSceneObject(tissueObj);
+
+    // Tool
+    auto toolGeometry = std::make_shared<LineMesh>();
+    auto verticesPtr  = std::make_shared<VecDataArray<double, 3>>(2);
+    (*verticesPtr)[0] = Vec3d(0.0, 0.0, 0.0);
+    (*verticesPtr)[1] = Vec3d(0.0, 2.0, 0.0);
+    auto indicesPtr = std::make_shared<VecDataArray<int, 2>>(1);
+    (*indicesPtr)[0] = Vec2i(0, 1);
+    toolGeometry->initialize(verticesPtr, indicesPtr);
+
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_gravity = Vec3d::Zero();
+    rbdModel->getConfig()->m_maxNumIterations       = 7;
+    rbdModel->getConfig()->m_velocityDamping        = 0.95;
+    rbdModel->getConfig()->m_angularVelocityDamping = 1.0;
+    rbdModel->getConfig()->m_maxNumConstraints      = 40;
+    rbdModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    auto toolObj = std::make_shared<RigidObject2>("Tool");
+    toolObj->setVisualGeometry(toolGeometry);
+    toolObj->setCollidingGeometry(toolGeometry);
+    toolObj->setPhysicsGeometry(toolGeometry);
+    toolObj->setDynamicalModel(rbdModel);
+    toolObj->getRigidBody()->m_mass = 0.2;
+    toolObj->getRigidBody()->m_intertiaTensor = Mat3d::Identity() * 10000.0;
+    toolObj->getRigidBody()->m_initPos        = Vec3d(0.0, 0.8, 0.0);
+    scene->addSceneObject(toolObj);
+
+    auto interaction = std::make_shared<PbdRigidObjectCollision>(tissueObj, toolObj, "ClosedSurfaceMeshToMeshCD");
+    std::dynamic_pointer_cast<ClosedSurfaceMeshToMeshCD>(interaction->getCollisionDetection())->setGenerateEdgeEdgeContacts(true);
+    scene->addInteraction(interaction);
+
+    // Press into the tissue and sweep across it
+    driveAlongPath(sceneManager, scene, toolObj, [](const double t)
+        {
+            return Vec3d(2.0 * std::sin(t), 0.8 - 1.0 * std::abs(std::sin(2.0 * t)), 0.0);
+        }, 100.0, 1.0);
+
+    return scene;
+}
+
+///
+/// \brief Tet beam fixed at one end bending under gravity, falling onto a plane
+/// (DeformableBody)
+///
+std::shared_ptr<Scene>
+makeFemDeformableScene(std::shared_ptr<SceneManager>)
+{
+    auto scene = std::make_shared<Scene>("FemDeformable");
+
+    const Vec3i                      dim(12, 4, 4);
+    std::shared_ptr<TetrahedralMesh> tetMesh  = GeometryUtils::toTetGrid(Vec3d::Zero(), Vec3d(6.0, 2.0, 2.0), dim);
+    std::shared_ptr<SurfaceMesh>     surfMesh = tetMesh->extractSurfaceMesh();
+
+    auto config = std::make_shared<FemModelConfig>();
+    for (int z = 0; z < dim[2]; z++)
+    {
+        for (int y = 0; y < dim[1]; y++)
+        {
+            config->m_fixedNodeIds.push_back(dim[0] * (y + dim[1] * z));
+        }
+    }
+
+    auto dynaModel = std::make_shared<FemDeformableBodyModel>();
+    dynaModel->configure(config);
+    dynaModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+    dynaModel->setModelGeometry(tetMesh);
+    dynaModel->setTimeIntegrator(std::make_shared<BackwardEuler>(0.01));
+
+    auto deformableObj = std::make_shared<FeDeformableObject>("Beam");
+    deformableObj->setVisualGeometry(surfMesh);
+    deformableObj->setPhysicsGeometry(tetMesh);
+    deformableObj->setPhysicsToVisualMap(std::make_shared<PointwiseMap>(tetMesh, surfMesh));
+    deformableObj->setDynamicalModel(dynaModel);
+    scene->addSceneObject(deformableObj);
+
+    return scene;
+}
+
+///
+/// \brief Block of fluid dropped in a box of planes (SPHFluid)
+///
+std::shared_ptr<Scene>
+makeSphFluidScene(std::shared_ptr<SceneManager>)
+{
+    auto scene = std::make_shared<Scene>("SphFluid");
+
+    const double particleRadius = 0.1;
+    const int    dim = 20;
+    auto         particles      = std::make_shared<VecDataArray<double, 3>>();
+    particles->reserve(dim * dim * dim);
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                particles->push_back(Vec3d(x - dim / 2, y + 1, z - dim / 2) * 2.0 * particleRadius);
+            }
+        }
+    }
+    auto geometry = std::make_shared<PointSet>();
+    geometry->initialize(particles);
+
+    auto sphParams = std::make_shared<SphModelConfig>(particleRadius);
+    sphParams->m_bNormalizeDensity = true;
+
+    auto sphModel = std::make_shared<SphModel>();
+    sphModel->setModelGeometry(geometry);
+    sphModel->configure(sphParams);
+    sphModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    auto fluidObj = std::make_shared<SphObject>("Fluid");
+    fluidObj->setVisualGeometry(geometry);
+    fluidObj->setCollidingGeometry(geometry);
+    fluidObj->setPhysicsGeometry(geometry);
+    fluidObj->setDynamicalModel(sphModel);
+    scene->addSceneObject(fluidObj);
+
+    // Floor and walls
+    const double halfWidth = dim * particleRadius * 1.5;
+    const Vec3d  normals[] = { Vec3d(0.0, 1.0, 0.0), Vec3d(1.0, 0.0, 0.0), Vec3d(-1.0, 0.0, 0.0),
+                               Vec3d(0.0, 0.0, 1.0), Vec3d(0.0, 0.0, -1.0) };
+    for (int i = 0; i < 5; i++)
+    {
+        const Vec3d pos   = (i == 0) ? Vec3d::Zero() : Vec3d(-normals[i] * halfWidth);
+        auto        plane = std::make_shared<Plane>(pos, normals[i]);
+        auto        solid = std::make_shared<CollidingObject>("Wall" + std::to_string(i));
+        solid->setCollidingGeometry(plane);
+        scene->addSceneObject(solid);
+        scene->addInteraction(std::make_shared<SphObjectCollision>(fluidObj, solid));
+    }
+
+    return scene;
+}
+
+///
+/// \brief Pile of spheres dropped onto a plane, colliding with each other (RbdBallDrop)
+///
+std::shared_ptr<Scene>
+makeRbdPileScene(std::shared_ptr<SceneManager>)
+{
+    auto scene = std::make_shared<Scene>("RbdPile");
+
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_gravity = Vec3d(0.0, -9.8, 0.0);
+    rbdModel->getConfig()->m_maxNumIterations = 10;
+    rbdModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    auto planeObj = std::make_shared<CollidingObject>("Plane");
+    planeObj->setCollidingGeometry(std::make_shared<Plane>(Vec3d::Zero(), Vec3d::UnitY()));
+    scene->addSceneObject(planeObj);
+
+    // Stacked layers offset from each other so the spheres fall into a pile
+    std::vector<std::shared_ptr<RigidObject2>> sphereObjs;
+    for (int y = 0; y < 3; y++)
+    {
+        for (int z = 0; z < 2; z++)
+        {
+            for (int x = 0; x < 2; x++)
+            {
+                auto sphere    = std::make_shared<Sphere>(Vec3d::Zero(), 0.5);
+                auto sphereObj = std::make_shared<RigidObject2>("Sphere" + std::to_string(sphereObjs.size()));
+                sphereObj->setVisualGeometry(sphere);
+                sphereObj->setCollidingGeometry(sphere);
+                sphereObj->setPhysicsGeometry(sphere);
+                sphereObj->setDynamicalModel(rbdModel);
+                sphereObj->getRigidBody()->m_mass = 1.0;
+                sphereObj->getRigidBody()->m_initPos        = Vec3d(x * 1.1 + y * 0.3, 0.55 + y * 1.05, z * 1.1 - y * 0.2);
+                sphereObj->getRigidBody()->m_intertiaTensor = Mat3d::Identity();
+                scene->addSceneObject(sphereObj);
+                sphereObjs.push_back(sphereObj);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < sphereObjs.size(); i++)
+    {
+        scene->addInteraction(std::make_shared<RigidObjectCollision>(sphereObjs[i], planeObj));
+        for (size_t j = i + 1; j < sphereObjs.size(); j++)
+        {
+            scene->addInteraction(std::make_shared<RigidObjectCollision>(sphereObjs[i], sphereObjs[j]));
+        }
+    }
+
+    return scene;
+}
+
+///
+/// \brief Spherical burr driven into a level set block, removing material (FemurCut)
+///
+std::shared_ptr<Scene>
+makeLevelSetDrillingScene(std::shared_ptr<SceneManager> sceneManager)
+{
+    auto scene = std::make_shared<Scene>("LevelSetDrilling");
+
+    // Signed distance of the box [-0.5, 0.5] x [-0.3, 0.3] x [-0.5, 0.5]
+    const int    dim     = 64;
+    const double spacing = 1.2 / dim;
+    auto         image   = std::make_shared<ImageData>();
+    image->allocate(IMSTK_DOUBLE, 1, Vec3i(dim, dim, dim), Vec3d(spacing, spacing, spacing), Vec3d(-0.6, -0.6, -0.6));
+    DataArray<double>& scalars = *std::dynamic_pointer_cast<DataArray<double>>(image->getScalars());
+    const Vec3d        halfSize(0.5, 0.3, 0.5);
+    for (int z = 0; z < dim; z++)
+    {
+        for (int y = 0; y < dim; y++)
+        {
+            for (int x = 0; x < dim; x++)
+            {
+                const Vec3d pos = image->getOrigin() + (Vec3d(x, y, z) + Vec3d(0.5, 0.5, 0.5)) * spacing;
+                const Vec3d d   = pos.cwiseAbs() - halfSize;
+                scalars[image->getScalarIndex(x, y, z)] = d.cwiseMax(0.0).norm() + std::min(d.maxCoeff(), 0.0);
+            }
+        }
+    }
+    auto sdf = std::make_shared<SignedDistanceField>(image);
+
+    auto lvlSetConfig = std::make_shared<LevelSetModelConfig>();
+    lvlSetConfig->m_sparseUpdate = true;
+    lvlSetConfig->m_substeps     = 15;
+
+    auto lvlSetModel = std::make_shared<LevelSetModel>();
+    lvlSetModel->setModelGeometry(sdf);
+    lvlSetModel->configure(lvlSetConfig);
+    lvlSetModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    auto blockObj = std::make_shared<LevelSetDeformableObject>("Block");
+    blockObj->setPhysicsGeometry(sdf);
+    blockObj->setCollidingGeometry(sdf);
+    blockObj->setDynamicalModel(lvlSetModel);
+    scene->addSceneObject(blockObj);
+
+    // Tool
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_gravity = Vec3d::Zero();
+    rbdModel->getConfig()->m_maxNumIterations       = 8;
+    rbdModel->getConfig()->m_velocityDamping        = 1.0;
+    rbdModel->getConfig()->m_angularVelocityDamping = 1.0;
+    rbdModel->getConfig()->m_maxNumConstraints      = 40;
+    rbdModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    std::shared_ptr<SurfaceMesh> toolMesh =
+        GeometryUtils::toUVSphereSurfaceMesh(std::make_shared<Sphere>(Vec3d::Zero(), 0.1), 16, 16);
+
+    auto toolObj = std::make_shared<RigidObject2>("Burr");
+    toolObj->setVisualGeometry(toolMesh);
+    toolObj->setPhysicsGeometry(toolMesh);
+    toolObj->setCollidingGeometry(toolMesh);
+    toolObj->setDynamicalModel(rbdModel);
+    toolObj->getRigidBody()->m_mass = 10.0;
+    toolObj->getRigidBody()->m_intertiaTensor = Mat3d::Identity() * 10000.0;
+    toolObj->getRigidBody()->m_initPos        = Vec3d(0.2, 0.42, 0.0);
+    scene->addSceneObject(toolObj);
+
+    auto interaction = std::make_shared<RigidObjectLevelSetCollision>(toolObj, blockObj);
+    {
+        auto colHandlerA = std::dynamic_pointer_cast<RigidBodyCH>(interaction->getCollisionHandlingA());
+        colHandlerA->setUseFriction(false);
+        colHandlerA->setBaumgarteStabilization(0.05);
+
+        auto colHandlerB = std::dynamic_pointer_cast<LevelSetCH>(interaction->getCollisionHandlingB());
+        colHandlerB->setLevelSetVelocityScaling(0.01);
+        colHandlerB->setKernel(3, 1.0);
+        colHandlerB->setUseProportionalVelocity(true);
+    }
+    scene->addInteraction(interaction);
+
+    // Drill down into the block while circling
+    driveAlongPath(sceneManager, scene, toolObj, [](const double t)
+        {
+            return Vec3d(0.2 * std::cos(4.0 * t), 0.42 - 0.5 * t, 0.2 * std::sin(4.0 * t));
+        }, 1000.0, 100.0);
+
+    return scene;
+}
+
+struct SceneEntry
+{
+    std::string name;
+    std::function<std::shared_ptr<Scene>(std::shared_ptr<SceneManager>)> make;
+};
+
+const std::vector<SceneEntry>&
+getScenes()
+{
+    static const std::vector<SceneEntry> scenes = {
+        { "PbdCloth", makePbdClothScene },
+        { "PbdTissueContact", makePbdTissueContactScene },
+        { "FemDeformable", makeFemDeformableScene },
+        { "SphFluid", makeSphFluidScene },
+        { "RbdPile", makeRbdPileScene },
+        { "LevelSetDrilling", makeLevelSetDrillingScene }
+    };
+    return scenes;
+}
+
+///
+/// \brief Distribution of a set of times, ms
+///
+struct TimeStats
+{
+    double mean   = 0.0;
+    double min    = 0.0;
+    double max    = 0.0;
+    double median = 0.0;
+    double p95    = 0.0;
+    double stdDev = 0.0;
+};
+
+TimeStats
+computeStats(std::vector<double> times)
+{
+    TimeStats stats;
+    if (times.empty())
+    {
+        return stats;
+    }
+    std::sort(times.begin(), times.end());
+    const size_t n = times.size();
+    stats.mean   = std::accumulate(times.begin(), times.end(), 0.0) / n;
+    stats.min    = times.front();
+    stats.max    = times.back();
+    stats.median = (n % 2 == 1) ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+    stats.p95    = times[std::min(static_cast<size_t>(std::ceil(0.95 * n)) - 1, n - 1)];
+    double sqSum = 0.0;
+    for (const double t : times)
+    {
+        sqSum += (t - stats.mean) * (t - stats.mean);
+    }
+    stats.stdDev = std::sqrt(sqSum / n);
+    return stats;
+}
+
+std::string
+toJsonString(const std::string& str)
+{
+    std::string escaped = "\"";
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+
+void
+writeStats(std::ostream& os, const TimeStats& stats)
+{
+    os << "{ \"mean\": " << stats.mean << ", \"min\": " << stats.min << ", \"max\": " << stats.max
+       << ", \"median\": " << stats.median << ", \"p95\": " << stats.p95 << ", \"stddev\": " << stats.stdDev << " }";
+}
+
+///
+/// \brief Timings of one scene run with one thread count
+///
+struct RunResult
+{
+    std::string sceneName;
+    size_t numThreads;
+    TimeStats frameStats;
+    std::map<std::string, TimeStats> taskStats;
+};
+
+RunResult
+runScene(const SceneEntry& entry, const size_t numThreads, const int numSteps, const double dt)
+{
+    ParallelUtils::ThreadManager::setThreadPoolSize(numThreads);
+
+    auto sceneManager = std::make_shared<SceneManager>();
+    sceneManager->setActiveScene(entry.make(sceneManager));
+
+    ReplayDriver driver;
+    driver.addModule(sceneManager);
+    driver.setUseFixedStep(true);
+    driver.setDesiredDt(dt);
+    driver.setNumSteps(numSteps);
+    driver.start();
+
+    RunResult result;
+    result.sceneName  = entry.name;
+    result.numThreads = numThreads;
+    result.frameStats = computeStats(driver.getStepTimes());
+    for (const auto& nodeSamples : driver.getTaskTimeSamples())
+    {
+        result.taskStats[nodeSamples.first] = computeStats(nodeSamples.second);
+    }
+    return result;
+}
+
+void
+writeResults(std::ostream& os, const std::vector<RunResult>& results, const int numSteps, const double dt)
+{
+    os << "{\n  \"steps\": " << numSteps << ",\n  \"dt\": " << dt << ",\n  \"runs\": [\n";
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const RunResult& result = results[i];
+        os << "    {\n      \"scene\": " << toJsonString(result.sceneName)
+           << ",\n      \"threads\": " << result.numThreads << ",\n      \"frame\": ";
+        writeStats(os, result.frameStats);
+        os << ",\n      \"tasks\": {";
+        size_t j = 0;
+        for (const auto& nodeStats : result.taskStats)
+        {
+            os << (j++ == 0 ? "\n" : ",\n") << "        " << toJsonString(nodeStats.first) << ": ";
+            writeStats(os, nodeStats.second);
+        }
+        os << "\n      }\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+std::vector<size_t>
+parseThreadCounts(const std::string& str)
+{
+    std::vector<size_t> counts;
+    std::stringstream   ss(str);
+    std::string         item;
+    while (std::getline(ss, item, ','))
+    {
+        const int count = std::atoi(item.c_str());
+        if (count > 0)
+        {
+            counts.push_back(static_cast<size_t>(count));
+        }
+    }
+    return counts;
+}
+
+void
+printUsage()
+{
+    std::cout << "Usage: SceneBenchmark [--scene name|all] [--steps N] [--dt dt] [--threads 1,2,4] [--out file.json]\n"
+              << "Scenes:";
+    for (const SceneEntry& entry : getScenes())
+    {
+        std::cout << " " << entry.name;
+    }
+    std::cout << std::endl;
+}
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+    Logger::startLogger();
+
+    std::string         sceneName   = "all";
+    int                 numSteps    = 500;
+    double              dt          = 0.001;
+    std::vector<size_t> threadCounts = { 1, 2, 4 };
+    std::string         outFile;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h" || i + 1 == argc)
+        {
+            printUsage();
+            return (arg == "--help" || arg == "-h") ? 0 : 1;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--scene")
+        {
+            sceneName = value;
+        }
+        else if (arg == "--steps")
+        {
+            numSteps = std::atoi(value.c_str());
+        }
+        else if (arg == "--dt")
+        {
+            dt = std::atof(value.c_str());
+        }
+        else if (arg == "--threads")
+        {
+            threadCounts = parseThreadCounts(value);
+        }
+        else if (arg == "--out")
+        {
+            outFile = value;
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (numSteps <= 0 || dt <= 0.0 || threadCounts.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    std::vector<RunResult> results;
+    for (const SceneEntry& entry : getScenes())
+    {
+        if (sceneName != "all" && sceneName != entry.name)
+        {
+            continue;
+        }
+        for (const size_t numThreads : threadCounts)
+        {
+            results.push_back(runScene(entry, numThreads, numSteps, dt));
+            LOG(INFO) << entry.name << " with " << numThreads << " threads: mean frame "
+                      << results.back().frameStats.mean << "ms";
+        }
+    }
+    if (results.empty())
+    {
+        LOG(WARNING) << "Unknown scene " << sceneName;
+        printUsage();
+        return 1;
+    }
+
+    if (outFile.empty())
+    {
+        writeResults(std::cout, results, numSteps, dt);
+    }
+    else
+    {
+        std::ofstream file(outFile);
+        if (!file.is_open())
+        {
+            LOG(WARNING) << "Failed to open " << outFile;
+            return 1;
+        }
+        writeResults(file, results, numSteps, dt);
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCollidingObject.h"
+#include "imstkDeviceControl.h"
+#include "imstkFeDeformableObject.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkPbdObject.h"
+#include "imstkRbdConstraint.h"
+#include "imstkRigidBodyModel2.h"
+#include "imstkRigidObject2.h"
+#include "imstkScene.h"
+#include "imstkSceneTestingUtils.h"
+#include "imstkSphere.h"
+#include "imstkSurfaceMesh.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Per frame overhead of Scene::advance on a scene of 500 cheap objects, and the
+/// cost of dispatching to the objects of a type with casts versus the lists kept by the scene
+///
+namespace
+{
+class IdleControl : public DeviceControl
+{
+public:
+    IdleControl(const std::string& name) : DeviceControl(name) { }
+
+    void update(const double dt) override { m_time += dt; }
+
+    double m_time = 0.0;
+};
+
+///
+/// \brief 500 objects, 100 tiny pbd cloths, 100 rigid spheres sharing one model,
+/// 250 static colliding spheres and 50 controls
+///
+std::shared_ptr<Scene>
+makeScene(const bool parallel)
+{
+    auto sceneConfig = std::make_shared<SceneConfig>();
+    sceneConfig->taskParallelizationEnabled    = parallel;
+    sceneConfig->controlParallelizationEnabled = parallel;
+    auto scene = std::make_shared<Scene>("SceneOverhead", sceneConfig);
+
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_gravity = Vec3d(0.0, -9.8, 0.0);
+    rbdModel->setTimeStepSizeType(TimeSteppingType::RealTime);
+
+    for (int i = 0; i < 100; i++)
+    {
+        std::shared_ptr<PbdObject> clothObj = makePbdCloth("Cloth",
+            GeometryUtils::toTriangleGrid(Vec3d(2.0 * i, 0.0, 0.0), Vec2d(1.0, 1.0), Vec2i(3, 3)), 3, 1.0, 1);
+        clothObj->getPbdModel()->setTimeStepSizeType(TimeSteppingType::RealTime);
+        scene->addSceneObject(clothObj);
+
+        auto sphere    = std::make_shared<Sphere>(Vec3d::Zero(), 0.1);
+        auto sphereObj = std::make_shared<RigidObject2>("Sphere");
+        sphereObj->setVisualGeometry(sphere);
+        sphereObj->setCollidingGeometry(sphere);
+        sphereObj->setPhysicsGeometry(sphere);
+        sphereObj->setDynamicalModel(rbdModel);
+        sphereObj->getRigidBody()->m_mass    = 1.0;
+        sphereObj->getRigidBody()->m_initPos = Vec3d(2.0 * i, 1.0, 0.0);
+        scene->addSceneObject(sphereObj);
+    }
+    for (int i = 0; i < 250; i++)
+    {
+        auto obj = std::make_shared<CollidingObject>("Static");
+        obj->setCollidingGeometry(std::make_shared<Sphere>(Vec3d(2.0 * i, -2.0, 0.0), 0.5));
+        scene->addSceneObject(obj);
+    }
+    for (int i = 0; i < 50; i++)
+    {
+        scene->addControl(std::make_shared<IdleControl>("Control"));
+    }
+
+    scene->initialize();
+    return scene;
+}
+} // namespace
+
+///
+/// \brief Advance the 500 object scene, range(0) toggles the parallel stages and task graph
+///
+static void
+BM_SceneAdvance(benchmark::State& state)
+{
+    std::shared_ptr<Scene> scene = makeScene(state.range(0) != 0);
+    for (auto _ : state)
+    {
+        scene->advance(0.001);
+    }
+    state.counters["Objects"] = static_cast<double>(scene->getSceneObjects().size());
+}
+
+BENCHMARK(BM_SceneAdvance)
+->Unit(benchmark::kMicrosecond)
+->Name("Advance 500 objects, parallel")
+->Arg(0)->Arg(1)
+->UseRealTime();
+
+///
+/// \brief The per frame dispatch of Scene::advance done by casting every object
+///
+static void
+BM_CastDispatch(benchmark::State& state)
+{
+    std::shared_ptr<Scene> scene = makeScene(false);
+    for (auto _ : state)
+    {
+        for (auto obj : scene->getSceneObjects())
+        {
+            if (auto dynaObj = std::dynamic_pointer_cast<DynamicObject>(obj))
+            {
+                if (dynaObj->getDynamicalModel()->getTimeStepSizeType() == TimeSteppingType::RealTime)
+                {
+                    dynaObj->getDynamicalModel()->setTimeStep(0.001);
+                }
+            }
+        }
+        for (auto obj : scene->getSceneObjects())
+        {
+            if (auto defObj = std::dynamic_pointer_cast<FeDeformableObject>(obj))
+            {
+                benchmark::DoNotOptimize(defObj);
+            }
+        }
+        for (auto obj : scene->getSceneObjects())
+        {
+            if (auto controlObj = std::dynamic_pointer_cast<DeviceControl>(obj))
+            {
+                controlObj->update(0.001);
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_CastDispatch)
+->Unit(benchmark::kMicrosecond)
+->Name("Dispatch 500 objects, casts");
+
+///
+/// \brief The per frame dispatch of Scene::advance done with the lists of the scene
+///
+static void
+BM_ListDispatch(benchmark::State& state)
+{
+    std::shared_ptr<Scene> scene = makeScene(false);
+    for (auto _ : state)
+    {
+        for (const auto& dynaObj : scene->getDynamicObjects())
+        {
+            if (dynaObj->getDynamicalModel()->getTimeStepSizeType() == TimeSteppingType::RealTime)
+            {
+                dynaObj->getDynamicalModel()->setTimeStep(0.001);
+            }
+        }
+        for (const auto& defObj : scene->getFeDeformableObjects())
+        {
+            benchmark::DoNotOptimize(defObj);
+        }
+        for (const auto& control : scene->getDeviceControls())
+        {
+            control->update(0.001);
+        }
+    }
+}
+
+BENCHMARK(BM_ListDispatch)
+->Unit(benchmark::kMicrosecond)
+->Name("Dispatch 500 objects, lists");
+
+BENCHMARK_MAIN();
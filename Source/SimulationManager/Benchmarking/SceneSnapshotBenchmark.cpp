@@ -0,0 +1,127 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkGeometryUtilities.h"
+#include "imstkPbdObject.h"
+#include "imstkRbdConstraint.h"
+#include "imstkRigidBodyModel2.h"
+#include "imstkRigidObject2.h"
+#include "imstkScene.h"
+#include "imstkSceneSnapshot.h"
+#include "imstkSceneTestingUtils.h"
+#include "imstkSphere.h"
+#include "imstkSurfaceMesh.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Latency of resetting a scene against the number of objects in it, by resetting
+/// every object to its initial state versus restoring a snapshot
+///
+namespace
+{
+///
+/// \brief Scene of numObjects pinned pbd cloths, each 16x16 vertices, and numObjects rigid
+/// spheres sharing one model, advanced a few steps
+///
+std::shared_ptr<Scene>
+makeScene(const int numObjects)
+{
+    auto scene = std::make_shared<Scene>("SnapshotBenchmark");
+
+    auto rbdModel = std::make_shared<RigidBodyModel2>();
+    rbdModel->getConfig()->m_gravity = Vec3d(0.0, -9.8, 0.0);
+
+    for (int i = 0; i < numObjects; i++)
+    {
+        scene->addSceneObject(makePbdCloth("Cloth" + std::to_string(i),
+            GeometryUtils::toTriangleGrid(Vec3d(2.0 * i, 0.0, 0.0), Vec2d(1.0, 1.0), Vec2i(16, 16)), 16, 1.0, 2));
+
+        auto sphere    = std::make_shared<Sphere>(Vec3d::Zero(), 0.1);
+        auto sphereObj = std::make_shared<RigidObject2>("Sphere" + std::to_string(i));
+        sphereObj->setVisualGeometry(sphere);
+        sphereObj->setCollidingGeometry(sphere);
+        sphereObj->setPhysicsGeometry(sphere);
+        sphereObj->setDynamicalModel(rbdModel);
+        sphereObj->getRigidBody()->m_mass    = 1.0;
+        sphereObj->getRigidBody()->m_initPos = Vec3d(2.0 * i, 1.0, 0.0);
+        scene->addSceneObject(sphereObj);
+    }
+
+    scene->initialize();
+    for (int i = 0; i < 5; i++)
+    {
+        scene->advance(0.01);
+    }
+    return scene;
+}
+} // namespace
+
+///
+/// \brief Reset every object to its initial state with Scene::resetSceneObjects
+///
+static void
+BM_ResetSceneObjects(benchmark::State& state)
+{
+    std::shared_ptr<Scene> scene = makeScene(static_cast<int>(state.range(0)));
+    for (auto _ : state)
+    {
+        scene->resetSceneObjects();
+    }
+    state.counters["Objects"] = static_cast<double>(scene->getSceneObjects().size());
+}
+
+BENCHMARK(BM_ResetSceneObjects)
+->Unit(benchmark::kMicrosecond)
+->Name("Reset scene objects")
+->RangeMultiplier(4)->Range(1, 256);
+
+///
+/// \brief Restore a snapshot captured after initialization with Scene::restoreSnapshot
+///
+static void
+BM_RestoreSnapshot(benchmark::State& state)
+{
+    std::shared_ptr<Scene> scene = makeScene(static_cast<int>(state.range(0)));
+    SceneSnapshot          snapshot;
+    scene->captureSnapshot(snapshot);
+    for (auto _ : state)
+    {
+        scene->restoreSnapshot(snapshot);
+    }
+    state.counters["Objects"] = static_cast<double>(scene->getSceneObjects().size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * snapshot.getNumBytes()));
+}
+
+BENCHMARK(BM_RestoreSnapshot)
+->Unit(benchmark::kMicrosecond)
+->Name("Restore snapshot")
+->RangeMultiplier(4)->Range(1, 256);
+
+///
+/// \brief Capture a snapshot, reusing its memory
+///
+static void
+BM_CaptureSnapshot(benchmark::State& state)
+{
+    std::shared_ptr<Scene> scene = makeScene(static_cast<int>(state.range(0)));
+    SceneSnapshot          snapshot;
+    for (auto _ : state)
+    {
+        scene->captureSnapshot(snapshot);
+    }
+    state.counters["Objects"] = static_cast<double>(scene->getSceneObjects().size());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * snapshot.getNumBytes()));
+}
+
+BENCHMARK(BM_CaptureSnapshot)
+->Unit(benchmark::kMicrosecond)
+->Name("Capture snapshot")
+->RangeMultiplier(4)->Range(1, 256);
+
+BENCHMARK_MAIN();
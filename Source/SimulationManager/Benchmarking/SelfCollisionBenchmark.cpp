@@ -0,0 +1,136 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkCDObjectFactory.h"
+#include "imstkCollisionData.h"
+#include "imstkCollisionDetectionAlgorithm.h"
+#include "imstkGeometryUtilities.h"
+#include "imstkPbdModel.h"
+#include "imstkPbdObject.h"
+#include "imstkPbdObjectCollision.h"
+#include "imstkScene.h"
+#include "imstkSceneSnapshot.h"
+#include "imstkSurfaceMesh.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace imstk;
+
+///
+/// \brief Cost of self collision of a thin membrane, detection alone and detection plus
+/// the pbd solve of a whole frame, against the number of triangles. A membrane of about
+/// 20k triangles at 60Hz has a budget of 16.7ms per frame
+///
+namespace
+{
+///
+/// \brief Membrane of 4*res^2 triangles folded over itself, the upper layer slopes down
+/// through the lower layer such that they intersect along a line across the membrane
+///
+std::shared_ptr<SurfaceMesh>
+makeFoldedMembrane(const int res)
+{
+    std::shared_ptr<SurfaceMesh> surfMesh =
+        GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(2.0, 1.0), Vec2i(2 * res + 1, res + 1));
+
+    // Fold the grid in half along x at x = 0.5
+    VecDataArray<double, 3>& vertices = *surfMesh->getVertexPositions();
+    for (int i = 0; i < vertices.size(); i++)
+    {
+        const double s = vertices[i][0] + 1.0;
+        if (s <= 1.0)
+        {
+            vertices[i] = Vec3d(s - 0.5, 0.0, vertices[i][2]);
+        }
+        else
+        {
+            const double u = 2.0 - s;
+            vertices[i] = Vec3d(u - 0.5, 0.04 * (u - 0.45), vertices[i][2]);
+        }
+    }
+    surfMesh->setInitialVertexPositions(std::make_shared<VecDataArray<double, 3>>(vertices));
+    return surfMesh;
+}
+} // namespace
+
+///
+/// \brief SurfaceMeshSelfCD on a folded membrane of 4*range(0)^2 triangles
+///
+static void
+BM_SurfaceMeshSelfCD(benchmark::State& state)
+{
+    std::shared_ptr<SurfaceMesh> surfMesh = makeFoldedMembrane(static_cast<int>(state.range(0)));
+
+    std::shared_ptr<CollisionDetectionAlgorithm> cd = CDObjectFactory::makeCollisionDetection("SurfaceMeshSelfCD");
+    cd->setInputGeometryA(surfMesh);
+    cd->setInputGeometryB(surfMesh);
+    for (auto _ : state)
+    {
+        cd->update();
+    }
+    state.counters["Tris"]     = surfMesh->getNumCells();
+    state.counters["Contacts"] = cd->getCollisionData()->elementsA.size();
+}
+
+BENCHMARK(BM_SurfaceMeshSelfCD)
+->Unit(benchmark::kMillisecond)
+->Name("SurfaceMeshSelfCD")
+->Arg(18)->Arg(35)->Arg(71);
+
+///
+/// \brief One 60Hz frame of a pbd membrane of 4*range(0)^2 triangles, with distance and
+/// dihedral constraints, colliding with itself. Every frame starts from the same folded
+/// state, restored from a snapshot outside of the timing
+///
+static void
+BM_SelfCollisionFrame(benchmark::State& state)
+{
+    std::shared_ptr<SurfaceMesh> surfMesh = makeFoldedMembrane(static_cast<int>(state.range(0)));
+
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Dihedral, 1.0e1);
+    pbdParams->m_uniformMassValue = 1.0;
+    pbdParams->m_gravity    = Vec3d::Zero();
+    pbdParams->m_dt         = 1.0 / 60.0;
+    pbdParams->m_iterations = 5;
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(surfMesh);
+    pbdModel->configure(pbdParams);
+
+    auto membraneObj = std::make_shared<PbdObject>("Membrane");
+    membraneObj->setVisualGeometry(surfMesh);
+    membraneObj->setCollidingGeometry(surfMesh);
+    membraneObj->setPhysicsGeometry(surfMesh);
+    membraneObj->setDynamicalModel(pbdModel);
+
+    auto scene = std::make_shared<Scene>("SelfCollisionBenchmark");
+    scene->addSceneObject(membraneObj);
+    auto interaction = std::make_shared<PbdObjectCollision>(membraneObj, membraneObj, "SurfaceMeshSelfCD");
+    scene->addInteraction(interaction);
+    scene->initialize();
+
+    SceneSnapshot snapshot;
+    scene->captureSnapshot(snapshot);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        scene->restoreSnapshot(snapshot);
+        state.ResumeTiming();
+
+        scene->advance(pbdParams->m_dt);
+    }
+    state.counters["Tris"]     = surfMesh->getNumCells();
+    state.counters["Contacts"] = interaction->getCollisionDetection()->getCollisionData()->elementsA.size();
+}
+
+BENCHMARK(BM_SelfCollisionFrame)
+->Unit(benchmark::kMillisecond)
+->Name("Self collision frame")
+->Arg(18)->Arg(35)->Arg(71);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkDeviceRecording.h"
+#include "imstkDummyClient.h"
+#include "imstkReplayDriver.h"
+#include "imstkScene.h"
+#include "imstkSceneManager.h"
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Module recording the dt and device position it is updated with
+///
+class ProbeModule : public Module
+{
+public:
+    bool initModule() override { return true; }
+
+    void updateModule() override
+    {
+        m_dts.push_back(m_dt);
+        m_positions.push_back(m_device->getPosition());
+    }
+
+    std::shared_ptr<DeviceClient> m_device;
+    std::vector<double> m_dts;
+    std::vector<Vec3d>  m_positions;
+};
+
+std::shared_ptr<DeviceRecording>
+makeRecording(const int numFrames)
+{
+    auto recording = std::make_shared<DeviceRecording>(1);
+    for (int i = 0; i < numFrames; i++)
+    {
+        DeviceRecording::Frame frame;
+        frame.dt = 0.01 * (i + 1);
+        frame.states.resize(1);
+        frame.states[0].position = Vec3d(i, 0.0, 0.0);
+        recording->addFrame(frame);
+    }
+    return recording;
+}
+} // namespace
+
+///
+/// \brief Test every frame is replayed with its dt
+///
+TEST(imstkReplayDriverTest, TestReplay)
+{
+    ReplayDriver driver;
+    driver.setRecording(makeRecording(3));
+    ASSERT_EQ(driver.getNumDevices(), 1);
+
+    auto probe = std::make_shared<ProbeModule>();
+    probe->m_device = driver.getDevice(0);
+    driver.addModule(probe);
+    driver.start();
+
+    ASSERT_EQ(probe->m_dts.size(), 3);
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_DOUBLE_EQ(probe->m_dts[i], 0.01 * (i + 1));
+        EXPECT_EQ(probe->m_positions[i], Vec3d(i, 0.0, 0.0));
+    }
+    EXPECT_EQ(driver.getStepTimes().size(), 3);
+}
+
+///
+/// \brief Test fixed step mode, and steps past the recording holding the last frame
+///
+TEST(imstkReplayDriverTest, TestFixedStep)
+{
+    ReplayDriver driver;
+    driver.setRecording(makeRecording(3));
+    driver.setUseFixedStep(true);
+    driver.setDesiredDt(0.005);
+    driver.setNumSteps(5);
+
+    auto probe = std::make_shared<ProbeModule>();
+    probe->m_device = driver.getDevice(0);
+    driver.addModule(probe);
+    driver.start();
+
+    ASSERT_EQ(probe->m_dts.size(), 5);
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_EQ(probe->m_dts[i], 0.005);
+        EXPECT_EQ(probe->m_positions[i], Vec3d(std::min(i, 2), 0.0, 0.0));
+    }
+}
+
+///
+/// \brief Test the scene is advanced and its task nodes are timed
+///
+TEST(imstkReplayDriverTest, TestTaskTimes)
+{
+    auto scene = std::make_shared<Scene>("ReplayScene");
+    auto sceneManager = std::make_shared<SceneManager>();
+    sceneManager->setActiveScene(scene);
+
+    ReplayDriver driver;
+    driver.setNumSteps(10);
+    driver.setDesiredDt(0.01);
+    driver.addModule(sceneManager);
+    driver.start();
+
+    EXPECT_NEAR(scene->getSceneTime(), 0.1, 1.0e-12);
+    EXPECT_FALSE(driver.getTaskTimes().empty());
+
+    // Every timed node has a sample per step averaging to its mean
+    EXPECT_EQ(driver.getTaskTimeSamples().size(), driver.getTaskTimes().size());
+    for (const auto& nodeSamples : driver.getTaskTimeSamples())
+    {
+        ASSERT_EQ(nodeSamples.second.size(), 10u);
+        const double mean = std::accumulate(nodeSamples.second.begin(), nodeSamples.second.end(), 0.0) / 10.0;
+        EXPECT_NEAR(mean, driver.getTaskTimes().at(nodeSamples.first), 1.0e-9);
+    }
+}
@@ -0,0 +1,149 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkGeometryUtilities.h"
+#include "imstkPbdObject.h"
+#include "imstkScene.h"
+#include "imstkSceneBatchManager.h"
+#include "imstkSceneTestingUtils.h"
+#include "imstkSurfaceMesh.h"
+#include "imstkVecDataArray.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+using namespace imstk;
+
+namespace
+{
+///
+/// \brief Cloth pinned at two corners. The cells and initial positions are taken from
+/// the given mesh, the vertices are copied
+///
+std::shared_ptr<Scene>
+makeClothScene(std::shared_ptr<SurfaceMesh> restMesh)
+{
+    auto scene = std::make_shared<Scene>("Cloth");
+
+    auto clothMesh = std::make_shared<SurfaceMesh>();
+    clothMesh->initialize(std::make_shared<VecDataArray<double, 3>>(*restMesh->getInitialVertexPositions()),
+        restMesh->getCells());
+    clothMesh->setInitialVertexPositions(restMesh->getInitialVertexPositions());
+
+    std::shared_ptr<PbdObject> clothObj = makePbdCloth("Cloth", clothMesh, 8);
+    clothObj->getPbdModel()->setTimeStepSizeType(TimeSteppingType::RealTime);
+    scene->addSceneObject(clothObj);
+
+    return scene;
+}
+
+std::shared_ptr<SurfaceMesh>
+makeRestMesh()
+{
+    return GeometryUtils::toTriangleGrid(Vec3d::Zero(), Vec2d(1.0, 1.0), Vec2i(8, 8));
+}
+
+std::shared_ptr<SurfaceMesh>
+getClothMesh(std::shared_ptr<Scene> scene)
+{
+    return std::dynamic_pointer_cast<SurfaceMesh>(
+        std::dynamic_pointer_cast<PbdObject>(scene->getSceneObject("Cloth"))->getPhysicsGeometry());
+}
+} // namespace
+
+///
+/// \brief Test the shared data is created once and shared by all instances
+///
+TEST(imstkSceneBatchManagerTest, TestSharedData)
+{
+    auto batch = std::make_shared<SceneBatchManager>();
+    batch->setNumInstances(4);
+
+    int numCreated = 0;
+    batch->setSceneFactory([&](const int)
+        {
+            return makeClothScene(batch->getSharedData<SurfaceMesh>("RestMesh", [&]()
+            {
+                numCreated++;
+                return makeRestMesh();
+            }));
+        });
+    batch->init();
+    ASSERT_TRUE(batch->getInit());
+    ASSERT_EQ(batch->getScenes().size(), 4);
+    EXPECT_EQ(numCreated, 1);
+
+    std::shared_ptr<SurfaceMesh> mesh0 = getClothMesh(batch->getScene(0));
+    for (int i = 1; i < 4; i++)
+    {
+        std::shared_ptr<SurfaceMesh> mesh = getClothMesh(batch->getScene(i));
+        EXPECT_EQ(mesh->getCells(), mesh0->getCells());
+        EXPECT_EQ(mesh->getInitialVertexPositions(), mesh0->getInitialVertexPositions());
+        EXPECT_NE(mesh->getVertexPositions(), mesh0->getVertexPositions());
+    }
+}
+
+///
+/// \brief Test every instance advances in lockstep to the same state as a lone scene
+///
+TEST(imstkSceneBatchManagerTest, TestAdvance)
+{
+    auto batch = std::make_shared<SceneBatchManager>();
+    batch->setNumInstances(8);
+    batch->setNumThreads(4);
+    batch->setDt(0.01);
+    batch->setSceneFactory([&](const int)
+        {
+            return makeClothScene(batch->getSharedData<SurfaceMesh>("RestMesh", makeRestMesh));
+        });
+
+    std::atomic<int> numCallbacks = ATOMIC_VAR_INIT(0);
+    batch->setPreAdvanceCallback([&](const int, std::shared_ptr<Scene>)
+        {
+            numCallbacks++;
+        });
+    batch->init();
+    ASSERT_TRUE(batch->getInit());
+
+    std::shared_ptr<Scene> loneScene = makeClothScene(makeRestMesh());
+    ASSERT_TRUE(loneScene->initialize());
+
+    for (int i = 0; i < 20; i++)
+    {
+        batch->update();
+        loneScene->advance(0.01);
+    }
+    EXPECT_EQ(numCallbacks, 8 * 20);
+
+    const VecDataArray<double, 3>& expected = *getClothMesh(loneScene)->getVertexPositions();
+    for (const auto& scene : batch->getScenes())
+    {
+        EXPECT_DOUBLE_EQ(scene->getSceneTime(), loneScene->getSceneTime());
+        const VecDataArray<double, 3>& vertices = *getClothMesh(scene)->getVertexPositions();
+        ASSERT_EQ(vertices.size(), expected.size());
+        for (int j = 0; j < vertices.size(); j++)
+        {
+            EXPECT_TRUE(vertices[j].isApprox(expected[j])) << vertices[j].transpose() << " vs " << expected[j].transpose();
+        }
+    }
+
+    // The cloth fell
+    EXPECT_LT(expected[63][1], -0.1);
+
+    // Reset restores the rest positions
+    batch->resetScenes();
+    std::shared_ptr<SurfaceMesh>   restMesh     = makeRestMesh();
+    const VecDataArray<double, 3>& restVertices = *restMesh->getVertexPositions();
+    for (const auto& scene : batch->getScenes())
+    {
+        const VecDataArray<double, 3>& vertices = *getClothMesh(scene)->getVertexPositions();
+        for (int j = 0; j < vertices.size(); j++)
+        {
+            EXPECT_TRUE(vertices[j].isApprox(restVertices[j]));
+        }
+    }
+}
@@ -0,0 +1,210 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkReplayDriver.h"
+#include "imstkDeviceRecording.h"
+#include "imstkDummyClient.h"
+#include "imstkLogger.h"
+#include "imstkModule.h"
+#include "imstkScene.h"
+#include "imstkSceneManager.h"
+#include "imstkTimer.h"
+#include "imstkViewer.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace imstk
+{
+void
+ReplayDriver::start()
+{
+    // Modules may end the run, ie: a viewer window being closed
+    for (auto module : m_modules)
+    {
+        connect<Event>(module, &Module::end, [this](Event*) { requestStatus(ModuleDriverStopped); });
+    }
+    requestStatus(ModuleDriverRunning);
+
+    // Enable timing before the scenes initialize their task graphs
+    std::vector<std::shared_ptr<Scene>> scenes;
+    for (auto module : m_stepModules)
+    {
+        if (auto sceneManager = std::dynamic_pointer_cast<SceneManager>(module))
+        {
+            if (sceneManager->getActiveScene() != nullptr)
+            {
+                sceneManager->getActiveScene()->setEnableTaskTiming(true);
+                scenes.push_back(sceneManager->getActiveScene());
+            }
+        }
+    }
+
+    for (auto viewer : m_viewers)
+    {
+        viewer->init();
+    }
+    for (auto module : m_stepModules)
+    {
+        module->init();
+    }
+
+    const int numFrames = (m_recording != nullptr) ? m_recording->getNumFrames() : 0;
+    const int numSteps  = (m_numSteps >= 0) ? m_numSteps : numFrames;
+
+    m_stepTimes.clear();
+    m_stepTimes.reserve(numSteps);
+    m_taskTimes.clear();
+    m_taskTimeSamples.clear();
+
+    StopWatch timer;
+    for (int i = 0; i < numSteps && simState != ModuleDriverStopped; i++)
+    {
+        timer.start();
+
+        // Past the end of the recording the devices hold their last state
+        double dt = m_desiredDt;
+        if (i < numFrames)
+        {
+            applyFrame(i);
+            if (!m_useFixedStep)
+            {
+                dt = m_recording->getFrame(i).dt;
+            }
+        }
+
+        for (auto module : m_stepModules)
+        {
+            module->setDt(dt);
+            module->update();
+        }
+        for (auto viewer : m_viewers)
+        {
+            viewer->processEvents();
+            viewer->setDt(dt);
+            viewer->update();
+        }
+
+        m_stepTimes.push_back(timer.getTimeElapsed());
+        for (auto scene : scenes)
+        {
+            for (const auto& nodeTime : scene->getTaskComputeTimes())
+            {
+                m_taskTimes[nodeTime.first] += nodeTime.second;
+
+                // Nodes first seen in this step did not run in the previous ones
+                std::vector<double>& samples = m_taskTimeSamples[nodeTime.first];
+                samples.resize(m_stepTimes.size(), 0.0);
+                samples.back() += nodeTime.second;
+            }
+        }
+    }
+
+    if (!m_stepTimes.empty())
+    {
+        for (auto& nodeTime : m_taskTimes)
+        {
+            nodeTime.second /= static_cast<double>(m_stepTimes.size());
+        }
+    }
+    for (auto& nodeSamples : m_taskTimeSamples)
+    {
+        nodeSamples.second.resize(m_stepTimes.size(), 0.0);
+    }
+
+    for (auto module : m_modules)
+    {
+        module->uninit();
+    }
+}
+
+void
+ReplayDriver::addModule(std::shared_ptr<Module> module)
+{
+    ModuleDriver::addModule(module);
+
+    if (std::shared_ptr<Viewer> viewer = std::dynamic_pointer_cast<Viewer>(module))
+    {
+        m_viewers.push_back(viewer);
+    }
+    else
+    {
+        m_stepModules.push_back(module);
+    }
+}
+
+void
+ReplayDriver::clearModules()
+{
+    ModuleDriver::clearModules();
+    m_viewers.clear();
+    m_stepModules.clear();
+}
+
+void
+ReplayDriver::setRecording(std::shared_ptr<DeviceRecording> recording)
+{
+    m_recording = recording;
+    m_devices.clear();
+    if (m_recording != nullptr)
+    {
+        for (int i = 0; i < m_recording->getNumDevices(); i++)
+        {
+            m_devices.push_back(std::make_shared<DummyClient>("ReplayDevice" + std::to_string(i)));
+        }
+    }
+}
+
+bool
+ReplayDriver::loadRecording(const std::string& filePath)
+{
+    auto recording = std::make_shared<DeviceRecording>();
+    if (!recording->read(filePath))
+    {
+        return false;
+    }
+    setRecording(recording);
+    return true;
+}
+
+void
+ReplayDriver::applyFrame(const int i)
+{
+    const DeviceRecording::Frame& frame = m_recording->getFrame(i);
+    for (size_t j = 0; j < m_devices.size(); j++)
+    {
+        m_devices[j]->setDeviceState(frame.states[j]);
+        for (const auto& button : frame.buttons[j])
+        {
+            m_devices[j]->setButton(button.first, button.second);
+        }
+    }
+}
+
+void
+ReplayDriver::printTimes() const
+{
+    if (m_stepTimes.empty())
+    {
+        LOG(INFO) << "No steps taken";
+        return;
+    }
+
+    const double totalTime = std::accumulate(m_stepTimes.begin(), m_stepTimes.end(), 0.0);
+    LOG(INFO) << m_stepTimes.size() << " steps, mean " << totalTime / m_stepTimes.size() << "ms, min "
+              << *std::min_element(m_stepTimes.begin(), m_stepTimes.end()) << "ms, max "
+              << *std::max_element(m_stepTimes.begin(), m_stepTimes.end()) << "ms";
+
+    // Slowest first
+    std::vector<std::pair<std::string, double>> taskTimes(m_taskTimes.begin(), m_taskTimes.end());
+    std::sort(taskTimes.begin(), taskTimes.end(),
+        [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) { return a.second > b.second; });
+    for (const auto& nodeTime : taskTimes)
+    {
+        LOG(INFO) << "  " << nodeTime.first << ": " << nodeTime.second << "ms";
+    }
+}
+} // namespace imstk
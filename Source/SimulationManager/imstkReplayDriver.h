@@ -0,0 +1,130 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkModuleDriver.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace imstk
+{
+class DeviceRecording;
+class DummyClient;
+class Viewer;
+
+///
+/// \class ReplayDriver
+///
+/// \brief Drives the modules from a DeviceRecording instead of live devices and wall
+/// clock time, for repeatable runs ie: performance regression. Every frame of the
+/// recording sets the state of one DummyClient per recorded device (use these in place
+/// of the live devices) then steps every module once with the frame's time step, or
+/// with the desired dt in fixed step mode. Modules are stepped sequentially on the
+/// calling thread regardless of their execution type. Viewers are optional, without
+/// any the run is headless.
+///
+/// Task timing is enabled on the active scene of every SceneManager and the TaskNode
+/// compute times are accumulated over the run
+///
+class ReplayDriver : public ModuleDriver
+{
+public:
+    ReplayDriver() = default;
+    ~ReplayDriver() override = default;
+
+    void start() override;
+
+    void addModule(std::shared_ptr<Module> module) override;
+
+    void clearModules() override;
+
+    ///
+    /// \brief Set the recording to replay, creates its devices
+    ///
+    void setRecording(std::shared_ptr<DeviceRecording> recording);
+
+    ///
+    /// \brief Read the recording to replay from file, returns false on failure
+    ///
+    bool loadRecording(const std::string& filePath);
+
+    std::shared_ptr<DeviceRecording> getRecording() const { return m_recording; }
+
+    ///
+    /// \brief Get the device replaying the i'th recorded device
+    ///
+    std::shared_ptr<DummyClient> getDevice(const int i) const { return m_devices[i]; }
+
+    int getNumDevices() const { return static_cast<int>(m_devices.size()); }
+
+    ///
+    /// \brief Set/Get whether to step with the desired dt rather than the recorded one
+    ///@{
+    void setUseFixedStep(const bool useFixedStep) { m_useFixedStep = useFixedStep; }
+    bool getUseFixedStep() const { return m_useFixedStep; }
+    ///@}
+
+    ///
+    /// \brief Set/Get the dt used in fixed step mode or without recording, default 0.003
+    ///@{
+    void setDesiredDt(const double dt) { m_desiredDt = dt; }
+    double getDesiredDt() const { return m_desiredDt; }
+    ///@}
+
+    ///
+    /// \brief Set/Get the number of steps to run, -1 (default) runs the whole recording.
+    /// Without recording the steps are run with no device input
+    ///@{
+    void setNumSteps(const int numSteps) { m_numSteps = numSteps; }
+    int getNumSteps() const { return m_numSteps; }
+    ///@}
+
+    ///
+    /// \brief Wall time of every step taken in the last run, ms
+    ///
+    const std::vector<double>& getStepTimes() const { return m_stepTimes; }
+
+    ///
+    /// \brief Mean compute time per step of every TaskNode in the last run, ms.
+    /// Nodes of different scenes with the same name are summed
+    ///
+    const std::map<std::string, double>& getTaskTimes() const { return m_taskTimes; }
+
+    ///
+    /// \brief Compute time of every TaskNode in every step of the last run, ms. Steps
+    /// a node did not run in are 0
+    ///
+    const std::map<std::string, std::vector<double>>& getTaskTimeSamples() const { return m_taskTimeSamples; }
+
+    ///
+    /// \brief Log the step and TaskNode timings of the last run
+    ///
+    void printTimes() const;
+
+protected:
+    ///
+    /// \brief Apply frame i of the recording to the devices
+    ///
+    void applyFrame(const int i);
+
+    std::shared_ptr<DeviceRecording> m_recording;
+    std::vector<std::shared_ptr<DummyClient>> m_devices;
+
+    std::vector<std::shared_ptr<Viewer>> m_viewers;
+    std::vector<std::shared_ptr<Module>> m_stepModules; ///< Non viewer modules in order added
+
+    bool   m_useFixedStep = false;
+    double m_desiredDt    = 0.003;
+    int    m_numSteps     = -1;
+
+    std::vector<double> m_stepTimes;
+    std::map<std::string, double> m_taskTimes;
+    std::map<std::string, std::vector<double>> m_taskTimeSamples;
+};
+} // namespace imstk
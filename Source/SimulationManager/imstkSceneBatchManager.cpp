@@ -0,0 +1,104 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#include "imstkSceneBatchManager.h"
+#include "imstkLogger.h"
+#include "imstkParallelFor.h"
+#include "imstkScene.h"
+
+namespace imstk
+{
+SceneBatchManager::SceneBatchManager()
+{
+    // All instances step together with the other sequential modules
+    m_executionType = ExecutionType::SEQUENTIAL;
+}
+
+void
+SceneBatchManager::clearSharedData()
+{
+    std::lock_guard<std::mutex> lock(m_sharedDataMutex);
+    m_sharedData.clear();
+}
+
+void
+SceneBatchManager::advance(const double dt)
+{
+    m_arena->execute([&]()
+        {
+            ParallelUtils::parallelFor(m_scenes.size(), [&](const size_t i)
+            {
+                if (m_preAdvanceCallback != nullptr)
+                {
+                    m_preAdvanceCallback(static_cast<int>(i), m_scenes[i]);
+                }
+                m_scenes[i]->advance(dt);
+            });
+        });
+}
+
+void
+SceneBatchManager::resetScenes()
+{
+    m_arena->execute([&]()
+        {
+            ParallelUtils::parallelFor(m_scenes.size(), [&](const size_t i)
+            {
+                m_scenes[i]->resetSceneObjects();
+            });
+        });
+}
+
+bool
+SceneBatchManager::initModule()
+{
+    if (m_sceneFactory == nullptr)
+    {
+        LOG(WARNING) << "SceneBatchManager has no scene factory";
+        return false;
+    }
+
+    m_arena = (m_numThreads > 0) ?
+              std::unique_ptr<tbb::task_arena>(new tbb::task_arena(m_numThreads)) :
+              std::unique_ptr<tbb::task_arena>(new tbb::task_arena());
+
+    // Instances are created and initialized in order, the first one creates the shared data
+    m_scenes.clear();
+    m_scenes.reserve(m_numInstances);
+    for (int i = 0; i < m_numInstances; i++)
+    {
+        std::shared_ptr<Scene> scene = m_sceneFactory(i);
+        if (scene == nullptr)
+        {
+            LOG(WARNING) << "SceneBatchManager factory failed to create instance " << i;
+            return false;
+        }
+        if (!scene->initialize())
+        {
+            LOG(WARNING) << "SceneBatchManager failed to initialize instance " << i;
+            return false;
+        }
+        m_scenes.push_back(scene);
+    }
+    return true;
+}
+
+void
+SceneBatchManager::updateModule()
+{
+    // Process events given to this module
+    this->doAllEvents();
+
+    advance(getDt());
+}
+
+void
+SceneBatchManager::uninitModule()
+{
+    m_scenes.clear();
+    m_arena = nullptr;
+}
+} // namespace imstk
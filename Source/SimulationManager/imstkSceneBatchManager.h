@@ -0,0 +1,144 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkMacros.h"
+#include "imstkModule.h"
+
+DISABLE_WARNING_PUSH
+    DISABLE_WARNING_PADDING
+#include <tbb/task_arena.h>
+DISABLE_WARNING_POP
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace imstk
+{
+class Scene;
+
+///
+/// \class SceneBatchManager
+///
+/// \brief Module that runs many independent instances of a scene in one process,
+/// ie: for training data generation. The instances are created by the scene factory
+/// and advanced in lockstep, every update advances all of them once, concurrently,
+/// in a single tbb arena shared by the instances (and their task graphs and parallel
+/// loops). No instance is advanced again before all are done.
+///
+/// Identical instances may share read-only data through getSharedData, it is created
+/// once by the first instance asking for it. Only share data that is not written while
+/// the scenes advance, ie: the initial vertices of a mesh (PointSet::setInitialVertexPositions),
+/// its cells when it is not cut, or the image of a static SignedDistanceField
+///
+class SceneBatchManager : public Module
+{
+public:
+    ///
+    /// \brief Creates the instance with the given index
+    ///
+    using SceneFactory = std::function<std::shared_ptr<Scene>(const int instanceId)>;
+
+    ///
+    /// \brief Called for every instance before it's advanced, on the thread advancing it
+    ///
+    using InstanceCallback = std::function<void(const int instanceId, std::shared_ptr<Scene> scene)>;
+
+    SceneBatchManager();
+    ~SceneBatchManager() override = default;
+
+    ///
+    /// \brief Set the factory creating the instances
+    ///
+    void setSceneFactory(SceneFactory factory) { m_sceneFactory = factory; }
+
+    ///
+    /// \brief Set/Get the number of instances created on initialization, default 1
+    ///@{
+    void setNumInstances(const int numInstances) { m_numInstances = numInstances; }
+    int getNumInstances() const { return m_numInstances; }
+    ///@}
+
+    ///
+    /// \brief Set/Get the maximum number of threads of the arena, 0 (default) for
+    /// the default concurrency. Takes effect on initialization
+    ///@{
+    void setNumThreads(const int numThreads) { m_numThreads = numThreads; }
+    int getNumThreads() const { return m_numThreads; }
+    ///@}
+
+    ///
+    /// \brief Set the callback called for every instance before it's advanced
+    ///
+    void setPreAdvanceCallback(InstanceCallback callback) { m_preAdvanceCallback = callback; }
+
+    ///
+    /// \brief Get the instances, empty before initialization
+    ///@{
+    const std::vector<std::shared_ptr<Scene>>& getScenes() const { return m_scenes; }
+    std::shared_ptr<Scene> getScene(const int instanceId) const { return m_scenes[instanceId]; }
+    ///@}
+
+    ///
+    /// \brief Get the data shared by the instances under the name, the first call
+    /// creates it with create. Thread safe
+    ///
+    template<typename T, typename CreateFunc>
+    std::shared_ptr<T> getSharedData(const std::string& name, CreateFunc create)
+    {
+        std::lock_guard<std::mutex> lock(m_sharedDataMutex);
+        auto                        iter = m_sharedData.find(name);
+        if (iter == m_sharedData.end())
+        {
+            iter = m_sharedData.emplace(name, std::shared_ptr<T>(create())).first;
+        }
+        return std::static_pointer_cast<T>(iter->second);
+    }
+
+    ///
+    /// \brief Release the shared data, instances keep what they hold
+    ///
+    void clearSharedData();
+
+    ///
+    /// \brief Advance every instance once with the given dt, in parallel
+    ///
+    void advance(const double dt);
+
+    ///
+    /// \brief Reset every instance
+    ///
+    void resetScenes();
+
+    ///
+    /// \brief Create and initialize the instances
+    ///
+    bool initModule() override;
+
+    ///
+    /// \brief Advance every instance with the module's dt
+    ///
+    void updateModule() override;
+
+    void uninitModule() override;
+
+protected:
+    SceneFactory     m_sceneFactory = nullptr;
+    InstanceCallback m_preAdvanceCallback = nullptr;
+    int m_numInstances = 1;
+    int m_numThreads   = 0;
+
+    std::vector<std::shared_ptr<Scene>> m_scenes;
+    std::unique_ptr<tbb::task_arena>    m_arena;
+
+    std::unordered_map<std::string, std::shared_ptr<void>> m_sharedData;
+    std::mutex m_sharedDataMutex;
+};
+} // namespace imstk
@@ -16,16 +16,31 @@ PbdSolver::PbdSolver() :
     m_dt(0.0),
     m_constraints(std::make_shared<PbdConstraintContainer>()),
     m_positions(std::make_shared<VecDataArray<double, 3>>()),
-    m_invMasses(std::make_shared<DataArray<double>>())
+    m_invMasses(std::make_shared<DataArray<double>>()),
+    m_positionsf(std::make_shared<VecDataArray<float, 3>>()),
+    m_invMassesf(std::make_shared<DataArray<float>>())
 {
 }
 
 void
 PbdSolver::solve()
+{
+    if (m_singlePrecision)
+    {
+        solve(*m_positionsf, *m_invMassesf);
+    }
+    else
+    {
+        solve(*m_positions, *m_invMasses);
+    }
+}
+
+template<typename T>
+void
+PbdSolver::solve(VecDataArray<T, 3>& currPositions, const DataArray<T>& invMasses)
 {
     // Solve the constraints and partitioned constraints
-    VecDataArray<double, 3>& currPositions = *m_positions;
-    const DataArray<double>& invMasses     = *m_invMasses;
+    const T dt = static_cast<T>(m_dt);
 
     const std::vector<std::shared_ptr<PbdConstraint>>&              constraints = m_constraints->getConstraints();
     const std::vector<std::vector<std::shared_ptr<PbdConstraint>>>& partitionedConstraints = m_constraints->getPartitionedConstraints();
@@ -50,7 +65,7 @@ PbdSolver::solve()
     {
         for (const auto& constraint : constraints)
         {
-            constraint->projectConstraint(invMasses, m_dt, m_solverType, currPositions);
+            constraint->projectConstraint(invMasses, dt, m_solverType, currPositions);
         }
 
         for (const auto& constraintPartition : partitionedConstraints)
@@ -58,12 +73,12 @@ PbdSolver::solve()
             ParallelUtils::parallelFor(constraintPartition.size(),
                 [&](const size_t idx)
                 {
-                    constraintPartition[idx]->projectConstraint(invMasses, m_dt, m_solverType, currPositions);
+                    constraintPartition[idx]->projectConstraint(invMasses, dt, m_solverType, currPositions);
                 });
             //// Sequential
             //for (size_t k = 0; k < constraintPartition.size(); k++)
             //{
-            //    constraintPartition[k]->projectConstraint(invMasses, m_dt, m_solverType, currPositions);
+            //    constraintPartition[k]->projectConstraint(invMasses, dt, m_solverType, currPositions);
             //}
         }
     }
@@ -84,6 +99,7 @@ void
 PbdCollisionSolver::solve()
 {
     // Solve collision constraints
+    m_lastCollisionConstraints.clear();
     if (m_collisionConstraints->size() > 0)
     {
         unsigned int i = 0;
@@ -99,7 +115,20 @@ PbdCollisionSolver::solve()
             }
         }
 
-        m_collisionConstraints->clear();
+        m_lastCollisionConstraints.swap(*m_collisionConstraints);
+    }
+}
+
+void
+PbdCollisionSolver::solveLastCollisionConstraints()
+{
+    for (auto constraintList : m_lastCollisionConstraints)
+    {
+        const std::vector<PbdCollisionConstraint*>& constraints = *constraintList;
+        for (size_t j = 0; j < constraints.size(); j++)
+        {
+            constraints[j]->solvePosition();
+        }
     }
 }
 } // namespace imstk
\ No newline at end of file
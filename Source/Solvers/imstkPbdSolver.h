@@ -69,6 +69,23 @@ public:
     ///
     void setInvMasses(std::shared_ptr<DataArray<double>> invMasses) { this->m_invMasses = invMasses; }
 
+    ///
+    /// \brief Sets the single precision positions and invMasses used when solving in
+    /// single precision, see setSinglePrecision
+    ///@{
+    void setPositions(std::shared_ptr<VecDataArray<float, 3>> positions) { this->m_positionsf = positions; }
+    void setInvMasses(std::shared_ptr<DataArray<float>> invMasses) { this->m_invMassesf = invMasses; }
+///@}
+
+    ///
+    /// \brief Get/Set whether constraints are projected on the single precision
+    /// positions and invMasses. All constraints must support single precision,
+    /// see PbdConstraint::supportsSinglePrecision. Default false
+    ///@{
+    void setSinglePrecision(const bool singlePrecision) { m_singlePrecision = singlePrecision; }
+    bool getSinglePrecision() const { return m_singlePrecision; }
+///@}
+
     ///
     /// \brief Set time step
     ///
@@ -90,6 +107,9 @@ public:
     void solve() override;
 
 private:
+    template<typename T>
+    void solve(VecDataArray<T, 3>& currPositions, const DataArray<T>& invMasses);
+
     size_t m_iterations = 20;                                        ///< Number of NL Gauss-Seidel iterations for regular constraints
     double m_dt;                                                     ///< time step
 
@@ -97,6 +117,9 @@ private:
 
     std::shared_ptr<VecDataArray<double, 3>> m_positions = nullptr;
     std::shared_ptr<DataArray<double>>       m_invMasses = nullptr;
+    std::shared_ptr<VecDataArray<float, 3>>  m_positionsf = nullptr;
+    std::shared_ptr<DataArray<float>>        m_invMassesf = nullptr;
+    bool m_singlePrecision = false;
     PbdConstraint::SolverType m_solverType = PbdConstraint::SolverType::xPBD;
 };
 
@@ -126,12 +149,26 @@ public:
 
     ///
     /// \brief Solve the non linear system of equations G(x)=0 using Newton's method.
+    /// The solved constraints are kept as the last collision constraints
     ///
     void solve() override;
 
+    ///
+    /// \brief Project the constraints of the last solve once more, used by substepping
+    /// PbdModels to reuse the contacts of the previous step instead of detecting them
+    /// again every substep
+    ///
+    void solveLastCollisionConstraints();
+
+    ///
+    /// \brief Forget the constraints of the last solve, ie: when the collision is culled
+    ///
+    void clearLastCollisionConstraints() { m_lastCollisionConstraints.clear(); }
+
 private:
     size_t m_collisionIterations = 5;                                                                   ///< Number of NL Gauss-Seidel iterations for collision constraints
 
     std::shared_ptr<std::list<std::vector<PbdCollisionConstraint*>*>> m_collisionConstraints = nullptr; ///< Collision contraints charged to this solver
+    std::list<std::vector<PbdCollisionConstraint*>*> m_lastCollisionConstraints;                        ///< Collision constraints of the last solve
 };
 } // namespace imstk
\ No newline at end of file
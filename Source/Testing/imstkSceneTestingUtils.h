@@ -0,0 +1,49 @@
+/*
+** This file is part of the Interactive Medical Simulation Toolkit (iMSTK)
+** iMSTK is distributed under the Apache License, Version 2.0.
+** See accompanying NOTICE for details.
+*/
+
+#pragma once
+
+#include "imstkPbdModel.h"
+#include "imstkPbdObject.h"
+#include "imstkSurfaceMesh.h"
+
+namespace imstk
+{
+///
+/// \brief Pbd cloth with distance and dihedral constraints, pinned at both ends of its
+/// first row of vertices, falling under gravity. Shared by the scene tests and benchmarks,
+/// header only such that the Testing library does not depend on SceneEntities
+/// \param name name of the object
+/// \param clothMesh triangle grid as made by GeometryUtils::toTriangleGrid, used as
+/// the visual, physics and colliding geometry
+/// \param numCols number of vertices along a row of the grid
+/// \param uniformMass mass of every vertex
+/// \param iterations number of iterations of the solver
+///
+inline std::shared_ptr<PbdObject>
+makePbdCloth(const std::string& name, std::shared_ptr<SurfaceMesh> clothMesh, const int numCols,
+             const double uniformMass = 1.0, const unsigned int iterations = 5)
+{
+    auto pbdParams = std::make_shared<PbdModelConfig>();
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Distance, 1.0e2);
+    pbdParams->enableConstraint(PbdModelConfig::ConstraintGenType::Dihedral, 1.0e1);
+    pbdParams->m_fixedNodeIds     = { 0, static_cast<size_t>(numCols) - 1 };
+    pbdParams->m_uniformMassValue = uniformMass;
+    pbdParams->m_gravity    = Vec3d(0.0, -9.8, 0.0);
+    pbdParams->m_iterations = iterations;
+
+    auto pbdModel = std::make_shared<PbdModel>();
+    pbdModel->setModelGeometry(clothMesh);
+    pbdModel->configure(pbdParams);
+
+    auto clothObj = std::make_shared<PbdObject>(name);
+    clothObj->setVisualGeometry(clothMesh);
+    clothObj->setPhysicsGeometry(clothMesh);
+    clothObj->setCollidingGeometry(clothMesh);
+    clothObj->setDynamicalModel(pbdModel);
+    return clothObj;
+}
+} // namespace imstk
@@ -19,6 +19,8 @@
 %ignore imstk::DataArray::end(); /* fix the multiple-definition problem. */
 %ignore imstk::DataArray::cend() const; /* fix the multiple-definition problem. */
 %ignore imstk::DataArray::clone();
+%ignore imstk::DataArray::setAllocator;
+%ignore imstk::DataArray::getAllocator;
 %ignore imstk::VecDataArray::iterator; /* fix the multiple-definition problem. */
 %ignore imstk::VecDataArray::const_iterator;
 %ignore imstk::VecDataArray::begin(); /* fix the multiple-definition problem. */ 
@@ -27,6 +29,7 @@
 %ignore imstk::VecDataArray::cend() const; /* fix the multiple-definition problem. */
 %ignore imstk::VecDataArray::setData();
 %ignore imstk::VecDataArray::clone();
+%ignore imstk::VecDataArray::setAllocator;
 %ignore imstk::stdSink;
 %ignore imstk::LogManager;
 %ignore imstk::LoggerG3::Logger();
@@ -51,6 +54,8 @@
 %ignore imstk::RbdConstraint;
 %ignore imstk::PbdConstraintContainer;
 %ignore imstk::CollisionHandling::getTaskNode();
+%ignore imstk::SurfaceMeshSelfCD::getBVH() const;
+%ignore imstk::ClosedSurfaceMeshToMeshCD::getBVH() const;
 
 %ignore imstk::VTKTextStatusManager::getTextActor();
 %ignore imstk::AbstractVTKViewer::getVtkRenderWindow() const;
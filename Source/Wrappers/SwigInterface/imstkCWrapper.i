@@ -145,6 +145,7 @@
 #include "imstkSphereToCylinderCD.h"
 #include "imstkSphereToSphereCD.h"
 #include "imstkSurfaceMeshToCapsuleCD.h"
+#include "imstkSurfaceMeshSelfCD.h"
 #include "imstkSurfaceMeshToSphereCD.h"
 #include "imstkSurfaceMeshToSurfaceMeshCD.h"
 #include "imstkTetraToLineMeshCD.h"
@@ -171,6 +172,7 @@
  * Scene
  */
 #include "imstkScene.h"
+#include "imstkCollisionBroadPhase.h"
 #include "imstkCollisionInteraction.h"
 #include "imstkRigidObjectCollision.h"
 #include "imstkPbdObjectCutting.h"
@@ -394,6 +396,7 @@ namespace std
 %include "../../CollisionDetection/CollisionDetection/imstkPointSetToSphereCD.h"
 %include "../../CollisionDetection/CollisionDetection/imstkSphereToCylinderCD.h"
 %include "../../CollisionDetection/CollisionDetection/imstkSphereToSphereCD.h"
+%include "../../CollisionDetection/CollisionDetection/imstkSurfaceMeshSelfCD.h"
 %include "../../CollisionDetection/CollisionDetection/imstkSurfaceMeshToCapsuleCD.h"
 %include "../../CollisionDetection/CollisionDetection/imstkSurfaceMeshToSphereCD.h"
 %include "../../CollisionDetection/CollisionDetection/imstkSurfaceMeshToSurfaceMeshCD.h"
@@ -421,6 +424,7 @@ namespace std
  * Scene
  */
 %include "../../Scene/imstkScene.h";
+%include "../../Scene/imstkCollisionBroadPhase.h"
 %include "../../Scene/imstkCollisionInteraction.h"
 %include "../../Scene/imstkRigidObjectCollision.h"
 %include "../../Scene/imstkPbdObjectCutting.h"
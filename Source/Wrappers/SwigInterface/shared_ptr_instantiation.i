@@ -146,6 +146,7 @@
 %shared_ptr(imstk::PointSetToPlaneCD)
 %shared_ptr(imstk::SphereToCylinderCD)
 %shared_ptr(imstk::SphereToSphereCD)
+%shared_ptr(imstk::SurfaceMeshSelfCD)
 %shared_ptr(imstk::SurfaceMeshToCapsuleCD)
 %shared_ptr(imstk::SurfaceMeshToSphereCD)
 %shared_ptr(imstk::SurfaceMeshToSurfaceMeshCD)
@@ -176,6 +177,7 @@
  */
 %shared_ptr(imstk::SceneConfig)
 %shared_ptr(imstk::Scene)
+%shared_ptr(imstk::CollisionBroadPhase)
 %shared_ptr(imstk::CollisionInteraction)
 %shared_ptr(imstk::RigidObjectCollision)
 %shared_ptr(imstk::PbdObjectCutting)